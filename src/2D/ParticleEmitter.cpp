@@ -0,0 +1,38 @@
+#include "ParticleEmitter.h"
+
+ParticleEmitter::ParticleEmitter(Vector position, float rate, float lifetime, float minSpeed, float maxSpeed)
+{
+    this->position = position;
+    this->rate = rate;
+    this->lifetime = lifetime;
+    this->minSpeed = minSpeed;
+    this->maxSpeed = maxSpeed;
+}
+
+/**
+ * @brief Spawn the particles due during a step. When the system is full, the remaining particles are dropped
+ * @param system The system receiving the particles
+ * @param delta_t The duration of the step
+ * @return The number of particles spawned
+ */
+int ParticleEmitter::emit(ParticleSystem& system, float delta_t)
+{
+    if (!active) return 0;
+    pending += rate * delta_t;
+    int due = static_cast<int>(pending);
+    pending -= due;
+
+    int emitted = 0;
+    for (; emitted < due; emitted++)
+    {
+        float angle = direction + ofRandom(-spread, spread);
+        float speed = ofRandom(minSpeed, maxSpeed);
+        Vector velocity = Vector(std::cos(angle) * speed, std::sin(angle) * speed);
+        int index = system.add(position, velocity, mass, radius, lifetime);
+        if (index < 0) break;
+        system.red[index] = color[0];
+        system.green[index] = color[1];
+        system.blue[index] = color[2];
+    }
+    return emitted;
+}
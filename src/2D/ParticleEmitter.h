@@ -0,0 +1,35 @@
+#pragma once
+#include "ParticleSystem.h"
+
+/**
+ * @brief Spawns particles into a ParticleSystem at a steady rate, each with a lifetime and a random velocity in
+ * a cone around a direction. The particles come from the pool of the system, nothing is allocated
+ *
+ */
+class ParticleEmitter
+{
+private:
+    // Fraction of particle not emitted yet, carried to the next step
+    float pending = 0;
+
+public:
+    Vector position;
+    // Particles per second
+    float rate;
+    // Seconds, 0 for particles that never die
+    float lifetime;
+    // Angle of the mean direction of the particles, in radians from the x axis
+    float direction = PI / 2;
+    // Half angle of the cone of directions, in radians
+    float spread = 0;
+    float minSpeed;
+    float maxSpeed;
+    float mass = 1;
+    float radius = 1;
+    int color[3] = {255, 255, 255};
+    bool active = true;
+
+    ParticleEmitter(Vector position, float rate, float lifetime, float minSpeed, float maxSpeed);
+
+    int emit(ParticleSystem& system, float delta_t);
+};
@@ -0,0 +1,576 @@
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "SPHSolver.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Add a particle
+ * @param position The position
+ * @param velocity The velocity
+ * @param mass The mass, 0 for an immovable particle
+ * @param radius The radius
+ * @param lifetime The age the particle dies at, 0 for never
+ * @return The index of the particle, valid until the next step, or -1 when the system is full
+ */
+int ParticleSystem::add(Vector position, Vector velocity, float mass, float radius, float lifetime)
+{
+    if (capacity > 0 && size() >= capacity) return -1;
+    x.push_back(position.x);
+    y.push_back(position.y);
+    vx.push_back(velocity.x);
+    vy.push_back(velocity.y);
+    inversedMass.push_back(mass == 0 ? 0 : 1 / mass);
+    this->radius.push_back(radius);
+    red.push_back(255);
+    green.push_back(255);
+    blue.push_back(255);
+    time.push_back(0);
+    this->lifetime.push_back(lifetime);
+    return size() - 1;
+}
+
+/**
+ * @brief Remove a particle in constant time: the last particle takes its index
+ * @param index The index of the particle
+ */
+void ParticleSystem::remove(int index)
+{
+    removeAt(x, index);
+    removeAt(y, index);
+    removeAt(vx, index);
+    removeAt(vy, index);
+    removeAt(inversedMass, index);
+    removeAt(radius, index);
+    removeAt(red, index);
+    removeAt(green, index);
+    removeAt(blue, index);
+    removeAt(time, index);
+    removeAt(lifetime, index);
+}
+
+/**
+ * @brief Move the last value of an array to an index and drop the last slot, the capacity is kept
+ */
+template <class T> void ParticleSystem::removeAt(std::vector<T>& values, int index)
+{
+    values[index] = values.back();
+    values.pop_back();
+}
+
+/**
+ * @brief Remove the particles older than their lifetime
+ */
+void ParticleSystem::removeExpired()
+{
+    expiredCount = 0;
+    int i = 0;
+    while (i < size())
+    {
+        if (lifetime[i] > 0 && time[i] >= lifetime[i])
+        {
+            // The last particle is moved here, check it before going on
+            remove(i);
+            expiredCount++;
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/**
+ * @brief Allocate the arrays, the scratch of the sort and the grid once and limit the system to this number of
+ * particles, so that the steps never allocate
+ * @param count The number of particles
+ */
+void ParticleSystem::reserve(int count)
+{
+    capacity = count;
+    x.reserve(count);
+    y.reserve(count);
+    vx.reserve(count);
+    vy.reserve(count);
+    inversedMass.reserve(count);
+    radius.reserve(count);
+    red.reserve(count);
+    green.reserve(count);
+    blue.reserve(count);
+    time.reserve(count);
+    lifetime.reserve(count);
+    cellOf.reserve(count);
+    order.reserve(count);
+    scratch.reserve(count);
+    colorScratch.reserve(count);
+    cellStart.reserve(static_cast<size_t>(MAX_CELLS_PER_PARTICLE) * count + 2);
+}
+
+/**
+ * @return The memory held by the arrays of the particles, the scratch of the sort and the grid, in bytes
+ */
+size_t ParticleSystem::getAllocatedBytes()
+{
+    size_t floats = x.capacity() + y.capacity() + vx.capacity() + vy.capacity() + inversedMass.capacity()
+        + radius.capacity() + time.capacity() + lifetime.capacity() + scratch.capacity();
+    size_t ints = cellOf.capacity() + order.capacity() + cellStart.capacity();
+    size_t bytes = red.capacity() + green.capacity() + blue.capacity() + colorScratch.capacity();
+    return floats * sizeof(float) + ints * sizeof(int) + bytes;
+}
+
+/**
+ * @brief Remove every particle, the memory is kept
+ */
+void ParticleSystem::clear()
+{
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+    inversedMass.clear();
+    radius.clear();
+    red.clear();
+    green.clear();
+    blue.clear();
+    time.clear();
+    lifetime.clear();
+    collisionCount = 0;
+    expiredCount = 0;
+}
+
+int ParticleSystem::size()
+{
+    return static_cast<int>(x.size());
+}
+
+/**
+ * @return The number of threads the kernels run on
+ */
+int ParticleSystem::getThreadCount()
+{
+#ifdef _OPENMP
+    return threadCount > 0 ? threadCount : omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief Simulate one step: collisions, boundaries, fluid and other forces then integration, as the PhysicsWorld.
+ * The particles are then one step older, and the expired ones are removed
+ * @param delta_t The duration of the step
+ */
+void ParticleSystem::step(float delta_t)
+{
+    if (collisions) collide();
+    else collisionCount = 0;
+    checkBoundaries();
+    if (fluid != nullptr) fluid->apply(*this, delta_t);
+    applyForces(delta_t);
+    integrate(delta_t);
+    removeExpired();
+}
+
+/**
+ * @brief Apply the gravity and the friction to the velocities. The immovable particles are left at rest
+ * @param delta_t The duration of the step
+ */
+void ParticleSystem::applyForces(float delta_t)
+{
+    const int count = size();
+    float* velocityX = vx.data();
+    float* velocityY = vy.data();
+    const float* inversed = inversedMass.data();
+    const float gravityX = gravity.x * delta_t;
+    const float gravityY = gravity.y * delta_t;
+    const float drag = friction * delta_t;
+    const int threads = getThreadCount();
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        // Same as ParticleGravity, which skips the particles of infinite mass
+        float movable = inversed[i] > 0 ? 1.0f : 0.0f;
+        velocityX[i] += gravityX * movable - drag * velocityX[i] * inversed[i];
+        velocityY[i] += gravityY * movable - drag * velocityY[i] * inversed[i];
+    }
+}
+
+/**
+ * @brief Move the particles with their velocity, after the forces as in RigidBody::eulerIntegration, and age them
+ * @param delta_t The duration of the step
+ */
+void ParticleSystem::integrate(float delta_t)
+{
+    const int count = size();
+    float* positionX = x.data();
+    float* positionY = y.data();
+    const float* velocityX = vx.data();
+    const float* velocityY = vy.data();
+    float* age = time.data();
+    const int threads = getThreadCount();
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        positionX[i] += velocityX[i] * delta_t;
+        positionY[i] += velocityY[i] * delta_t;
+        age[i] += delta_t;
+    }
+}
+
+/**
+ * @brief Bounce the particles on the walls, when the system is bounded
+ */
+void ParticleSystem::checkBoundaries()
+{
+    if (width <= 0 || height <= 0) return;
+    const int count = size();
+    const int threads = getThreadCount();
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        if (x[i] < radius[i] || x[i] > width - radius[i])
+        {
+            x[i] = std::min(std::max(x[i], radius[i]), width - radius[i]);
+            vx[i] = x[i] == radius[i] ? std::abs(vx[i]) : -std::abs(vx[i]);
+        }
+        if (y[i] < radius[i] || y[i] > height - radius[i])
+        {
+            y[i] = std::min(std::max(y[i], radius[i]), height - radius[i]);
+            vy[i] = y[i] == radius[i] ? std::abs(vy[i]) : -std::abs(vy[i]);
+        }
+    }
+}
+
+/**
+ * @brief Resolve the overlapping pairs. Each particle is only tested against the particles of its cell and of
+ * the neighbour cells, with cells as large as the largest particle diameter. The oversized particles are tested
+ * against each other and against the cells their bounds overlap
+ */
+void ParticleSystem::collide()
+{
+    collisionCount = 0;
+    if (size() < 2) return;
+    sortByCell(0);
+
+    for (int row = 0; row < rows; row++)
+    {
+        for (int column = 0; column < columns; column++)
+        {
+            int cell = row * columns + column;
+            int begin = cellStart[cell];
+            int end = cellStart[cell + 1];
+            if (begin == end) continue;
+
+            // Half of the neighbourhood, so that each pair of cells is visited once
+            collideRange(begin, end);
+            if (column + 1 < columns) collideRanges(begin, end, cellStart[cell + 1], cellStart[cell + 2]);
+            if (row + 1 >= rows) continue;
+            for (int offset = -1; offset <= 1; offset++)
+            {
+                if (column + offset < 0 || column + offset >= columns) continue;
+                int other = cell + columns + offset;
+                collideRanges(begin, end, cellStart[other], cellStart[other + 1]);
+            }
+        }
+    }
+
+    // The particles of the grid are at most half a cell large
+    const int count = size();
+    for (int i = cellStart[columns * rows]; i < count; i++)
+    {
+        collideRanges(i, i + 1, i + 1, count);
+        float reach = radius[i] + cellSize / 2;
+        int firstColumn = std::max(cellIndex(static_cast<double>(x[i]) - reach - gridX, cellSize, columns), 0);
+        int lastColumn = std::min(cellIndex(static_cast<double>(x[i]) + reach - gridX, cellSize, columns), columns - 1);
+        int firstRow = std::max(cellIndex(static_cast<double>(y[i]) - reach - gridY, cellSize, rows), 0);
+        int lastRow = std::min(cellIndex(static_cast<double>(y[i]) + reach - gridY, cellSize, rows), rows - 1);
+        for (int row = firstRow; row <= lastRow; row++)
+        {
+            for (int column = firstColumn; column <= lastColumn; column++)
+            {
+                int cell = row * columns + column;
+                collideRanges(i, i + 1, cellStart[cell], cellStart[cell + 1]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Index of the cell at an offset from the grid along one axis, clamped just outside the grid so that a
+ * particle escaped far away can not overflow the conversion
+ * @param offset The offset from the first cell
+ * @param cellSize The size of the cells
+ * @param cells The number of cells along the axis
+ * @return The index, from -1 to cells
+ */
+int ParticleSystem::cellIndex(double offset, float cellSize, int cells)
+{
+    double index = std::floor(offset / cellSize);
+    if (!(index >= -1)) return -1;
+    return index < cells ? static_cast<int>(index) : cells;
+}
+
+/**
+ * @brief Build the grid over the particles and reorder the particle arrays cell by cell, with a counting sort.
+ * The grid covers the particles only, its cells grow when the particles are too spread out. The oversized
+ * particles are left out of the grid and sorted after its last cell
+ * @param minCellSize The smallest size of the cells, which are at least as large as the largest particle of the
+ * grid
+ */
+void ParticleSystem::sortByCell(float minCellSize)
+{
+    const int count = size();
+    float meanRadius = 0;
+    for (int i = 0; i < count; i++)
+    {
+        meanRadius += radius[i];
+    }
+    // At least one particle is not larger than the mean, the grid is never empty
+    const float oversized = OVERSIZED_RADIUS_FACTOR * meanRadius / count;
+
+    float minX = std::numeric_limits<float>::max(), maxX = -std::numeric_limits<float>::max();
+    float minY = minX, maxY = maxX;
+    float maxRadius = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (radius[i] > oversized) continue;
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+        maxRadius = std::max(maxRadius, radius[i]);
+    }
+
+    // The extents and cell counts are computed in double, they overflow an int when a particle escaped far away
+    const double extentX = static_cast<double>(maxX) - minX;
+    const double extentY = static_cast<double>(maxY) - minY;
+    const double maxCells = static_cast<double>(MAX_CELLS_PER_PARTICLE) * count;
+    double size = std::max(std::max(2 * maxRadius, minCellSize), 1e-3f);
+    while ((std::floor(extentX / size) + 1) * (std::floor(extentY / size) + 1) > maxCells)
+    {
+        size *= 2;
+    }
+    cellSize = static_cast<float>(size);
+    columns = static_cast<int>(extentX / size) + 1;
+    rows = static_cast<int>(extentY / size) + 1;
+    gridX = minX;
+    gridY = minY;
+
+    // Count the particles of each cell, shifted by one so that the prefix sum gives the start of each cell.
+    // The oversized particles go to an extra cell after the grid
+    const int cells = columns * rows;
+    cellStart.assign(cells + 2, 0);
+    cellOf.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        if (radius[i] > oversized)
+        {
+            cellOf[i] = cells;
+        }
+        else
+        {
+            int column = std::min(cellIndex(static_cast<double>(x[i]) - gridX, cellSize, columns), columns - 1);
+            int row = std::min(cellIndex(static_cast<double>(y[i]) - gridY, cellSize, rows), rows - 1);
+            cellOf[i] = row * columns + column;
+        }
+        cellStart[cellOf[i] + 1]++;
+    }
+    for (int cell = 0; cell <= cells; cell++)
+    {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+    // Stable within a cell, each start is moved to the end of its cell then shifted back
+    order.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        order[cellStart[cellOf[i]]++] = i;
+    }
+    for (int cell = cells + 1; cell > 0; cell--)
+    {
+        cellStart[cell] = cellStart[cell - 1];
+    }
+    cellStart[0] = 0;
+
+    permute(x, scratch);
+    permute(y, scratch);
+    permute(vx, scratch);
+    permute(vy, scratch);
+    permute(inversedMass, scratch);
+    permute(radius, scratch);
+    permute(red, colorScratch);
+    permute(green, colorScratch);
+    permute(blue, colorScratch);
+    permute(time, scratch);
+    permute(lifetime, scratch);
+}
+
+/**
+ * @brief Reorder an array of the particles in the order of the cells
+ * @param values The array, indexed by particle
+ * @param buffer Storage of the reordered array, swapped with values
+ */
+template <class T> void ParticleSystem::permute(std::vector<T>& values, std::vector<T>& buffer)
+{
+    const int count = size();
+    buffer.resize(count);
+    const int threads = getThreadCount();
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        buffer[i] = values[order[i]];
+    }
+    values.swap(buffer);
+}
+
+/**
+ * @brief Color the particles by their distance to the diagonal of the screen, as Particle::updateColor
+ * @param screenWidth The width of the screen
+ * @param screenHeight The height of the screen
+ */
+void ParticleSystem::updateColors(float screenWidth, float screenHeight)
+{
+    const int count = size();
+    const int threads = getThreadCount();
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        float distanceToDiagonal = y[i] / screenHeight - x[i] / screenWidth;
+        // Clamped for the particles out of the screen
+        float absDistance = std::min(std::abs(distanceToDiagonal), 1.0f);
+        // From the middle color towards the color of the side of the diagonal
+        float toRed = 0;
+        float toGreen = distanceToDiagonal < 0 ? 139 : 255;
+        float toBlue = distanceToDiagonal < 0 ? 139 : 127;
+        red[i] = static_cast<unsigned char>(102 + (toRed - 102) * absDistance);
+        green[i] = static_cast<unsigned char>(51 + (toGreen - 51) * absDistance);
+        blue[i] = static_cast<unsigned char>(153 + (toBlue - 153) * absDistance);
+    }
+}
+
+/**
+ * @brief Resolve the pairs of particles of a single cell
+ * @param begin The first particle of the cell
+ * @param end The particle after the last one
+ */
+void ParticleSystem::collideRange(int begin, int end)
+{
+    for (int i = begin; i < end; i++)
+    {
+        for (int j = i + 1; j < end; j++)
+        {
+            resolve(i, j);
+        }
+    }
+}
+
+/**
+ * @brief Resolve the pairs made of a particle of each of two different cells
+ */
+void ParticleSystem::collideRanges(int begin, int end, int otherBegin, int otherEnd)
+{
+    for (int i = begin; i < end; i++)
+    {
+        for (int j = otherBegin; j < otherEnd; j++)
+        {
+            resolve(i, j);
+        }
+    }
+}
+
+/**
+ * @brief Resolve a pair of particles if they overlap: the same impulse as CollisionManager2D, then the particles
+ * are pushed apart in proportion to their inverse masses
+ * @param i The first particle
+ * @param j The second particle
+ */
+void ParticleSystem::resolve(int i, int j)
+{
+    float dx = x[j] - x[i];
+    float dy = y[j] - y[i];
+    float minDistance = radius[i] + radius[j];
+    float squaredDistance = dx * dx + dy * dy;
+    if (squaredDistance > minDistance * minDistance) return;
+    collisionCount++;
+    float totalInversedMass = inversedMass[i] + inversedMass[j];
+    if (totalInversedMass == 0) return;
+
+    // Normal from i to j, any direction when the centers are the same
+    float distance = std::sqrt(squaredDistance);
+    float nx = 1;
+    float ny = 0;
+    if (distance > 0)
+    {
+        nx = dx / distance;
+        ny = dy / distance;
+    }
+
+    // Only the particles moving towards each other bounce
+    float approach = (vx[i] - vx[j]) * nx + (vy[i] - vy[j]) * ny;
+    if (approach > 0)
+    {
+        float k = approach * (PARTICLE_RESTITUTION + 1) / totalInversedMass;
+        vx[i] -= nx * k * inversedMass[i];
+        vy[i] -= ny * k * inversedMass[i];
+        vx[j] += nx * k * inversedMass[j];
+        vy[j] += ny * k * inversedMass[j];
+    }
+
+    float correction = (minDistance - distance) / totalInversedMass;
+    x[i] -= nx * correction * inversedMass[i];
+    y[i] -= ny * correction * inversedMass[i];
+    x[j] += nx * correction * inversedMass[j];
+    y[j] += ny * correction * inversedMass[j];
+}
+
+/**
+ * @brief Draw the particles as points, in screen space with y going up as Particle::draw
+ */
+void ParticleSystem::draw()
+{
+    const int count = size();
+    const float screenHeight = ofGetHeight();
+    mesh.clear();
+    mesh.setMode(OF_PRIMITIVE_POINTS);
+    for (int i = 0; i < count; i++)
+    {
+        mesh.addVertex(glm::vec3(x[i], screenHeight - y[i], 0));
+        mesh.addColor(ofColor(red[i], green[i], blue[i]));
+    }
+    mesh.draw();
+}
+
+/**
+ * @brief Measure the steps of a crowded system without any window: a square of particles with random velocities,
+ * under gravity and inside walls
+ * @param count The number of particles
+ * @param steps The number of steps
+ * @return The average duration of a step, in milliseconds
+ */
+double ParticleSystem::benchmark(int count, int steps)
+{
+    ParticleSystem system;
+    system.reserve(count);
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    float spacing = 3;
+    system.width = system.height = side * spacing;
+    system.gravity = Vector(0, -9.81f);
+    for (int i = 0; i < count; i++)
+    {
+        Vector position = Vector((i % side + 0.5f) * spacing, (i / side + 0.5f) * spacing);
+        system.add(position, Vector(ofRandom(-10, 10), ofRandom(-10, 10)), 1, 1);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int step = 0; step < steps; step++)
+    {
+        system.step(1.0f / 60.0f);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() / std::max(steps, 1);
+}
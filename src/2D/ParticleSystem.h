@@ -0,0 +1,110 @@
+#pragma once
+#include <vector>
+
+#include "Drawable.h"
+#include "Vector.h"
+
+// Restitution of the collisions between particles, as in CollisionManager2D
+#define PARTICLE_RESTITUTION 0.9f
+// The grid never has more cells than this many per particle, the cells grow instead
+#define MAX_CELLS_PER_PARTICLE 4
+// Particles larger than this many times the mean radius are kept out of the grid, so that its cells stay as
+// small as the other particles
+#define OVERSIZED_RADIUS_FACTOR 4.0f
+// Below this many particles, the kernels run on the calling thread only
+#define PARALLEL_MIN_PARTICLES 4096
+
+class SPHSolver;
+
+/**
+ * @brief A lightweight 2D particle system for effects. Particles are not objects: each property is a contiguous
+ * array (structure of arrays) indexed by particle, so that integration and forces are flat loops the compiler
+ * vectorizes. Collisions use a uniform grid rebuilt at each step with a counting sort, and the particles are
+ * reordered by cell so that each cell is a contiguous range. Indices are therefore not stable across steps.
+ * The few oversized particles are sorted after the last cell and tested against the cells they overlap.
+ * The per particle kernels (forces, integration, boundaries, colors) are split across threads with OpenMP.
+ * The arrays are a pool: reserve fixes their capacity, and a dead particle is replaced by the last one, so
+ * spawning and killing particles never touches the heap
+ *
+ */
+class ParticleSystem : public Drawable
+{
+private:
+    std::vector<int> cellOf;
+    std::vector<int> order;
+    std::vector<float> scratch;
+    std::vector<unsigned char> colorScratch;
+    // Rebuilt from the arrays at each draw
+    ofVboMesh mesh;
+
+    template <class T> void permute(std::vector<T>& values, std::vector<T>& buffer);
+    void collideRange(int begin, int end);
+    void collideRanges(int begin, int end, int otherBegin, int otherEnd);
+    void resolve(int i, int j);
+    void checkBoundaries();
+    template <class T> static void removeAt(std::vector<T>& values, int index);
+    static int cellIndex(double offset, float cellSize, int cells);
+
+public:
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> inversedMass;
+    std::vector<float> radius;
+    std::vector<unsigned char> red;
+    std::vector<unsigned char> green;
+    std::vector<unsigned char> blue;
+    // Age of each particle in seconds, as Particle::time, and the age it dies at, 0 for never
+    std::vector<float> time;
+    std::vector<float> lifetime;
+
+    // Settings, applied to every particle
+    Vector gravity = Vector(0, 0);
+    // Linear drag, as ParticleFriction
+    float friction = 0;
+    bool collisions = true;
+    // Particles bounce on the walls of [0, width] x [0, height] when both are positive
+    float width = 0;
+    float height = 0;
+
+    // Threads of the kernels, 0 for every core
+    int threadCount = 0;
+
+    // Maximum number of particles, 0 for no limit. Set by reserve, so that adding never allocates
+    int capacity = 0;
+
+    // Fluid forces applied at each step when set, not owned
+    SPHSolver* fluid = nullptr;
+
+    // Grid of the last sort: start of the range of each cell in the particle arrays. The oversized particles
+    // come after the last cell, from cellStart[columns * rows] to the end
+    std::vector<int> cellStart;
+    int columns = 0;
+    int rows = 0;
+    float cellSize = 0;
+    float gridX = 0;
+    float gridY = 0;
+
+    // Overlapping pairs found during the last step
+    int collisionCount = 0;
+    // Particles that reached their lifetime during the last step
+    int expiredCount = 0;
+
+    int add(Vector position, Vector velocity, float mass, float radius, float lifetime = 0);
+    void remove(int index);
+    void removeExpired();
+    void reserve(int count);
+    size_t getAllocatedBytes();
+    void clear();
+    int size();
+    void step(float delta_t);
+    void applyForces(float delta_t);
+    void integrate(float delta_t);
+    void collide();
+    void sortByCell(float minCellSize);
+    void updateColors(float screenWidth, float screenHeight);
+    int getThreadCount();
+    void draw() override;
+    static double benchmark(int count, int steps);
+};
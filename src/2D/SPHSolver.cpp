@@ -0,0 +1,225 @@
+#include "SPHSolver.h"
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief One fluid step: neighbours, densities and pressures, then the pressure and viscosity forces change the
+ * velocities. Called by the system before its other forces
+ * @param system The particles of the fluid
+ * @param delta_t The duration of the step
+ */
+void SPHSolver::apply(ParticleSystem& system, float delta_t)
+{
+    updateKernels();
+    buildNeighbours(system);
+    computeDensity(system);
+    applyForces(system, delta_t);
+}
+
+/**
+ * @brief Normalization of the 2D kernels for the current smoothing radius
+ */
+void SPHSolver::updateKernels()
+{
+    float h = smoothingRadius;
+    poly6 = 4 / (PI * std::pow(h, 8.0f));
+    spikyGradient = -30 / (PI * std::pow(h, 5.0f));
+    viscosityLaplacian = 40 / (PI * std::pow(h, 5.0f));
+}
+
+/**
+ * @brief Sort the particles in a grid with cells as large as the smoothing radius, then list the neighbours of
+ * each particle. A first parallel pass counts them, a second one writes them: each particle only writes its own
+ * range, so the passes need no synchronization
+ * @param system The particles, reordered by cell
+ */
+void SPHSolver::buildNeighbours(ParticleSystem& system)
+{
+    const int count = system.size();
+    neighbourStart.assign(count + 1, 0);
+    neighbours.clear();
+    if (count == 0) return;
+    system.sortByCell(smoothingRadius);
+
+    const int threads = system.getThreadCount();
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        neighbourStart[i + 1] = findNeighbours(system, i, nullptr);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        neighbourStart[i + 1] += neighbourStart[i];
+    }
+
+    neighbours.resize(neighbourStart[count]);
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        findNeighbours(system, i, neighbours.data() + neighbourStart[i]);
+    }
+}
+
+/**
+ * @brief Find the particles closer than the smoothing radius to a particle, in the 3 x 3 cells around it and
+ * among the oversized particles, which are not in the cells
+ * @param system The particles, sorted by cell
+ * @param particle The particle
+ * @param output Receives the neighbours when not null
+ * @return The number of neighbours
+ */
+int SPHSolver::findNeighbours(ParticleSystem& system, int particle, int* output)
+{
+    const float squaredRadius = smoothingRadius * smoothingRadius;
+    const float px = system.x[particle];
+    const float py = system.y[particle];
+    const int column = std::min(static_cast<int>((px - system.gridX) / system.cellSize), system.columns - 1);
+    const int row = std::min(static_cast<int>((py - system.gridY) / system.cellSize), system.rows - 1);
+
+    int found = 0;
+    auto check = [&](int j)
+    {
+        float dx = system.x[j] - px;
+        float dy = system.y[j] - py;
+        if (j == particle || dx * dx + dy * dy >= squaredRadius) return;
+        if (output != nullptr) output[found] = j;
+        found++;
+    };
+    for (int otherRow = std::max(row - 1, 0); otherRow <= std::min(row + 1, system.rows - 1); otherRow++)
+    {
+        for (int otherColumn = std::max(column - 1, 0); otherColumn <= std::min(column + 1, system.columns - 1);
+             otherColumn++)
+        {
+            int cell = otherRow * system.columns + otherColumn;
+            for (int j = system.cellStart[cell]; j < system.cellStart[cell + 1]; j++)
+            {
+                check(j);
+            }
+        }
+    }
+    for (int j = system.cellStart[system.columns * system.rows]; j < system.size(); j++)
+    {
+        check(j);
+    }
+    return found;
+}
+
+/**
+ * @brief Density of each particle from its neighbours and itself, and the pressure it gives
+ * @param system The particles, with their neighbours built
+ */
+void SPHSolver::computeDensity(ParticleSystem& system)
+{
+    const int count = system.size();
+    const float squaredRadius = smoothingRadius * smoothingRadius;
+    density.resize(count);
+    pressure.resize(count);
+
+    const int threads = system.getThreadCount();
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        // The particle itself, at distance 0
+        float sum = squaredRadius * squaredRadius * squaredRadius;
+        for (int n = neighbourStart[i]; n < neighbourStart[i + 1]; n++)
+        {
+            int j = neighbours[n];
+            float dx = system.x[j] - system.x[i];
+            float dy = system.y[j] - system.y[i];
+            float difference = squaredRadius - (dx * dx + dy * dy);
+            sum += difference * difference * difference;
+        }
+        density[i] = particleMass * poly6 * sum;
+        pressure[i] = stiffness * (density[i] - restDensity);
+    }
+}
+
+/**
+ * @brief Change the velocities of the movable particles with the pressure and viscosity forces. Each particle
+ * sums the forces of its neighbours on itself from the velocities of the start of the step, so the particles are
+ * independent and processed in parallel
+ * @param system The particles, with their densities computed
+ * @param delta_t The duration of the step
+ */
+void SPHSolver::applyForces(ParticleSystem& system, float delta_t)
+{
+    const int count = system.size();
+    deltaVx.resize(count);
+    deltaVy.resize(count);
+    const int threads = system.getThreadCount();
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        deltaVx[i] = deltaVy[i] = 0;
+        if (system.inversedMass[i] == 0) continue;
+        float forceX = 0;
+        float forceY = 0;
+        for (int n = neighbourStart[i]; n < neighbourStart[i + 1]; n++)
+        {
+            int j = neighbours[n];
+            float dx = system.x[i] - system.x[j];
+            float dy = system.y[i] - system.y[j];
+            float distance = std::sqrt(dx * dx + dy * dy);
+            float closeness = smoothingRadius - distance;
+
+            // Pressure, along the line between the particles, pushes them apart above the rest density
+            if (distance > 0)
+            {
+                float magnitude = -particleMass * (pressure[i] + pressure[j]) / (2 * density[j])
+                    * spikyGradient * closeness * closeness;
+                forceX += magnitude * dx / distance;
+                forceY += magnitude * dy / distance;
+            }
+
+            // Viscosity, towards the velocity of the neighbour
+            float weight = viscosity * particleMass / density[j] * viscosityLaplacian * closeness;
+            forceX += weight * (system.vx[j] - system.vx[i]);
+            forceY += weight * (system.vy[j] - system.vy[i]);
+        }
+        deltaVx[i] = forceX / density[i] * delta_t;
+        deltaVy[i] = forceY / density[i] * delta_t;
+    }
+
+#pragma omp parallel for num_threads(threads) schedule(static) if (count >= PARALLEL_MIN_PARTICLES)
+    for (int i = 0; i < count; i++)
+    {
+        system.vx[i] += deltaVx[i];
+        system.vy[i] += deltaVy[i];
+    }
+}
+
+/**
+ * @brief Measure the steps of a block of fluid falling in a tank, without any window
+ * @param count The number of particles
+ * @param steps The number of steps
+ * @return The average duration of a step, in milliseconds
+ */
+double SPHSolver::benchmark(int count, int steps)
+{
+    SPHSolver solver;
+    ParticleSystem system;
+    system.reserve(count);
+    system.collisions = false;
+    system.fluid = &solver;
+    system.gravity = Vector(0, -981);
+
+    // Particles half a smoothing radius apart, in a block a third as wide as the tank
+    float spacing = solver.smoothingRadius / 2;
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    system.width = side * spacing * 3;
+    system.height = side * spacing * 2;
+    for (int i = 0; i < count; i++)
+    {
+        Vector position = Vector((i % side + 1) * spacing, (i / side + 1) * spacing);
+        system.add(position, Vector(0, 0), 1, 1);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int step = 0; step < steps; step++)
+    {
+        system.step(1.0f / 600.0f);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() / std::max(steps, 1);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <vector>
+
+#include "ParticleSystem.h"
+
+/**
+ * @brief Smoothed particle hydrodynamics on the particles of a ParticleSystem, with the kernels of Müller et al.
+ * 2003 in 2D. Each particle is a sample of the fluid: its density comes from its neighbours within the smoothing
+ * radius, and the pressure and viscosity forces from the differences with them.
+ * The neighbours come from the grid of the system, with cells as large as the smoothing radius, and are stored
+ * per particle in a flat list built in parallel. Immovable particles take part as walls but are not moved
+ *
+ */
+class SPHSolver
+{
+private:
+    float poly6;
+    float spikyGradient;
+    float viscosityLaplacian;
+    // Velocity changes of the step, applied once every particle has read the velocities of its neighbours
+    std::vector<float> deltaVx;
+    std::vector<float> deltaVy;
+
+    void updateKernels();
+    int findNeighbours(ParticleSystem& system, int particle, int* output);
+
+public:
+    // Interaction distance, in the units of the positions
+    float smoothingRadius = 16;
+    float restDensity = 300;
+    // Pressure per density above the rest density
+    float stiffness = 2000;
+    float viscosity = 200;
+    // Every particle weighs the same for the fluid, whatever its mass in the system
+    float particleMass = 2.5f;
+
+    // Indexed by particle, valid until the system is sorted again
+    std::vector<float> density;
+    std::vector<float> pressure;
+    // Neighbours of particle i, itself excluded: neighbours[neighbourStart[i]] to neighbours[neighbourStart[i + 1] - 1]
+    std::vector<int> neighbourStart;
+    std::vector<int> neighbours;
+
+    void apply(ParticleSystem& system, float delta_t);
+    void buildNeighbours(ParticleSystem& system);
+    void computeDensity(ParticleSystem& system);
+    void applyForces(ParticleSystem& system, float delta_t);
+    static double benchmark(int count, int steps);
+};
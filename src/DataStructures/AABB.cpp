@@ -0,0 +1,146 @@
+#include "AABB.h"
+
+AABB::AABB()
+{
+    this->minCorner = Vector(0, 0, 0);
+    this->maxCorner = Vector(0, 0, 0);
+}
+
+AABB::AABB(Vector minCorner, Vector maxCorner)
+{
+    this->minCorner = minCorner;
+    this->maxCorner = maxCorner;
+}
+
+/**
+ * @brief Build the box enclosing a sphere
+ *
+ * @param center The center of the sphere
+ * @param radius The radius of the sphere
+ * @return The bounding box of the sphere
+ */
+AABB AABB::fromSphere(Vector center, float radius)
+{
+    return AABB(center - Vector(radius, radius, radius), center + Vector(radius, radius, radius));
+}
+
+/**
+ * @param other The other box
+ * @return True if the two boxes overlap (touching counts as overlapping)
+ */
+bool AABB::overlaps(AABB other)
+{
+    return minCorner.x <= other.maxCorner.x && maxCorner.x >= other.minCorner.x &&
+        minCorner.y <= other.maxCorner.y && maxCorner.y >= other.minCorner.y &&
+        minCorner.z <= other.maxCorner.z && maxCorner.z >= other.minCorner.z;
+}
+
+/**
+ * @param other The other box
+ * @return True if the other box is fully inside this one
+ */
+bool AABB::contains(AABB other)
+{
+    return minCorner.x <= other.minCorner.x && minCorner.y <= other.minCorner.y && minCorner.z <= other.minCorner.z
+        && maxCorner.x >= other.maxCorner.x && maxCorner.y >= other.maxCorner.y && maxCorner.z >= other.maxCorner.z;
+}
+
+/**
+ * @param other The other box
+ * @return The smallest box enclosing both boxes
+ */
+AABB AABB::merge(AABB other)
+{
+    return AABB(Vector(std::min(minCorner.x, other.minCorner.x), std::min(minCorner.y, other.minCorner.y),
+                       std::min(minCorner.z, other.minCorner.z)),
+                Vector(std::max(maxCorner.x, other.maxCorner.x), std::max(maxCorner.y, other.maxCorner.y),
+                       std::max(maxCorner.z, other.maxCorner.z)));
+}
+
+/**
+ * @param margin The distance added on every side
+ * @return The box grown by margin in every direction
+ */
+AABB AABB::fattened(float margin)
+{
+    return AABB(minCorner - Vector(margin, margin, margin), maxCorner + Vector(margin, margin, margin));
+}
+
+/**
+ * @param displacement The expected displacement of the box
+ * @return The box stretched in the direction of the displacement
+ */
+AABB AABB::extended(Vector displacement)
+{
+    AABB result = *this;
+    if (displacement.x < 0) result.minCorner.x += displacement.x;
+    else result.maxCorner.x += displacement.x;
+    if (displacement.y < 0) result.minCorner.y += displacement.y;
+    else result.maxCorner.y += displacement.y;
+    if (displacement.z < 0) result.minCorner.z += displacement.z;
+    else result.maxCorner.z += displacement.z;
+    return result;
+}
+
+/**
+ * @return The center of the box
+ */
+Vector AABB::center()
+{
+    return (minCorner + maxCorner) * 0.5f;
+}
+
+/**
+ * @return The half size of the box along each axis
+ */
+Vector AABB::halfExtents()
+{
+    return (maxCorner - minCorner) * 0.5f;
+}
+
+/**
+ * @return The surface area of the box, used as the insertion cost of the AABB tree
+ */
+float AABB::surfaceArea()
+{
+    Vector d = maxCorner - minCorner;
+    return 2 * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+/**
+ * @brief Slab test between a ray and the box
+ *
+ * @param origin The origin of the ray
+ * @param direction The direction of the ray (does not need to be normalized)
+ * @param maxDistance The length of the ray, in units of direction
+ * @param distance Set to the entry distance along the ray when it hits
+ * @return True if the ray hits the box before maxDistance
+ */
+bool AABB::rayIntersect(Vector origin, Vector direction, float maxDistance, float& distance)
+{
+    float tMin = 0;
+    float tMax = maxDistance;
+    float o[3] = {origin.x, origin.y, origin.z};
+    float d[3] = {direction.x, direction.y, direction.z};
+    float lo[3] = {minCorner.x, minCorner.y, minCorner.z};
+    float hi[3] = {maxCorner.x, maxCorner.y, maxCorner.z};
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (glm::abs(d[i]) < FLT_EPSILON)
+        {
+            // The ray is parallel to the slab, it must start inside of it
+            if (o[i] < lo[i] || o[i] > hi[i]) return false;
+            continue;
+        }
+        float inverse = 1.0f / d[i];
+        float t1 = (lo[i] - o[i]) * inverse;
+        float t2 = (hi[i] - o[i]) * inverse;
+        if (t1 > t2) std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) return false;
+    }
+    distance = tMin;
+    return true;
+}
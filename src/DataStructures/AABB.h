@@ -0,0 +1,27 @@
+#pragma once
+#include "Vector.h"
+
+/**
+ * @brief An axis-aligned bounding box, stored as its lower and upper corners
+ *
+ */
+class AABB
+{
+public:
+    Vector minCorner;
+    Vector maxCorner;
+
+    AABB();
+    AABB(Vector minCorner, Vector maxCorner);
+    static AABB fromSphere(Vector center, float radius);
+
+    bool overlaps(AABB other);
+    bool contains(AABB other);
+    AABB merge(AABB other);
+    AABB fattened(float margin);
+    AABB extended(Vector displacement);
+    Vector center();
+    Vector halfExtents();
+    float surfaceArea();
+    bool rayIntersect(Vector origin, Vector direction, float maxDistance, float& distance);
+};
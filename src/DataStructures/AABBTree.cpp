@@ -0,0 +1,575 @@
+#include "AABBTree.h"
+
+#include <algorithm>
+
+/**
+ * @brief Get a coordinate of a vector from its axis index
+ */
+static float getAxis(Vector v, int axis)
+{
+    return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
+AABBTree::AABBTree(): root(AABB_TREE_NULL_NODE), freeList(AABB_TREE_NULL_NODE), leafCount(0)
+{
+}
+
+/**
+ * @brief Take a node from the free list, or grow the node pool if it is empty
+ * @return The index of the node
+ */
+int AABBTree::allocateNode()
+{
+    int index;
+    if (freeList == AABB_TREE_NULL_NODE)
+    {
+        nodes.emplace_back();
+        index = static_cast<int>(nodes.size()) - 1;
+    }
+    else
+    {
+        index = freeList;
+        freeList = nodes[index].parent;
+    }
+
+    nodes[index].parent = AABB_TREE_NULL_NODE;
+    nodes[index].child1 = AABB_TREE_NULL_NODE;
+    nodes[index].child2 = AABB_TREE_NULL_NODE;
+    nodes[index].height = 0;
+    nodes[index].object = nullptr;
+    return index;
+}
+
+/**
+ * @brief Give a node back to the free list
+ * @param node The index of the node
+ */
+void AABBTree::freeNode(int node)
+{
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    nodes[node].object = nullptr;
+    freeList = node;
+}
+
+/**
+ * @brief Insert an object in the tree. Its proxyId is set to the index of its leaf
+ * @param object The object to insert
+ */
+void AABBTree::insert(RigidBody* object)
+{
+    int leaf = allocateNode();
+    nodes[leaf].box = object->getBounds().fattened(AABB_TREE_FAT_MARGIN);
+    nodes[leaf].object = object;
+    object->proxyId = leaf;
+
+    insertLeaf(leaf);
+    leafCount++;
+}
+
+/**
+ * @brief Replace the content of the tree with many objects at once. The tree is built top-down by median splits,
+ * which is much faster than inserting the objects one by one and gives a balanced tree
+ * @param objects The objects to insert
+ */
+void AABBTree::build(const std::vector<RigidBody*>& objects)
+{
+    clear();
+    if (objects.empty()) return;
+
+    // n leaves and n - 1 internal nodes
+    nodes.reserve(2 * objects.size() - 1);
+    std::vector<int> leaves(objects.size());
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        int leaf = allocateNode();
+        nodes[leaf].box = objects[i]->getBounds().fattened(AABB_TREE_FAT_MARGIN);
+        nodes[leaf].object = objects[i];
+        objects[i]->proxyId = leaf;
+        leaves[i] = leaf;
+    }
+    leafCount = static_cast<int>(objects.size());
+    root = buildNode(leaves, 0, leafCount);
+    nodes[root].parent = AABB_TREE_NULL_NODE;
+}
+
+/**
+ * @brief Build the subtree holding a range of leaves
+ * @return The index of the root of the subtree
+ */
+int AABBTree::buildNode(std::vector<int>& leaves, int first, int count)
+{
+    if (count == 1) return leaves[first];
+
+    AABB centers(nodes[leaves[first]].box.center(), nodes[leaves[first]].box.center());
+    for (int i = first + 1; i < first + count; i++)
+    {
+        Vector center = nodes[leaves[i]].box.center();
+        centers = centers.merge(AABB(center, center));
+    }
+
+    // Split at the median along the axis where the centers are the most spread
+    Vector spread = centers.maxCorner - centers.minCorner;
+    int axis = spread.x > spread.y && spread.x > spread.z ? 0 : spread.y > spread.z ? 1 : 2;
+    int half = count / 2;
+    std::nth_element(leaves.begin() + first, leaves.begin() + first + half, leaves.begin() + first + count,
+                     [this, axis](int a, int b)
+                     {
+                         return getAxis(nodes[a].box.center(), axis) < getAxis(nodes[b].box.center(), axis);
+                     });
+
+    int node = allocateNode();
+    int child1 = buildNode(leaves, first, half);
+    int child2 = buildNode(leaves, first + half, count - half);
+    nodes[node].child1 = child1;
+    nodes[node].child2 = child2;
+    nodes[child1].parent = node;
+    nodes[child2].parent = node;
+    refit(node);
+    return node;
+}
+
+/**
+ * @brief Remove an object from the tree
+ * @param object The object to remove
+ */
+void AABBTree::remove(RigidBody* object)
+{
+    int leaf = object->proxyId;
+    if (leaf == AABB_TREE_NULL_NODE) return;
+
+    removeLeaf(leaf);
+    freeNode(leaf);
+    object->proxyId = AABB_TREE_NULL_NODE;
+    leafCount--;
+}
+
+/**
+ * @brief Update the leaf of an object after it moved. The leaf is only reinserted if the object
+ * left its fat box, or if the fat box became much larger than the object
+ * @param object The object that moved
+ * @param displacement The expected displacement of the object during the next step
+ * @return True if the leaf was reinserted
+ */
+bool AABBTree::update(RigidBody* object, Vector displacement)
+{
+    if (object->proxyId == AABB_TREE_NULL_NODE)
+    {
+        insert(object);
+        return true;
+    }
+
+    int leaf = object->proxyId;
+    AABB tight = object->getBounds();
+    Vector predicted = displacement * AABB_TREE_DISPLACEMENT_MULTIPLIER;
+
+    if (nodes[leaf].box.contains(tight))
+    {
+        // Still inside, unless the fat box is far too large (the object slowed down a lot)
+        AABB largest = tight.fattened(4 * AABB_TREE_FAT_MARGIN).extended(predicted * 4);
+        if (largest.contains(nodes[leaf].box)) return false;
+    }
+
+    removeLeaf(leaf);
+    nodes[leaf].box = tight.fattened(AABB_TREE_FAT_MARGIN).extended(predicted);
+    insertLeaf(leaf);
+    return true;
+}
+
+/**
+ * @brief Remove every object from the tree and release the node pool
+ */
+void AABBTree::clear()
+{
+    for (auto& node : nodes)
+    {
+        if (node.height == 0 && node.object) node.object->proxyId = AABB_TREE_NULL_NODE;
+    }
+    nodes.clear();
+    root = AABB_TREE_NULL_NODE;
+    freeList = AABB_TREE_NULL_NODE;
+    leafCount = 0;
+}
+
+/**
+ * @brief Find the best sibling for a leaf using the surface area heuristic, then rebalance the path to the root
+ * @param leaf The index of the leaf
+ */
+void AABBTree::insertLeaf(int leaf)
+{
+    if (root == AABB_TREE_NULL_NODE)
+    {
+        root = leaf;
+        nodes[root].parent = AABB_TREE_NULL_NODE;
+        return;
+    }
+
+    // Descend the tree, choosing the child that costs the least area growth
+    AABB leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].isLeaf())
+    {
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        float area = nodes[index].box.surfaceArea();
+        float combinedArea = nodes[index].box.merge(leafBox).surfaceArea();
+
+        // Cost of creating a new parent for this node and the leaf
+        float cost = 2 * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritanceCost = 2 * (combinedArea - area);
+
+        float cost1 = leafBox.merge(nodes[child1].box).surfaceArea() + inheritanceCost;
+        if (!nodes[child1].isLeaf()) cost1 -= nodes[child1].box.surfaceArea();
+        float cost2 = leafBox.merge(nodes[child2].box).surfaceArea() + inheritanceCost;
+        if (!nodes[child2].isLeaf()) cost2 -= nodes[child2].box.surfaceArea();
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    // Create a new parent for the sibling and the leaf
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = leafBox.merge(nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+
+    if (oldParent != AABB_TREE_NULL_NODE)
+    {
+        if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+        else nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        root = newParent;
+    }
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    // Walk back up the tree, fixing heights and boxes
+    index = nodes[leaf].parent;
+    while (index != AABB_TREE_NULL_NODE)
+    {
+        index = balance(index);
+        refit(index);
+        index = nodes[index].parent;
+    }
+}
+
+/**
+ * @brief Detach a leaf from the tree. The leaf itself is not freed
+ * @param leaf The index of the leaf
+ */
+void AABBTree::removeLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = AABB_TREE_NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == AABB_TREE_NULL_NODE)
+    {
+        root = sibling;
+        nodes[sibling].parent = AABB_TREE_NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    // The sibling takes the place of the parent
+    if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+    else nodes[grandParent].child2 = sibling;
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    int index = grandParent;
+    while (index != AABB_TREE_NULL_NODE)
+    {
+        index = balance(index);
+        refit(index);
+        index = nodes[index].parent;
+    }
+}
+
+/**
+ * @brief Recompute the box and height of an internal node from its children
+ * @param node The index of the node
+ */
+void AABBTree::refit(int node)
+{
+    int child1 = nodes[node].child1;
+    int child2 = nodes[node].child2;
+    nodes[node].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+    nodes[node].box = nodes[child1].box.merge(nodes[child2].box);
+}
+
+/**
+ * @brief Perform a left or right rotation if the node is unbalanced
+ * @param iA The index of the node to balance
+ * @return The index of the node that now sits at the position of iA
+ */
+int AABBTree::balance(int iA)
+{
+    AABBTreeNode& A = nodes[iA];
+    if (A.isLeaf() || A.height < 2) return iA;
+
+    int iB = A.child1;
+    int iC = A.child2;
+    AABBTreeNode& B = nodes[iB];
+    AABBTreeNode& C = nodes[iC];
+
+    int balanceFactor = C.height - B.height;
+
+    // Rotate C up
+    if (balanceFactor > 1)
+    {
+        int iF = C.child1;
+        int iG = C.child2;
+        AABBTreeNode& F = nodes[iF];
+        AABBTreeNode& G = nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != AABB_TREE_NULL_NODE)
+        {
+            if (nodes[C.parent].child1 == iA) nodes[C.parent].child1 = iC;
+            else nodes[C.parent].child2 = iC;
+        }
+        else
+        {
+            root = iC;
+        }
+
+        if (F.height > G.height)
+        {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.box = B.box.merge(G.box);
+            C.box = A.box.merge(F.box);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else
+        {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.box = B.box.merge(F.box);
+            C.box = A.box.merge(G.box);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // Rotate B up
+    if (balanceFactor < -1)
+    {
+        int iD = B.child1;
+        int iE = B.child2;
+        AABBTreeNode& D = nodes[iD];
+        AABBTreeNode& E = nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != AABB_TREE_NULL_NODE)
+        {
+            if (nodes[B.parent].child1 == iA) nodes[B.parent].child1 = iB;
+            else nodes[B.parent].child2 = iB;
+        }
+        else
+        {
+            root = iB;
+        }
+
+        if (D.height > E.height)
+        {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.box = C.box.merge(E.box);
+            B.box = A.box.merge(D.box);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else
+        {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.box = C.box.merge(D.box);
+            B.box = A.box.merge(E.box);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+/**
+ * @brief Draw the boxes of the tree, leaves in red and internal nodes in blue
+ */
+void AABBTree::draw()
+{
+    ofNoFill();
+    for (auto& node : nodes)
+    {
+        if (node.height < 0) continue;
+        ofSetColor(node.isLeaf() ? ofColor::red : ofColor::blue);
+        Vector size = node.box.halfExtents() * 2;
+        ofDrawBox(node.box.center().v3(), size.x, size.y, size.z);
+    }
+    ofFill();
+}
+
+/**
+ * @brief Collect the boxes of the nodes, to draw them elsewhere
+ * @param leaves Receives the boxes of the leaves, appended
+ * @param internalNodes Receives the boxes of the internal nodes, appended
+ */
+void AABBTree::getBoxes(std::vector<AABB>& leaves, std::vector<AABB>& internalNodes)
+{
+    for (auto& node : nodes)
+    {
+        if (node.height < 0) continue;
+        if (node.isLeaf()) leaves.push_back(node.box);
+        else internalNodes.push_back(node.box);
+    }
+}
+
+/**
+ * @return The height of the tree (0 when it holds a single leaf)
+ */
+int AABBTree::getHeight()
+{
+    return root == AABB_TREE_NULL_NODE ? 0 : nodes[root].height;
+}
+
+/**
+ * @return The number of objects in the tree
+ */
+int AABBTree::getLeafCount()
+{
+    return leafCount;
+}
+
+/**
+ * @brief Handler function to check for broad collisions. Each pair is reported once
+ * @return All the pairs of objects whose bounds overlap
+ */
+std::vector<std::pair<RigidBody*, RigidBody*>> AABBTree::getCollisions()
+{
+    std::vector<std::pair<RigidBody*, RigidBody*>> collisions;
+    if (root == AABB_TREE_NULL_NODE) return collisions;
+
+    for (int i = 0; i < static_cast<int>(nodes.size()); i++)
+    {
+        if (nodes[i].height != 0) continue;
+
+        AABB box = nodes[i].object->getBounds();
+        stack.clear();
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            int index = stack.back();
+            stack.pop_back();
+            if (!nodes[index].box.overlaps(box)) continue;
+
+            if (nodes[index].isLeaf())
+            {
+                // Only keep the pair from the leaf with the lowest index, so it is not reported twice
+                if (index > i && nodes[index].object->getBounds().overlaps(box))
+                {
+                    collisions.emplace_back(nodes[i].object, nodes[index].object);
+                }
+            }
+            else
+            {
+                stack.push_back(nodes[index].child1);
+                stack.push_back(nodes[index].child2);
+            }
+        }
+    }
+    return collisions;
+}
+
+/**
+ * @brief Find all the objects whose bounds overlap a box
+ * @param box The box to test
+ * @param results The overlapping objects are appended to this vector
+ */
+void AABBTree::queryOverlap(AABB box, std::vector<RigidBody*>& results)
+{
+    queryOverlap(box, results, stack);
+}
+
+/**
+ * @brief Find all the objects whose bounds overlap a box. Only reads the tree, so that queries with their own
+ * traversal stack can run in parallel
+ * @param box The box to test
+ * @param results The overlapping objects are appended to this vector
+ * @param traversal The stack of the traversal
+ */
+void AABBTree::queryOverlap(AABB box, std::vector<RigidBody*>& results, std::vector<int>& traversal)
+{
+    if (root == AABB_TREE_NULL_NODE) return;
+
+    traversal.clear();
+    traversal.push_back(root);
+    while (!traversal.empty())
+    {
+        int index = traversal.back();
+        traversal.pop_back();
+        if (!nodes[index].box.overlaps(box)) continue;
+
+        if (nodes[index].isLeaf())
+        {
+            if (nodes[index].object->getBounds().overlaps(box)) results.push_back(nodes[index].object);
+        }
+        else
+        {
+            traversal.push_back(nodes[index].child1);
+            traversal.push_back(nodes[index].child2);
+        }
+    }
+}
+
+/**
+ * @brief Find the first object whose bounds are hit by a ray
+ * @param origin The origin of the ray
+ * @param direction The direction of the ray
+ * @param maxDistance The length of the ray, in units of direction
+ * @param distance Set to the distance of the hit along the ray
+ * @return The closest object hit, or nullptr
+ */
+RigidBody* AABBTree::raycast(Vector origin, Vector direction, float maxDistance, float& distance)
+{
+    RigidBody* hit = nullptr;
+    // The ray is shortened at each hit, so far subtrees get culled
+    queryRay(origin, direction, maxDistance, 0, stack,
+             [&](RigidBody* object, float closest)
+             {
+                 float t;
+                 if (!object->getBounds().rayIntersect(origin, direction, closest, t)) return closest;
+                 hit = object;
+                 distance = t;
+                 return t;
+             });
+    return hit;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "AABB.h"
+#include "RigidBody.h"
+
+#define AABB_TREE_NULL_NODE (-1)
+// Margin added around each leaf so that small moves do not trigger a reinsertion
+#define AABB_TREE_FAT_MARGIN 5.0f
+// How far ahead a leaf is stretched along the displacement of its object
+#define AABB_TREE_DISPLACEMENT_MULTIPLIER 2.0f
+
+/**
+ * @brief A node of the AABB tree. Leaves hold an object, internal nodes always have two children
+ *
+ */
+struct AABBTreeNode
+{
+    AABB box;
+    RigidBody* object = nullptr;
+    // Parent of the node, or the next free node while the node is in the free list
+    int parent = AABB_TREE_NULL_NODE;
+    int child1 = AABB_TREE_NULL_NODE;
+    int child2 = AABB_TREE_NULL_NODE;
+    // 0 for a leaf, -1 for a free node
+    int height = -1;
+
+    bool isLeaf()
+    {
+        return child1 == AABB_TREE_NULL_NODE;
+    }
+};
+
+/**
+ * @brief A dynamic bounding volume hierarchy used as broad phase. Unlike the Octree, it is not bounded
+ * by the viewport and is updated incrementally: leaves are fattened so that an object is only reinserted
+ * when it leaves its fat box, and the tree is kept balanced with rotations.
+ *
+ */
+class AABBTree
+{
+private:
+    std::vector<AABBTreeNode> nodes;
+    int root;
+    int freeList;
+    int leafCount;
+    // Traversal stack, kept between queries to avoid reallocations
+    std::vector<int> stack;
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int node);
+    void refit(int node);
+    int buildNode(std::vector<int>& leaves, int first, int count);
+
+public:
+    AABBTree();
+
+    void insert(RigidBody* object);
+    void build(const std::vector<RigidBody*>& objects);
+    void remove(RigidBody* object);
+    bool update(RigidBody* object, Vector displacement);
+    void clear();
+    void draw();
+    void getBoxes(std::vector<AABB>& leaves, std::vector<AABB>& internalNodes);
+    int getHeight();
+    int getLeafCount();
+
+    std::vector<std::pair<RigidBody*, RigidBody*>> getCollisions();
+    void queryOverlap(AABB box, std::vector<RigidBody*>& results);
+    void queryOverlap(AABB box, std::vector<RigidBody*>& results, std::vector<int>& traversal);
+    RigidBody* raycast(Vector origin, Vector direction, float maxDistance, float& distance);
+    template <class LeafTest>
+    void queryRay(Vector origin, Vector direction, float maxDistance, float margin, std::vector<int>& traversal,
+                  LeafTest leafTest);
+};
+
+/**
+ * @brief Visit the leaves whose box is reached by a ray, nearest child first. The leaf test gives the new length
+ * of the ray, so that a hit culls everything behind it.
+ * Only reads the tree: queries with their own traversal stack can run in parallel, as long as the tree is not updated
+ * @param origin The origin of the ray
+ * @param direction The direction of the ray
+ * @param maxDistance The length of the ray, in units of direction
+ * @param margin Grows every box, the radius of a cast sphere
+ * @param traversal The stack of the traversal
+ * @param leafTest Called as leafTest(object, maxDistance) for each leaf reached, returns the new length of the ray
+ */
+template <class LeafTest>
+void AABBTree::queryRay(Vector origin, Vector direction, float maxDistance, float margin,
+                        std::vector<int>& traversal, LeafTest leafTest)
+{
+    if (root == AABB_TREE_NULL_NODE) return;
+
+    float t;
+    traversal.clear();
+    traversal.push_back(root);
+    while (!traversal.empty())
+    {
+        int index = traversal.back();
+        traversal.pop_back();
+        // Tested again when popped, the ray may have been shortened since the node was pushed
+        if (!nodes[index].box.fattened(margin).rayIntersect(origin, direction, maxDistance, t)) continue;
+
+        if (nodes[index].isLeaf())
+        {
+            maxDistance = leafTest(nodes[index].object, maxDistance);
+            continue;
+        }
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+        float t1;
+        float t2;
+        bool hit1 = nodes[child1].box.fattened(margin).rayIntersect(origin, direction, maxDistance, t1);
+        bool hit2 = nodes[child2].box.fattened(margin).rayIntersect(origin, direction, maxDistance, t2);
+        // The last pushed is visited first
+        if (hit1 && hit2 && t1 < t2) std::swap(child1, child2);
+        if (hit1 && hit2)
+        {
+            traversal.push_back(child1);
+            traversal.push_back(child2);
+        }
+        else if (hit1 || hit2)
+        {
+            traversal.push_back(hit1 ? child1 : child2);
+        }
+    }
+}
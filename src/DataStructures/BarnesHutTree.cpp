@@ -0,0 +1,224 @@
+#include "BarnesHutTree.h"
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief Rebuild the tree over a set of point sources
+ * @param points The positions of the sources
+ * @param strengths The strength of each source, such as its mass or its charge
+ */
+void BarnesHutTree::build(const std::vector<Vector>& points, const std::vector<float>& strengths)
+{
+    clear();
+    if (points.empty()) return;
+    this->points = points;
+    this->strengths = strengths;
+
+    // Smallest cube around the points
+    Vector minCorner = points[0];
+    Vector maxCorner = points[0];
+    for (auto point : points)
+    {
+        minCorner = Vector(std::min(minCorner.x, point.x), std::min(minCorner.y, point.y),
+                           std::min(minCorner.z, point.z));
+        maxCorner = Vector(std::max(maxCorner.x, point.x), std::max(maxCorner.y, point.y),
+                           std::max(maxCorner.z, point.z));
+    }
+    Vector extent = maxCorner - minCorner;
+    float halfSize = std::max(std::max(extent.x, extent.y), std::max(extent.z, 1e-3f)) / 2;
+    nodes.reserve(2 * points.size() / BARNES_HUT_LEAF_SIZE + 1);
+    buildNode(0, static_cast<int>(points.size()), (minCorner + maxCorner) * 0.5, halfSize, 0);
+}
+
+/**
+ * @brief Remove every node and point
+ */
+void BarnesHutTree::clear()
+{
+    nodes.clear();
+    points.clear();
+    strengths.clear();
+}
+
+/**
+ * @brief Build the subtree of a cell, splitting its points into the eight octants of the cell
+ * @param first The first point of the cell in the sorted points
+ * @param count The number of points of the cell
+ * @param cellCenter The center of the cube of the cell
+ * @param halfSize The half size of the cube of the cell
+ * @param depth The depth of the cell
+ * @return The index of the node of the cell
+ */
+int BarnesHutTree::buildNode(int first, int count, Vector cellCenter, float halfSize, int depth)
+{
+    int node = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+    nodes[node].cellCenter = cellCenter;
+    nodes[node].halfSize = halfSize;
+
+    if (count <= BARNES_HUT_LEAF_SIZE || depth == MAX_BARNES_HUT_DEPTH)
+    {
+        nodes[node].first = first;
+        nodes[node].count = count;
+    }
+    else
+    {
+        // Counting sort of the points by octant, bit 0 for x, 1 for y and 2 for z
+        auto octantOf = [&cellCenter](Vector point)
+        {
+            return (point.x >= cellCenter.x ? 1 : 0) | (point.y >= cellCenter.y ? 2 : 0)
+                | (point.z >= cellCenter.z ? 4 : 0);
+        };
+        int starts[9] = {0};
+        for (int i = first; i < first + count; i++)
+        {
+            starts[octantOf(points[i]) + 1]++;
+        }
+        for (int octant = 0; octant < 8; octant++)
+        {
+            starts[octant + 1] += starts[octant];
+        }
+        int next[8];
+        std::copy(starts, starts + 8, next);
+        order.resize(count);
+        for (int i = first; i < first + count; i++)
+        {
+            order[next[octantOf(points[i])]++] = i;
+        }
+        sortedPoints.resize(count);
+        sortedStrengths.resize(count);
+        for (int i = 0; i < count; i++)
+        {
+            sortedPoints[i] = points[order[i]];
+            sortedStrengths[i] = strengths[order[i]];
+        }
+        std::copy(sortedPoints.begin(), sortedPoints.begin() + count, points.begin() + first);
+        std::copy(sortedStrengths.begin(), sortedStrengths.begin() + count, strengths.begin() + first);
+
+        float childHalfSize = halfSize / 2;
+        for (int octant = 0; octant < 8; octant++)
+        {
+            int childCount = starts[octant + 1] - starts[octant];
+            if (childCount == 0) continue;
+            Vector offset = Vector(octant & 1 ? childHalfSize : -childHalfSize,
+                                   octant & 2 ? childHalfSize : -childHalfSize,
+                                   octant & 4 ? childHalfSize : -childHalfSize);
+            int child = buildNode(first + starts[octant], childCount, cellCenter + offset, childHalfSize, depth + 1);
+            nodes[node].children[octant] = child;
+        }
+    }
+
+    // Total strength, and center of the points weighted by their absolute strengths so that opposite charges
+    // do not push the center out of the cell
+    float strength = 0;
+    float weight = 0;
+    Vector center = Vector(0, 0, 0);
+    for (int i = first; i < first + count; i++)
+    {
+        strength += strengths[i];
+        weight += std::abs(strengths[i]);
+        center += points[i] * std::abs(strengths[i]);
+    }
+    nodes[node].strength = strength;
+    nodes[node].center = weight > 0 ? center * (1 / weight) : cellCenter;
+    return node;
+}
+
+/**
+ * @brief Inverse square field at a point: the sum over the sources of strength * offset / distance^3, the offset
+ * going from the point to the source. A cell is used as a single source when its size over its distance is below
+ * the opening angle, unless it contains the point: with a wide opening angle the source at the point would
+ * otherwise act on itself through the center of its cell. Sources at the point itself are skipped
+ * @param point The point
+ * @param openingAngle The opening angle, 0 for the exact sum over every source
+ * @param softening Added to the distances, so that close sources do not give an unbounded field
+ * @return The field
+ */
+Vector BarnesHutTree::field(Vector point, float openingAngle, float softening)
+{
+    if (nodes.empty()) return Vector(0, 0, 0);
+    const float squaredSoftening = softening * softening;
+    const float squaredAngle = openingAngle * openingAngle;
+
+    // Plain floats in the inner loops, this is where the queries spend their time
+    float fieldX = 0, fieldY = 0, fieldZ = 0;
+    auto addSource = [&](const Vector& source, float strength)
+    {
+        float dx = source.x - point.x;
+        float dy = source.y - point.y;
+        float dz = source.z - point.z;
+        float squaredDistance = dx * dx + dy * dy + dz * dz;
+        if (squaredDistance == 0) return;
+        float softened = squaredDistance + squaredSoftening;
+        float scale = strength / (softened * std::sqrt(softened));
+        fieldX += dx * scale;
+        fieldY += dy * scale;
+        fieldZ += dz * scale;
+    };
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        BarnesHutNode& node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.count > 0)
+        {
+            for (int i = node.first; i < node.first + node.count; i++)
+            {
+                addSource(points[i], strengths[i]);
+            }
+            continue;
+        }
+
+        float dx = node.center.x - point.x;
+        float dy = node.center.y - point.y;
+        float dz = node.center.z - point.z;
+        float size = 2 * node.halfSize;
+        bool containsPoint = std::abs(point.x - node.cellCenter.x) <= node.halfSize
+            && std::abs(point.y - node.cellCenter.y) <= node.halfSize
+            && std::abs(point.z - node.cellCenter.z) <= node.halfSize;
+        if (!containsPoint && size * size < squaredAngle * (dx * dx + dy * dy + dz * dz))
+        {
+            addSource(node.center, node.strength);
+            continue;
+        }
+        for (int child : node.children)
+        {
+            if (child != BARNES_HUT_NULL_NODE) stack.push_back(child);
+        }
+    }
+    return Vector(fieldX, fieldY, fieldZ);
+}
+
+int BarnesHutTree::getNodeCount()
+{
+    return static_cast<int>(nodes.size());
+}
+
+/**
+ * @brief Measure the build and the queries at every point of a random cloud, without any window
+ * @param pointCount The number of points
+ * @param openingAngle The opening angle of the queries
+ * @return The duration of the build and of all the queries, in milliseconds
+ */
+double BarnesHutTree::benchmark(int pointCount, float openingAngle)
+{
+    std::vector<Vector> points(pointCount, Vector(0, 0, 0));
+    std::vector<float> strengths(pointCount, 1);
+    for (auto& point : points)
+    {
+        point = Vector(ofRandom(-1000, 1000), ofRandom(-1000, 1000), ofRandom(-1000, 1000));
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    BarnesHutTree tree;
+    tree.build(points, strengths);
+    for (auto& point : points)
+    {
+        tree.field(point, openingAngle, 1);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count();
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+
+#include "Vector.h"
+
+#define BARNES_HUT_NULL_NODE (-1)
+// Coincident points stop the subdivision here, they share a leaf
+#define MAX_BARNES_HUT_DEPTH 24
+// A leaf holds at most this many points before it is subdivided
+#define BARNES_HUT_LEAF_SIZE 4
+
+/**
+ * @brief A cell of the Barnes-Hut tree. Internal nodes have up to eight children, leaves a range of points
+ *
+ */
+struct BarnesHutNode
+{
+    // Center and half size of the cube of the cell
+    Vector cellCenter;
+    float halfSize = 0;
+    // Sum of the strengths of the points of the cell, and their center weighted by the absolute strengths
+    float strength = 0;
+    Vector center;
+    int children[8] = {BARNES_HUT_NULL_NODE, BARNES_HUT_NULL_NODE, BARNES_HUT_NULL_NODE, BARNES_HUT_NULL_NODE,
+                       BARNES_HUT_NULL_NODE, BARNES_HUT_NULL_NODE, BARNES_HUT_NULL_NODE, BARNES_HUT_NULL_NODE};
+    // Range of the points of a leaf in the sorted points, count is 0 for internal nodes
+    int first = 0;
+    int count = 0;
+};
+
+/**
+ * @brief An octree over point sources (masses or charges) for the Barnes-Hut approximation of inverse square
+ * fields. Unlike the Octree of the broad phase, it is unbounded, has no depth limit besides coincident points, and
+ * each cell keeps the total strength and center of its points. A far enough cell, seen under an angle smaller
+ * than the opening angle, acts as a single source, so a query costs O(log n) instead of O(n).
+ * The tree is rebuilt from scratch, top down, whenever the points move
+ *
+ */
+class BarnesHutTree
+{
+private:
+    std::vector<BarnesHutNode> nodes;
+    // Points and strengths sorted by leaf
+    std::vector<Vector> points;
+    std::vector<float> strengths;
+    // Scratch of the counting sort of a cell
+    std::vector<int> order;
+    std::vector<Vector> sortedPoints;
+    std::vector<float> sortedStrengths;
+    // Traversal stack, kept between queries to avoid reallocations
+    std::vector<int> stack;
+
+    int buildNode(int first, int count, Vector cellCenter, float halfSize, int depth);
+
+public:
+    void build(const std::vector<Vector>& points, const std::vector<float>& strengths);
+    void clear();
+    Vector field(Vector point, float openingAngle, float softening);
+    int getNodeCount();
+    static double benchmark(int pointCount, float openingAngle);
+};
@@ -42,9 +42,9 @@ void Octree::insert(RigidBody* object)
 
 void Octree::subdivide()
 {
-    setupChildren(); // Setup Children if not already done
-
-    if (children[0] !=nullptr){
+    // Children created now get all the objects, existing ones only miss the last one
+    if (children[0] == nullptr){
+        setupChildren();
         for (auto object : objects)
         {
             for (int i = 0; i < 8; i++) children[i]->insert(object);
@@ -121,6 +121,23 @@ void Octree::draw(bool printTree, std::string tab = "")
 
 }
 
+/**
+ * @brief: Collect the boxes of this node and its children, to draw them elsewhere
+ * @param boxes: Receives the boxes, appended
+ */
+void Octree::getBoxes(std::vector<AABB>& boxes)
+{
+    Vector halfSize(width, height, depth);
+    boxes.push_back(AABB(position - halfSize, position + halfSize));
+    if (!isLeaf)
+    {
+        for (auto child : children)
+        {
+            if (child) child->getBoxes(boxes);
+        }
+    }
+}
+
 /**
  * @brief: Handler function to check for broad collisions 
  * @return: Contains all objects that collide
@@ -133,7 +150,7 @@ std::vector<std::pair<RigidBody*,RigidBody*>> Octree::getCollisions()
         if(objects.size() == 2)
         {
             // Ideal case when there's only 2 objects on a leaf 
-            if(objects[0]->colliderRadius + objects[1]->colliderRadius > objects[0]->position.distance(objects[1]->position)){
+            if(objects[0]->getBounds().overlaps(objects[1]->getBounds())){
                 collisions.push_back(std::pair(objects[0],objects[1]));
                 return collisions;
             } 
@@ -145,7 +162,7 @@ std::vector<std::pair<RigidBody*,RigidBody*>> Octree::getCollisions()
             {
                 for (int j = i+1; j < static_cast<int>(objects.size()); j++)
                 {
-                    if(objects[i]->colliderRadius + objects[j]->colliderRadius > objects[i]->position.distance(objects[j]->position)){
+                    if(objects[i]->getBounds().overlaps(objects[j]->getBounds())){
                         collisions.push_back(std::pair(objects[i],objects[j]));
                     } 
                 }
@@ -177,19 +194,7 @@ std::vector<std::pair<RigidBody*,RigidBody*>> Octree::getCollisions()
  */
 bool Octree::intersects(RigidBody* object)
 {
-    // Checks if the object is inside the subdivision
-    if(abs(object->position.x - position.x) <= width && abs(object->position.y - position.y) <= height && abs(object->position.z - position.z) <= depth) return true;
-    
-    // Else it checks if the object bounding sphere overlaps with the subdivision
-    auto distance_x = abs(object->position.x - position.x) - width;
-    auto distance_y = abs(object->position.y - position.y) - height;
-    auto distance_z = abs(object->position.z - position.z) - depth;
-
-    distance_x = max(distance_x, 0.0f);
-    distance_y = max(distance_y, 0.0f);
-    distance_z = max(distance_z, 0.0f);
-
-    auto distance_spherique = sqrt(distance_x * distance_x + distance_y * distance_y + distance_z * distance_z);
-    return distance_spherique <= object->colliderRadius;
-    
+    // Checks if the object bounding box overlaps with the subdivision
+    AABB subdivision(position - Vector(width, height, depth), position + Vector(width, height, depth));
+    return subdivision.overlaps(object->getBounds());
 }
\ No newline at end of file
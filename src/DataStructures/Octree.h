@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "AABB.h"
 #include "RigidBody.h"
 #include "Vector.h"
 
@@ -40,6 +41,7 @@ public:
     void setupChildren();  
     void clear();
     void draw(bool printTree, std::string tab);
+    void getBoxes(std::vector<AABB>& boxes);
 
     std::vector<std::pair<RigidBody*,RigidBody*>> getCollisions();
 
@@ -0,0 +1,277 @@
+#include "QuickHull.h"
+
+#include <algorithm>
+
+#include "AABB.h"
+
+/**
+ * @brief Build the hull of a point cloud
+ * @param points The cloud, duplicates and inner points are allowed
+ * @param maxVertices The hull stops growing at this many vertices, 0 for no limit. The remaining points are dropped
+ * @return False if the points are all on a plane, the result is then empty
+ */
+bool QuickHull::build(const std::vector<Vector>& points, int maxVertices)
+{
+    this->points = &points;
+    faces.clear();
+    edges.clear();
+    vertexFaces.assign(points.size(), 0);
+    vertexCount = 0;
+    vertices.clear();
+    triangles.clear();
+    if (points.size() < 4) return false;
+
+    AABB cloud(points[0], points[0]);
+    for (Vector point : points)
+    {
+        cloud = cloud.merge(AABB(point, point));
+    }
+    Vector size = cloud.maxCorner - cloud.minCorner;
+    tolerance = HULL_TOLERANCE * std::max(size.x, std::max(size.y, size.z));
+
+    int simplex[4];
+    if (!buildSimplex(simplex)) return false;
+
+    // Each point goes to the face it is furthest in front of
+    for (int i = 0; i < static_cast<int>(points.size()); i++)
+    {
+        if (std::find(simplex, simplex + 4, i) != simplex + 4) continue;
+        int best = -1;
+        float bestDistance = tolerance;
+        for (int f = 0; f < 4; f++)
+        {
+            float pointDistance = distance(faces[f], i);
+            if (pointDistance > bestDistance)
+            {
+                best = f;
+                bestDistance = pointDistance;
+            }
+        }
+        if (best >= 0) faces[best].outside.push_back(i);
+    }
+
+    std::vector<int> visible;
+    std::vector<int> stack;
+    std::vector<std::pair<int, int>> horizon;
+    std::vector<int> orphans;
+    std::vector<char> state;
+    // New faces are appended, so a single pass reaches every face that gets points
+    for (size_t current = 0; current < faces.size(); current++)
+    {
+        if (faces[current].removed || faces[current].outside.empty()) continue;
+        if (maxVertices > 0 && vertexCount >= maxVertices) break;
+
+        int eye = faces[current].outside[0];
+        float eyeDistance = distance(faces[current], eye);
+        for (int point : faces[current].outside)
+        {
+            float pointDistance = distance(faces[current], point);
+            if (pointDistance > eyeDistance)
+            {
+                eye = point;
+                eyeDistance = pointDistance;
+            }
+        }
+
+        // Flood the faces the eye sees from the current one, 1 for visible and 2 for hidden
+        state.assign(faces.size(), 0);
+        visible.clear();
+        horizon.clear();
+        stack.assign(1, static_cast<int>(current));
+        state[current] = 1;
+        while (!stack.empty())
+        {
+            int f = stack.back();
+            stack.pop_back();
+            visible.push_back(f);
+            for (int e = 0; e < 3; e++)
+            {
+                int from = faces[f].vertices[e];
+                int to = faces[f].vertices[(e + 1) % 3];
+                int neighbour = edges[edgeKey(to, from)];
+                if (state[neighbour] == 0)
+                {
+                    state[neighbour] = distance(faces[neighbour], eye) > tolerance ? 1 : 2;
+                    if (state[neighbour] == 1) stack.push_back(neighbour);
+                }
+                if (state[neighbour] == 2) horizon.push_back({from, to});
+            }
+        }
+
+        orphans.clear();
+        for (int f : visible)
+        {
+            Face& face = faces[f];
+            for (int point : face.outside)
+            {
+                if (point != eye) orphans.push_back(point);
+            }
+            face.outside.clear();
+            face.outside.shrink_to_fit();
+            face.removed = true;
+            for (int e = 0; e < 3; e++)
+            {
+                edges.erase(edgeKey(face.vertices[e], face.vertices[(e + 1) % 3]));
+                // A vertex left without faces is now inside the hull
+                if (--vertexFaces[face.vertices[e]] == 0) vertexCount--;
+            }
+        }
+
+        // The horizon edges keep their direction, so the new faces wind like the ones they replace
+        int firstNew = static_cast<int>(faces.size());
+        for (auto& edge : horizon)
+        {
+            addFace(edge.first, edge.second, eye);
+        }
+        for (int point : orphans)
+        {
+            int best = -1;
+            float bestDistance = tolerance;
+            for (int f = firstNew; f < static_cast<int>(faces.size()); f++)
+            {
+                float pointDistance = distance(faces[f], point);
+                if (pointDistance > bestDistance)
+                {
+                    best = f;
+                    bestDistance = pointDistance;
+                }
+            }
+            if (best >= 0) faces[best].outside.push_back(point);
+        }
+    }
+
+    // Keep the points used by the remaining faces, in order of first use
+    std::vector<int> remap(points.size(), -1);
+    for (auto& face : faces)
+    {
+        if (face.removed) continue;
+        for (int vertex : face.vertices)
+        {
+            if (remap[vertex] < 0)
+            {
+                remap[vertex] = static_cast<int>(vertices.size());
+                vertices.push_back(points[vertex]);
+            }
+            triangles.push_back(remap[vertex]);
+        }
+    }
+    faces.clear();
+    edges.clear();
+    this->points = nullptr;
+    return true;
+}
+
+/**
+ * @brief Find four points spanning a volume: the two furthest apart of the extreme points along the axes, then
+ * the furthest from their line and the furthest from the plane of the three. Create the four faces of the
+ * tetrahedron, facing outwards
+ * @param simplex Receives the indices of the four points
+ * @return False if the cloud is flat
+ */
+bool QuickHull::buildSimplex(int simplex[4])
+{
+    const std::vector<Vector>& cloud = *points;
+    int extremes[6] = {0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < static_cast<int>(cloud.size()); i++)
+    {
+        const Vector& point = cloud[i];
+        if (point.x < cloud[extremes[0]].x) extremes[0] = i;
+        if (point.x > cloud[extremes[1]].x) extremes[1] = i;
+        if (point.y < cloud[extremes[2]].y) extremes[2] = i;
+        if (point.y > cloud[extremes[3]].y) extremes[3] = i;
+        if (point.z < cloud[extremes[4]].z) extremes[4] = i;
+        if (point.z > cloud[extremes[5]].z) extremes[5] = i;
+    }
+
+    float bestDistance = 0;
+    for (int i = 0; i < 6; i++)
+    {
+        for (int j = i + 1; j < 6; j++)
+        {
+            float pointDistance = Vector(cloud[extremes[i]]).distance(cloud[extremes[j]]);
+            if (pointDistance > bestDistance)
+            {
+                bestDistance = pointDistance;
+                simplex[0] = extremes[i];
+                simplex[1] = extremes[j];
+            }
+        }
+    }
+    if (bestDistance <= tolerance) return false;
+
+    Vector origin = cloud[simplex[0]];
+    Vector line = (Vector(cloud[simplex[1]]) - origin).normalized();
+    bestDistance = 0;
+    for (int i = 0; i < static_cast<int>(cloud.size()); i++)
+    {
+        float pointDistance = (Vector(cloud[i]) - origin).vectorialProduct(line).magnitude();
+        if (pointDistance > bestDistance)
+        {
+            bestDistance = pointDistance;
+            simplex[2] = i;
+        }
+    }
+    if (bestDistance <= tolerance) return false;
+
+    Vector normal = (Vector(cloud[simplex[1]]) - origin).vectorialProduct(Vector(cloud[simplex[2]]) - origin).normalized();
+    bestDistance = 0;
+    for (int i = 0; i < static_cast<int>(cloud.size()); i++)
+    {
+        float pointDistance = std::abs((Vector(cloud[i]) - origin) * normal);
+        if (pointDistance > bestDistance)
+        {
+            bestDistance = pointDistance;
+            simplex[3] = i;
+        }
+    }
+    if (bestDistance <= tolerance) return false;
+
+    // The first face must not see the fourth point
+    if ((Vector(cloud[simplex[3]]) - origin) * normal > 0) std::swap(simplex[1], simplex[2]);
+    int a = simplex[0], b = simplex[1], c = simplex[2], d = simplex[3];
+    addFace(a, b, c);
+    addFace(a, d, b);
+    addFace(b, d, c);
+    addFace(c, d, a);
+    return true;
+}
+
+/**
+ * @brief Append a face, register its edges and count its vertices
+ * @return The index of the face
+ */
+int QuickHull::addFace(int a, int b, int c)
+{
+    const std::vector<Vector>& cloud = *points;
+    Face face;
+    face.vertices[0] = a;
+    face.vertices[1] = b;
+    face.vertices[2] = c;
+    Vector origin = cloud[a];
+    face.normal = (Vector(cloud[b]) - origin).vectorialProduct(Vector(cloud[c]) - origin).normalized();
+    face.offset = face.normal * origin;
+
+    for (int vertex : face.vertices)
+    {
+        if (vertexFaces[vertex]++ == 0) vertexCount++;
+    }
+    int index = static_cast<int>(faces.size());
+    faces.push_back(face);
+    edges[edgeKey(a, b)] = index;
+    edges[edgeKey(b, c)] = index;
+    edges[edgeKey(c, a)] = index;
+    return index;
+}
+
+/**
+ * @return The signed distance of a point of the cloud to the plane of a face, positive in front of it
+ */
+float QuickHull::distance(const Face& face, int point)
+{
+    return Vector(face.normal) * (*points)[point] - face.offset;
+}
+
+long long QuickHull::edgeKey(int from, int to)
+{
+    return static_cast<long long>(from) * static_cast<long long>(points->size()) + to;
+}
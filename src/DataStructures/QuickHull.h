@@ -0,0 +1,52 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include "Vector.h"
+
+// Points closer to a face than this fraction of the size of the cloud are taken as on the face
+#define HULL_TOLERANCE 1e-4f
+
+/**
+ * @brief Builds the convex hull of a point cloud with quickhull. Starting from a tetrahedron of extreme points,
+ * the point furthest outside a face is added at each iteration: the faces it sees are removed and their horizon
+ * is joined to it. The points outside the removed faces are given to the new ones, the others are inside and
+ * dropped. Faces are handled in order of creation and each one adds its furthest point, so a hull stopped at a
+ * number of vertices grows evenly and stays close to the full one, though it is not made of the furthest points
+ * of the whole cloud. Faces are triangles, counterclockwise seen from outside
+ *
+ */
+class QuickHull
+{
+private:
+    struct Face
+    {
+        int vertices[3];
+        Vector normal;
+        float offset;
+        // Points of the cloud in front of this face and of no face found before it
+        std::vector<int> outside;
+        bool removed = false;
+    };
+
+    std::vector<Face> faces;
+    // Face of each directed edge, keyed by from * point count + to
+    std::unordered_map<long long, int> edges;
+    // Remaining faces around each point, and the number of points with at least one
+    std::vector<int> vertexFaces;
+    int vertexCount = 0;
+    const std::vector<Vector>* points = nullptr;
+    float tolerance = 0;
+
+    int addFace(int a, int b, int c);
+    float distance(const Face& face, int point);
+    long long edgeKey(int from, int to);
+    bool buildSimplex(int simplex[4]);
+
+public:
+    // Result of the last build: the vertices of the hull, and three vertex indices per triangle
+    std::vector<Vector> vertices;
+    std::vector<int> triangles;
+
+    bool build(const std::vector<Vector>& points, int maxVertices = 0);
+};
@@ -0,0 +1,92 @@
+#include "SpatialHash.h"
+
+#include <cmath>
+#include <cstdlib>
+
+SpatialHash::SpatialHash(float spacing)
+{
+    this->spacing = spacing;
+}
+
+float SpatialHash::getSpacing()
+{
+    return spacing;
+}
+
+int SpatialHash::cellCoordinate(float value)
+{
+    return static_cast<int>(std::floor(value / spacing));
+}
+
+/**
+ * @return The bucket of a cell, from large primes mixing the coordinates
+ */
+int SpatialHash::hashCell(int x, int y, int z)
+{
+    unsigned int hash = (static_cast<unsigned int>(x) * 92837111u) ^ (static_cast<unsigned int>(y) * 689287499u)
+        ^ (static_cast<unsigned int>(z) * 283923481u);
+    return static_cast<int>(hash % (bucketStart.size() - 1));
+}
+
+/**
+ * @brief Bucket the points, with a table of two buckets per point
+ * @param x The x coordinates of the points
+ * @param y The y coordinates of the points
+ * @param z The z coordinates of the points
+ */
+void SpatialHash::build(const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z)
+{
+    const int count = static_cast<int>(x.size());
+    bucketStart.assign(2 * count + 2, 0);
+    entries.resize(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        bucketStart[hashCell(cellCoordinate(x[i]), cellCoordinate(y[i]), cellCoordinate(z[i])) + 1]++;
+    }
+    for (size_t bucket = 1; bucket < bucketStart.size(); bucket++)
+    {
+        bucketStart[bucket] += bucketStart[bucket - 1];
+    }
+    // Each start is moved to the end of its bucket then shifted back, as ParticleSystem::sortByCell
+    for (int i = 0; i < count; i++)
+    {
+        entries[bucketStart[hashCell(cellCoordinate(x[i]), cellCoordinate(y[i]), cellCoordinate(z[i]))]++] = i;
+    }
+    for (size_t bucket = bucketStart.size() - 1; bucket > 0; bucket--)
+    {
+        bucketStart[bucket] = bucketStart[bucket - 1];
+    }
+    bucketStart[0] = 0;
+}
+
+/**
+ * @brief Find the points that may be within a distance of a position
+ * @param x The x coordinate of the position
+ * @param y The y coordinate of the position
+ * @param z The z coordinate of the position
+ * @param radius The distance
+ * @param candidates Receives the points of every cell touching the cube around the position, cleared first
+ */
+void SpatialHash::query(float x, float y, float z, float radius, std::vector<int>& candidates)
+{
+    candidates.clear();
+    if (entries.empty()) return;
+    int minX = cellCoordinate(x - radius), maxX = cellCoordinate(x + radius);
+    int minY = cellCoordinate(y - radius), maxY = cellCoordinate(y + radius);
+    int minZ = cellCoordinate(z - radius), maxZ = cellCoordinate(z + radius);
+    for (int cellX = minX; cellX <= maxX; cellX++)
+    {
+        for (int cellY = minY; cellY <= maxY; cellY++)
+        {
+            for (int cellZ = minZ; cellZ <= maxZ; cellZ++)
+            {
+                int bucket = hashCell(cellX, cellY, cellZ);
+                for (int entry = bucketStart[bucket]; entry < bucketStart[bucket + 1]; entry++)
+                {
+                    candidates.push_back(entries[entry]);
+                }
+            }
+        }
+    }
+}
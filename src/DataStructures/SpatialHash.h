@@ -0,0 +1,28 @@
+#pragma once
+#include <vector>
+
+/**
+ * @brief Dense spatial hash of points, for proximity queries between many small objects. The space is split in
+ * cubic cells hashed into a table of a few entries per point; the points are bucketed with a counting sort, so
+ * the table is two flat arrays rebuilt without allocation once its size is reached.
+ * Different cells may share a bucket, a query returns candidates that the caller filters by distance
+ *
+ */
+class SpatialHash
+{
+private:
+    float spacing;
+    // Start of each bucket in the entries, one more entry than buckets
+    std::vector<int> bucketStart;
+    std::vector<int> entries;
+
+    int cellCoordinate(float value);
+    int hashCell(int x, int y, int z);
+
+public:
+    explicit SpatialHash(float spacing);
+
+    void build(const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z);
+    void query(float x, float y, float z, float radius, std::vector<int>& candidates);
+    float getSpacing();
+};
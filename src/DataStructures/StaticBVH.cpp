@@ -0,0 +1,120 @@
+#include "StaticBVH.h"
+
+#include <algorithm>
+
+/**
+ * @brief Get a coordinate of a vector from its axis index
+ */
+static float getAxis(Vector v, int axis)
+{
+    return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
+/**
+ * @brief Build the hierarchy, replacing the previous one
+ * @param itemBoxes The bounding box of each item, the item indices are the positions in this vector
+ */
+void StaticBVH::build(std::vector<AABB> itemBoxes)
+{
+    clear();
+    boxes = std::move(itemBoxes);
+    if (boxes.empty()) return;
+
+    items.resize(boxes.size());
+    for (int i = 0; i < static_cast<int>(items.size()); i++) items[i] = i;
+    // A binary tree with at least one item per leaf has less than twice as many nodes as items
+    nodes.reserve(2 * boxes.size());
+    buildNode(0, static_cast<int>(items.size()));
+}
+
+/**
+ * @brief Build the node covering a range of items, then its children
+ * @return The index of the node
+ */
+int StaticBVH::buildNode(int first, int count)
+{
+    int index = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+
+    AABB box = boxes[items[first]];
+    AABB centers(box.center(), box.center());
+    for (int i = first + 1; i < first + count; i++)
+    {
+        box = box.merge(boxes[items[i]]);
+        centers = centers.merge(AABB(boxes[items[i]].center(), boxes[items[i]].center()));
+    }
+    nodes[index].box = box;
+
+    if (count <= STATIC_BVH_LEAF_SIZE)
+    {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return index;
+    }
+
+    // Split at the median along the axis where the centers are the most spread
+    Vector spread = centers.maxCorner - centers.minCorner;
+    int axis = spread.x > spread.y && spread.x > spread.z ? 0 : spread.y > spread.z ? 1 : 2;
+    int half = count / 2;
+    std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+                     [this, axis](int a, int b)
+                     {
+                         return getAxis(boxes[a].center(), axis) < getAxis(boxes[b].center(), axis);
+                     });
+
+    int left = buildNode(first, half);
+    int right = buildNode(first + half, count - half);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+/**
+ * @brief Remove every item
+ */
+void StaticBVH::clear()
+{
+    nodes.clear();
+    items.clear();
+    boxes.clear();
+}
+
+/**
+ * @brief Find all the items whose box overlaps a box
+ * @param box The query box
+ * @param results The indices of the overlapping items are appended to this vector
+ */
+void StaticBVH::query(AABB box, std::vector<int>& results)
+{
+    if (nodes.empty()) return;
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        int index = stack.back();
+        stack.pop_back();
+        if (!nodes[index].box.overlaps(box)) continue;
+
+        if (nodes[index].isLeaf())
+        {
+            for (int i = nodes[index].first; i < nodes[index].first + nodes[index].count; i++)
+            {
+                if (boxes[items[i]].overlaps(box)) results.push_back(items[i]);
+            }
+        }
+        else
+        {
+            stack.push_back(nodes[index].left);
+            stack.push_back(nodes[index].right);
+        }
+    }
+}
+
+/**
+ * @return The number of nodes of the hierarchy
+ */
+int StaticBVH::getNodeCount()
+{
+    return static_cast<int>(nodes.size());
+}
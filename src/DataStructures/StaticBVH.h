@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+
+#include "AABB.h"
+
+// Maximum number of items in a leaf of the static BVH
+#define STATIC_BVH_LEAF_SIZE 4
+
+/**
+ * @brief A node of the static BVH. Leaves reference a range of the sorted item list, internal nodes two children
+ *
+ */
+struct StaticBVHNode
+{
+    AABB box;
+    int left = -1;
+    int right = -1;
+    int first = 0;
+    int count = 0;
+
+    bool isLeaf()
+    {
+        return count > 0;
+    }
+};
+
+/**
+ * @brief A bounding volume hierarchy over items that never move, such as the triangles of a mesh.
+ * It is built once, top-down, by splitting the items at the median of the longest axis of their centers.
+ * Unlike the AABBTree, it can not be updated: adding items means building it again
+ *
+ */
+class StaticBVH
+{
+private:
+    std::vector<StaticBVHNode> nodes;
+    // Item indices, ordered so that each leaf covers a contiguous range
+    std::vector<int> items;
+    std::vector<AABB> boxes;
+    // Traversal stack, kept between queries to avoid reallocations
+    std::vector<int> stack;
+
+    int buildNode(int first, int count);
+
+public:
+    void build(std::vector<AABB> itemBoxes);
+    void clear();
+    void query(AABB box, std::vector<int>& results);
+    int getNodeCount();
+};
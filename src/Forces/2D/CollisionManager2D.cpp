@@ -1,5 +1,7 @@
 ﻿#include "CollisionManager2D.h"
 
+#include "Material.h"
+
 /**
  * @brief Return the new velocity of the Particle 1 when in collision with the Particle 2
  *
@@ -37,7 +39,7 @@ void CollisionManager2D::CheckCollision(std::list<Particle*> tabParticle)
 
             if (d <= minD)
             {
-                float e = 0.9f;
+                float e = MaterialTable::getPair((*particle1)->material, (*particle2)->material).restitution;
                 ++numCollisions;
                 Particle* p1 = (*particle1);
                 Particle* p2 = (*particle2);
@@ -0,0 +1,26 @@
+﻿#include "ElectrostaticGenerator.h"
+
+ElectrostaticGenerator::ElectrostaticGenerator(float k, float openingAngle, float softening)
+    : LongRangeGenerator(openingAngle, softening)
+{
+    forceType = ElectrostaticForce;
+    this->k = k;
+}
+
+float ElectrostaticGenerator::getSource(RigidBody* object)
+{
+    return object->charge;
+}
+
+/**
+ * @brief Push the object away from the charges of its sign, towards the others
+ * 
+ * @param object 
+ * @param duration 
+ */
+void ElectrostaticGenerator::updateForce(RigidBody* object, float duration)
+{
+    if (object->charge == 0) return;
+    // The field points towards the positive charges
+    object->addForce(tree.field(object->position, openingAngle, softening) * (-k * object->charge));
+}
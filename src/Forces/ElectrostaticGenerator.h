@@ -0,0 +1,20 @@
+﻿#pragma once
+#include "LongRangeGenerator.h"
+
+/**
+ * @brief Coulomb force between every pair of bodies the generator is registered with: like charges repel,
+ * opposite charges attract
+ *
+ */
+class ElectrostaticGenerator : public LongRangeGenerator
+{
+protected:
+    float getSource(RigidBody* object) override;
+
+public:
+    // Coulomb constant, in the units of the scene
+    float k;
+
+    ElectrostaticGenerator(float k, float openingAngle, float softening);
+    void updateForce(RigidBody* object, float duration) override;
+};
@@ -1,8 +1,34 @@
 ﻿#pragma once
+#include <vector>
+
 #include "RigidBody.h"
 
+/**
+ * @brief Kind of a generator, for the snapshots to know which parameters to save
+ */
+enum ForceType
+{
+    // A generator without snapshot format
+    CustomForce = 0,
+    GravityForce = 1,
+    FrictionForce = 2,
+    SpringForce = 3,
+    MutualGravityForce = 4,
+    ElectrostaticForce = 5
+};
+
 class ForceGenerator
 {
 public:
+    ForceType forceType = CustomForce;
+
+    virtual ~ForceGenerator() = default;
     virtual void updateForce(RigidBody* object, float duration) = 0;
+
+    /**
+     * @brief Called once per update with every object the generator is registered with, before any force is
+     * applied. Generators coupling their objects build their shared state here
+     * @param objects The objects of the registrations of the generator
+     */
+    virtual void prepare(const std::vector<RigidBody*>& objects) {}
 };
@@ -1,6 +1,5 @@
 ﻿#include "ForceRegistry.h"
 
-
 void ForceRegistry::add(RigidBody* object, ForceGenerator* fg)
 {
     struct ForceRegistration var;
@@ -47,6 +46,25 @@ void ForceRegistry::clear()
  */
 void ForceRegistry::updateForces(float duration)
 {
+    // Group the objects by generator, in the order the generators are first registered
+    groups.clear();
+    generators.clear();
+    for (auto& var : rg)
+    {
+        auto group = groups.emplace(var.fg, generators.size());
+        if (group.second)
+        {
+            if (generators.size() == objects.size()) objects.emplace_back();
+            else objects[generators.size()].clear();
+            generators.push_back(var.fg);
+        }
+        objects[group.first->second].push_back(var.object);
+    }
+    for (size_t i = 0; i < generators.size(); i++)
+    {
+        generators[i]->prepare(objects[i]);
+    }
+
     for (auto& var : rg)
     {
         var.fg->updateForce(var.object, duration);
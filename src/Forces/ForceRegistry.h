@@ -1,8 +1,16 @@
 ﻿#pragma once
+#include <unordered_map>
+
 #include "ForceGenerator.h"
 
 class ForceRegistry
 {
+private:
+    // Objects of each generator during updateForces, kept between the steps to reuse their storage
+    std::unordered_map<ForceGenerator*, size_t> groups;
+    std::vector<ForceGenerator*> generators;
+    std::vector<std::vector<RigidBody*>> objects;
+
 public:
     struct ForceRegistration
     {
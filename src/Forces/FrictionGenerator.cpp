@@ -2,6 +2,7 @@
 
 FrictionGenerator::FrictionGenerator(float k1)
 {
+    forceType = FrictionForce;
     this->k1 = k1;
 }
 
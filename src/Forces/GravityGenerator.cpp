@@ -7,6 +7,7 @@ Vector GravityGenerator::getGravity()
 
 GravityGenerator::GravityGenerator(Vector gravity)
 {
+    forceType = GravityForce;
     this->gravity = gravity;
 }
 
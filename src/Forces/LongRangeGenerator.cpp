@@ -0,0 +1,26 @@
+﻿#include "LongRangeGenerator.h"
+
+LongRangeGenerator::LongRangeGenerator(float openingAngle, float softening)
+{
+    this->openingAngle = openingAngle;
+    this->softening = softening;
+}
+
+/**
+ * @brief Rebuild the tree from the current positions of the bodies
+ * 
+ * @param objects 
+ */
+void LongRangeGenerator::prepare(const std::vector<RigidBody*>& objects)
+{
+    std::vector<Vector> points;
+    std::vector<float> strengths;
+    points.reserve(objects.size());
+    strengths.reserve(objects.size());
+    for (RigidBody* object : objects)
+    {
+        points.push_back(object->position);
+        strengths.push_back(getSource(object));
+    }
+    tree.build(points, strengths);
+}
@@ -0,0 +1,31 @@
+﻿#pragma once
+#include "BarnesHutTree.h"
+#include "ForceGenerator.h"
+
+// Usual trade off between accuracy and speed, the error on the forces is around 1%
+#define DEFAULT_OPENING_ANGLE 0.5f
+
+/**
+ * @brief Base of the generators of inverse square forces between the bodies they are registered with. The
+ * sources are put in a Barnes-Hut tree once per update, so each body costs O(log n) instead of O(n)
+ *
+ */
+class LongRangeGenerator : public ForceGenerator
+{
+protected:
+    BarnesHutTree tree;
+
+    /**
+     * @return The strength of the body as a source, such as its mass or its charge
+     */
+    virtual float getSource(RigidBody* object) = 0;
+
+public:
+    // Cells seen under a smaller angle act as a single source, 0 for the exact sum
+    float openingAngle;
+    // Keeps the forces bounded when two bodies get very close
+    float softening;
+
+    LongRangeGenerator(float openingAngle, float softening);
+    void prepare(const std::vector<RigidBody*>& objects) override;
+};
@@ -0,0 +1,26 @@
+﻿#include "MutualGravityGenerator.h"
+
+MutualGravityGenerator::MutualGravityGenerator(float G, float openingAngle, float softening)
+    : LongRangeGenerator(openingAngle, softening)
+{
+    forceType = MutualGravityForce;
+    this->G = G;
+}
+
+float MutualGravityGenerator::getSource(RigidBody* object)
+{
+    // Immovable bodies have an infinite mass, they neither attract nor are attracted
+    return object->getInversedMass() == 0 ? 0 : object->getMass();
+}
+
+/**
+ * @brief Pull the object towards the masses of the other objects
+ * 
+ * @param object 
+ * @param duration 
+ */
+void MutualGravityGenerator::updateForce(RigidBody* object, float duration)
+{
+    if (object->getInversedMass() == 0) return;
+    object->addForce(tree.field(object->position, openingAngle, softening) * (G * object->getMass()));
+}
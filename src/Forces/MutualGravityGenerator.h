@@ -0,0 +1,19 @@
+﻿#pragma once
+#include "LongRangeGenerator.h"
+
+/**
+ * @brief Newtonian attraction between every pair of bodies the generator is registered with
+ *
+ */
+class MutualGravityGenerator : public LongRangeGenerator
+{
+protected:
+    float getSource(RigidBody* object) override;
+
+public:
+    // Gravitational constant, in the units of the scene
+    float G;
+
+    MutualGravityGenerator(float G, float openingAngle, float softening);
+    void updateForce(RigidBody* object, float duration) override;
+};
@@ -0,0 +1,27 @@
+﻿#include "SpringGenerator.h"
+
+SpringGenerator::SpringGenerator(float k, float length, RigidBody* other, float damping)
+{
+    forceType = SpringForce;
+    this->k = k;
+    this->length = length;
+    this->other = other;
+    this->damping = damping;
+}
+
+/**
+ * @brief Pull or push the object along the line between the centers of the two bodies. Register a second spring
+ * with the bodies swapped for the other end
+ * 
+ * @param object 
+ * @param duration 
+ */
+void SpringGenerator::updateForce(RigidBody* object, float duration)
+{
+    Vector offset = object->position - other->position;
+    float distance = offset.magnitude();
+    if (distance == 0) return;
+    Vector direction = offset * (1 / distance);
+    float stretchSpeed = (object->linearVelocity - other->linearVelocity) * direction;
+    object->addForce(direction * (-k * (distance - length) - damping * stretchSpeed));
+}
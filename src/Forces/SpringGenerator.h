@@ -0,0 +1,14 @@
+﻿#pragma once
+#include "ForceGenerator.h"
+
+class SpringGenerator : public ForceGenerator
+{
+public:
+    float k;
+    float length;
+    // Resists the relative velocity along the spring, 0 for an undamped spring
+    float damping;
+    RigidBody* other;
+    SpringGenerator(float k, float length, RigidBody* other, float damping = 0);
+    void updateForce(RigidBody* object, float duration) override;
+};
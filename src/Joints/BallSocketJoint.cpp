@@ -0,0 +1,50 @@
+#include "BallSocketJoint.h"
+
+/**
+ * @param first The first body
+ * @param second The second body, nullptr for the world
+ * @param anchor The world point the bodies are attached at
+ */
+BallSocketJoint::BallSocketJoint(RigidBody* first, RigidBody* second, Vector anchor)
+    : BallSocketJoint(JointBallSocket, first, second, anchor, 3)
+{
+}
+
+BallSocketJoint::BallSocketJoint(JointType jointType, RigidBody* first, RigidBody* second, Vector anchor,
+                                 int rowCount)
+    : Joint(jointType, first, second, rowCount)
+{
+    this->localAnchorFirst = toLocal(first, anchor - getCenter(first));
+    this->localAnchorSecond = toLocal(second, anchor - getCenter(second));
+}
+
+/**
+ * @brief Fill the three first rows, one per world axis
+ */
+void BallSocketJoint::buildRows(float delta_t, float positionCorrection)
+{
+    Vector leverFirst = toWorld(first, localAnchorFirst);
+    Vector leverSecond = toWorld(second, localAnchorSecond);
+    Vector separation = getSeparation();
+    Vector axes[3] = {Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1)};
+    for (int i = 0; i < 3; i++)
+    {
+        setPointRow(rows[i], axes[i], leverFirst, leverSecond, separation * axes[i], positionCorrection / delta_t);
+    }
+}
+
+/**
+ * @return The world vector from the anchor of the first body to the anchor of the second
+ */
+Vector BallSocketJoint::getSeparation()
+{
+    return getCenter(second) + toWorld(second, localAnchorSecond) - getCenter(first) - toWorld(first, localAnchorFirst);
+}
+
+/**
+ * @return The distance between the anchors
+ */
+float BallSocketJoint::getError()
+{
+    return getSeparation().magnitude();
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "Joint.h"
+
+/**
+ * @brief Keeps a point of each body together, leaving the rotations free
+ *
+ */
+class BallSocketJoint : public Joint
+{
+protected:
+    BallSocketJoint(JointType jointType, RigidBody* first, RigidBody* second, Vector anchor, int rowCount);
+
+    void buildRows(float delta_t, float positionCorrection) override;
+    Vector getSeparation();
+
+public:
+    // The anchor in the frame of each body, from its center of mass
+    Vector localAnchorFirst;
+    Vector localAnchorSecond;
+
+    BallSocketJoint(RigidBody* first, RigidBody* second, Vector anchor);
+    float getError() override;
+};
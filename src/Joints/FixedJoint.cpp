@@ -0,0 +1,36 @@
+#include "FixedJoint.h"
+
+#include <algorithm>
+
+/**
+ * @param first The first body
+ * @param second The second body, nullptr for the world
+ * @param anchor The world point the bodies are welded at, the center of the second one is the most stable
+ */
+FixedJoint::FixedJoint(RigidBody* first, RigidBody* second, Vector anchor)
+    : BallSocketJoint(JointFixed, first, second, anchor, 6)
+{
+    storeRelativeAxes(first, second, relativeAxes);
+}
+
+/**
+ * @brief The anchor rows, then three angular rows locking the rotation
+ */
+void FixedJoint::buildRows(float delta_t, float positionCorrection)
+{
+    BallSocketJoint::buildRows(delta_t, positionCorrection);
+    Vector error = getRotationError(first, second, relativeAxes);
+    Vector axes[3] = {Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1)};
+    for (int i = 0; i < 3; i++)
+    {
+        setAngularRow(rows[3 + i], axes[i], error * axes[i], positionCorrection / delta_t);
+    }
+}
+
+/**
+ * @return The largest of the distance between the anchors and the rotation from the rest orientation
+ */
+float FixedJoint::getError()
+{
+    return std::max(BallSocketJoint::getError(), getRotationError(first, second, relativeAxes).magnitude());
+}
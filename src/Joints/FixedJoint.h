@@ -0,0 +1,19 @@
+#pragma once
+#include "BallSocketJoint.h"
+
+/**
+ * @brief Welds two bodies together, they keep their relative position and orientation
+ *
+ */
+class FixedJoint : public BallSocketJoint
+{
+protected:
+    void buildRows(float delta_t, float positionCorrection) override;
+
+public:
+    // The axes of the second body in the frame of the first, at rest
+    Vector relativeAxes[3];
+
+    FixedJoint(RigidBody* first, RigidBody* second, Vector anchor);
+    float getError() override;
+};
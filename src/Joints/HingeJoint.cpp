@@ -0,0 +1,45 @@
+#include "HingeJoint.h"
+
+#include <algorithm>
+
+/**
+ * @param first The first body
+ * @param second The second body, nullptr for the world
+ * @param anchor A world point of the axis
+ * @param axis The world direction of the axis
+ */
+HingeJoint::HingeJoint(RigidBody* first, RigidBody* second, Vector anchor, Vector axis)
+    : BallSocketJoint(JointHinge, first, second, anchor, 5)
+{
+    axis = axis.normalized();
+    Vector normals[2];
+    getPerpendiculars(axis, normals[0], normals[1]);
+    this->localAxisFirst = toLocal(first, axis);
+    this->localAxisSecond = toLocal(second, axis);
+    this->localNormals[0] = toLocal(first, normals[0]);
+    this->localNormals[1] = toLocal(first, normals[1]);
+}
+
+/**
+ * @brief The anchor rows, then two angular rows keeping the axes of both bodies aligned
+ */
+void HingeJoint::buildRows(float delta_t, float positionCorrection)
+{
+    BallSocketJoint::buildRows(delta_t, positionCorrection);
+    // The axis of the second body leaves the first one by rotating around their cross product
+    Vector misalignment = toWorld(first, localAxisFirst).vectorialProduct(toWorld(second, localAxisSecond));
+    for (int i = 0; i < 2; i++)
+    {
+        Vector normal = toWorld(first, localNormals[i]);
+        setAngularRow(rows[3 + i], normal, misalignment * normal, positionCorrection / delta_t);
+    }
+}
+
+/**
+ * @return The largest of the distance between the anchors and the sine of the angle between the axes
+ */
+float HingeJoint::getError()
+{
+    Vector misalignment = toWorld(first, localAxisFirst).vectorialProduct(toWorld(second, localAxisSecond));
+    return std::max(BallSocketJoint::getError(), misalignment.magnitude());
+}
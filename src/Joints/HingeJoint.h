@@ -0,0 +1,21 @@
+#pragma once
+#include "BallSocketJoint.h"
+
+/**
+ * @brief A ball socket that only lets the bodies rotate around a common axis, as a door on its hinges
+ *
+ */
+class HingeJoint : public BallSocketJoint
+{
+protected:
+    void buildRows(float delta_t, float positionCorrection) override;
+
+public:
+    // The axis in the frame of each body, and two directions orthogonal to it in the frame of the first
+    Vector localAxisFirst;
+    Vector localAxisSecond;
+    Vector localNormals[2];
+
+    HingeJoint(RigidBody* first, RigidBody* second, Vector anchor, Vector axis);
+    float getError() override;
+};
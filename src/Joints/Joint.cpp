@@ -0,0 +1,175 @@
+#include "Joint.h"
+
+#include <cmath>
+
+Joint::Joint(JointType jointType, RigidBody* first, RigidBody* second, int rowCount)
+{
+    this->jointType = jointType;
+    this->first = first;
+    this->second = second;
+    this->rows.resize(rowCount);
+}
+
+/**
+ * @brief Compute the rows for the current positions, then apply the impulses of the last step
+ * @param delta_t The duration of the step
+ * @param positionCorrection The part of the position error corrected at each step, in [0, 1]
+ * @param warmStart Whether to start from the impulses of the last step, they are reset otherwise
+ */
+void Joint::prepare(float delta_t, float positionCorrection, bool warmStart)
+{
+    inversedMassFirst = first->getInversedMass();
+    inversedInertiaFirst = getWorldInversedInertia(first);
+    inversedMassSecond = second != nullptr ? second->getInversedMass() : 0;
+    inversedInertiaSecond = getWorldInversedInertia(second);
+
+    buildRows(delta_t, positionCorrection);
+    for (auto& row : rows)
+    {
+        float inversedEffectiveMass = row.linearFirst * row.linearFirst * inversedMassFirst
+            + row.angularFirst * (inversedInertiaFirst * row.angularFirst)
+            + row.linearSecond * row.linearSecond * inversedMassSecond
+            + row.angularSecond * (inversedInertiaSecond * row.angularSecond);
+        row.effectiveMass = inversedEffectiveMass > 0 ? 1 / inversedEffectiveMass : 0;
+
+        if (warmStart) applyImpulse(row, row.impulse);
+        else row.impulse = 0;
+    }
+}
+
+/**
+ * @brief One Gauss-Seidel iteration: each row in turn cancels the relative velocity it measures, plus its bias
+ */
+void Joint::solve()
+{
+    for (auto& row : rows)
+    {
+        float velocity = row.linearFirst * first->linearVelocity + row.angularFirst * first->angularVelocity;
+        if (second != nullptr)
+        {
+            velocity += row.linearSecond * second->linearVelocity + row.angularSecond * second->angularVelocity;
+        }
+        float impulse = -(velocity + row.bias) * row.effectiveMass;
+        row.impulse += impulse;
+        applyImpulse(row, impulse);
+    }
+}
+
+/**
+ * @brief Apply the impulse of a row to both bodies, along its Jacobian
+ */
+void Joint::applyImpulse(Row& row, float impulse)
+{
+    first->linearVelocity += row.linearFirst * (impulse * inversedMassFirst);
+    first->angularVelocity += inversedInertiaFirst * (row.angularFirst * impulse);
+    if (second == nullptr) return;
+    second->linearVelocity += row.linearSecond * (impulse * inversedMassSecond);
+    second->angularVelocity += inversedInertiaSecond * (row.angularSecond * impulse);
+}
+
+/**
+ * @brief Set a row keeping two points, one on each body, at the same coordinate along an axis
+ * @param axis The world axis, of unit length
+ * @param leverFirst The point of the first body, from its center of mass
+ * @param leverSecond The point of the second body, from its center of mass
+ * @param error The distance from the first point to the second along the axis
+ * @param factor The part of the error corrected during the step, divided by its duration
+ */
+void Joint::setPointRow(Row& row, Vector axis, Vector leverFirst, Vector leverSecond, float error, float factor)
+{
+    row.linearFirst = axis.opposite();
+    row.angularFirst = axis.vectorialProduct(leverFirst);
+    row.linearSecond = axis;
+    row.angularSecond = leverSecond.vectorialProduct(axis);
+    row.bias = error * factor;
+}
+
+/**
+ * @brief Set a row cancelling the relative rotation of the bodies around an axis
+ * @param axis The world axis, of unit length
+ * @param error The rotation of the second body from its rest orientation around the axis, in radians
+ * @param factor The part of the error corrected during the step, divided by its duration
+ */
+void Joint::setAngularRow(Row& row, Vector axis, float error, float factor)
+{
+    row.linearFirst = Vector(0, 0, 0);
+    row.angularFirst = axis.opposite();
+    row.linearSecond = Vector(0, 0, 0);
+    row.angularSecond = axis;
+    row.bias = error * factor;
+}
+
+/**
+ * @return The center of mass of a body, the origin for the world
+ */
+Vector Joint::getCenter(RigidBody* body)
+{
+    return body != nullptr ? body->getWorldMassCenter() : Vector(0, 0, 0);
+}
+
+/**
+ * @brief Rotate a direction from the frame of a body to the world. The rows of quatToMat are the axes of the body
+ */
+Vector Joint::toWorld(RigidBody* body, Vector direction)
+{
+    if (body == nullptr) return direction;
+    return body->orientation.quatToMat().transpose() * direction;
+}
+
+/**
+ * @brief Rotate a world direction to the frame of a body
+ */
+Vector Joint::toLocal(RigidBody* body, Vector direction)
+{
+    if (body == nullptr) return direction;
+    return body->orientation.quatToMat() * direction;
+}
+
+/**
+ * @brief The inverse of the inertia tensor of a body in world space, from its tensor in its own frame
+ * @return The inverse, zero for the world and the bodies without rotational inertia
+ */
+Matrix Joint::getWorldInversedInertia(RigidBody* body)
+{
+    if (body == nullptr || body->getInversedMass() == 0 || body->tenseurJ.determinant() == 0) return Matrix::zero();
+    Matrix rotation = body->orientation.quatToMat();
+    return rotation.transpose() * body->tenseurJ.inverse() * rotation;
+}
+
+/**
+ * @brief Complete a unit axis into an orthonormal basis
+ */
+void Joint::getPerpendiculars(Vector axis, Vector& first, Vector& second)
+{
+    Vector reference = std::abs(axis.x) < 0.57f ? Vector(1, 0, 0) : Vector(0, 1, 0);
+    first = axis.vectorialProduct(reference).normalized();
+    second = axis.vectorialProduct(first);
+}
+
+/**
+ * @brief Express the axes of the second body in the frame of the first, to lock their relative orientation
+ */
+void Joint::storeRelativeAxes(RigidBody* first, RigidBody* second, Vector (&axes)[3])
+{
+    Vector world[3] = {Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1)};
+    for (int i = 0; i < 3; i++)
+    {
+        axes[i] = toLocal(first, toWorld(second, world[i]));
+    }
+}
+
+/**
+ * @brief The small rotation taking the axes the second body should have to the axes it has
+ * @param axes The axes of the second body in the frame of the first, at rest
+ * @return The rotation vector, in world space
+ */
+Vector Joint::getRotationError(RigidBody* first, RigidBody* second, Vector (&axes)[3])
+{
+    Vector world[3] = {Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1)};
+    Vector error(0, 0, 0);
+    for (int i = 0; i < 3; i++)
+    {
+        error += toWorld(first, axes[i]).vectorialProduct(toWorld(second, world[i]));
+    }
+    return error * 0.5f;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <vector>
+
+#include "Matrix.h"
+#include "RigidBody.h"
+#include "Vector.h"
+
+/**
+ * @brief Kind of a joint, for the snapshots to know which local vectors to save
+ */
+enum JointType
+{
+    JointBallSocket = 0,
+    JointHinge = 1,
+    JointSlider = 2,
+    JointFixed = 3
+};
+
+/**
+ * @brief A constraint between two rigid bodies, or a body and the world, solved on the velocities by sequential
+ * impulses. Each joint is a few scalar rows: a Jacobian (the linear and angular velocities it measures on each
+ * body), a bias correcting the position drift, and the impulse accumulated on the row.
+ * The impulses are kept between steps and applied again before the first iteration (warm starting), so that a
+ * resting structure starts from the previous solution instead of from zero
+ *
+ */
+class Joint
+{
+public:
+    struct Row
+    {
+        Vector linearFirst;
+        Vector angularFirst;
+        Vector linearSecond;
+        Vector angularSecond;
+        // Velocity the row must cancel, from the position error
+        float bias = 0;
+        float effectiveMass = 0;
+        float impulse = 0;
+    };
+
+protected:
+    float inversedMassFirst = 0;
+    float inversedMassSecond = 0;
+    Matrix inversedInertiaFirst = Matrix::zero();
+    Matrix inversedInertiaSecond = Matrix::zero();
+
+    virtual void buildRows(float delta_t, float positionCorrection) = 0;
+
+    void setPointRow(Row& row, Vector axis, Vector leverFirst, Vector leverSecond, float error, float factor);
+    void setAngularRow(Row& row, Vector axis, float error, float factor);
+    void applyImpulse(Row& row, float impulse);
+
+    static Vector getCenter(RigidBody* body);
+    static Vector toWorld(RigidBody* body, Vector direction);
+    static Vector toLocal(RigidBody* body, Vector direction);
+    static Matrix getWorldInversedInertia(RigidBody* body);
+    static void getPerpendiculars(Vector axis, Vector& first, Vector& second);
+    static Vector getRotationError(RigidBody* first, RigidBody* second, Vector (&axes)[3]);
+    static void storeRelativeAxes(RigidBody* first, RigidBody* second, Vector (&axes)[3]);
+
+public:
+    JointType jointType;
+    RigidBody* first;
+    // nullptr to attach the first body to the world
+    RigidBody* second;
+    std::vector<Row> rows;
+
+    Joint(JointType jointType, RigidBody* first, RigidBody* second, int rowCount);
+    virtual ~Joint() = default;
+
+    void prepare(float delta_t, float positionCorrection, bool warmStart);
+    void solve();
+    virtual float getError() = 0;
+};
@@ -0,0 +1,106 @@
+#include "JointSolver.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+JointSolver::~JointSolver()
+{
+    clear();
+}
+
+/**
+ * @brief Add a joint, which the solver takes the ownership of
+ * @param joint The joint to solve at every step
+ */
+void JointSolver::add(Joint* joint)
+{
+    joints.push_back(joint);
+}
+
+/**
+ * @brief Remove and delete every joint
+ */
+void JointSolver::clear()
+{
+    for (Joint* joint : joints)
+    {
+        delete joint;
+    }
+    joints.clear();
+    bodies.clear();
+}
+
+/**
+ * @brief Solve every joint for a step, changing the velocities of their bodies
+ * @param delta_t The duration of the step
+ */
+void JointSolver::solve(float delta_t)
+{
+    if (joints.empty() || delta_t <= 0) return;
+    collectBodies();
+    addForces(delta_t, 1);
+
+    for (Joint* joint : joints)
+    {
+        joint->prepare(delta_t, positionCorrection, warmStarting);
+    }
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        for (Joint* joint : joints)
+        {
+            joint->solve();
+        }
+    }
+
+    addForces(delta_t, -1);
+}
+
+/**
+ * @return The largest position error of the joints
+ */
+float JointSolver::getMaxError()
+{
+    float error = 0;
+    for (Joint* joint : joints)
+    {
+        error = std::max(error, joint->getError());
+    }
+    return error;
+}
+
+/**
+ * @brief List each body attached to a joint once, in the order of the joints
+ */
+void JointSolver::collectBodies()
+{
+    bodies.clear();
+    std::unordered_set<RigidBody*> found;
+    for (Joint* joint : joints)
+    {
+        for (RigidBody* body : {joint->first, joint->second})
+        {
+            if (body != nullptr && found.insert(body).second)
+            {
+                bodies.push_back(body);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Add or remove the velocities the forces and torques of the step give, as eulerIntegration applies them
+ * @param sign 1 to add them, -1 to remove them
+ */
+void JointSolver::addForces(float delta_t, float sign)
+{
+    for (RigidBody* body : bodies)
+    {
+        body->linearVelocity += body->accumForce * (delta_t * sign);
+        if (body->tenseurJ.determinant() != 0)
+        {
+            // The integrator multiplies the torque by the rows of its inverse, hence the transpose
+            Matrix inversedInertia = body->computeInversedJ();
+            body->angularVelocity += inversedInertia.transpose() * (body->torque * (delta_t * sign));
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+
+#include "Joint.h"
+
+// Gauss-Seidel iterations over every joint per step
+#define JOINT_ITERATIONS 8
+// Part of the position error of the joints corrected at each step (Baumgarte stabilization)
+#define JOINT_POSITION_CORRECTION 0.2f
+
+/**
+ * @brief Solves the joints of a world on the velocities, just before the integration. The forces of the step are
+ * first added to the velocities, so that the impulses also cancel the forces pulling the joints apart, then they
+ * are removed for the integrator to add them back
+ *
+ */
+class JointSolver
+{
+private:
+    std::vector<RigidBody*> bodies;
+
+    void collectBodies();
+    void addForces(float delta_t, float sign);
+
+public:
+    // Owned
+    std::vector<Joint*> joints;
+    int iterations = JOINT_ITERATIONS;
+    float positionCorrection = JOINT_POSITION_CORRECTION;
+    bool warmStarting = true;
+
+    ~JointSolver();
+
+    void add(Joint* joint);
+    void clear();
+    void solve(float delta_t);
+    float getMaxError();
+};
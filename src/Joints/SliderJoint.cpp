@@ -0,0 +1,74 @@
+#include "SliderJoint.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @param first The first body
+ * @param second The second body, nullptr for the world
+ * @param anchor A world point of the axis
+ * @param axis The world direction the bodies slide along
+ */
+SliderJoint::SliderJoint(RigidBody* first, RigidBody* second, Vector anchor, Vector axis)
+    : Joint(JointSlider, first, second, 5)
+{
+    axis = axis.normalized();
+    Vector normals[2];
+    getPerpendiculars(axis, normals[0], normals[1]);
+    this->localAnchorFirst = toLocal(first, anchor - getCenter(first));
+    this->localAnchorSecond = toLocal(second, anchor - getCenter(second));
+    this->localAxis = toLocal(first, axis);
+    this->localNormals[0] = toLocal(first, normals[0]);
+    this->localNormals[1] = toLocal(first, normals[1]);
+    storeRelativeAxes(first, second, relativeAxes);
+}
+
+/**
+ * @brief Two rows keeping the anchor of the second body on the axis of the first, then three angular rows locking
+ * the rotation
+ */
+void SliderJoint::buildRows(float delta_t, float positionCorrection)
+{
+    Vector leverSecond = toWorld(second, localAnchorSecond);
+    Vector separation = getSeparation();
+    // The point of the first body under the anchor of the second, which moves with the translation
+    Vector leverFirst = toWorld(first, localAnchorFirst) + separation;
+    for (int i = 0; i < 2; i++)
+    {
+        Vector normal = toWorld(first, localNormals[i]);
+        setPointRow(rows[i], normal, leverFirst, leverSecond, separation * normal, positionCorrection / delta_t);
+    }
+
+    Vector error = getRotationError(first, second, relativeAxes);
+    Vector axes[3] = {Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1)};
+    for (int i = 0; i < 3; i++)
+    {
+        setAngularRow(rows[2 + i], axes[i], error * axes[i], positionCorrection / delta_t);
+    }
+}
+
+/**
+ * @return The world vector from the anchor of the first body to the anchor of the second
+ */
+Vector SliderJoint::getSeparation()
+{
+    return getCenter(second) + toWorld(second, localAnchorSecond) - getCenter(first) - toWorld(first, localAnchorFirst);
+}
+
+/**
+ * @return The distance the second body slid along the axis since the joint was created
+ */
+float SliderJoint::getTranslation()
+{
+    return getSeparation() * toWorld(first, localAxis);
+}
+
+/**
+ * @return The largest of the distance of the anchor from the axis and the rotation from the rest orientation
+ */
+float SliderJoint::getError()
+{
+    Vector separation = getSeparation();
+    Vector offAxis = separation - toWorld(first, localAxis) * getTranslation();
+    return std::max(offAxis.magnitude(), getRotationError(first, second, relativeAxes).magnitude());
+}
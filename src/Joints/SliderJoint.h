@@ -0,0 +1,27 @@
+#pragma once
+#include "Joint.h"
+
+/**
+ * @brief Lets the bodies translate along a common axis only, without any rotation, as a piston
+ *
+ */
+class SliderJoint : public Joint
+{
+protected:
+    void buildRows(float delta_t, float positionCorrection) override;
+    Vector getSeparation();
+
+public:
+    // The anchor in the frame of each body, from its center of mass
+    Vector localAnchorFirst;
+    Vector localAnchorSecond;
+    // The axis and two directions orthogonal to it, in the frame of the first body
+    Vector localAxis;
+    Vector localNormals[2];
+    // The axes of the second body in the frame of the first, at rest
+    Vector relativeAxes[3];
+
+    SliderJoint(RigidBody* first, RigidBody* second, Vector anchor, Vector axis);
+    float getTranslation();
+    float getError() override;
+};
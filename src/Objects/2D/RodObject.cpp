@@ -1,5 +1,7 @@
 ﻿#include "RodObject.h"
 
+#include "Material.h"
+
 RodObject::RodObject(Particle* p1, Particle* p2, float K, float length)
 {
     this->p1 = p1;
@@ -10,7 +12,7 @@ RodObject::RodObject(Particle* p1, Particle* p2, float K, float length)
 
 void RodObject::CheckCollision()
 {
-    auto e = 0.9;
+    auto e = MaterialTable::getPair(p1->material, p2->material).restitution;
     
     auto distance = p1->position.distance(p2->position);
 
@@ -1,6 +1,8 @@
 ﻿
 #include "WireObject.h"
 
+#include "Material.h"
+
 WireObject::WireObject(Particle *p1, Particle* p2, float K, float length)
 {
     this->p1 = p1;
@@ -11,7 +13,7 @@ WireObject::WireObject(Particle *p1, Particle* p2, float K, float length)
 
 void WireObject::CheckCollision()
 {
-    auto e = 0.9;
+    auto e = MaterialTable::getPair(p1->material, p2->material).restitution;
     float distance = p1->position.distance(p2->position);
     if(distance > length)
     {
@@ -5,12 +5,11 @@ Box::Box()
     this->width = 1; // b
     this->height = 1; // c
     this->depth = 1; // a
-    this->shape = ofBoxPrimitive(width, height, depth);
-    this->tenseurJ.l1 = Vector((getMass() / 12) * (glm::pow2(width) + glm::pow2(height)), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(height)), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(width)));
+    this->tenseurJ = MassProperties::box(width, height, depth, 1).withMass(getMass()).inertia;
     this->inversedTenseurJ = tenseurJ.inverse();
     colliderRadius = Vector(0,0,0).distance(Vector(width/2, height/2, depth/2));
+    shapeType = BoxShape;
+    updateBounds();
     RigidBody();
 }
 
@@ -19,13 +18,12 @@ Box::Box(float width, float height, float length)
     this->width = width;
     this->height = height;
     this->depth = length;
-    this->shape = ofBoxPrimitive(width, height, length);
-    this->tenseurJ.l1 = Vector((getMass() / 12) * (glm::pow2(width) + glm::pow2(height)), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(height)), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(width)));
+    this->tenseurJ = MassProperties::box(width, height, depth, 1).withMass(getMass()).inertia;
     this->inversedTenseurJ = tenseurJ.inverse();
     massCenter = Vector(0, 0, 0);
     colliderRadius = Vector(0,0,0).distance(Vector(width/2, height/2, depth/2));
+    shapeType = BoxShape;
+    updateBounds();
     RigidBody();
 }
 
@@ -37,13 +35,12 @@ Box::Box(float width, float height, float length, int color[3])
     this->color[0] = color[0];
     this->color[1] = color[1];
     this->color[2] = color[2];
-    this->shape = ofBoxPrimitive(width, height, length);
-    this->tenseurJ.l1 = Vector((getMass() / 12) * (glm::pow2(width) + glm::pow2(height)), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(height)), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(width)));
+    this->tenseurJ = MassProperties::box(width, height, depth, 1).withMass(getMass()).inertia;
     this->inversedTenseurJ = tenseurJ.inverse();
     
     colliderRadius = Vector(0,0,0).distance(Vector(width/2, height/2, depth/2));
+    shapeType = BoxShape;
+    updateBounds();
     RigidBody();
 }
 
@@ -55,14 +52,13 @@ Box::Box(float width, float height, float length, Vector translation)
     this->color[0] = color[0];
     this->color[1] = color[1];
     this->color[2] = color[2];
-    this->shape = ofBoxPrimitive(width, height, length);
-    this->tenseurJ.l1 = Vector((getMass() / 12) * (glm::pow2(width) + glm::pow2(height)), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(height)), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(width)));
+    this->tenseurJ = MassProperties::box(width, height, depth, 1).withMass(getMass()).inertia;
     this->moveCenterMass(translation);
     this->inversedTenseurJ = tenseurJ.inverse();
     
     colliderRadius = Vector(0,0,0).distance(Vector(width/2, height/2, depth/2));
+    shapeType = BoxShape;
+    updateBounds();
     RigidBody();
 }
 
@@ -75,12 +71,11 @@ Box::Box(float width, float height, float length, float gravity, Vector linearVe
     this->color[0] = color[0];
     this->color[1] = color[1];
     this->color[2] = color[2];
-    this->shape = ofBoxPrimitive(width, height, length);
-    this->tenseurJ.l1 = Vector((getMass() / 12) * (glm::pow2(width) + glm::pow2(height)), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(height)), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (getMass() / 12) * (glm::pow2(depth) + glm::pow2(width)));
+    this->tenseurJ = MassProperties::box(width, height, depth, 1).withMass(getMass()).inertia;
     this->inversedTenseurJ = tenseurJ.inverse();
     colliderRadius = Vector(0,0,0).distance(Vector(width/2, height/2, depth/2));
+    shapeType = BoxShape;
+    updateBounds();
     RigidBody(gravity, linearVelocity, angularVelocity, linearAcceleration);
 }
 
@@ -99,22 +94,50 @@ Box* Box::copy()
     return new Box(width, height, depth, gravity, linearVelocity, angularVelocity, linearAcceleration, color);
 }
 
-void Box::draw()
+/**
+ * @brief Update the world space bounding box from the orientation of the box. Each world axis
+ * receives the projection of the three rotated half extents
+ *
+ */
+void Box::updateBounds()
 {
-    // Draw the center of mass of the box
-    Vector realCenter = orientation.applyRotation(massCenter, orientation);
-    ofSetColor(ofColor::yellow, 255);
-    ofDrawSphere((position + realCenter).v3(), 5);
+    // The rows of the rotation matrix are the axes of the box in world space
+    Matrix rotation = orientation.quatToMat();
+    float halfWidth = width / 2;
+    float halfHeight = height / 2;
+    float halfDepth = depth / 2;
 
-    // Draw the box
-    ofSetColor(color[0], color[1], color[2], 150);
-    shape.setPosition(position.v3());
-    shape.setOrientation(orientation.q());
-    shape.draw();
+    Vector extents(
+        glm::abs(rotation.l1.x) * halfWidth + glm::abs(rotation.l2.x) * halfHeight + glm::abs(rotation.l3.x) * halfDepth,
+        glm::abs(rotation.l1.y) * halfWidth + glm::abs(rotation.l2.y) * halfHeight + glm::abs(rotation.l3.y) * halfDepth,
+        glm::abs(rotation.l1.z) * halfWidth + glm::abs(rotation.l2.z) * halfHeight + glm::abs(rotation.l3.z) * halfDepth);
 
-    ofNoFill();
-    ofSetColor(ofColor::red, 20);
-    ofDrawSphere(position.v3(),colliderRadius);
-    ofSetColor(255, 255, 255,255);
-    ofFill();
+    bounds = AABB(position - extents, position + extents);
+}
+
+/**
+ * @brief Support function of the box: the corner furthest in the given direction
+ *
+ * @param direction The search direction
+ * @return The corner of the box with the largest projection on direction
+ */
+Vector Box::support(Vector direction)
+{
+    Matrix rotation = orientation.quatToMat();
+    Vector corner = position;
+    corner += rotation.l1 * (direction * rotation.l1 >= 0 ? width / 2 : -width / 2);
+    corner += rotation.l2 * (direction * rotation.l2 >= 0 ? height / 2 : -height / 2);
+    corner += rotation.l3 * (direction * rotation.l3 >= 0 ? depth / 2 : -depth / 2);
+    return corner;
+}
+
+/**
+ * @brief Mass properties of the solid box
+ *
+ * @param density The mass per unit of volume
+ * @return The properties, in the frame of the box
+ */
+MassProperties Box::computeMassProperties(float density)
+{
+    return MassProperties::box(width, height, depth, density);
 }
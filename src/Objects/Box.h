@@ -36,11 +36,7 @@ public:
 
 
     Box* copy();
-/**
-* @brief Draw the rectangle
-*
-*/
-    void draw();
-
-    
+    void updateBounds() override;
+    MassProperties computeMassProperties(float density) override;
+    Vector support(Vector direction) override;
 };
@@ -0,0 +1,418 @@
+#include "Cloth.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <set>
+
+/**
+ * @brief Add a free particle
+ * @param position The rest position of the particle, where it starts
+ * @param mass The mass of the particle, 0 for a pinned one
+ * @return The index of the particle
+ */
+int Cloth::addParticle(Vector position, float mass)
+{
+    x.push_back(position.x);
+    y.push_back(position.y);
+    z.push_back(position.z);
+    restX.push_back(position.x);
+    restY.push_back(position.y);
+    restZ.push_back(position.z);
+    px.push_back(position.x);
+    py.push_back(position.y);
+    pz.push_back(position.z);
+    vx.push_back(0);
+    vy.push_back(0);
+    vz.push_back(0);
+    inversedMass.push_back(mass > 0 ? 1 / mass : 0);
+    return size() - 1;
+}
+
+/**
+ * @brief Link two particles at their current distance
+ * @param first The first particle
+ * @param second The second particle
+ * @param compliance The inverse stiffness of the link, 0 for a rigid one
+ */
+void Cloth::addConstraint(int first, int second, float compliance)
+{
+    float dx = x[first] - x[second];
+    float dy = y[first] - y[second];
+    float dz = z[first] - z[second];
+    constraints.push_back({first, second, std::sqrt(dx * dx + dy * dy + dz * dz), compliance});
+}
+
+/**
+ * @brief Fix a particle where it is, it is still moved by the code but never by the solver
+ * @param index The particle
+ */
+void Cloth::pin(int index)
+{
+    inversedMass[index] = 0;
+    vx[index] = vy[index] = vz[index] = 0;
+}
+
+/**
+ * @brief Replace the cloth by a rectangular grid of particles hanging in the xy plane, from its top left corner.
+ * Structural springs link the neighbours of each row and column, shear springs the diagonals of each cell, and
+ * bend springs the particles two apart, which resist folding without any angle constraint
+ * @param columns The number of particles of each row
+ * @param rows The number of particles of each column
+ * @param spacing The rest distance between neighbours
+ * @param origin The position of the top left particle, the rows go down along -y
+ * @param mass The total mass of the cloth
+ */
+void Cloth::buildGrid(int columns, int rows, float spacing, Vector origin, float mass)
+{
+    clear();
+    float particleMass = mass / (columns * rows);
+    for (int row = 0; row < rows; row++)
+    {
+        for (int column = 0; column < columns; column++)
+        {
+            addParticle(origin + Vector(column * spacing, -row * spacing, 0), particleMass);
+        }
+    }
+
+    auto index = [columns](int column, int row) { return row * columns + column; };
+    // Each kind is stored together, so that the stiffest springs are projected first
+    for (int row = 0; row < rows; row++)
+    {
+        for (int column = 0; column < columns; column++)
+        {
+            if (column + 1 < columns) addConstraint(index(column, row), index(column + 1, row), STRUCTURAL_COMPLIANCE);
+            if (row + 1 < rows) addConstraint(index(column, row), index(column, row + 1), STRUCTURAL_COMPLIANCE);
+        }
+    }
+    for (int row = 0; row + 1 < rows; row++)
+    {
+        for (int column = 0; column + 1 < columns; column++)
+        {
+            addConstraint(index(column, row), index(column + 1, row + 1), SHEAR_COMPLIANCE);
+            addConstraint(index(column + 1, row), index(column, row + 1), SHEAR_COMPLIANCE);
+        }
+    }
+    for (int row = 0; row < rows; row++)
+    {
+        for (int column = 0; column < columns; column++)
+        {
+            if (column + 2 < columns) addConstraint(index(column, row), index(column + 2, row), BEND_COMPLIANCE);
+            if (row + 2 < rows) addConstraint(index(column, row), index(column, row + 2), BEND_COMPLIANCE);
+        }
+    }
+
+    for (int row = 0; row + 1 < rows; row++)
+    {
+        for (int column = 0; column + 1 < columns; column++)
+        {
+            unsigned int corner = index(column, row);
+            triangles.insert(triangles.end(), {corner, corner + columns, corner + 1});
+            triangles.insert(triangles.end(), {corner + 1, corner + columns, corner + columns + 1u});
+        }
+    }
+
+    hash = SpatialHash(thickness);
+}
+
+/**
+ * @brief Replace the cloth by a soft box: a lattice of particles where each cell is split into six tetrahedra
+ * sharing its main diagonal. The edges of the tetrahedra are the constraints, which keep the volume of each cell
+ * @param countX The number of particles along x
+ * @param countY The number of particles along y
+ * @param countZ The number of particles along z
+ * @param spacing The rest distance between neighbours
+ * @param origin The position of the particle with the lowest coordinates
+ * @param mass The total mass of the box
+ * @param compliance The inverse stiffness of every edge
+ */
+void Cloth::buildSoftBox(int countX, int countY, int countZ, float spacing, Vector origin, float mass,
+                         float compliance)
+{
+    clear();
+    float particleMass = mass / (countX * countY * countZ);
+    for (int k = 0; k < countZ; k++)
+    {
+        for (int j = 0; j < countY; j++)
+        {
+            for (int i = 0; i < countX; i++)
+            {
+                addParticle(origin + Vector(i * spacing, j * spacing, k * spacing), particleMass);
+            }
+        }
+    }
+
+    auto index = [countX, countY](int i, int j, int k) { return (k * countY + j) * countX + i; };
+    // Each tetrahedron follows the axes in one order from the lowest corner of the cell to the highest
+    const int axes[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    std::set<std::pair<int, int>> edges;
+    for (int k = 0; k + 1 < countZ; k++)
+    {
+        for (int j = 0; j + 1 < countY; j++)
+        {
+            for (int i = 0; i + 1 < countX; i++)
+            {
+                for (auto& order : axes)
+                {
+                    int corner[3] = {i, j, k};
+                    int vertices[4];
+                    vertices[0] = index(corner[0], corner[1], corner[2]);
+                    for (int step = 0; step < 3; step++)
+                    {
+                        corner[order[step]]++;
+                        vertices[step + 1] = index(corner[0], corner[1], corner[2]);
+                    }
+                    for (int a = 0; a < 4; a++)
+                    {
+                        for (int b = a + 1; b < 4; b++)
+                        {
+                            edges.insert({std::min(vertices[a], vertices[b]), std::max(vertices[a], vertices[b])});
+                        }
+                    }
+                }
+            }
+        }
+    }
+    constraints.reserve(edges.size());
+    for (auto& edge : edges)
+    {
+        addConstraint(edge.first, edge.second, compliance);
+    }
+
+    hash = SpatialHash(thickness);
+}
+
+/**
+ * @brief Remove every particle and constraint, the settings are kept
+ */
+void Cloth::clear()
+{
+    for (auto values : {&x, &y, &z, &px, &py, &pz, &vx, &vy, &vz, &inversedMass, &restX, &restY, &restZ})
+    {
+        values->clear();
+    }
+    constraints.clear();
+    triangles.clear();
+}
+
+int Cloth::size()
+{
+    return static_cast<int>(x.size());
+}
+
+Vector Cloth::getPosition(int index)
+{
+    return Vector(x[index], y[index], z[index]);
+}
+
+/**
+ * @brief Simulate a step, split in substeps which each project the constraints once. Small substeps converge
+ * faster than many iterations of a single step
+ * @param delta_t The duration of the step
+ */
+void Cloth::step(float delta_t)
+{
+    if (delta_t <= 0 || size() == 0) return;
+    selfCollisionCount = 0;
+    if (hash.getSpacing() != thickness) hash = SpatialHash(thickness);
+
+    float substep = delta_t / std::max(substeps, 1);
+    for (int i = 0; i < std::max(substeps, 1); i++)
+    {
+        predict(substep);
+        solveConstraints(substep);
+        if (selfCollision) solveSelfCollisions();
+        solvePlanes();
+        updateVelocities(substep);
+    }
+}
+
+/**
+ * @brief Apply the gravity and move the free particles along their velocity
+ */
+void Cloth::predict(float delta_t)
+{
+    const int count = size();
+    for (int i = 0; i < count; i++)
+    {
+        if (inversedMass[i] == 0)
+        {
+            px[i] = x[i];
+            py[i] = y[i];
+            pz[i] = z[i];
+            continue;
+        }
+        vx[i] += gravity.x * delta_t;
+        vy[i] += gravity.y * delta_t;
+        vz[i] += gravity.z * delta_t;
+        px[i] = x[i] + vx[i] * delta_t;
+        py[i] = y[i] + vy[i] * delta_t;
+        pz[i] = z[i] + vz[i] * delta_t;
+    }
+}
+
+/**
+ * @brief Project each distance constraint in turn (Gauss-Seidel), moving both particles along their axis by their
+ * inversed mass. The compliance is scaled by the squared substep so that the stiffness does not depend on it
+ */
+void Cloth::solveConstraints(float delta_t)
+{
+    const float inversedStep = 1 / (delta_t * delta_t);
+    for (auto& constraint : constraints)
+    {
+        const int a = constraint.first;
+        const int b = constraint.second;
+        float weight = inversedMass[a] + inversedMass[b];
+        if (weight == 0) continue;
+
+        float dx = px[a] - px[b];
+        float dy = py[a] - py[b];
+        float dz = pz[a] - pz[b];
+        float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (length < 1e-9f) continue;
+
+        float correction = (length - constraint.restLength) / (weight + constraint.compliance * inversedStep) / length;
+        px[a] -= dx * correction * inversedMass[a];
+        py[a] -= dy * correction * inversedMass[a];
+        pz[a] -= dz * correction * inversedMass[a];
+        px[b] += dx * correction * inversedMass[b];
+        py[b] += dy * correction * inversedMass[b];
+        pz[b] += dz * correction * inversedMass[b];
+    }
+}
+
+/**
+ * @brief Push apart the particles closer than the thickness, except those already that close at rest, which the
+ * constraints keep apart. The hash only gives candidates, each pair is checked once from its lowest index
+ */
+void Cloth::solveSelfCollisions()
+{
+    const int count = size();
+    const float minRest = thickness * SELF_COLLISION_REST_RATIO;
+    hash.build(px, py, pz);
+    for (int i = 0; i < count; i++)
+    {
+        hash.query(px[i], py[i], pz[i], thickness, candidates);
+        for (int j : candidates)
+        {
+            if (j <= i) continue;
+            float weight = inversedMass[i] + inversedMass[j];
+            if (weight == 0) continue;
+
+            float dx = px[i] - px[j];
+            float dy = py[i] - py[j];
+            float dz = pz[i] - pz[j];
+            float squaredDistance = dx * dx + dy * dy + dz * dz;
+            if (squaredDistance >= thickness * thickness || squaredDistance < 1e-12f) continue;
+
+            float restDx = restX[i] - restX[j];
+            float restDy = restY[i] - restY[j];
+            float restDz = restZ[i] - restZ[j];
+            if (restDx * restDx + restDy * restDy + restDz * restDz <= minRest * minRest) continue;
+
+            float distance = std::sqrt(squaredDistance);
+            float correction = (thickness - distance) / weight / distance;
+            px[i] += dx * correction * inversedMass[i];
+            py[i] += dy * correction * inversedMass[i];
+            pz[i] += dz * correction * inversedMass[i];
+            px[j] -= dx * correction * inversedMass[j];
+            py[j] -= dy * correction * inversedMass[j];
+            pz[j] -= dz * correction * inversedMass[j];
+            selfCollisionCount++;
+        }
+    }
+}
+
+/**
+ * @brief Keep the particles half the thickness above every plane
+ */
+void Cloth::solvePlanes()
+{
+    const int count = size();
+    for (auto plane : planes)
+    {
+        const float limit = plane->offset + thickness / 2;
+        for (int i = 0; i < count; i++)
+        {
+            float height = plane->normal.x * px[i] + plane->normal.y * py[i] + plane->normal.z * pz[i];
+            if (height >= limit || inversedMass[i] == 0) continue;
+            px[i] += plane->normal.x * (limit - height);
+            py[i] += plane->normal.y * (limit - height);
+            pz[i] += plane->normal.z * (limit - height);
+        }
+    }
+}
+
+/**
+ * @brief Derive the velocities from the motion of the substep, then accept the predicted positions
+ */
+void Cloth::updateVelocities(float delta_t)
+{
+    const int count = size();
+    const float scale = std::max(0.0f, 1 - damping * delta_t) / delta_t;
+    for (int i = 0; i < count; i++)
+    {
+        if (inversedMass[i] == 0) continue;
+        vx[i] = (px[i] - x[i]) * scale;
+        vy[i] = (py[i] - y[i]) * scale;
+        vz[i] = (pz[i] - z[i]) * scale;
+        x[i] = px[i];
+        y[i] = py[i];
+        z[i] = pz[i];
+    }
+}
+
+/**
+ * @brief Draw the triangles, or the constraints when there are none
+ */
+void Cloth::draw()
+{
+    const int count = size();
+    mesh.clear();
+    for (int i = 0; i < count; i++)
+    {
+        mesh.addVertex(glm::vec3(x[i], y[i], z[i]));
+    }
+    if (triangles.empty())
+    {
+        mesh.setMode(OF_PRIMITIVE_LINES);
+        for (auto& constraint : constraints)
+        {
+            mesh.addIndex(constraint.first);
+            mesh.addIndex(constraint.second);
+        }
+    }
+    else
+    {
+        mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+        for (unsigned int index : triangles)
+        {
+            mesh.addIndex(index);
+        }
+    }
+    ofSetColor(color);
+    mesh.draw();
+}
+
+/**
+ * @brief Measure the steps of a square cloth hanging from its top corners and folding on itself, without any
+ * window
+ * @param columns The number of particles of each side
+ * @param steps The number of steps
+ * @return The average duration of a step, in milliseconds
+ */
+double Cloth::benchmark(int columns, int steps)
+{
+    Cloth cloth;
+    cloth.buildGrid(columns, columns, 0.1f, Vector(0, 0, 0), columns * columns * 0.01f);
+    cloth.pin(0);
+    cloth.pin(columns - 1);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int step = 0; step < steps; step++)
+    {
+        cloth.step(1.0f / 60.0f);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() / std::max(steps, 1);
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+
+#include "Drawable.h"
+#include "SpatialHash.h"
+#include "StaticPlane.h"
+#include "Vector.h"
+
+// Compliance (inverse stiffness) of each kind of spring, 0 is rigid
+#define STRUCTURAL_COMPLIANCE 0.0f
+#define SHEAR_COMPLIANCE 1e-5f
+#define BEND_COMPLIANCE 1e-3f
+// Self collisions are skipped between particles closer than this at rest, as a ratio of the thickness
+#define SELF_COLLISION_REST_RATIO 1.0f
+
+/**
+ * @brief Cloth and soft bodies as particles linked by distance constraints, solved with extended position based
+ * dynamics (XPBD): each substep predicts the positions, projects every constraint once, then derives the
+ * velocities from the motion. A compliance softens each constraint independently of the time step, instead of
+ * the stiff springs an explicit integrator would need tiny steps for.
+ * Like ParticleSystem, each property is a contiguous array indexed by particle, and the constraints are a single
+ * array of plain structs. Self collisions push apart the particles closer than the thickness, found with a
+ * spatial hash rebuilt at each substep
+ *
+ */
+class Cloth : public Drawable
+{
+public:
+    struct DistanceConstraint
+    {
+        int first;
+        int second;
+        float restLength;
+        float compliance;
+    };
+
+private:
+    SpatialHash hash = SpatialHash(1);
+    std::vector<int> candidates;
+    // Rest positions, self collisions are skipped between particles already close at rest
+    std::vector<float> restX;
+    std::vector<float> restY;
+    std::vector<float> restZ;
+    ofMesh mesh;
+
+    void predict(float delta_t);
+    void solveConstraints(float delta_t);
+    void solveSelfCollisions();
+    void solvePlanes();
+    void updateVelocities(float delta_t);
+
+public:
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    // Positions predicted during a substep
+    std::vector<float> px;
+    std::vector<float> py;
+    std::vector<float> pz;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> vz;
+    // 0 for pinned particles
+    std::vector<float> inversedMass;
+    std::vector<DistanceConstraint> constraints;
+    // Indices of the rendered triangles, empty to draw the constraints as lines
+    std::vector<unsigned int> triangles;
+
+    // Settings
+    Vector gravity = Vector(0, -9.81, 0);
+    int substeps = 10;
+    // Velocity lost per second, in [0, 1]
+    float damping = 0.1f;
+    // Minimum distance between particles and from the planes
+    float thickness = 0.1f;
+    bool selfCollision = true;
+    ofColor color = ofColor(220, 220, 220);
+    // Collision planes, not owned
+    std::vector<StaticPlane*> planes;
+
+    // Self collisions pushed apart during the last step
+    int selfCollisionCount = 0;
+
+    int addParticle(Vector position, float mass);
+    void addConstraint(int first, int second, float compliance);
+    void pin(int index);
+    void buildGrid(int columns, int rows, float spacing, Vector origin, float mass);
+    void buildSoftBox(int countX, int countY, int countZ, float spacing, Vector origin, float mass,
+                      float compliance);
+    void clear();
+    int size();
+    Vector getPosition(int index);
+    void step(float delta_t);
+    void draw() override;
+    static double benchmark(int columns, int steps);
+};
@@ -1,238 +1,481 @@
 ﻿#include "CollisionManager.h"
 
+#include <algorithm>
+
 #include "Box.h"
+#include "Compound.h"
+#include "GJK.h"
+#include "Material.h"
+
+// Kernels indexed by the shape types of a pair. Pairs are sorted so that the first type is the smallest,
+// the lower half of the table is only a fallback
+static const NarrowPhaseKernel kernels[ShapeTypeCount][ShapeTypeCount] = {
+    // SphereShape                   BoxShape                        ConeShape                        ConvexHullShape                  CompoundShape
+    {CollisionManager::sphereSphere, CollisionManager::sphereBox, CollisionManager::convexConvex, CollisionManager::convexConvex, CollisionManager::compound}, // SphereShape
+    {CollisionManager::convexConvex, CollisionManager::boxBox, CollisionManager::convexConvex, CollisionManager::convexConvex, CollisionManager::compound},    // BoxShape
+    {CollisionManager::convexConvex, CollisionManager::convexConvex, CollisionManager::convexConvex, CollisionManager::convexConvex, CollisionManager::compound}, // ConeShape
+    {CollisionManager::convexConvex, CollisionManager::convexConvex, CollisionManager::convexConvex, CollisionManager::convexConvex, CollisionManager::compound}, // ConvexHullShape
+    {CollisionManager::compound, CollisionManager::compound, CollisionManager::compound, CollisionManager::compound, CollisionManager::compound}          // CompoundShape
+};
 
 /**
  * \brief: Handler for the narrow phase collision detection. It checks in all the pairs of Rigidbodies wether their body shapes intersect and resolve the collisions.
+ * The pairs are sorted by shape types, so each specialised kernel runs on a contiguous batch of pairs.
+ * All the contacts are found before any of them is resolved, in the order of the sorted pairs.
  * \param collisions : All the pairs of Rigidbodies to be checked. Should be paired with a broad collision check
+ * \param delta_t : The duration of the step
  * \return: The list of objects that collided in the narrow phase.
  */
 std::vector<std::pair<RigidBody*, RigidBody*>> CollisionManager::getNarrowCollision(
-    std::vector<std::pair<RigidBody*, RigidBody*>> collisions)
+    std::vector<std::pair<RigidBody*, RigidBody*>> collisions, float delta_t)
 {
     std::vector<std::pair<RigidBody*, RigidBody*>> narrowCollisions;
-    for (auto collision : collisions)
+    std::vector<Contact> contacts;
+    sortByShapeType(collisions);
+
+    size_t batchStart = 0;
+    while (batchStart < collisions.size())
     {
-        auto first = static_cast<Box*>(collision.first);
-        auto second = static_cast<Box*>(collision.second);
+        ShapeType firstType = collisions[batchStart].first->shapeType;
+        ShapeType secondType = collisions[batchStart].second->shapeType;
+        NarrowPhaseKernel kernel = getKernel(firstType, secondType);
 
-        auto firstCollisionResolve= intersect(*first, *second);
-        auto secondCollisionResolve = intersect(*second, *first);
-        if (firstCollisionResolve || secondCollisionResolve)
+        size_t batchEnd = batchStart;
+        for (; batchEnd < collisions.size(); batchEnd++)
         {
-            narrowCollisions.emplace_back(std::pair(first,second));
+            auto collision = collisions[batchEnd];
+            if (collision.first->shapeType != firstType || collision.second->shapeType != secondType) break;
+
+            Contact contact;
+            contact.first = collision.first;
+            contact.second = collision.second;
+            if (kernel(*contact.first, *contact.second, contact))
+            {
+                contacts.push_back(contact);
+                narrowCollisions.emplace_back(collision);
+            }
         }
+        batchStart = batchEnd;
+    }
+
+    for (auto& contact : contacts)
+    {
+        resolveContact(contact, delta_t);
     }
     return narrowCollisions;
 }
 
 /**
- * \brief: Retrieve the 8 corners of the box
- * \param box: The applied on box
- * \return: A vector containing the absolute positions of the 8 corners of the box
+ * \brief: Order each pair by shape type, then sort the pairs so that the ones sharing a kernel are contiguous.
+ * Ties are broken with the body ids, so the order does not depend on the broad phase nor on the addresses
+ * \param collisions : The pairs to sort in place
  */
-std::vector<Vector> CollisionManager::getCorners(Box& box)
+void CollisionManager::sortByShapeType(std::vector<std::pair<RigidBody*, RigidBody*>>& collisions)
 {
-    Vector xAxis = Vector(box.shape.getXAxis().x, box.shape.getXAxis().y, box.shape.getXAxis().z).normalized();
-    Vector yAxis = Vector(box.shape.getYAxis().x, box.shape.getYAxis().y, box.shape.getYAxis().z).normalized();
-    Vector zAxis = Vector(box.shape.getZAxis().x, box.shape.getZAxis().y, box.shape.getZAxis().z).normalized();
-    //  Retrieve the 8 corners of the box
-    Vector Corner1 = box.position + xAxis * (box.getWidth() / 2) + yAxis * (box.getHeight() / 2) + zAxis * (box.
-        getDepth() / 2);
-    Vector Corner2 = box.position - xAxis * (box.getWidth() / 2) + yAxis * (box.getHeight() / 2) + zAxis * (box.
-        getDepth() / 2);
-    Vector Corner3 = box.position + xAxis * (box.getWidth() / 2) - yAxis * (box.getHeight() / 2) + zAxis * (box.
-        getDepth() / 2);
-    Vector Corner4 = box.position - xAxis * (box.getWidth() / 2) - yAxis * (box.getHeight() / 2) + zAxis * (box.
-        getDepth() / 2);
-    Vector Corner5 = box.position + xAxis * (box.getWidth() / 2) + yAxis * (box.getHeight() / 2) - zAxis * (box.
-        getDepth() / 2);
-    Vector Corner6 = box.position - xAxis * (box.getWidth() / 2) + yAxis * (box.getHeight() / 2) - zAxis * (box.
-        getDepth() / 2);
-    Vector Corner7 = box.position + xAxis * (box.getWidth() / 2) - yAxis * (box.getHeight() / 2) - zAxis * (box.
-        getDepth() / 2);
-    Vector Corner8 = box.position - xAxis * (box.getWidth() / 2) - yAxis * (box.getHeight() / 2) - zAxis * (box.
-        getDepth() / 2);
-
-    auto cornerList = std::vector<Vector>();
-    cornerList.push_back(Corner1);
-    cornerList.push_back(Corner2);
-    cornerList.push_back(Corner3);
-    cornerList.push_back(Corner4);
-    cornerList.push_back(Corner5);
-    cornerList.push_back(Corner6);
-    cornerList.push_back(Corner7);
-    cornerList.push_back(Corner8);
-    return cornerList;
+    for (auto& collision : collisions)
+    {
+        if (collision.first->shapeType > collision.second->shapeType
+            || (collision.first->shapeType == collision.second->shapeType && collision.first->id > collision.second->id))
+        {
+            std::swap(collision.first, collision.second);
+        }
+    }
+    std::sort(collisions.begin(), collisions.end(),
+              [](const std::pair<RigidBody*, RigidBody*>& a, const std::pair<RigidBody*, RigidBody*>& b)
+              {
+                  int firstKey = a.first->shapeType * ShapeTypeCount + a.second->shapeType;
+                  int secondKey = b.first->shapeType * ShapeTypeCount + b.second->shapeType;
+                  if (firstKey != secondKey) return firstKey < secondKey;
+                  if (a.first->id != b.first->id) return a.first->id < b.first->id;
+                  return a.second->id < b.second->id;
+              });
 }
 
 /**
- * \brief: Retrieve the 6 faces of the box 
- * \param box: The applied on box
- * \return : A vector containing the absolute positions of the 6 faces of the box
+ * \brief: Retrieve the narrow phase algorithm of a pair of shape types
+ * \return: The specialised kernel if there is one, GJK/EPA otherwise
  */
-std::vector<Vector> CollisionManager::getFaces(Box& box)
+NarrowPhaseKernel CollisionManager::getKernel(ShapeType first, ShapeType second)
 {
-    // Retrieve the 6 faces of second
-    Vector face1 = box.position + Vector(box.shape.getXAxis().x, box.shape.getXAxis().y, box.shape.getXAxis().z).normalized()*(box.getWidth()/2);  
-    Vector face2 = box.position + Vector(box.shape.getYAxis().x, box.shape.getYAxis().y, box.shape.getYAxis().z).normalized()*(box.getHeight()/2);
-    Vector face3 = box.position + Vector(box.shape.getZAxis().x, box.shape.getZAxis().y, box.shape.getZAxis().z).normalized()*(box.getDepth()/2);
-    Vector face4 = box.position - Vector(box.shape.getXAxis().x, box.shape.getXAxis().y, box.shape.getXAxis().z).normalized()*(box.getWidth()/2) ;
-    Vector face5 = box.position - Vector(box.shape.getYAxis().x, box.shape.getYAxis().y, box.shape.getYAxis().z).normalized()*(box.getHeight()/2);
-    Vector face6 = box.position - Vector(box.shape.getZAxis().x, box.shape.getZAxis().y, box.shape.getZAxis().z).normalized()*(box.getDepth()/2);
-
-    auto faceList = std::vector<Vector>();
-    faceList.push_back(face1);
-    faceList.push_back(face2);
-    faceList.push_back(face3);
-    faceList.push_back(face4);
-    faceList.push_back(face5);
-    faceList.push_back(face6);
-    return faceList;
+    return kernels[first][second];
 }
 
 /**
- * \brief : Resolve the collision between two boxes
- * \param applicationPoint : Point of collision
- * \param n : Normal of the collision (usually the face of a box)
- * \param interpenetration : The penetration distance between the two boxes. Applied to move the objects
- * \param first : The first box
- * \param second: The second box
+ * \brief: Sphere against sphere, from the distance between the centers
+ * \param first : A body with a SphereShape
+ * \param second : A body with a SphereShape
+ * \param contact : Filled with the normal from first to second, the depth and the middle of the overlap
+ * \return: True if the spheres overlap
  */
-void CollisionManager::resolveCollision(Vector applicationPoint, Vector n, float interpenetration,  Box& first, Box& second)
+bool CollisionManager::sphereSphere(RigidBody& first, RigidBody& second, Contact& contact)
 {
+    Vector offset = second.position - first.position;
+    float radii = first.colliderRadius + second.colliderRadius;
+    float squaredDistance = offset.squaredMagnitude();
+    if (squaredDistance >= radii * radii) return false;
 
-    // Resolve the position
-    float K = first.getMass() / ( first.getMass() + second.getMass());
-    auto f= n * K * interpenetration;
-    first.position += n * K * interpenetration;
-    
-    // Apply the force
-    float intensity = ((first.linearVelocity.magnitude() > first.angularVelocity.magnitude() )? first.linearVelocity : first.angularVelocity).magnitude();
-    Vector force = n* (0.9*intensity/(ofGetLastFrameTime() == 0.0f ? 1.0f/60.0f: ofGetLastFrameTime()));
-    first.addForce(force, applicationPoint);
+    float distance = glm::sqrt(squaredDistance);
+    // Concentric spheres have no preferred direction
+    contact.normal = distance > 0 ? offset * (1 / distance) : Vector(0, 1, 0);
+    contact.penetration = radii - distance;
+    contact.point = first.position + contact.normal * (first.colliderRadius - contact.penetration / 2);
+    return true;
 }
 
 /**
- * \brief : Check if two boxes intersect and resolve the collision
- * \param first : The first box
- * \param second: The second box
- * \return : True if the boxes intersect
+ * \brief: Sphere against oriented box, from the point of the box closest to the sphere center
+ * \param first : A body with a SphereShape
+ * \param second : A Box
+ * \param contact : Filled with the normal from the sphere to the box, the depth and the closest point of the box
+ * \return: True if the sphere overlaps the box
  */
-bool CollisionManager::intersect(Box& first, Box& second)
+bool CollisionManager::sphereBox(RigidBody& first, RigidBody& second, Contact& contact)
 {
-    auto corners = getCorners(first);
-
-    auto faces = getFaces(second);
+    Box& box = static_cast<Box&>(second);
+    Matrix rotation = box.orientation.quatToMat();
+    Vector axes[3] = {rotation.l1, rotation.l2, rotation.l3};
+    float halfExtents[3] = {box.getWidth() / 2, box.getHeight() / 2, box.getDepth() / 2};
 
-    Vector cornerPoint;
-    bool intersected = true; 
-    for (auto corner : corners)
+    // Clamp the center of the sphere in the local frame of the box
+    Vector relative = first.position - box.position;
+    Vector closest = box.position;
+    bool inside = true;
+    float faceDistance = FLT_MAX;
+    Vector faceNormal;
+    for (int i = 0; i < 3; i++)
     {
-        intersected = true;
-        for (auto face : faces)
+        float coordinate = relative * axes[i];
+        if (coordinate > halfExtents[i])
         {
-            auto relativeCorner = corner - face;
-            if(relativeCorner * face > 0)
-            {
-                intersected = false;
-                break;
-            }
-            
+            coordinate = halfExtents[i];
+            inside = false;
         }
-        if(intersected)
+        else if (coordinate < -halfExtents[i])
+        {
+            coordinate = -halfExtents[i];
+            inside = false;
+        }
+        closest += axes[i] * coordinate;
+
+        if (halfExtents[i] - glm::abs(coordinate) < faceDistance)
         {
-            cornerPoint = corner;
-            break;
+            faceDistance = halfExtents[i] - glm::abs(coordinate);
+            faceNormal = coordinate >= 0 ? axes[i] : axes[i].opposite();
         }
     }
 
+    if (!inside)
+    {
+        Vector offset = closest - first.position;
+        float distance = offset.magnitude();
+        if (distance >= first.colliderRadius) return false;
+
+        contact.normal = offset * (1 / distance);
+        contact.penetration = first.colliderRadius - distance;
+        contact.point = closest;
+        return true;
+    }
+
+    // The center is inside the box, the sphere leaves through the nearest face
+    contact.normal = faceNormal.opposite();
+    contact.penetration = first.colliderRadius + faceDistance;
+    contact.point = first.position + faceNormal * faceDistance;
+    return true;
+}
 
-    if (intersected){
-        float min = FLT_MAX;
-        Vector n = faces[0];
-        for(auto face : faces )
+/**
+ * \brief: Overlap of two oriented boxes projected on an axis
+ * \return: The overlap length, negative when the axis separates the boxes
+ */
+static float getOverlapOnAxis(Vector axis, Vector* firstAxes, float* firstHalfExtents, Vector* secondAxes,
+                              float* secondHalfExtents, Vector offset)
+{
+    float firstRadius = 0;
+    float secondRadius = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        firstRadius += glm::abs(firstAxes[i] * axis) * firstHalfExtents[i];
+        secondRadius += glm::abs(secondAxes[i] * axis) * secondHalfExtents[i];
+    }
+    return firstRadius + secondRadius - glm::abs(offset * axis);
+}
+
+/**
+ * \brief: Oriented box against oriented box with the separating axis theorem, on the 3 face axes of each box
+ * and the 9 cross products of their edges. The axis of least overlap gives the contact normal.
+ * \param first : A Box
+ * \param second : A Box
+ * \param contact : Filled with the normal from first to second, the depth and the contact point
+ * \return: True if the boxes overlap
+ */
+bool CollisionManager::boxBox(RigidBody& first, RigidBody& second, Contact& contact)
+{
+    Box& firstBox = static_cast<Box&>(first);
+    Box& secondBox = static_cast<Box&>(second);
+    Matrix firstRotation = firstBox.orientation.quatToMat();
+    Matrix secondRotation = secondBox.orientation.quatToMat();
+    Vector firstAxes[3] = {firstRotation.l1, firstRotation.l2, firstRotation.l3};
+    Vector secondAxes[3] = {secondRotation.l1, secondRotation.l2, secondRotation.l3};
+    float firstHalfExtents[3] = {firstBox.getWidth() / 2, firstBox.getHeight() / 2, firstBox.getDepth() / 2};
+    float secondHalfExtents[3] = {secondBox.getWidth() / 2, secondBox.getHeight() / 2, secondBox.getDepth() / 2};
+    Vector offset = secondBox.position - firstBox.position;
+
+    // 0 to 2: faces of first, 3 to 5: faces of second, 6 to 14: edge pairs
+    float minOverlap = FLT_MAX;
+    int bestAxis = -1;
+    Vector normal;
+    for (int i = 0; i < 6; i++)
+    {
+        Vector axis = i < 3 ? firstAxes[i] : secondAxes[i - 3];
+        float overlap = getOverlapOnAxis(axis, firstAxes, firstHalfExtents, secondAxes, secondHalfExtents, offset);
+        if (overlap < 0) return false;
+        if (overlap < minOverlap)
+        {
+            minOverlap = overlap;
+            bestAxis = i;
+            normal = axis;
+        }
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
         {
-            auto relativeDistance = (cornerPoint).projection(face).distance(face);
-            
-            if(relativeDistance < min)
+            Vector axis = firstAxes[i].vectorialProduct(secondAxes[j]);
+            // Parallel edges, the face axes already cover this direction
+            if (axis.squaredMagnitude() < 0.000001f) continue;
+            axis = axis.normalized();
+
+            float overlap = getOverlapOnAxis(axis, firstAxes, firstHalfExtents, secondAxes, secondHalfExtents, offset);
+            if (overlap < 0) return false;
+            if (overlap < minOverlap * SAT_EDGE_BIAS)
             {
-                n = face.normalized();
-                min = relativeDistance;
+                minOverlap = overlap;
+                bestAxis = 6 + i * 3 + j;
+                normal = axis;
             }
         }
+    }
 
-        auto Copy = first.copy();
-        resolveCollision(cornerPoint,n.opposite(), min,first, second);
-        resolveCollision(cornerPoint,n, min,second, *Copy);
+    if (normal * offset < 0) normal = normal.opposite();
+    contact.normal = normal;
+    contact.penetration = minOverlap;
+
+    if (bestAxis < 3)
+    {
+        // Deepest corner of the second box inside a face of the first one
+        contact.point = secondBox.support(normal.opposite()) + normal * (minOverlap / 2);
     }
-    
-    return intersected;
+    else if (bestAxis < 6)
+    {
+        contact.point = firstBox.support(normal) - normal * (minOverlap / 2);
+    }
+    else
+    {
+        // Closest points of the two crossing edges
+        Vector firstDirection = firstAxes[(bestAxis - 6) / 3];
+        Vector secondDirection = secondAxes[(bestAxis - 6) % 3];
+        Vector firstCorner = firstBox.support(normal);
+        Vector secondCorner = secondBox.support(normal.opposite());
+        Vector firstEdge = firstCorner - firstDirection * ((firstCorner - firstBox.position) * firstDirection);
+        Vector secondEdge = secondCorner - secondDirection * ((secondCorner - secondBox.position) * secondDirection);
+
+        Vector between = firstEdge - secondEdge;
+        float cosine = firstDirection * secondDirection;
+        float denominator = 1 - cosine * cosine;
+        float firstParameter = (cosine * (secondDirection * between) - firstDirection * between) / denominator;
+        float secondParameter = cosine * firstParameter + secondDirection * between;
+        firstParameter = glm::clamp(firstParameter, -firstHalfExtents[(bestAxis - 6) / 3],
+                                    firstHalfExtents[(bestAxis - 6) / 3]);
+        secondParameter = glm::clamp(secondParameter, -secondHalfExtents[(bestAxis - 6) % 3],
+                                     secondHalfExtents[(bestAxis - 6) % 3]);
+
+        contact.point = (firstEdge + firstDirection * firstParameter + secondEdge + secondDirection * secondParameter)
+            * 0.5f;
+    }
+    return true;
 }
 
-// Archived fucntions to check narrow collisions in a general purpose
-/*
+/**
+ * \brief: Largest separation of two oriented boxes over the 15 SAT axes, with the boxes moved to the given centers.
+ * It is a lower bound of the distance between the boxes
+ * \return: The separation, negative when the boxes overlap
+ */
+float CollisionManager::getBoxSeparation(Box& first, Vector firstPosition, Box& second, Vector secondPosition)
+{
+    Vector axis;
+    return getBoxSeparation(first, firstPosition, second, secondPosition, axis);
+}
 
-bool CollisionManager::intersect(Box& first, Box& second)
+/**
+ * \brief: Largest separation of two oriented boxes over the 15 SAT axes, with the axis it is found on
+ * \param axis : Receives the unit axis of the largest separation, pointing from first to second
+ * \return: The separation, negative when the boxes overlap
+ */
+float CollisionManager::getBoxSeparation(Box& first, Vector firstPosition, Box& second, Vector secondPosition,
+                                         Vector& axis)
 {
-    Vector firstxAxis = Vector(first.shape.getXAxis().x, first.shape.getXAxis().y, first.shape.getXAxis().z).normalized();
-    Vector firstyAxis = Vector(first.shape.getYAxis().x, first.shape.getYAxis().y, first.shape.getYAxis().z).normalized();
-    Vector firstzAxis = Vector(first.shape.getZAxis().x, first.shape.getZAxis().y, first.shape.getZAxis().z).normalized();
-    Vector secondxAxis = Vector(second.shape.getXAxis().x, second.shape.getXAxis().y, second.shape.getXAxis().z).normalized();
-    Vector secondyAxis = Vector(second.shape.getYAxis().x, second.shape.getYAxis().y, second.shape.getYAxis().z).normalized();
-    Vector secondzAxis = Vector(second.shape.getZAxis().x, second.shape.getZAxis().y, second.shape.getZAxis().z).normalized();
-    auto list = std::vector<Vector>();
-    list.push_back(firstxAxis);
-    list.push_back(firstyAxis);
-    list.push_back(firstzAxis);
-    list.push_back(secondxAxis);
-    list.push_back(secondyAxis);
-    list.push_back(secondzAxis);
-
-    auto dist = first.position - second.position;
-    for (auto axis : list)
-    {
-        float firstRadius = getRadius(axis, first);
-        float secondRadius = getRadius(axis, second);
-        auto projectedDist = dist.projection(axis).magnitude();
-        
-        if (projectedDist > firstRadius + secondRadius)
+    Matrix firstRotation = first.orientation.quatToMat();
+    Matrix secondRotation = second.orientation.quatToMat();
+    Vector firstAxes[3] = {firstRotation.l1, firstRotation.l2, firstRotation.l3};
+    Vector secondAxes[3] = {secondRotation.l1, secondRotation.l2, secondRotation.l3};
+    float firstHalfExtents[3] = {first.getWidth() / 2, first.getHeight() / 2, first.getDepth() / 2};
+    float secondHalfExtents[3] = {second.getWidth() / 2, second.getHeight() / 2, second.getDepth() / 2};
+    Vector offset = secondPosition - firstPosition;
+
+    float separation = -FLT_MAX;
+    auto testAxis = [&](Vector candidate)
+    {
+        float candidateSeparation = -getOverlapOnAxis(candidate, firstAxes, firstHalfExtents, secondAxes,
+                                                      secondHalfExtents, offset);
+        if (candidateSeparation > separation)
         {
-            return false;
+            separation = candidateSeparation;
+            axis = offset * candidate < 0 ? candidate.opposite() : candidate;
+        }
+    };
+    for (int i = 0; i < 3; i++)
+    {
+        testAxis(firstAxes[i]);
+        testAxis(secondAxes[i]);
+        for (int j = 0; j < 3; j++)
+        {
+            Vector edgeAxis = firstAxes[i].vectorialProduct(secondAxes[j]);
+            if (edgeAxis.squaredMagnitude() < 0.000001f) continue;
+            testAxis(edgeAxis.normalized());
         }
     }
-    return true;
+    return separation;
 }
 
+/**
+ * \brief: Generic convex against convex test, GJK exits on the first separating direction and EPA only runs for
+ * overlapping pairs
+ * \return: True if the shapes overlap
+ */
+bool CollisionManager::convexConvex(RigidBody& first, RigidBody& second, Contact& contact)
+{
+    return GJK::penetration(first, second, contact.normal, contact.penetration, contact.point);
+}
 
-float CollisionManager::getRadius(Vector n, Box box)
+/**
+ * \brief: Test a body against each child of a compound with the kernel of their shape types, and keep the deepest
+ * contact. A compound against another one tests the children of both
+ * \param first : Any body
+ * \param second : A body with a CompoundShape, or the first body when both are compounds
+ * \return: True if a child overlaps the body
+ */
+bool CollisionManager::compound(RigidBody& first, RigidBody& second, Contact& contact)
 {
-    Vector xAxis = Vector(box.shape.getXAxis().x, box.shape.getXAxis().y, box.shape.getXAxis().z).
-            normalized();
-    Vector yAxis = Vector(box.shape.getYAxis().x, box.shape.getYAxis().y, box.shape.getYAxis().z).
-        normalized();
-    Vector zAxis = Vector(box.shape.getZAxis().x, box.shape.getZAxis().y, box.shape.getZAxis().z).
-        normalized();
-    
-    // Position of the full positive diagonal
-    Vector D1 = (xAxis * (box.getWidth() / 2) + yAxis * (box.getHeight() / 2) + zAxis * (box.
-        getDepth() / 2));
+    bool secondIsCompound = second.shapeType == CompoundShape;
+    Compound& parent = static_cast<Compound&>(secondIsCompound ? second : first);
+    RigidBody& other = secondIsCompound ? first : second;
+    AABB otherBounds = other.getBounds();
 
-    Vector D2 = (xAxis * (-box.getWidth() / 2) + yAxis * (box.getHeight() / 2) + zAxis * (-box.
-        getDepth() / 2));
+    bool found = false;
+    for (auto& child : parent.children)
+    {
+        Shape& part = *child.shape;
+        if (!part.getBounds().overlaps(otherBounds)) continue;
 
-    // Position of the full positive diagonal
-    Vector D3 = (xAxis * (box.getWidth() / 2) + yAxis * (box.getHeight() / 2) + zAxis * (-box.
-        getDepth() / 2));
+        // The kernels expect the smallest shape type first
+        Contact candidate;
+        bool partFirst = part.shapeType < other.shapeType;
+        bool hit = partFirst ? getKernel(part.shapeType, other.shapeType)(part, other, candidate)
+                             : getKernel(other.shapeType, part.shapeType)(other, part, candidate);
+        if (!hit || (found && candidate.penetration <= contact.penetration)) continue;
 
-    // Position of the full negative diagonal
-    Vector D4 = (xAxis * (-box.getWidth() / 2) + yAxis * (box.getHeight() / 2) + zAxis * (box.
-        getDepth() / 2));
+        // Normal from the other body towards the compound
+        Vector normal = partFirst ? candidate.normal.opposite() : candidate.normal;
+        contact.normal = secondIsCompound ? normal : normal.opposite();
+        contact.penetration = candidate.penetration;
+        contact.point = candidate.point;
+        found = true;
+    }
+    contact.first = &first;
+    contact.second = &second;
+    return found;
+}
 
-    Vector projectedPosition = box.position.projection(n);
-    auto radius = max(D1.projection(n).magnitude(), D2.projection(n).magnitude());
-    radius = max(radius, D3.projection(n).magnitude());
-    radius = max(radius, D4.projection(n).magnitude());
-    return radius;
+/**
+ * \brief : Push both bodies of a contact apart and apply the collision forces
+ * \param contact : The contact, with its normal pointing from the first body to the second
+ * \param delta_t : The duration of the step
+ */
+void CollisionManager::resolveContact(Contact& contact, float delta_t)
+{
+    resolveCollision(contact.point, contact.normal.opposite(), contact.penetration, *contact.first, *contact.second,
+                     delta_t);
+    resolveCollision(contact.point, contact.normal, contact.penetration, *contact.second, *contact.first, delta_t);
+}
+
+/**
+ * \brief : Push a body out of the static geometry, make it bounce and slow its sliding along the surface with the
+ * Coulomb friction of the pair of materials. The geometry does not move
+ * \param contact : The contact, with the body as first and the normal pointing into the geometry
+ */
+void CollisionManager::resolveStaticContact(Contact& contact)
+{
+    RigidBody& body = *contact.first;
+    body.position -= contact.normal * contact.penetration;
+
+    float approach = body.linearVelocity * contact.normal;
+    if (approach > 0)
+    {
+        MaterialPair material = MaterialTable::getPair(body.material, contact.staticMaterial);
+        Vector sliding = body.linearVelocity - contact.normal * approach;
+        float normalImpulse = (1 + material.restitution) * approach;
+        body.linearVelocity -= contact.normal * normalImpulse;
+
+        // The contact sticks while the friction needed stays below the static limit. Sliding friction can stop
+        // the body but never reverse its sliding
+        float slidingSpeed = sliding.magnitude();
+        if (slidingSpeed <= material.staticFriction * normalImpulse) body.linearVelocity -= sliding;
+        else body.linearVelocity -= sliding * (std::min(slidingSpeed, material.dynamicFriction * normalImpulse)
+                                               / slidingSpeed);
+    }
+    body.updateBounds();
+}
+
+/**
+ * \brief : Resolve the collision between two bodies
+ * \param applicationPoint : Point of collision
+ * \param n : Normal of the collision, in the direction the first body is pushed
+ * \param interpenetration : The penetration distance between the two bodies. Applied to move the objects
+ * \param first : The body moved by this call
+ * \param second: The other body
+ * \param delta_t : The duration of the step, the force cancels the velocity over it
+ */
+void CollisionManager::resolveCollision(Vector applicationPoint, Vector n, float interpenetration, RigidBody& first,
+                                        RigidBody& second, float delta_t)
+{
+
+    // Resolve the position
+    float K = first.getMass() / ( first.getMass() + second.getMass());
+    auto f= n * K * interpenetration;
+    first.position += n * K * interpenetration;
+    
+    // Apply the force
+    MaterialPair material = MaterialTable::getPair(first.material, second.material);
+    float duration = delta_t == 0.0f ? 1.0f / 60.0f : delta_t;
+    float intensity = ((first.linearVelocity.magnitude() > first.angularVelocity.magnitude() )? first.linearVelocity : first.angularVelocity).magnitude();
+    Vector force = n * (material.restitution * intensity / duration);
+    first.addForce(force, applicationPoint);
 
-}*/
\ No newline at end of file
+    // Friction against the sliding of the contact point on the other body, bounded by the normal force.
+    // Each body of the pair takes half of the change of velocity stopping the sliding
+    Vector relative = first.linearVelocity
+        + first.angularVelocity.vectorialProduct(applicationPoint - first.getWorldMassCenter())
+        - second.linearVelocity
+        - second.angularVelocity.vectorialProduct(applicationPoint - second.getWorldMassCenter());
+    Vector sliding = relative - n * (relative * n);
+    float slidingSpeed = sliding.magnitude();
+    if (slidingSpeed > 0)
+    {
+        float normalForce = force.magnitude();
+        float stopping = slidingSpeed / (2 * duration);
+        float friction = stopping <= material.staticFriction * normalForce
+                             ? stopping
+                             : std::min(stopping, material.dynamicFriction * normalForce);
+        first.addForce(sliding * (-friction / slidingSpeed), applicationPoint);
+    }
+}
@@ -2,19 +2,33 @@
 #include <utility>
 
 #include "Box.h"
+#include "Contact.h"
 #include "RigidBody.h"
 
 class Octree;
 
+// Narrow phase algorithm for one pair of shape types. It fills the contact and returns true when the bodies overlap
+typedef bool (*NarrowPhaseKernel)(RigidBody& first, RigidBody& second, Contact& contact);
+
+// Edge axes of the box-box SAT must beat face axes by this ratio to be kept, face contacts are more stable
+#define SAT_EDGE_BIAS 0.95f
+
 class CollisionManager
 {
 public:
     static std::vector<std::pair<RigidBody*, RigidBody*>> getNarrowCollision(
-    std::vector<std::pair<RigidBody*, RigidBody*>> collisions);
-    static std::vector<Vector> getCorners(Box& box);
-    static std::vector<Vector> getFaces(Box& box);
-    static void resolveCollision(Vector applicationPoint, Vector n, float interpenetration, Box& first, Box& second);
-    static bool intersect(Box& first, Box& second);
-    static float getRadius(Vector n, Box box);
-
+    std::vector<std::pair<RigidBody*, RigidBody*>> collisions, float delta_t);
+    static void sortByShapeType(std::vector<std::pair<RigidBody*, RigidBody*>>& collisions);
+    static NarrowPhaseKernel getKernel(ShapeType first, ShapeType second);
+    static bool sphereSphere(RigidBody& first, RigidBody& second, Contact& contact);
+    static bool sphereBox(RigidBody& first, RigidBody& second, Contact& contact);
+    static bool boxBox(RigidBody& first, RigidBody& second, Contact& contact);
+    static bool convexConvex(RigidBody& first, RigidBody& second, Contact& contact);
+    static bool compound(RigidBody& first, RigidBody& second, Contact& contact);
+    static float getBoxSeparation(Box& first, Vector firstPosition, Box& second, Vector secondPosition);
+    static float getBoxSeparation(Box& first, Vector firstPosition, Box& second, Vector secondPosition, Vector& axis);
+    static void resolveCollision(Vector applicationPoint, Vector n, float interpenetration, RigidBody& first,
+                                 RigidBody& second, float delta_t);
+    static void resolveContact(Contact& contact, float delta_t);
+    static void resolveStaticContact(Contact& contact);
 };
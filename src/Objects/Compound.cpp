@@ -0,0 +1,96 @@
+#include "Compound.h"
+
+#include "Material.h"
+
+Compound::Compound()
+{
+    shapeType = CompoundShape;
+    updateBounds();
+}
+
+Compound::~Compound()
+{
+    for (auto& child : children)
+    {
+        delete child.shape;
+    }
+}
+
+/**
+ * @brief Attach a shape to the compound, which takes its ownership. The mass properties are not updated
+ * @param shape The shape
+ * @param offset The position of the shape in the frame of the compound
+ * @param orientation The orientation of the shape in the frame of the compound
+ */
+void Compound::addChild(Shape* shape, Vector offset, Quaternion orientation)
+{
+    children.push_back({shape, offset, orientation});
+    colliderRadius = std::max(colliderRadius, offset.magnitude() + shape->colliderRadius);
+    updateBounds();
+}
+
+/**
+ * @brief Move the children to the world pose they have in the compound
+ */
+void Compound::updateChildren()
+{
+    Matrix rotation = orientation.quatToMat().transpose();
+    for (auto& child : children)
+    {
+        child.shape->position = position + rotation * child.offset;
+        child.shape->orientation = (orientation * child.orientation).normalize();
+        child.shape->linearVelocity = linearVelocity;
+        child.shape->angularVelocity = angularVelocity;
+        child.shape->updateBounds();
+    }
+}
+
+/**
+ * @brief Update the children, then enclose their boxes
+ */
+void Compound::updateBounds()
+{
+    updateChildren();
+    if (children.empty())
+    {
+        RigidBody::updateBounds();
+        return;
+    }
+    bounds = children[0].shape->getBounds();
+    for (size_t i = 1; i < children.size(); i++)
+    {
+        bounds = bounds.merge(children[i].shape->getBounds());
+    }
+}
+
+/**
+ * @brief Support function of the convex hull of the children, used against the static geometry and by the
+ * continuous collisions. The narrow phase between bodies tests each child instead
+ */
+Vector Compound::support(Vector direction)
+{
+    if (children.empty()) return RigidBody::support(direction);
+    Vector best = children[0].shape->support(direction);
+    for (size_t i = 1; i < children.size(); i++)
+    {
+        Vector point = children[i].shape->support(direction);
+        if (point * direction > best * direction) best = point;
+    }
+    return best;
+}
+
+/**
+ * @brief Combine the properties of the children, each with the density of its own material. The density of the
+ * compound is not used
+ */
+MassProperties Compound::computeMassProperties(float /*density*/)
+{
+    std::vector<MassProperties> parts;
+    parts.reserve(children.size());
+    for (auto& child : children)
+    {
+        float childDensity = MaterialTable::get(child.shape->material).density;
+        parts.push_back(child.shape->computeMassProperties(childDensity).transformed(child.orientation, child.offset));
+    }
+    return MassProperties::combine(parts);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+
+#include "Shape.h"
+
+/**
+ * @brief A body made of several shapes rigidly attached to it, such as a cluster of boxes that would otherwise be
+ * held together by joints. The children keep their own shape and material, and their position and orientation
+ * are kept in world space by updateBounds, so that the narrow phase tests each of them as a regular body
+ *
+ */
+class Compound : public Shape
+{
+public:
+    struct Child
+    {
+        // Owned
+        Shape* shape;
+        // Position and orientation in the frame of the compound
+        Vector offset;
+        Quaternion orientation;
+    };
+
+    std::vector<Child> children;
+
+    Compound();
+    ~Compound() override;
+
+    void addChild(Shape* shape, Vector offset, Quaternion orientation = Quaternion(1, 0, 0, 0));
+    void updateChildren();
+    void updateBounds() override;
+    Vector support(Vector direction) override;
+    MassProperties computeMassProperties(float density) override;
+};
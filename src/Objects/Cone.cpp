@@ -4,11 +4,11 @@ Cone::Cone()
 {
     this->radius = 1;
     this->height = 1;
-    this->shape = ofConePrimitive(radius, height, 20, 20);
-    this->tenseurJ.l1 = Vector((3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (3 * getMass() / 10) * glm::pow2(radius));
+    this->tenseurJ = MassProperties::cone(radius, height, 1).withMass(getMass()).inertia;
     this->inversedTenseurJ = tenseurJ.inverse();
+    colliderRadius = Vector(0, 0, 0).distance(Vector(radius, height / 2, 0));
+    shapeType = ConeShape;
+    updateBounds();
     RigidBody();
 }
 
@@ -16,11 +16,11 @@ Cone::Cone(float radius, float height)
 {
     this->radius = radius;
     this->height = height;
-    this->shape = ofConePrimitive(radius, height, 20, 20);
-    this->tenseurJ.l1 = Vector((3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (3 * getMass() / 10) * glm::pow2(radius));
+    this->tenseurJ = MassProperties::cone(radius, height, 1).withMass(getMass()).inertia;
     this->inversedTenseurJ = tenseurJ.inverse();
+    colliderRadius = Vector(0, 0, 0).distance(Vector(radius, height / 2, 0));
+    shapeType = ConeShape;
+    updateBounds();
     RigidBody();
 }
 
@@ -31,11 +31,11 @@ Cone::Cone(float radius, float height, int color[3])
     this->color[0] = color[0];
     this->color[1] = color[1];
     this->color[2] = color[2];
-    this->shape = ofConePrimitive(radius, height, 20, 20);
-    this->tenseurJ.l1 = Vector((3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (3 * getMass() / 10) * glm::pow2(radius));
+    this->tenseurJ = MassProperties::cone(radius, height, 1).withMass(getMass()).inertia;
     this->inversedTenseurJ = tenseurJ.inverse();
+    colliderRadius = Vector(0, 0, 0).distance(Vector(radius, height / 2, 0));
+    shapeType = ConeShape;
+    updateBounds();
 }
 
 Cone::Cone(float radius, float height, Vector translation)
@@ -45,12 +45,12 @@ Cone::Cone(float radius, float height, Vector translation)
     this->color[0] = color[0];
     this->color[1] = color[1];
     this->color[2] = color[2];
-    this->shape = ofConePrimitive(radius, height, 20, 20);
-    this->tenseurJ.l1 = Vector((3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (3 * getMass() / 10) * glm::pow2(radius));
+    this->tenseurJ = MassProperties::cone(radius, height, 1).withMass(getMass()).inertia;
     this->moveCenterMass(translation);
     this->inversedTenseurJ = tenseurJ.inverse();
+    colliderRadius = Vector(0, 0, 0).distance(Vector(radius, height / 2, 0));
+    shapeType = ConeShape;
+    updateBounds();
     RigidBody();
 }
 
@@ -62,25 +62,59 @@ Cone::Cone(float radius, float height, float gravity, Vector linearVelocity, Vec
     this->color[0] = color[0];
     this->color[1] = color[1];
     this->color[2] = color[2];
-    this->shape = ofConePrimitive(radius, height, 20, 20);
-    this->tenseurJ.l1 = Vector((3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0, 0);
-    this->tenseurJ.l2 = Vector(0, (3 * getMass() / 20) * (glm::pow2(radius) + glm::pow2(height) / 4), 0);
-    this->tenseurJ.l3 = Vector(0, 0, (3 * getMass() / 10) * glm::pow2(radius));
+    this->tenseurJ = MassProperties::cone(radius, height, 1).withMass(getMass()).inertia;
     this->inversedTenseurJ = tenseurJ.inverse();
+    colliderRadius = Vector(0, 0, 0).distance(Vector(radius, height / 2, 0));
+    shapeType = ConeShape;
+    updateBounds();
     RigidBody(gravity, linearVelocity, angularVelocity, linearAcceleration);
 }
 
-void Cone::draw()
+/**
+ * @brief Update the world space bounding box from the orientation of the cone. The box encloses
+ * the apex and the base disc, whose extent along a world axis is radius * sqrt(1 - axis^2)
+ *
+ */
+void Cone::updateBounds()
 {
-    // Draw the center of mass of the cone
-    Vector realCenter = orientation.applyRotation(massCenter, orientation);
-    ofSetColor(ofColor::yellow, 255);
-    ofDrawSphere((position + realCenter).v3(), 5);
+    // Like ofConePrimitive, the cone is along its local Y axis with the apex at -height/2
+    Vector axis = orientation.quatToMat().l2;
+    Vector apex = position - axis * (height / 2);
+    Vector baseCenter = position + axis * (height / 2);
 
-    // Draw the cone
-    ofSetColor(color[0], color[1], color[2], 150);
-    shape.setPosition(position.v3());
-    shape.setOrientation(orientation.q());
-    shape.draw();
-    ofSetColor(255, 255, 255);
+    Vector discExtents(radius * glm::sqrt(std::max(0.0f, 1 - glm::pow2(axis.x))),
+                       radius * glm::sqrt(std::max(0.0f, 1 - glm::pow2(axis.y))),
+                       radius * glm::sqrt(std::max(0.0f, 1 - glm::pow2(axis.z))));
+
+    bounds = AABB(baseCenter - discExtents, baseCenter + discExtents).merge(AABB(apex, apex));
+}
+
+/**
+ * @brief Support function of the cone: either the apex or the point of the base rim furthest in the direction
+ *
+ * @param direction The search direction
+ * @return The point of the cone with the largest projection on direction
+ */
+Vector Cone::support(Vector direction)
+{
+    Vector axis = orientation.quatToMat().l2;
+    Vector apex = position - axis * (height / 2);
+    Vector baseCenter = position + axis * (height / 2);
+
+    // Part of the direction in the plane of the base
+    Vector radial = direction - axis * (direction * axis);
+    Vector rim = baseCenter + radial.normalized() * radius;
+
+    return apex * direction > rim * direction ? apex : rim;
+}
+
+/**
+ * @brief Mass properties of the solid cone, whose center of mass is towards the base
+ *
+ * @param density The mass per unit of volume
+ * @return The properties, in the frame of the cone
+ */
+MassProperties Cone::computeMassProperties(float density)
+{
+    return MassProperties::cone(radius, height, density);
 }
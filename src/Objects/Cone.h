@@ -27,10 +27,7 @@ public:
         return height;
     }
 
-    /**
-* @brief Draw the cone
-*
-*/
-    void draw();
-    
+    void updateBounds() override;
+    MassProperties computeMassProperties(float density) override;
+    Vector support(Vector direction) override;
 };
@@ -0,0 +1,21 @@
+#pragma once
+#include "RigidBody.h"
+#include "Vector.h"
+
+/**
+ * @brief The result of a narrow phase test between two bodies
+ *
+ */
+struct Contact
+{
+    RigidBody* first = nullptr;
+    // Null when the first body touches static geometry
+    RigidBody* second = nullptr;
+    // Unit normal pointing from the first body towards the second
+    Vector normal;
+    float penetration = 0;
+    // World space contact point
+    Vector point;
+    // Material of the static geometry, when there is no second body
+    int staticMaterial = 0;
+};
@@ -0,0 +1,123 @@
+#include "ContinuousCollision.h"
+
+#include "CollisionManager.h"
+
+/**
+ * @brief Time of impact of a moving sphere with a plane. The sphere is expected on the side the normal points to
+ *
+ * @param center The center of the sphere at the start of the step
+ * @param radius The radius of the sphere
+ * @param displacement The motion of the center during the step
+ * @param planeNormal The unit normal of the plane, pointing to the free side
+ * @param planeOffset The plane contains the points x with planeNormal * x = planeOffset
+ * @param toi Set to the fraction of the displacement at which the sphere touches the plane
+ * @return True if the sphere reaches the plane during the step
+ */
+bool ContinuousCollision::sweptSpherePlane(Vector center, float radius, Vector displacement, Vector planeNormal,
+                                           float planeOffset, float& toi)
+{
+    float distance = planeNormal * center - planeOffset - radius;
+    float approach = -(planeNormal * displacement);
+    if (distance < 0 || approach <= 0 || distance >= approach) return false;
+
+    toi = distance / approach;
+    return true;
+}
+
+/**
+ * @brief Time of impact of a translating body with a plane, the orientation is kept during the step.
+ * The extent of the body towards the plane comes from its support function, so boxes and cones touch with their
+ * real shape instead of their collider sphere
+ *
+ * @return True if the body reaches the plane during the step
+ */
+bool ContinuousCollision::sweptShapePlane(RigidBody& body, Vector displacement, Vector planeNormal,
+                                          float planeOffset, float& toi)
+{
+    float extent = planeNormal * (body.position - body.support(planeNormal.opposite()));
+    return sweptSpherePlane(body.position, extent, displacement, planeNormal, planeOffset, toi);
+}
+
+/**
+ * @brief Time of impact of two moving spheres, from the first root of |relative position + t * relative motion| = radii
+ *
+ * @return True if the spheres start apart and touch during the step
+ */
+bool ContinuousCollision::sweptSphereSphere(Vector firstCenter, float firstRadius, Vector firstDisplacement,
+                                            Vector secondCenter, float secondRadius, Vector secondDisplacement,
+                                            float& toi)
+{
+    Vector offset = secondCenter - firstCenter;
+    Vector motion = secondDisplacement - firstDisplacement;
+    float radii = firstRadius + secondRadius;
+
+    float a = motion * motion;
+    float b = 2 * (offset * motion);
+    float c = offset * offset - radii * radii;
+    // Already overlapping, or no relative motion
+    if (c < 0 || a == 0) return false;
+
+    float discriminant = b * b - 4 * a * c;
+    if (discriminant < 0) return false;
+
+    float t = (-b - glm::sqrt(discriminant)) / (2 * a);
+    if (t < 0 || t > 1) return false;
+
+    toi = t;
+    return true;
+}
+
+/**
+ * @brief Time of impact of two translating oriented boxes by conservative advancement.
+ * The largest SAT separation is a lower bound of the distance between the boxes, so moving both boxes by this
+ * distance over their relative speed can never make them cross
+ *
+ * @return True if the boxes start apart and touch during the step. Boxes starting in contact only have an impact
+ * if they are closing
+ */
+bool ContinuousCollision::conservativeAdvancement(Box& first, Vector firstDisplacement, Box& second,
+                                                  Vector secondDisplacement, float& toi)
+{
+    Vector motion = secondDisplacement - firstDisplacement;
+    float speed = motion.magnitude();
+    if (speed == 0) return false;
+
+    float t = 0;
+    Vector axis;
+    for (int i = 0; i < CCD_MAX_ITERATIONS; i++)
+    {
+        float separation = CollisionManager::getBoxSeparation(first, first.position + firstDisplacement * t,
+                                                              second, second.position + secondDisplacement * t, axis);
+        if (separation < CCD_TOLERANCE)
+        {
+            // Overlapping pairs are left to the discrete narrow phase, and resting pairs that move apart are free
+            if (i == 0 && (separation < 0 || motion * axis >= 0)) return false;
+            toi = t;
+            return true;
+        }
+
+        t += separation / speed;
+        if (t > 1) return false;
+    }
+    // Not converged, the current time is still a safe one
+    toi = t;
+    return true;
+}
+
+/**
+ * @brief Time of impact of two moving bodies. Boxes use conservative advancement on their real shape, the other
+ * shapes are swept as their collider sphere
+ *
+ * @return True if the bodies touch during the step
+ */
+bool ContinuousCollision::timeOfImpact(RigidBody& first, Vector firstDisplacement, RigidBody& second,
+                                       Vector secondDisplacement, float& toi)
+{
+    if (first.shapeType == BoxShape && second.shapeType == BoxShape)
+    {
+        return conservativeAdvancement(static_cast<Box&>(first), firstDisplacement, static_cast<Box&>(second),
+                                       secondDisplacement, toi);
+    }
+    return sweptSphereSphere(first.position, first.colliderRadius, firstDisplacement, second.position,
+                             second.colliderRadius, secondDisplacement, toi);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "Box.h"
+#include "RigidBody.h"
+#include "Vector.h"
+
+#define CCD_MAX_ITERATIONS 32
+// Conservative advancement stops once the bodies are closer than this distance
+#define CCD_TOLERANCE 0.01f
+
+/**
+ * @brief Time of impact queries for bodies moving during a step, to prevent fast bodies from tunnelling.
+ * Times of impact are fractions of the step displacement, between 0 and 1. Pairs already overlapping at the
+ * start of the step are left to the discrete narrow phase
+ *
+ */
+class ContinuousCollision
+{
+public:
+    static bool sweptSpherePlane(Vector center, float radius, Vector displacement, Vector planeNormal,
+                                 float planeOffset, float& toi);
+    static bool sweptShapePlane(RigidBody& body, Vector displacement, Vector planeNormal, float planeOffset,
+                                float& toi);
+    static bool sweptSphereSphere(Vector firstCenter, float firstRadius, Vector firstDisplacement,
+                                  Vector secondCenter, float secondRadius, Vector secondDisplacement, float& toi);
+    static bool conservativeAdvancement(Box& first, Vector firstDisplacement, Box& second,
+                                        Vector secondDisplacement, float& toi);
+    static bool timeOfImpact(RigidBody& first, Vector firstDisplacement, RigidBody& second,
+                             Vector secondDisplacement, float& toi);
+};
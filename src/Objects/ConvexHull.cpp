@@ -0,0 +1,200 @@
+#include "ConvexHull.h"
+
+#include "QuickHull.h"
+
+/**
+ * @brief Build the hull of a point cloud. If the points are all on a plane the hull is not valid, and the body
+ * is a point
+ * @param points The cloud, in the frame of the body
+ * @param maxVertices Vertices of the hull at most. 0 for no limit
+ */
+ConvexHull::ConvexHull(const std::vector<Vector>& points, int maxVertices)
+{
+    build(points, maxVertices, true);
+}
+
+/**
+ * @brief Build a hull again from its vertices, such as the ones of a snapshot. The vertices are kept as they are
+ * instead of being centered again, which would move them by the rounding errors of the center of mass
+ * @param vertices The vertices of a hull, in the frame of the body
+ * @param cloudOrigin The origin of the cloud the hull was first built from, in the frame of the body
+ */
+ConvexHull::ConvexHull(const std::vector<Vector>& vertices, Vector cloudOrigin)
+{
+    build(vertices, 0, false);
+    this->cloudOrigin = cloudOrigin;
+}
+
+/**
+ * @brief Compute the faces and the neighbours of the vertices of the hull of a point cloud
+ * @param center Whether to move the hull so that its center of mass is at the origin
+ */
+void ConvexHull::build(const std::vector<Vector>& points, int maxVertices, bool center)
+{
+    shapeType = ConvexHullShape;
+    QuickHull builder;
+    if (!builder.build(points, maxVertices))
+    {
+        updateBounds();
+        return;
+    }
+
+    MassProperties properties = MassProperties::polyhedron(builder.vertices, builder.triangles, 1);
+    cloudOrigin = center ? properties.centerOfMass.opposite() : Vector(0, 0, 0);
+    vertices = builder.vertices;
+    triangles = builder.triangles;
+    colliderRadius = 0;
+    for (auto& vertex : vertices)
+    {
+        vertex += cloudOrigin;
+        colliderRadius = std::max(colliderRadius, vertex.magnitude());
+    }
+
+    for (size_t i = 0; i < triangles.size(); i += 3)
+    {
+        Vector origin = vertices[triangles[i]];
+        Vector normal = (vertices[triangles[i + 1]] - origin).vectorialProduct(vertices[triangles[i + 2]] - origin);
+        faceNormals.push_back(normal.normalized());
+        faceOffsets.push_back(faceNormals.back() * origin);
+    }
+
+    // Each edge is in two faces, once in each direction: the directed edges give every neighbour once
+    neighbourStart.assign(vertices.size() + 1, 0);
+    for (int vertex : triangles)
+    {
+        neighbourStart[vertex + 1]++;
+    }
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        neighbourStart[i + 1] += neighbourStart[i];
+    }
+    neighbours.resize(triangles.size());
+    std::vector<int> filled(neighbourStart.begin(), neighbourStart.end() - 1);
+    for (size_t i = 0; i < triangles.size(); i += 3)
+    {
+        for (int e = 0; e < 3; e++)
+        {
+            neighbours[filled[triangles[i + e]]++] = triangles[i + (e + 1) % 3];
+        }
+    }
+
+    this->tenseurJ = properties.withMass(getMass()).inertia;
+    this->inversedTenseurJ = tenseurJ.inverse();
+    updateBounds();
+}
+
+/**
+ * @return False if the hull could not be built
+ */
+bool ConvexHull::isValid()
+{
+    return !vertices.empty();
+}
+
+/**
+ * @brief Find the vertex furthest in a direction by hill climbing: move to a better neighbour until there is none
+ * @param localDirection The direction, in the frame of the body
+ * @param start The vertex to climb from, a previous result speeds up close directions
+ * @return The index of the vertex
+ */
+int ConvexHull::getSupportVertex(Vector localDirection, int start)
+{
+    int best = start;
+    float bestProjection = localDirection * vertices[best];
+    if (vertices.size() < HULL_CLIMB_MIN_VERTICES)
+    {
+        for (int i = 0; i < static_cast<int>(vertices.size()); i++)
+        {
+            float projection = localDirection * vertices[i];
+            if (projection > bestProjection)
+            {
+                best = i;
+                bestProjection = projection;
+            }
+        }
+        return best;
+    }
+
+    bool climbed = true;
+    while (climbed)
+    {
+        climbed = false;
+        for (int i = neighbourStart[best]; i < neighbourStart[best + 1]; i++)
+        {
+            float projection = localDirection * vertices[neighbours[i]];
+            if (projection > bestProjection)
+            {
+                best = neighbours[i];
+                bestProjection = projection;
+                climbed = true;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @param point A point in world space
+ * @return True if the point is inside the hull or on its boundary, from the face planes
+ */
+bool ConvexHull::contains(Vector point)
+{
+    if (!isValid()) return false;
+    Vector local = orientation.quatToMat() * (point - position);
+    for (size_t i = 0; i < faceNormals.size(); i++)
+    {
+        if (faceNormals[i] * local > faceOffsets[i] + HULL_TOLERANCE * colliderRadius) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Update the world space bounding box from the support points along the world axes
+ *
+ */
+void ConvexHull::updateBounds()
+{
+    if (!isValid())
+    {
+        RigidBody::updateBounds();
+        return;
+    }
+    // The columns of the rotation matrix are the world axes in the frame of the body
+    Matrix rotation = orientation.quatToMat();
+    Matrix toWorld = rotation.transpose();
+    Vector minCorner;
+    Vector maxCorner;
+    float* minimums[3] = {&minCorner.x, &minCorner.y, &minCorner.z};
+    float* maximums[3] = {&maxCorner.x, &maxCorner.y, &maxCorner.z};
+    Vector axes[3] = {toWorld.l1, toWorld.l2, toWorld.l3};
+    for (int axis = 0; axis < 3; axis++)
+    {
+        *maximums[axis] = axes[axis] * vertices[getSupportVertex(axes[axis])];
+        *minimums[axis] = axes[axis] * vertices[getSupportVertex(axes[axis].opposite())];
+    }
+    bounds = AABB(position + minCorner, position + maxCorner);
+}
+
+/**
+ * @brief Support function of the hull: the vertex furthest in the given direction
+ *
+ * @param direction The search direction
+ * @return The vertex of the hull with the largest projection on direction
+ */
+Vector ConvexHull::support(Vector direction)
+{
+    if (!isValid()) return position;
+    Matrix rotation = orientation.quatToMat();
+    return position + rotation.transpose() * vertices[getSupportVertex(rotation * direction)];
+}
+
+/**
+ * @brief Mass properties of the solid hull
+ *
+ * @param density The mass per unit of volume
+ * @return The properties, in the frame of the hull
+ */
+MassProperties ConvexHull::computeMassProperties(float density)
+{
+    return MassProperties::polyhedron(vertices, triangles, density);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+
+#include "Shape.h"
+
+// Default limit of the vertices kept from a point cloud
+#define HULL_MAX_VERTICES 64
+// Below this many vertices, the support function tests every vertex instead of climbing the edges
+#define HULL_CLIMB_MIN_VERTICES 16
+
+/**
+ * @brief A convex polyhedron built from a point cloud with quickhull, for convex pieces that boxes approximate
+ * badly. The hull is moved so that its center of mass is at the position of the body.
+ * Each vertex keeps its neighbours along the edges: a linear function has no local maximum on a convex polyhedron,
+ * so the support function climbs from vertex to vertex instead of testing all of them
+ *
+ */
+class ConvexHull : public Shape
+{
+private:
+    void build(const std::vector<Vector>& points, int maxVertices, bool center);
+
+public:
+    // In the frame of the body
+    std::vector<Vector> vertices;
+    // Three vertex indices per face, counterclockwise seen from outside
+    std::vector<int> triangles;
+    // Outward unit normal of each face, and its offset: normal * point = offset on the face
+    std::vector<Vector> faceNormals;
+    std::vector<float> faceOffsets;
+    // The neighbours of vertex i are neighbours[neighbourStart[i]] up to neighbours[neighbourStart[i + 1]] excluded
+    std::vector<int> neighbourStart;
+    std::vector<int> neighbours;
+    // Where the points given to the constructor had their origin, in the frame of the body
+    Vector cloudOrigin;
+
+    ConvexHull(const std::vector<Vector>& points, int maxVertices = HULL_MAX_VERTICES);
+    ConvexHull(const std::vector<Vector>& vertices, Vector cloudOrigin);
+
+    bool isValid();
+    int getSupportVertex(Vector localDirection, int start = 0);
+    bool contains(Vector point);
+    void updateBounds() override;
+    Vector support(Vector direction) override;
+    MassProperties computeMassProperties(float density) override;
+};
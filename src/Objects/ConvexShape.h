@@ -0,0 +1,18 @@
+#pragma once
+#include "Vector.h"
+
+/**
+ * @brief An abstract class for convex shapes described by their support function, as used by GJK and EPA
+ *
+ */
+class ConvexShape
+{
+public:
+    /**
+     * @brief Get the furthest point of the shape in a direction
+     *
+     * @param direction The direction to search in (does not need to be normalized)
+     * @return The world space point of the shape with the largest projection on direction
+     */
+    virtual Vector support(Vector direction) = 0;
+};
@@ -0,0 +1,677 @@
+#include "GJK.h"
+
+/**
+ * @brief Add a point in front of the simplex, dropping the oldest one if it is full
+ * @param point The new support point
+ */
+void Simplex::pushFront(SupportPoint point)
+{
+    for (int i = std::min(size, 3); i > 0; i--) points[i] = points[i - 1];
+    points[0] = point;
+    size = std::min(size + 1, 4);
+}
+
+/**
+ * @brief Get the support point of the Minkowski difference first - second
+ * @param first The first shape
+ * @param second The second shape
+ * @param direction The search direction
+ * @return The support point, with the points of each shape that produced it
+ */
+SupportPoint GJK::support(ConvexShape& first, ConvexShape& second, Vector direction)
+{
+    SupportPoint result;
+    result.onFirst = first.support(direction);
+    result.onSecond = second.support(direction.opposite());
+    result.point = result.onFirst - result.onSecond;
+    return result;
+}
+
+/**
+ * @brief Check if two convex shapes overlap. Exits as soon as a separating direction is found
+ * @param first The first shape
+ * @param second The second shape
+ * @return True if the shapes overlap
+ */
+bool GJK::intersect(ConvexShape& first, ConvexShape& second)
+{
+    Simplex simplex;
+    return intersect(first, second, simplex);
+}
+
+/**
+ * @brief Check if two convex shapes overlap
+ * @param first The first shape
+ * @param second The second shape
+ * @param simplex Receives the last simplex, a tetrahedron enclosing the origin when the shapes overlap
+ * @return True if the shapes overlap
+ */
+bool GJK::intersect(ConvexShape& first, ConvexShape& second, Simplex& simplex)
+{
+    SupportPoint point = support(first, second, Vector(1, 0, 0));
+    simplex.size = 0;
+    simplex.pushFront(point);
+    Vector direction = point.point.opposite();
+
+    for (int i = 0; i < GJK_MAX_ITERATIONS; i++)
+    {
+        // The origin lies on the simplex: the shapes are touching
+        if (direction.squaredMagnitude() < FLT_EPSILON) return true;
+
+        point = support(first, second, direction);
+        // The new point did not pass the origin, so direction separates the shapes
+        if (point.point * direction < 0) return false;
+
+        simplex.pushFront(point);
+        if (nextSimplex(simplex, direction)) return true;
+    }
+    return false;
+}
+
+bool GJK::sameDirection(Vector direction, Vector other)
+{
+    return direction * other > 0;
+}
+
+/**
+ * @brief Reduce the simplex to the feature closest to the origin and update the search direction
+ * @return True if the simplex encloses the origin
+ */
+bool GJK::nextSimplex(Simplex& simplex, Vector& direction)
+{
+    switch (simplex.size)
+    {
+    case 2: return line(simplex, direction);
+    case 3: return triangle(simplex, direction);
+    case 4: return tetrahedron(simplex, direction);
+    default: return false;
+    }
+}
+
+bool GJK::line(Simplex& simplex, Vector& direction)
+{
+    Vector a = simplex.points[0].point;
+    Vector b = simplex.points[1].point;
+    Vector ab = b - a;
+    Vector ao = a.opposite();
+
+    if (sameDirection(ab, ao))
+    {
+        direction = ab.vectorialProduct(ao).vectorialProduct(ab);
+    }
+    else
+    {
+        simplex.size = 1;
+        direction = ao;
+    }
+    return false;
+}
+
+bool GJK::triangle(Simplex& simplex, Vector& direction)
+{
+    SupportPoint a = simplex.points[0];
+    SupportPoint b = simplex.points[1];
+    SupportPoint c = simplex.points[2];
+    Vector ab = b.point - a.point;
+    Vector ac = c.point - a.point;
+    Vector ao = a.point.opposite();
+    Vector abc = ab.vectorialProduct(ac);
+
+    if (sameDirection(abc.vectorialProduct(ac), ao))
+    {
+        if (sameDirection(ac, ao))
+        {
+            simplex.points[1] = c;
+            simplex.size = 2;
+            direction = ac.vectorialProduct(ao).vectorialProduct(ac);
+            return false;
+        }
+        simplex.size = 2;
+        return line(simplex, direction);
+    }
+
+    if (sameDirection(ab.vectorialProduct(abc), ao))
+    {
+        simplex.size = 2;
+        return line(simplex, direction);
+    }
+
+    if (sameDirection(abc, ao))
+    {
+        direction = abc;
+    }
+    else
+    {
+        // The origin is below the triangle, flip its winding so that abc faces it
+        simplex.points[1] = c;
+        simplex.points[2] = b;
+        direction = abc.opposite();
+    }
+    return false;
+}
+
+bool GJK::tetrahedron(Simplex& simplex, Vector& direction)
+{
+    SupportPoint a = simplex.points[0];
+    SupportPoint b = simplex.points[1];
+    SupportPoint c = simplex.points[2];
+    SupportPoint d = simplex.points[3];
+    Vector ab = b.point - a.point;
+    Vector ac = c.point - a.point;
+    Vector ad = d.point - a.point;
+    Vector ao = a.point.opposite();
+
+    Vector abc = ab.vectorialProduct(ac);
+    Vector acd = ac.vectorialProduct(ad);
+    Vector adb = ad.vectorialProduct(ab);
+
+    if (sameDirection(abc, ao))
+    {
+        simplex.size = 3;
+        return triangle(simplex, direction);
+    }
+    if (sameDirection(acd, ao))
+    {
+        simplex.points[1] = c;
+        simplex.points[2] = d;
+        simplex.size = 3;
+        return triangle(simplex, direction);
+    }
+    if (sameDirection(adb, ao))
+    {
+        simplex.points[1] = d;
+        simplex.points[2] = b;
+        simplex.size = 3;
+        return triangle(simplex, direction);
+    }
+    return true;
+}
+
+/**
+ * @brief GJK stops as soon as the origin is on its simplex, which may then be a point, a segment or a triangle.
+ * EPA needs a tetrahedron, so new support points are added around the simplex
+ * @return False if the Minkowski difference is flat, in which case there is no penetration to find
+ */
+bool GJK::completeSimplex(ConvexShape& first, ConvexShape& second, Simplex& simplex)
+{
+    if (simplex.size == 1)
+    {
+        Vector axes[6] = {Vector(1, 0, 0), Vector(-1, 0, 0), Vector(0, 1, 0),
+                          Vector(0, -1, 0), Vector(0, 0, 1), Vector(0, 0, -1)};
+        for (auto axis : axes)
+        {
+            SupportPoint point = support(first, second, axis);
+            if (point.point.distance(simplex.points[0].point) > GJK_DEGENERATE_EPSILON)
+            {
+                simplex.pushFront(point);
+                break;
+            }
+        }
+        if (simplex.size == 1) return false;
+    }
+
+    if (simplex.size == 2)
+    {
+        // Search perpendicularly to the segment, starting from the world axis least aligned with it
+        Vector line = (simplex.points[0].point - simplex.points[1].point).normalized();
+        Vector axis = Vector(1, 0, 0);
+        if (glm::abs(line.y) < glm::abs(line.x) && glm::abs(line.y) <= glm::abs(line.z)) axis = Vector(0, 1, 0);
+        else if (glm::abs(line.z) < glm::abs(line.x)) axis = Vector(0, 0, 1);
+        Vector perpendicular = line.vectorialProduct(axis);
+        Vector directions[4] = {perpendicular, perpendicular.opposite(), line.vectorialProduct(perpendicular),
+                                line.vectorialProduct(perpendicular).opposite()};
+
+        for (auto direction : directions)
+        {
+            SupportPoint point = support(first, second, direction);
+            Vector offset = point.point - simplex.points[1].point;
+            if ((offset - offset.projection(line)).magnitude() > GJK_DEGENERATE_EPSILON)
+            {
+                simplex.pushFront(point);
+                break;
+            }
+        }
+        if (simplex.size == 2) return false;
+    }
+
+    if (simplex.size == 3)
+    {
+        Vector normal = (simplex.points[1].point - simplex.points[0].point)
+                        .vectorialProduct(simplex.points[2].point - simplex.points[0].point).normalized();
+        SupportPoint point = support(first, second, normal);
+        if (glm::abs(normal * (point.point - simplex.points[0].point)) <= GJK_DEGENERATE_EPSILON)
+        {
+            point = support(first, second, normal.opposite());
+            if (glm::abs(normal * (point.point - simplex.points[0].point)) <= GJK_DEGENERATE_EPSILON) return false;
+        }
+        simplex.pushFront(point);
+    }
+    return true;
+}
+
+/**
+ * @brief Compute the outward normals of polytope faces and their distances to the origin
+ * @param center A point inside the polytope, used to orient the normals outwards
+ * @return The index of the face closest to the origin, among the ones from firstFace
+ */
+static int computeFaceNormals(std::vector<SupportPoint>& polytope, std::vector<int>& faces, int firstFace,
+                              Vector center, std::vector<Vector>& normals, std::vector<float>& distances)
+{
+    int minFace = -1;
+    float minDistance = FLT_MAX;
+    for (int i = firstFace; i < static_cast<int>(faces.size()) / 3; i++)
+    {
+        Vector a = polytope[faces[i * 3]].point;
+        Vector b = polytope[faces[i * 3 + 1]].point;
+        Vector c = polytope[faces[i * 3 + 2]].point;
+
+        Vector normal = (b - a).vectorialProduct(c - a).normalized();
+        if (normal * (a - center) < 0) normal = normal.opposite();
+        float distance = normal * a;
+        // A degenerate face can not be the closest one
+        if (normal.squaredMagnitude() == 0) distance = FLT_MAX;
+
+        normals.push_back(normal);
+        distances.push_back(distance);
+        if (distance < minDistance)
+        {
+            minDistance = distance;
+            minFace = i;
+        }
+    }
+    return minFace;
+}
+
+/**
+ * @brief Keep the edges on the horizon of the removed faces: an edge shared by two removed faces is dropped
+ */
+static void addUniqueEdge(std::vector<std::pair<int, int>>& edges, int a, int b)
+{
+    for (auto edge = edges.begin(); edge != edges.end(); ++edge)
+    {
+        if (edge->first == b && edge->second == a)
+        {
+            edges.erase(edge);
+            return;
+        }
+    }
+    edges.emplace_back(a, b);
+}
+
+/**
+ * @brief Find the penetration of two convex shapes with GJK, then expand the GJK simplex with EPA
+ * @param first The first shape
+ * @param second The second shape
+ * @param normal Receives the unit normal pointing from first towards second
+ * @param depth Receives the penetration depth along normal
+ * @param point Receives the contact point, between the deepest points of both shapes
+ * @return True if the shapes overlap with a non zero depth
+ */
+bool GJK::penetration(ConvexShape& first, ConvexShape& second, Vector& normal, float& depth, Vector& point)
+{
+    Simplex simplex;
+    if (!intersect(first, second, simplex)) return false;
+    if (!completeSimplex(first, second, simplex)) return false;
+
+    std::vector<SupportPoint> polytope(simplex.points, simplex.points + 4);
+    std::vector<int> faces = {0, 1, 2, 0, 3, 1, 0, 2, 3, 1, 3, 2};
+    std::vector<Vector> normals;
+    std::vector<float> distances;
+    // The polytope stays convex while it grows, so its first centroid always remains inside
+    Vector center = (polytope[0].point + polytope[1].point + polytope[2].point + polytope[3].point) * 0.25f;
+    int minFace = computeFaceNormals(polytope, faces, 0, center, normals, distances);
+    if (minFace < 0) return false;
+
+    std::vector<std::pair<int, int>> edges;
+    for (int iteration = 0; iteration < EPA_MAX_ITERATIONS; iteration++)
+    {
+        Vector minNormal = normals[minFace];
+        SupportPoint newPoint = support(first, second, minNormal);
+        // The face is on the boundary of the Minkowski difference
+        if (minNormal * newPoint.point - distances[minFace] < EPA_TOLERANCE) break;
+
+        // Remove the faces that can see the new point and keep their horizon
+        edges.clear();
+        for (int i = 0; i < static_cast<int>(normals.size()); i++)
+        {
+            if (sameDirection(normals[i], newPoint.point - polytope[faces[i * 3]].point))
+            {
+                addUniqueEdge(edges, faces[i * 3], faces[i * 3 + 1]);
+                addUniqueEdge(edges, faces[i * 3 + 1], faces[i * 3 + 2]);
+                addUniqueEdge(edges, faces[i * 3 + 2], faces[i * 3]);
+
+                int last = static_cast<int>(normals.size()) - 1;
+                faces[i * 3] = faces[last * 3];
+                faces[i * 3 + 1] = faces[last * 3 + 1];
+                faces[i * 3 + 2] = faces[last * 3 + 2];
+                faces.resize(last * 3);
+                normals[i] = normals[last];
+                normals.pop_back();
+                distances[i] = distances[last];
+                distances.pop_back();
+                i--;
+            }
+        }
+
+        // Close the polytope with faces from the horizon to the new point
+        int firstNewFace = static_cast<int>(normals.size());
+        for (auto edge : edges)
+        {
+            faces.push_back(edge.first);
+            faces.push_back(edge.second);
+            faces.push_back(static_cast<int>(polytope.size()));
+        }
+        polytope.push_back(newPoint);
+        computeFaceNormals(polytope, faces, firstNewFace, center, normals, distances);
+
+        minFace = -1;
+        float minDistance = FLT_MAX;
+        for (int i = 0; i < static_cast<int>(distances.size()); i++)
+        {
+            if (distances[i] < minDistance)
+            {
+                minDistance = distances[i];
+                minFace = i;
+            }
+        }
+        if (minFace < 0) return false;
+    }
+
+    normal = normals[minFace];
+    depth = distances[minFace];
+    if (depth <= 0) return false;
+
+    // Barycentric coordinates of the projection of the origin on the closest face
+    SupportPoint a = polytope[faces[minFace * 3]];
+    SupportPoint b = polytope[faces[minFace * 3 + 1]];
+    SupportPoint c = polytope[faces[minFace * 3 + 2]];
+    Vector v0 = b.point - a.point;
+    Vector v1 = c.point - a.point;
+    Vector v2 = normal * depth - a.point;
+    float d00 = v0 * v0;
+    float d01 = v0 * v1;
+    float d11 = v1 * v1;
+    float d20 = v2 * v0;
+    float d21 = v2 * v1;
+    float denominator = d00 * d11 - d01 * d01;
+
+    Vector onFirst = a.onFirst;
+    Vector onSecond = a.onSecond;
+    if (glm::abs(denominator) > FLT_EPSILON)
+    {
+        float v = (d11 * d20 - d01 * d21) / denominator;
+        float w = (d00 * d21 - d01 * d20) / denominator;
+        float u = 1 - v - w;
+        onFirst = a.onFirst * u + b.onFirst * v + c.onFirst * w;
+        onSecond = a.onSecond * u + b.onSecond * v + c.onSecond * w;
+    }
+    point = (onFirst + onSecond) * 0.5f;
+    return true;
+}
+
+/**
+ * @brief Cast a ray, or a sphere when the radius is positive, against a convex shape with the GJK ray cast of
+ * van den Bergen. The ray advances to the plane given by each new support point that separates it from the shape,
+ * and stops once GJK finds its point touching the shape
+ * @param shape The shape
+ * @param origin The start of the ray
+ * @param direction The unit direction of the ray
+ * @param radius The radius of the cast sphere, 0 for a ray
+ * @param maxDistance The length of the ray
+ * @param distance Receives the distance along the ray of the first contact, 0 if the ray starts inside
+ * @param normal Receives the unit normal of the shape at the contact, against the ray if it starts inside
+ * @return True if the shape is hit within maxDistance
+ */
+bool GJK::raycast(ConvexShape& shape, Vector origin, Vector direction, float radius, float maxDistance,
+                  float& distance, Vector& normal)
+{
+    float lambda = 0;
+    Vector position = origin;
+    Vector hitNormal(0, 0, 0);
+    // Points of the shape whose differences with the ray point form the simplex
+    Vector sources[4];
+    Vector points[4];
+    int size = 0;
+    Vector v = position - shape.support(direction);
+
+    for (int i = 0; i < RAYCAST_MAX_ITERATIONS && v.squaredMagnitude() > RAYCAST_TOLERANCE * RAYCAST_TOLERANCE; i++)
+    {
+        // Support point of the shape grown by the radius
+        Vector source = shape.support(v) + v.normalized() * radius;
+        Vector w = position - source;
+        if (v * w > 0)
+        {
+            // The plane through the support point separates the ray point: move to it, or miss if moving away
+            float approach = v * direction;
+            if (approach >= 0) return false;
+            lambda -= (v * w) / approach;
+            if (lambda > maxDistance) return false;
+            position = origin + direction * lambda;
+            hitNormal = v;
+        }
+
+        bool known = false;
+        for (int j = 0; j < size; j++)
+        {
+            known = known || (sources[j] - source).squaredMagnitude() < GJK_DEGENERATE_EPSILON * GJK_DEGENERATE_EPSILON;
+        }
+        if (!known) sources[size++] = source;
+        for (int j = 0; j < size; j++)
+        {
+            points[j] = position - sources[j];
+        }
+        v = closestPoint(points, sources, size);
+        // Inside the grown shape, the ray started in it or reached it
+        if (size == 4) break;
+    }
+    if (v.squaredMagnitude() > 100 * RAYCAST_TOLERANCE * RAYCAST_TOLERANCE && size < 4) return false;
+
+    distance = lambda;
+    normal = lambda > 0 ? hitNormal.normalized() : direction.opposite();
+    // The planes of a rounded shape only approach its normal, the direction to the closest point of the core is exact
+    if (radius > 0 && lambda > 0)
+    {
+        Vector offset = closestOffset(shape, position);
+        if (offset.squaredMagnitude() > 0) normal = offset.normalized();
+    }
+    return true;
+}
+
+/**
+ * @brief Run GJK for the distance between a point and a convex shape
+ * @return The offset from the closest point of the shape to the point, zero if the point is inside
+ */
+Vector GJK::closestOffset(ConvexShape& shape, Vector point)
+{
+    Vector sources[4];
+    Vector points[4];
+    int size = 0;
+    Vector v = point - shape.support(Vector(1, 0, 0));
+    for (int i = 0; i < GJK_MAX_ITERATIONS && size < 4 && v.squaredMagnitude() > 0; i++)
+    {
+        Vector source = shape.support(v);
+        Vector w = point - source;
+        // No support point gets closer than the current one
+        if (v * v - v * w <= GJK_DEGENERATE_EPSILON * v.magnitude()) break;
+        sources[size++] = source;
+        for (int j = 0; j < size; j++)
+        {
+            points[j] = point - sources[j];
+        }
+        v = closestPoint(points, sources, size);
+    }
+    return size == 4 ? Vector(0, 0, 0) : v;
+}
+
+/**
+ * @brief Find the point of a simplex closest to the origin, and reduce it to the feature holding this point
+ * @param points The vertices of the simplex, reduced in place
+ * @param sources Kept in the same order as the points
+ * @param size The number of vertices, 4 is left unchanged if the tetrahedron contains the origin
+ * @return The closest point
+ */
+Vector GJK::closestPoint(Vector* points, Vector* sources, int& size)
+{
+    if (size == 1) return points[0];
+    if (size == 2)
+    {
+        Vector ab = points[1] - points[0];
+        float t = -(points[0] * ab) / std::max(ab.squaredMagnitude(), FLT_EPSILON);
+        if (t <= 0)
+        {
+            size = 1;
+            return points[0];
+        }
+        if (t >= 1)
+        {
+            points[0] = points[1];
+            sources[0] = sources[1];
+            size = 1;
+            return points[0];
+        }
+        return points[0] + ab * t;
+    }
+    if (size == 3) return closestOnTriangle(points, sources, size);
+
+    // Tetrahedron: the closest point is on one of the faces the origin is in front of
+    static const int faces[4][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+    Vector best(0, 0, 0);
+    float bestDistance = FLT_MAX;
+    Vector bestPoints[3];
+    Vector bestSources[3];
+    int bestSize = 4;
+    for (auto& face : faces)
+    {
+        Vector a = points[face[0]];
+        Vector normal = (points[face[1]] - a).vectorialProduct(points[face[2]] - a);
+        float originSide = a.opposite() * normal;
+        float oppositeSide = (points[face[3]] - a) * normal;
+        // A flat tetrahedron has every face tested
+        if (originSide * oppositeSide > 0) continue;
+
+        Vector facePoints[3] = {points[face[0]], points[face[1]], points[face[2]]};
+        Vector faceSources[3] = {sources[face[0]], sources[face[1]], sources[face[2]]};
+        int faceSize = 3;
+        Vector closest = closestOnTriangle(facePoints, faceSources, faceSize);
+        if (closest.squaredMagnitude() < bestDistance)
+        {
+            bestDistance = closest.squaredMagnitude();
+            best = closest;
+            bestSize = faceSize;
+            for (int i = 0; i < faceSize; i++)
+            {
+                bestPoints[i] = facePoints[i];
+                bestSources[i] = faceSources[i];
+            }
+        }
+    }
+    if (bestSize == 4) return best;
+    size = bestSize;
+    for (int i = 0; i < size; i++)
+    {
+        points[i] = bestPoints[i];
+        sources[i] = bestSources[i];
+    }
+    return best;
+}
+
+/**
+ * @brief Closest point of a triangle to the origin, from its Voronoi regions (Ericson, Real-Time Collision
+ * Detection 5.1.5)
+ */
+Vector GJK::closestOnTriangle(Vector* points, Vector* sources, int& size)
+{
+    auto keep = [&](int first, int second)
+    {
+        Vector keptPoints[2] = {points[first], second >= 0 ? points[second] : points[first]};
+        Vector keptSources[2] = {sources[first], second >= 0 ? sources[second] : sources[first]};
+        size = second >= 0 ? 2 : 1;
+        for (int i = 0; i < size; i++)
+        {
+            points[i] = keptPoints[i];
+            sources[i] = keptSources[i];
+        }
+    };
+
+    Vector a = points[0];
+    Vector b = points[1];
+    Vector c = points[2];
+    Vector ab = b - a;
+    Vector ac = c - a;
+    float d1 = ab * a.opposite();
+    float d2 = ac * a.opposite();
+    if (d1 <= 0 && d2 <= 0)
+    {
+        keep(0, -1);
+        return a;
+    }
+    float d3 = ab * b.opposite();
+    float d4 = ac * b.opposite();
+    if (d3 >= 0 && d4 <= d3)
+    {
+        keep(1, -1);
+        return b;
+    }
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0)
+    {
+        keep(0, 1);
+        return a + ab * (d1 / (d1 - d3));
+    }
+    float d5 = ab * c.opposite();
+    float d6 = ac * c.opposite();
+    if (d6 >= 0 && d5 <= d6)
+    {
+        keep(2, -1);
+        return c;
+    }
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0)
+    {
+        keep(0, 2);
+        return a + ac * (d2 / (d2 - d6));
+    }
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+    {
+        keep(1, 2);
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    float sum = va + vb + vc;
+    if (std::abs(sum) < FLT_EPSILON)
+    {
+        // Degenerate triangle, the closest point is on one of its edges
+        static const int edges[3][2] = {{0, 1}, {1, 2}, {2, 0}};
+        Vector best;
+        float bestDistance = FLT_MAX;
+        Vector bestPoints[2];
+        Vector bestSources[2];
+        int bestSize = 0;
+        for (auto& edge : edges)
+        {
+            Vector edgePoints[2] = {points[edge[0]], points[edge[1]]};
+            Vector edgeSources[2] = {sources[edge[0]], sources[edge[1]]};
+            int edgeSize = 2;
+            Vector closest = closestPoint(edgePoints, edgeSources, edgeSize);
+            if (closest.squaredMagnitude() < bestDistance)
+            {
+                bestDistance = closest.squaredMagnitude();
+                best = closest;
+                bestSize = edgeSize;
+                for (int i = 0; i < edgeSize; i++)
+                {
+                    bestPoints[i] = edgePoints[i];
+                    bestSources[i] = edgeSources[i];
+                }
+            }
+        }
+        size = bestSize;
+        for (int i = 0; i < size; i++)
+        {
+            points[i] = bestPoints[i];
+            sources[i] = bestSources[i];
+        }
+        return best;
+    }
+    return a + ab * (vb / sum) + ac * (vc / sum);
+}
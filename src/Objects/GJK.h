@@ -0,0 +1,61 @@
+#pragma once
+#include "ConvexShape.h"
+#include "Vector.h"
+
+#define GJK_MAX_ITERATIONS 32
+#define EPA_MAX_ITERATIONS 64
+#define EPA_TOLERANCE 0.001f
+// Below this distance, a new support point is considered on the current simplex
+#define GJK_DEGENERATE_EPSILON 0.0001f
+#define RAYCAST_MAX_ITERATIONS 32
+// A ray closer than this distance to a shape hits it
+#define RAYCAST_TOLERANCE 0.001f
+
+/**
+ * @brief A point of the Minkowski difference A - B, with the points of A and B it comes from
+ *
+ */
+struct SupportPoint
+{
+    Vector point;
+    Vector onFirst;
+    Vector onSecond;
+};
+
+/**
+ * @brief A GJK simplex, the most recent point is stored first
+ *
+ */
+struct Simplex
+{
+    SupportPoint points[4];
+    int size = 0;
+
+    void pushFront(SupportPoint point);
+};
+
+/**
+ * @brief Generic convex narrow phase: GJK for the overlap test and EPA for the penetration depth and normal
+ *
+ */
+class GJK
+{
+public:
+    static SupportPoint support(ConvexShape& first, ConvexShape& second, Vector direction);
+    static bool intersect(ConvexShape& first, ConvexShape& second);
+    static bool intersect(ConvexShape& first, ConvexShape& second, Simplex& simplex);
+    static bool penetration(ConvexShape& first, ConvexShape& second, Vector& normal, float& depth, Vector& point);
+    static bool raycast(ConvexShape& shape, Vector origin, Vector direction, float radius, float maxDistance,
+                        float& distance, Vector& normal);
+
+private:
+    static bool nextSimplex(Simplex& simplex, Vector& direction);
+    static bool line(Simplex& simplex, Vector& direction);
+    static bool triangle(Simplex& simplex, Vector& direction);
+    static bool tetrahedron(Simplex& simplex, Vector& direction);
+    static bool sameDirection(Vector direction, Vector other);
+    static bool completeSimplex(ConvexShape& first, ConvexShape& second, Simplex& simplex);
+    static Vector closestPoint(Vector* points, Vector* sources, int& size);
+    static Vector closestOffset(ConvexShape& shape, Vector point);
+    static Vector closestOnTriangle(Vector* points, Vector* sources, int& size);
+};
@@ -11,8 +11,8 @@ public:
     int color[3] = {255, 255, 255};
     Vector position;
     float inversedMass = 1;
-
-    of3dPrimitive shape;
+    // Index in the MaterialTable, 0 for the default material
+    int material = 0;
 
     GameObject();
     float calculateDistance(GameObject* other);
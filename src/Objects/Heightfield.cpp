@@ -0,0 +1,120 @@
+#include "Heightfield.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+Heightfield::Heightfield(Vector origin, int columns, int rows, float cellSize, std::vector<float> heights)
+{
+    // A grid needs at least one cell, and one height per sample
+    if (columns < 2 || rows < 2 || heights.size() != static_cast<size_t>(columns) * rows)
+    {
+        throw std::invalid_argument("Heightfield needs columns * rows heights, with at least 2 of each");
+    }
+    this->origin = origin;
+    this->columns = columns;
+    this->rows = rows;
+    this->cellSize = cellSize;
+    this->heights = heights;
+
+    float minHeight = *std::min_element(heights.begin(), heights.end());
+    float maxHeight = *std::max_element(heights.begin(), heights.end());
+    bounds = AABB(origin + Vector(0, minHeight, 0),
+                  origin + Vector((columns - 1) * cellSize, maxHeight, (rows - 1) * cellSize));
+
+    // The geometry never changes, the render mesh is built once
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+    for (int row = 0; row < rows; row++)
+    {
+        for (int column = 0; column < columns; column++)
+        {
+            mesh.addVertex(getVertex(column, row).v3());
+        }
+    }
+    for (int row = 0; row < rows - 1; row++)
+    {
+        for (int column = 0; column < columns - 1; column++)
+        {
+            unsigned int first = row * columns + column;
+            mesh.addIndex(first);
+            mesh.addIndex(first + columns);
+            mesh.addIndex(first + 1);
+            mesh.addIndex(first + 1);
+            mesh.addIndex(first + columns);
+            mesh.addIndex(first + columns + 1);
+        }
+    }
+}
+
+float Heightfield::getHeight(int column, int row)
+{
+    return heights[row * columns + column];
+}
+
+/**
+ * @return The world position of a sample of the grid
+ */
+Vector Heightfield::getVertex(int column, int row)
+{
+    return origin + Vector(column * cellSize, getHeight(column, row), row * cellSize);
+}
+
+/**
+ * @brief One of the two triangles of a cell, both facing +Y
+ */
+Triangle Heightfield::getTriangle(int column, int row, bool second)
+{
+    if (!second)
+    {
+        return Triangle(getVertex(column, row), getVertex(column, row + 1), getVertex(column + 1, row));
+    }
+    return Triangle(getVertex(column + 1, row), getVertex(column, row + 1), getVertex(column + 1, row + 1));
+}
+
+AABB Heightfield::getBounds()
+{
+    return bounds;
+}
+
+/**
+ * @brief Test the triangles of the cells under the bounding box of the body
+ * @return True if the body overlaps the terrain, the contact is the deepest one
+ */
+bool Heightfield::collide(RigidBody& body, Contact& contact)
+{
+    AABB box = body.getBounds();
+    if (!box.overlaps(bounds)) return false;
+
+    int firstColumn = std::max(0, static_cast<int>(std::floor((box.minCorner.x - origin.x) / cellSize)));
+    int lastColumn = std::min(columns - 2, static_cast<int>(std::floor((box.maxCorner.x - origin.x) / cellSize)));
+    int firstRow = std::max(0, static_cast<int>(std::floor((box.minCorner.z - origin.z) / cellSize)));
+    int lastRow = std::min(rows - 2, static_cast<int>(std::floor((box.maxCorner.z - origin.z) / cellSize)));
+
+    bool collided = false;
+    for (int row = firstRow; row <= lastRow; row++)
+    {
+        for (int column = firstColumn; column <= lastColumn; column++)
+        {
+            for (int second = 0; second < 2; second++)
+            {
+                Triangle triangle = getTriangle(column, row, second == 1);
+                if (!triangle.getBounds().overlaps(box)) continue;
+
+                Contact triangleContact;
+                if (triangle.collide(body, triangleContact)
+                    && (!collided || triangleContact.penetration > contact.penetration))
+                {
+                    contact = triangleContact;
+                    collided = true;
+                }
+            }
+        }
+    }
+    return collided;
+}
+
+void Heightfield::draw()
+{
+    ofSetColor(ofColor::green);
+    mesh.drawWireframe();
+    ofSetColor(ofColor::white);
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+
+#include "StaticCollider.h"
+#include "Triangle.h"
+
+/**
+ * @brief Terrain described by a regular grid of heights in the XZ plane. Each cell is made of two triangles,
+ * only the cells under a body are tested
+ *
+ */
+class Heightfield : public StaticCollider
+{
+private:
+    AABB bounds;
+    ofVboMesh mesh;
+
+    Triangle getTriangle(int column, int row, bool second);
+
+public:
+    // Position of the first sample, the grid extends along +X and +Z
+    Vector origin;
+    int columns;
+    int rows;
+    float cellSize;
+    // rows * columns samples, row after row
+    std::vector<float> heights;
+
+    Heightfield(Vector origin, int columns, int rows, float cellSize, std::vector<float> heights);
+
+    float getHeight(int column, int row);
+    Vector getVertex(int column, int row);
+    AABB getBounds() override;
+    bool collide(RigidBody& body, Contact& contact) override;
+    void draw() override;
+};
@@ -0,0 +1,174 @@
+#include "MassProperties.h"
+
+/**
+ * @param width The size along X
+ * @param height The size along Y
+ * @param depth The size along Z
+ * @param density The mass per unit of volume
+ */
+MassProperties MassProperties::box(float width, float height, float depth, float density)
+{
+    MassProperties properties;
+    properties.mass = density * width * height * depth;
+    float factor = properties.mass / 12;
+    properties.inertia = Matrix(Vector(factor * (height * height + depth * depth), 0, 0),
+                                Vector(0, factor * (width * width + depth * depth), 0),
+                                Vector(0, 0, factor * (width * width + height * height)));
+    return properties;
+}
+
+MassProperties MassProperties::sphere(float radius, float density)
+{
+    MassProperties properties;
+    properties.mass = density * 4 * PI * radius * radius * radius / 3;
+    float moment = 2 * properties.mass * radius * radius / 5;
+    properties.inertia = Matrix(Vector(moment, 0, 0), Vector(0, moment, 0), Vector(0, 0, moment));
+    return properties;
+}
+
+/**
+ * @brief A solid cone along Y, apex at -height / 2. Its center of mass is a quarter of the height above the base
+ */
+MassProperties MassProperties::cone(float radius, float height, float density)
+{
+    MassProperties properties;
+    properties.mass = density * PI * radius * radius * height / 3;
+    properties.centerOfMass = Vector(0, height / 4, 0);
+    float transverse = properties.mass * (3 * radius * radius / 20 + 3 * height * height / 80);
+    properties.inertia = Matrix(Vector(transverse, 0, 0), Vector(0, 3 * properties.mass * radius * radius / 10, 0),
+                                Vector(0, 0, transverse));
+    return properties;
+}
+
+/**
+ * @brief A closed polyhedron, such as a convex hull, split into tetrahedra joining each face to a reference point.
+ * The second moments of the tetrahedra are summed, then moved to the center of mass
+ * @param vertices The vertices, in the frame of the body
+ * @param triangles Three vertex indices per face, counterclockwise seen from outside
+ * @param density The mass per unit of volume
+ */
+MassProperties MassProperties::polyhedron(const std::vector<Vector>& vertices, const std::vector<int>& triangles,
+                                          float density)
+{
+    MassProperties properties;
+    if (vertices.empty() || triangles.size() < 3) return properties;
+
+    // Any point works, one inside the solid keeps the tetrahedra small
+    Vector reference(0, 0, 0);
+    for (Vector vertex : vertices)
+    {
+        reference += vertex;
+    }
+    reference = reference * (1.0f / vertices.size());
+
+    float volume = 0;
+    Vector moment(0, 0, 0);
+    // Second moment (covariance) of the volume, about the reference
+    float covariance[3][3] = {};
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+    {
+        Vector a = Vector(vertices[triangles[i]]) - reference;
+        Vector b = Vector(vertices[triangles[i + 1]]) - reference;
+        Vector c = Vector(vertices[triangles[i + 2]]) - reference;
+        float determinant = a * b.vectorialProduct(c);
+        volume += determinant / 6;
+        moment += (a + b + c) * (determinant / 24);
+
+        Vector sum = a + b + c;
+        float points[4][3] = {{a.x, a.y, a.z}, {b.x, b.y, b.z}, {c.x, c.y, c.z}, {sum.x, sum.y, sum.z}};
+        for (int row = 0; row < 3; row++)
+        {
+            for (int column = 0; column < 3; column++)
+            {
+                float product = 0;
+                for (auto& point : points)
+                {
+                    product += point[row] * point[column];
+                }
+                covariance[row][column] += determinant / 120 * product;
+            }
+        }
+    }
+    if (volume <= 0) return properties;
+
+    Vector center = moment * (1 / volume);
+    float centered[3] = {center.x, center.y, center.z};
+    for (int row = 0; row < 3; row++)
+    {
+        for (int column = 0; column < 3; column++)
+        {
+            covariance[row][column] = density * (covariance[row][column] - volume * centered[row] * centered[column]);
+        }
+    }
+    float trace = covariance[0][0] + covariance[1][1] + covariance[2][2];
+
+    properties.mass = density * volume;
+    properties.centerOfMass = reference + center;
+    properties.inertia = Matrix(Vector(trace - covariance[0][0], -covariance[0][1], -covariance[0][2]),
+                                Vector(-covariance[1][0], trace - covariance[1][1], -covariance[1][2]),
+                                Vector(-covariance[2][0], -covariance[2][1], trace - covariance[2][2]));
+    return properties;
+}
+
+/**
+ * @brief The properties of a body made of several parts, all in the frame of the body
+ */
+MassProperties MassProperties::combine(const std::vector<MassProperties>& parts)
+{
+    MassProperties properties;
+    Vector moment(0, 0, 0);
+    for (auto part : parts)
+    {
+        properties.mass += part.mass;
+        moment += part.centerOfMass * part.mass;
+    }
+    if (properties.mass <= 0) return properties;
+
+    properties.centerOfMass = moment * (1 / properties.mass);
+    for (auto part : parts)
+    {
+        properties.inertia = properties.inertia + part.inertia + parallelAxis(part.mass, part.centerOfMass - properties.centerOfMass);
+    }
+    return properties;
+}
+
+/**
+ * @brief The inertia a point mass adds away from the axes (Huygens-Steiner theorem)
+ * @param mass The mass
+ * @param offset The position of the mass from the new origin
+ */
+Matrix MassProperties::parallelAxis(float mass, Vector offset)
+{
+    float squared = offset.squaredMagnitude();
+    return Matrix(Vector(squared - offset.x * offset.x, -offset.x * offset.y, -offset.x * offset.z),
+                  Vector(-offset.y * offset.x, squared - offset.y * offset.y, -offset.y * offset.z),
+                  Vector(-offset.z * offset.x, -offset.z * offset.y, squared - offset.z * offset.z))
+        * mass;
+}
+
+/**
+ * @brief Express the properties of a part in the frame of its body
+ * @param orientation The orientation of the part in the body
+ * @param offset The position of the origin of the part in the body
+ */
+MassProperties MassProperties::transformed(Quaternion orientation, Vector offset)
+{
+    // The rows of quatToMat are the axes of the part
+    Matrix rotation = orientation.quatToMat();
+    MassProperties properties;
+    properties.mass = mass;
+    properties.centerOfMass = offset + rotation.transpose() * centerOfMass;
+    properties.inertia = rotation.transpose() * inertia * rotation;
+    return properties;
+}
+
+/**
+ * @brief The same solid with another mass, as if its density changed
+ */
+MassProperties MassProperties::withMass(float newMass)
+{
+    MassProperties properties = *this;
+    properties.mass = newMass;
+    if (mass > 0) properties.inertia = inertia * (newMass / mass);
+    return properties;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "Vector.h"
+
+/**
+ * @brief The mass, center of mass and inertia tensor of a solid of uniform density, in the frame of its body.
+ * The primitives follow the frames of the shapes: a box centered on its position, a cone along its Y axis with
+ * the apex at -height / 2. Parts placed in a common frame combine into the properties of a compound body
+ *
+ */
+struct MassProperties
+{
+    float mass = 0;
+    Vector centerOfMass = Vector(0, 0, 0);
+    // About the center of mass
+    Matrix inertia = Matrix::zero();
+
+    static MassProperties box(float width, float height, float depth, float density);
+    static MassProperties sphere(float radius, float density);
+    static MassProperties cone(float radius, float height, float density);
+    static MassProperties polyhedron(const std::vector<Vector>& vertices, const std::vector<int>& triangles,
+                                     float density);
+    static MassProperties combine(const std::vector<MassProperties>& parts);
+    static Matrix parallelAxis(float mass, Vector offset);
+
+    MassProperties transformed(Quaternion orientation, Vector offset);
+    MassProperties withMass(float newMass);
+};
@@ -0,0 +1,74 @@
+#include "Material.h"
+
+#include <algorithm>
+
+std::vector<Material> MaterialTable::materials = {Material()};
+
+bool Material::operator ==(const Material& other) const
+{
+    return restitution == other.restitution && staticFriction == other.staticFriction
+        && dynamicFriction == other.dynamicFriction && density == other.density
+        && restitutionCombine == other.restitutionCombine && frictionCombine == other.frictionCombine;
+}
+
+/**
+ * @brief Register a material, or find the identical one already registered
+ * @param material The material
+ * @return The index of the material
+ */
+int MaterialTable::add(const Material& material)
+{
+    auto found = std::find(materials.begin(), materials.end(), material);
+    if (found != materials.end()) return static_cast<int>(found - materials.begin());
+    materials.push_back(material);
+    return static_cast<int>(materials.size()) - 1;
+}
+
+/**
+ * @param index The index of a material
+ * @return The material, or the default one for an unknown index
+ */
+const Material& MaterialTable::get(int index)
+{
+    if (index < 0 || index >= static_cast<int>(materials.size())) return materials[0];
+    return materials[index];
+}
+
+int MaterialTable::size()
+{
+    return static_cast<int>(materials.size());
+}
+
+/**
+ * @brief Combine a coefficient of two materials, with the mode of highest value
+ */
+float MaterialTable::combine(float first, float second, CombineMode firstMode, CombineMode secondMode)
+{
+    switch (std::max(firstMode, secondMode))
+    {
+    case CombineMinimum:
+        return std::min(first, second);
+    case CombineMultiply:
+        return first * second;
+    case CombineMaximum:
+        return std::max(first, second);
+    default:
+        return (first + second) / 2;
+    }
+}
+
+/**
+ * @param first The material index of the first body
+ * @param second The material index of the second body, or of the static geometry
+ * @return The coefficients of the contact between the two materials
+ */
+MaterialPair MaterialTable::getPair(int first, int second)
+{
+    const Material& a = get(first);
+    const Material& b = get(second);
+    MaterialPair pair;
+    pair.restitution = combine(a.restitution, b.restitution, a.restitutionCombine, b.restitutionCombine);
+    pair.staticFriction = combine(a.staticFriction, b.staticFriction, a.frictionCombine, b.frictionCombine);
+    pair.dynamicFriction = combine(a.dynamicFriction, b.dynamicFriction, a.frictionCombine, b.frictionCombine);
+    return pair;
+}
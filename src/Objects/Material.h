@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// The default material keeps the bounce the engine always had
+#define DEFAULT_RESTITUTION 0.9f
+#define DEFAULT_STATIC_FRICTION 0.5f
+#define DEFAULT_DYNAMIC_FRICTION 0.3f
+#define DEFAULT_DENSITY 1.0f
+
+/**
+ * @brief How the coefficients of two materials in contact are combined. When the materials disagree, the mode
+ * with the highest value wins
+ */
+enum CombineMode : uint8_t
+{
+    CombineAverage = 0,
+    CombineMinimum = 1,
+    CombineMultiply = 2,
+    CombineMaximum = 3
+};
+
+/**
+ * @brief The surface and bulk properties of a body
+ *
+ */
+struct Material
+{
+    // Part of the normal velocity kept after a contact
+    float restitution = DEFAULT_RESTITUTION;
+    // Friction coefficients below and above the sliding threshold
+    float staticFriction = DEFAULT_STATIC_FRICTION;
+    float dynamicFriction = DEFAULT_DYNAMIC_FRICTION;
+    // Mass per unit of volume
+    float density = DEFAULT_DENSITY;
+    CombineMode restitutionCombine = CombineAverage;
+    CombineMode frictionCombine = CombineAverage;
+
+    bool operator ==(const Material& other) const;
+};
+
+/**
+ * @brief The combined coefficients of a pair of materials, as the contact solver uses them
+ */
+struct MaterialPair
+{
+    float restitution;
+    float staticFriction;
+    float dynamicFriction;
+};
+
+/**
+ * @brief Every material of the application, in one array. Bodies and static colliders only keep the index of
+ * their material, 0 being the default one, and the collision code looks the coefficients up by index.
+ * Identical materials share an index, so that loading scenes again does not grow the table
+ *
+ */
+class MaterialTable
+{
+private:
+    static std::vector<Material> materials;
+
+public:
+    static int add(const Material& material);
+    static const Material& get(int index);
+    static int size();
+    static float combine(float first, float second, CombineMode firstMode, CombineMode secondMode);
+    static MaterialPair getPair(int first, int second);
+};
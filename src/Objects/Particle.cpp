@@ -11,7 +11,6 @@ Particle::Particle()
     this->color[2] = 255;
     this->radius = 1;
     this->gravity = 9.81;
-    this->shape = ofSpherePrimitive();
 }
 
 Particle::Particle(Vector velocity, float mass)
@@ -25,7 +24,6 @@ Particle::Particle(Vector velocity, float mass)
     this->color[2] = 255;
     this->radius = 1;
     this->gravity = 9.81;
-    this->shape = ofSpherePrimitive();
 }
 
 Particle::Particle(Vector velocity, float mass, float radius)
@@ -39,7 +37,6 @@ Particle::Particle(Vector velocity, float mass, float radius)
     this->color[2] = 255;
     this->radius = radius;
     this->gravity = 9.81;
-    this->shape = ofSpherePrimitive();
 }
 
 Particle::Particle(Vector velocity, float mass, float radius, float gravity)
@@ -53,7 +50,6 @@ Particle::Particle(Vector velocity, float mass, float radius, float gravity)
     this->color[2] = 255;
     this->radius = radius;
     this->gravity = gravity;
-    this->shape = ofSpherePrimitive();
 }
 
 Particle::Particle(Vector velocity, float mass, int r, int g, int b, float radius)
@@ -67,7 +63,6 @@ Particle::Particle(Vector velocity, float mass, int r, int g, int b, float radiu
     this->color[2] = b;
     this->radius = radius;
     this->gravity = 9.81;
-    this->shape = ofSpherePrimitive();
 }
 
 
@@ -109,6 +104,25 @@ bool Particle::checkCollision(Particle* particle)
     return (d <= minD);
 }
 
+/**
+ * @brief Update the bounding box and the collider sphere of the particle from its radius
+ *
+ */
+void Particle::updateBounds()
+{
+    colliderRadius = radius;
+    bounds = AABB::fromSphere(position, radius);
+}
+
+/**
+ * @brief Support function of the particle sphere
+ *
+ */
+Vector Particle::support(Vector direction)
+{
+    return position + direction.normalized() * radius;
+}
+
 /**
  * @brief Draw the particle
  *
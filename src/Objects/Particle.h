@@ -25,6 +25,8 @@ public:
     void setMass(float m);
     Particle* duplicate();
     bool checkCollision(Particle* particle);
+    void updateBounds() override;
+    Vector support(Vector direction) override;
     void draw() override;
     void updateColor() ;
 };
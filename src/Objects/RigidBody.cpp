@@ -1,5 +1,6 @@
 ﻿#include "RigidBody.h"
 
+#include "Material.h"
 #include "Particle.h"
 
 RigidBody::RigidBody()
@@ -38,17 +39,26 @@ void RigidBody::eulerIntegration(float delta_t)
     position += linearVelocity * delta_t;
 
     {
+        // The body turns about its center of mass, which is offset from the position of the shape
+        bool offCenter = massCenter.magnitude() > 0;
+        Vector centerOffset = offCenter ? getWorldMassCenter() - position : Vector(0, 0, 0);
+
         updateInversedJ();
         calculateAngularAcceleration();
 
         angularVelocity = angularVelocity + angularAcceleration * delta_t;
         orientation = orientation + (Quaternion::toQuaternion(angularVelocity) * orientation) * 0.5 * delta_t;
         orientation = orientation.normalize();
+
+        if (offCenter) position = position + centerOffset - (getWorldMassCenter() - position);
     }
 
     // Clears the force applied to the object
     clearAccum();
     torque = Vector(0, 0, 0);
+
+    // Moves the bounding box with the new position and orientation
+    updateBounds();
 }
 
 /**
@@ -65,7 +75,7 @@ void RigidBody::addForce(Vector force, Vector pointApplication)
 {
     this->accumForce += force;
     Vector l(0, 0, 0);
-    auto center = position + massCenter;
+    auto center = getWorldMassCenter();
     l.x = (pointApplication.x - center.x);
     l.y = (pointApplication.y - center.y);
     l.z = (pointApplication.z - center.z);
@@ -110,27 +120,106 @@ void RigidBody::calculateAngularAcceleration()
  */
 void RigidBody::updateInversedJ()
 {
-    inversedTenseurJ = (orientation.quatToMat() * inversedTenseurJ) * orientation.quatToMat().inverse();
+    inversedTenseurJ = computeInversedJ();
 }
 
 /**
- * @brief Move the center of mass of the object using a translation
+ * @brief The inverse of the tenseurJ the next integration uses, without changing the object
+ *
+ * @return The inverse, applied to the torque as calculateAngularAcceleration does
+ */
+Matrix RigidBody::computeInversedJ()
+{
+    return (orientation.quatToMat() * inversedTenseurJ) * orientation.quatToMat().inverse();
+}
+
+/**
+ * @brief Move the center of mass of the object using a translation, the inertia tensor follows with the parallel
+ * axis theorem
  * 
  * @param translation 
  */
 void RigidBody::moveCenterMass(Vector translation)
 {
-    tenseurJ = tenseurJ + (Matrix(
-        Vector(glm::pow2(translation.y) + glm::pow2(translation.z), -translation.x * translation.y,
-               -translation.x * translation.z),
-        Vector(-translation.x * translation.y, glm::pow2(translation.x) + glm::pow2(translation.z),
-               -translation.y * translation.z),
-        Vector(-translation.x * translation.z, -translation.y * translation.z,
-               glm::pow2(translation.x) + glm::pow2(translation.y))) * getMass());
-
+    tenseurJ = tenseurJ + MassProperties::parallelAxis(getMass(), translation);
     massCenter = translation;
 }
 
+/**
+ * @brief The center of mass in world space. massCenter is expressed in the frame of the object and turns with it
+ *
+ * @return The position of the center of mass
+ */
+Vector RigidBody::getWorldMassCenter()
+{
+    return position + orientation.quatToMat().transpose() * massCenter;
+}
+
+/**
+ * @brief Replace the mass, center of mass and inertia tensor of the object
+ *
+ * @param properties The properties, in the frame of the object
+ */
+void RigidBody::setMassProperties(MassProperties properties)
+{
+    if (properties.mass <= 0) return;
+    setMass(properties.mass);
+    massCenter = properties.centerOfMass;
+    tenseurJ = properties.inertia;
+    inversedTenseurJ = tenseurJ.inverse();
+}
+
+/**
+ * @brief Derive the mass properties of the object from its shape and the density of its material
+ *
+ */
+void RigidBody::updateMassProperties()
+{
+    setMassProperties(computeMassProperties(MaterialTable::get(material).density));
+}
+
+/**
+ * @brief The mass properties of the shape for a density. By default the collider sphere
+ *
+ * @param density The mass per unit of volume
+ * @return The properties, in the frame of the object
+ */
+MassProperties RigidBody::computeMassProperties(float density)
+{
+    return MassProperties::sphere(colliderRadius, density);
+}
+
+/**
+ * @brief Get the world space bounding box of the object, as computed by the last updateBounds()
+ *
+ * @return The bounding box of the object
+ */
+AABB RigidBody::getBounds()
+{
+    return bounds;
+}
+
+/**
+ * @brief Update the world space bounding box. By default it encloses the collider sphere, shapes
+ * override it with a box computed from their orientation and extents
+ *
+ */
+void RigidBody::updateBounds()
+{
+    bounds = AABB::fromSphere(position, colliderRadius);
+}
+
+/**
+ * @brief Support function of the collider sphere, used by the convex narrow phase
+ *
+ * @param direction The search direction
+ * @return The point of the collider sphere furthest in direction
+ */
+Vector RigidBody::support(Vector direction)
+{
+    return position + direction.normalized() * colliderRadius;
+}
+
 void RigidBody::setGravity(float gravity)
 {
     this->gravity = gravity;
@@ -144,6 +233,7 @@ float RigidBody::getGravity()
 void RigidBody::setPosition(Vector newPosition)
 {
     this->position = newPosition;
+    updateBounds();
 }
 
 void RigidBody::setLinearVelocity(Vector linearVelocity)
@@ -1,13 +1,31 @@
 ﻿#pragma once
+#include "AABB.h"
+#include "ConvexShape.h"
 #include "GameObject.h"
+#include "MassProperties.h"
 #include "Quaternion.h"
 #include "Vector.h"
 
+/**
+ * @brief Collision shape of a rigid body, used to pick the narrow phase algorithm of a pair.
+ * The order matters: pairs are stored with the smallest type first
+ */
+enum ShapeType
+{
+    SphereShape = 0,
+    BoxShape = 1,
+    ConeShape = 2,
+    ConvexHullShape = 3,
+    // Several shapes rigidly attached, the largest type so that it is always the second body of its pairs
+    CompoundShape = 4,
+    ShapeTypeCount = 5
+};
+
 /**
  * @brief A class that represents a rigid body and set the physics for a game object
  * 
  */
-class RigidBody : public GameObject
+class RigidBody : public GameObject, public ConvexShape
 {
 public:
     Vector linearVelocity;
@@ -22,11 +40,26 @@ public:
     Matrix inversedTenseurJ = Matrix::zero();
     Vector torque = Vector(0,0,0);
     Vector massCenter = Vector(0, 0, 0);
-    float colliderRadius;
+    float colliderRadius = 0;
+    ShapeType shapeType = SphereShape;
+    // Stable identifier given by the PhysicsWorld, used to order bodies and pairs deterministically
+    int id = -1;
+    // Sweep the motion of the body during a step against the walls and the other bodies, to prevent tunnelling
+    bool continuousCollision = false;
+    // Electric charge, only used by the ElectrostaticGenerator
+    float charge = 0;
+    // Contacts with other bodies and static geometry found during the last step
+    int contactCount = 0;
+    // World space bounding box, kept up to date by the integrator
+    AABB bounds;
+    // Index of the leaf of the object in the AABB tree, -1 when it is not in a tree
+    int proxyId = -1;
 
     RigidBody();
     RigidBody(float gravity, Vector linearVelocity, Vector angularVelocity,
               Vector linearAcceleration);
+    // Bodies are owned and deleted through base pointers
+    virtual ~RigidBody() = default;
 
     void eulerIntegration(float delta_t);
     void addForce(Vector force);
@@ -43,5 +76,13 @@ public:
     void setLinearAcceleration(Vector linearAcceleration);
     void calculateAngularAcceleration();
     void updateInversedJ();
+    Matrix computeInversedJ();
     void moveCenterMass(Vector translation);
+    Vector getWorldMassCenter();
+    void setMassProperties(MassProperties properties);
+    void updateMassProperties();
+    virtual MassProperties computeMassProperties(float density);
+    AABB getBounds();
+    virtual void updateBounds();
+    Vector support(Vector direction) override;
 };
@@ -1,9 +1,11 @@
 ﻿#pragma once
-#include "Drawable.h"
 #include "RigidBody.h"
 
-class Shape: public Drawable, public RigidBody
+/**
+ * @brief A rigid body of the world. It only holds the physics state: it is drawn through the RenderBody captured
+ * from it, with the mesh shared by every body of its shape type
+ *
+ */
+class Shape: public RigidBody
 {
-public:
-    void draw() override {}
 };
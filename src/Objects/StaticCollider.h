@@ -0,0 +1,35 @@
+#pragma once
+#include "AABB.h"
+#include "Contact.h"
+#include "RigidBody.h"
+
+/**
+ * @brief Immovable world geometry. Static colliders are added to the StaticWorld once, when the scene is loaded,
+ * and never move afterwards, so they are not part of the per-frame broad phase rebuild
+ *
+ */
+class StaticCollider
+{
+public:
+    // Index in the MaterialTable
+    int material = 0;
+
+    virtual ~StaticCollider() = default;
+
+    virtual AABB getBounds() = 0;
+    /**
+     * @brief Unbounded colliders, such as planes, are tested against every body instead of going through the BVH
+     */
+    virtual bool isBounded()
+    {
+        return true;
+    }
+    /**
+     * @brief Find the deepest contact between a body and the collider
+     * @param body The dynamic body
+     * @param contact Filled with the body as first, no second body, and the normal pointing into the collider
+     * @return True if the body overlaps the collider
+     */
+    virtual bool collide(RigidBody& body, Contact& contact) = 0;
+    virtual void draw() = 0;
+};
@@ -0,0 +1,44 @@
+#include "StaticPlane.h"
+
+StaticPlane::StaticPlane(Vector normal, float offset)
+{
+    this->normal = normal.normalized();
+    this->offset = offset;
+}
+
+/**
+ * @return A box covering the whole space
+ */
+AABB StaticPlane::getBounds()
+{
+    return AABB(Vector(-FLT_MAX, -FLT_MAX, -FLT_MAX), Vector(FLT_MAX, FLT_MAX, FLT_MAX));
+}
+
+bool StaticPlane::isBounded()
+{
+    return false;
+}
+
+/**
+ * @brief Test the point of the body the deepest behind the plane, found with its support function
+ */
+bool StaticPlane::collide(RigidBody& body, Contact& contact)
+{
+    Vector deepest = body.support(normal.opposite());
+    float distance = normal * deepest - offset;
+    if (distance >= 0) return false;
+
+    contact.first = &body;
+    contact.second = nullptr;
+    contact.normal = normal.opposite();
+    contact.penetration = -distance;
+    contact.point = deepest + normal * (contact.penetration / 2);
+    return true;
+}
+
+/**
+ * @brief Planes are not drawn, the ones of the arena are already shown by its box
+ */
+void StaticPlane::draw()
+{
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "StaticCollider.h"
+
+/**
+ * @brief An infinite plane, the free side being the one its normal points to.
+ * The plane contains the points x such that normal * x = offset
+ *
+ */
+class StaticPlane : public StaticCollider
+{
+public:
+    Vector normal;
+    float offset;
+
+    StaticPlane(Vector normal, float offset);
+
+    AABB getBounds() override;
+    bool isBounded() override;
+    bool collide(RigidBody& body, Contact& contact) override;
+    void draw() override;
+};
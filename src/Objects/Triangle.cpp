@@ -0,0 +1,60 @@
+#include "Triangle.h"
+
+#include "GJK.h"
+
+Triangle::Triangle(Vector a, Vector b, Vector c)
+{
+    this->a = a;
+    this->b = b;
+    this->c = c;
+}
+
+/**
+ * @return The unit normal of the front side
+ */
+Vector Triangle::normal()
+{
+    return (b - a).vectorialProduct(c - a).normalized();
+}
+
+AABB Triangle::getBounds()
+{
+    return AABB(a, a).merge(AABB(b, b)).merge(AABB(c, c));
+}
+
+/**
+ * @brief Support function of the triangle: the vertex furthest in the given direction
+ */
+Vector Triangle::support(Vector direction)
+{
+    float projectionA = a * direction;
+    float projectionB = b * direction;
+    float projectionC = c * direction;
+    if (projectionA >= projectionB && projectionA >= projectionC) return a;
+    return projectionB >= projectionC ? b : c;
+}
+
+/**
+ * @brief Test a body against the triangle with GJK/EPA. The body is always pushed out on the front side,
+ * so that a deep body does not fall through a surface made of triangles
+ * @param body The dynamic body
+ * @param contact Filled with the normal from the body to the triangle, the depth and the contact point
+ * @return True if the body overlaps the triangle
+ */
+bool Triangle::collide(RigidBody& body, Contact& contact)
+{
+    if (!GJK::penetration(body, *this, contact.normal, contact.penetration, contact.point)) return false;
+
+    Vector faceNormal = normal();
+    if (contact.normal * faceNormal > 0)
+    {
+        // EPA found a shorter way out through the back side, push the body along the face normal instead
+        Vector deepest = body.support(faceNormal.opposite());
+        contact.normal = faceNormal.opposite();
+        contact.penetration = faceNormal * (a - deepest);
+        contact.point = deepest + faceNormal * (contact.penetration / 2);
+    }
+    contact.first = &body;
+    contact.second = nullptr;
+    return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "AABB.h"
+#include "Contact.h"
+#include "ConvexShape.h"
+#include "RigidBody.h"
+#include "Vector.h"
+
+/**
+ * @brief A one-sided triangle of static geometry. The front side is the one its normal points to,
+ * with the vertices in counterclockwise order
+ *
+ */
+class Triangle : public ConvexShape
+{
+public:
+    Vector a;
+    Vector b;
+    Vector c;
+
+    Triangle(Vector a, Vector b, Vector c);
+
+    Vector normal();
+    AABB getBounds();
+    Vector support(Vector direction) override;
+    bool collide(RigidBody& body, Contact& contact);
+};
@@ -0,0 +1,80 @@
+#include "TriangleMesh.h"
+
+TriangleMesh::TriangleMesh(std::vector<Vector> vertices, std::vector<int> indices)
+{
+    this->vertices = vertices;
+    this->indices = indices;
+
+    std::vector<AABB> triangleBounds;
+    triangleBounds.reserve(getTriangleCount());
+    for (int i = 0; i < getTriangleCount(); i++)
+    {
+        triangleBounds.push_back(getTriangle(i).getBounds());
+        bounds = i == 0 ? triangleBounds.back() : bounds.merge(triangleBounds.back());
+    }
+    bvh.build(triangleBounds);
+
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+    for (auto vertex : vertices)
+    {
+        mesh.addVertex(vertex.v3());
+    }
+    for (auto index : indices)
+    {
+        mesh.addIndex(index);
+    }
+}
+
+int TriangleMesh::getTriangleCount()
+{
+    return static_cast<int>(indices.size()) / 3;
+}
+
+Triangle TriangleMesh::getTriangle(int index)
+{
+    return Triangle(vertices[indices[3 * index]], vertices[indices[3 * index + 1]], vertices[indices[3 * index + 2]]);
+}
+
+/**
+ * @brief Find the triangles whose bounds overlap a box
+ * @param results The indices of the triangles are appended to this vector
+ */
+void TriangleMesh::queryTriangles(AABB box, std::vector<int>& results)
+{
+    bvh.query(box, results);
+}
+
+AABB TriangleMesh::getBounds()
+{
+    return bounds;
+}
+
+/**
+ * @brief Test the triangles around the body, found with the BVH
+ * @return True if the body overlaps the mesh, the contact is the deepest one
+ */
+bool TriangleMesh::collide(RigidBody& body, Contact& contact)
+{
+    candidates.clear();
+    bvh.query(body.getBounds(), candidates);
+
+    bool collided = false;
+    for (auto index : candidates)
+    {
+        Contact triangleContact;
+        if (getTriangle(index).collide(body, triangleContact)
+            && (!collided || triangleContact.penetration > contact.penetration))
+        {
+            contact = triangleContact;
+            collided = true;
+        }
+    }
+    return collided;
+}
+
+void TriangleMesh::draw()
+{
+    ofSetColor(ofColor::green);
+    mesh.drawWireframe();
+    ofSetColor(ofColor::white);
+}
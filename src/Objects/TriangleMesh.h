@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+
+#include "StaticBVH.h"
+#include "StaticCollider.h"
+#include "Triangle.h"
+
+/**
+ * @brief Static geometry made of indexed triangles. The triangles are kept in their own BVH,
+ * built once with the mesh, so that a body is only tested against the triangles around it
+ *
+ */
+class TriangleMesh : public StaticCollider
+{
+private:
+    StaticBVH bvh;
+    AABB bounds;
+    ofVboMesh mesh;
+    // Triangles found by the last BVH query
+    std::vector<int> candidates;
+
+public:
+    std::vector<Vector> vertices;
+    // Three vertex indices per triangle, in counterclockwise order seen from the front side
+    std::vector<int> indices;
+
+    TriangleMesh(std::vector<Vector> vertices, std::vector<int> indices);
+
+    int getTriangleCount();
+    Triangle getTriangle(int index);
+    void queryTriangles(AABB box, std::vector<int>& results);
+    AABB getBounds() override;
+    bool collide(RigidBody& body, Contact& contact) override;
+    void draw() override;
+};
@@ -0,0 +1,410 @@
+#include "InputLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "Box.h"
+#include "Cone.h"
+#include "MappedFile.h"
+
+static void writeVector(Vector v, float* out)
+{
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+static Vector readVector(const float* in)
+{
+    return Vector(in[0], in[1], in[2]);
+}
+
+/**
+ * @param shapeType The shape of the new body, a box or a cone
+ * @param dimensions The box width, height and depth, or the cone radius and height
+ * @param position The position of the new body
+ * @param continuousCollision Whether the new body uses continuous collisions
+ * @param force The force applied on the center of the body during its first step
+ * @return The input adding a body
+ */
+InputEvent InputLog::addBodyEvent(ShapeType shapeType, Vector dimensions, Vector position, bool continuousCollision,
+                                  Vector force)
+{
+    InputEvent event = {};
+    event.type = AddBodyInput;
+    event.target = shapeType;
+    event.flags = continuousCollision ? SNAPSHOT_CONTINUOUS_COLLISION : 0;
+    writeVector(dimensions, event.values);
+    writeVector(position, event.values + 3);
+    writeVector(force, event.values + 6);
+    return event;
+}
+
+/**
+ * @param bodyId The id of the body
+ * @param force The force to add
+ * @param pointApplication The point of application of the force
+ * @return The input adding a force to a body
+ */
+InputEvent InputLog::addForceEvent(int bodyId, Vector force, Vector pointApplication)
+{
+    InputEvent event = {};
+    event.type = AddForceInput;
+    event.target = bodyId;
+    writeVector(force, event.values);
+    writeVector(pointApplication, event.values + 3);
+    return event;
+}
+
+/**
+ * @param settings The new settings, as SNAPSHOT_ bits
+ * @return The input changing the settings of the world
+ */
+InputEvent InputLog::settingsEvent(uint32_t settings)
+{
+    InputEvent event = {};
+    event.type = SettingsInput;
+    event.flags = settings;
+    return event;
+}
+
+/**
+ * @return The input removing every body
+ */
+InputEvent InputLog::clearEvent()
+{
+    InputEvent event = {};
+    event.type = ClearInput;
+    return event;
+}
+
+/**
+ * @param spacing Distance between two samples of the terrain
+ * @return The input adding the terrain
+ */
+InputEvent InputLog::terrainEvent(float spacing)
+{
+    InputEvent event = {};
+    event.type = TerrainInput;
+    event.values[0] = spacing;
+    return event;
+}
+
+/**
+ * @brief Apply an input to a world
+ * @param world The world
+ * @param event The input
+ */
+void InputLog::apply(PhysicsWorld& world, const InputEvent& event)
+{
+    switch (event.type)
+    {
+    case AddBodyInput:
+        {
+            Vector dimensions = readVector(event.values);
+            Shape* body;
+            if (event.target == ConeShape) body = new Cone(dimensions.x, dimensions.y, readVector(event.values + 3));
+            else body = new Box(dimensions.x, dimensions.y, dimensions.z, readVector(event.values + 3));
+            body->continuousCollision = event.flags & SNAPSHOT_CONTINUOUS_COLLISION;
+            world.addBody(body);
+            body->addForce(readVector(event.values + 6), Vector(0, 0, 0));
+            break;
+        }
+    case AddForceInput:
+        {
+            Shape* body = world.findBody(event.target);
+            if (body != nullptr) body->addForce(readVector(event.values), readVector(event.values + 3));
+            break;
+        }
+    case SettingsInput:
+        Snapshot::setSettings(world, event.flags);
+        break;
+    case ClearInput:
+        world.clear();
+        break;
+    case TerrainInput:
+        world.staticWorld.addTerrain(world.arenaSize, event.values[0]);
+        break;
+    case AddShapeInput:
+        {
+            Shape* body = Snapshot::readShape(shapes.data(), vertices.data(), event.target, materialIndices);
+            // As in the scenes, a compound gets its mass from the densities of its children
+            if (body->shapeType == CompoundShape) body->updateMassProperties();
+            body->position = readVector(event.values);
+            body->continuousCollision = event.flags & SNAPSHOT_CONTINUOUS_COLLISION;
+            body->updateBounds();
+            world.addBody(body);
+            body->addForce(readVector(event.values + 3), Vector(0, 0, 0));
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Find a material of the table in the log, adding it if it is not there yet
+ * @param tableIndex The index of the material in the MaterialTable
+ * @return Its index in the log
+ */
+int InputLog::addMaterial(int tableIndex)
+{
+    auto found = std::find(materialIndices.begin(), materialIndices.end(), tableIndex);
+    if (found != materialIndices.end()) return static_cast<int>(found - materialIndices.begin());
+    materials.push_back(MaterialTable::get(tableIndex));
+    materialIndices.push_back(tableIndex);
+    return static_cast<int>(materials.size()) - 1;
+}
+
+/**
+ * @brief Drop the previous events and record the next ones
+ * @param scene The static geometry of the world, as INPUT_LOG_ bits
+ * @param arenaSize Half size of the arena
+ * @param terrainSpacing Spacing of the terrain samples, if there is one
+ */
+void InputLog::start(uint32_t scene, float arenaSize, float terrainSpacing)
+{
+    events.clear();
+    shapes.clear();
+    vertices.clear();
+    materials.clear();
+    materialIndices.clear();
+    cursor = 0;
+    this->scene = scene;
+    this->arenaSize = arenaSize;
+    this->terrainSpacing = terrainSpacing;
+    recording = true;
+}
+
+void InputLog::stop()
+{
+    recording = false;
+}
+
+/**
+ * @brief Apply an input to a world, and record it with the index of the next step if recording
+ * @param world The world
+ * @param event The input, its step is overwritten
+ */
+void InputLog::submit(PhysicsWorld& world, InputEvent event)
+{
+    event.step = world.stepCount;
+    apply(world, event);
+    if (recording) events.push_back(event);
+}
+
+/**
+ * @brief Add a body of any shape with snapshot format, such as a compound or a hull, and record it like submit
+ * does. The body added is built from the description of the shape kept in the log, as the replay will build it
+ * @param world The world
+ * @param shape The shape to copy, with its children and materials, it is not kept
+ * @param position The position of the new body
+ * @param continuousCollision Whether the new body uses continuous collisions
+ * @param force The force applied on the center of the body during its first step
+ * @return False if the shape has no snapshot format, nothing is added then
+ */
+bool InputLog::submitShape(PhysicsWorld& world, Shape* shape, Vector position, bool continuousCollision,
+                           Vector force)
+{
+    size_t first = shapes.size();
+    size_t firstCoordinate = vertices.size();
+    shapes.emplace_back();
+    if (!Snapshot::writeShape(shape, shapes, vertices, first))
+    {
+        shapes.resize(first);
+        vertices.resize(firstCoordinate);
+        return false;
+    }
+    for (size_t i = first; i < shapes.size(); i++)
+    {
+        shapes[i].material = addMaterial(shapes[i].material);
+    }
+
+    InputEvent event = {};
+    event.type = AddShapeInput;
+    event.target = static_cast<int32_t>(first);
+    event.flags = continuousCollision ? SNAPSHOT_CONTINUOUS_COLLISION : 0;
+    writeVector(position, event.values);
+    writeVector(force, event.values + 3);
+    submit(world, event);
+    // Only the recorded events need their shape
+    if (!recording)
+    {
+        shapes.resize(first);
+        vertices.resize(firstCoordinate);
+    }
+    return true;
+}
+
+/**
+ * @brief Write the log to a file, replacing it
+ * @param path The path of the file
+ * @return False if the file can not be written
+ */
+bool InputLog::save(const std::string& path)
+{
+    InputLogHeader header = {};
+    header.magic = INPUT_LOG_MAGIC;
+    header.version = INPUT_LOG_VERSION;
+    header.eventCount = static_cast<uint32_t>(events.size());
+    header.scene = scene;
+    header.arenaSize = arenaSize;
+    header.terrainSpacing = terrainSpacing;
+    header.shapeCount = static_cast<uint32_t>(shapes.size());
+    header.vertexCount = static_cast<uint32_t>(vertices.size() / 3);
+    header.materialCount = static_cast<uint32_t>(materials.size());
+
+    std::vector<SnapshotMaterial> records(materials.size());
+    for (size_t i = 0; i < materials.size(); i++)
+    {
+        records[i] = Snapshot::writeMaterial(materials[i]);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(InputEvent));
+    file.write(reinterpret_cast<const char*>(shapes.data()), shapes.size() * sizeof(SnapshotShape));
+    file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(float));
+    file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(SnapshotMaterial));
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Replace the log with the one of a file, ready to be replayed. The materials of the log are added to the
+ * MaterialTable, identical ones being shared
+ * @param path The path of the file
+ * @return False if the file can not be read or is not a valid log, the log is left untouched
+ */
+bool InputLog::load(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path) || file.getSize() < sizeof(InputLogHeader)) return false;
+    auto header = reinterpret_cast<const InputLogHeader*>(file.getData());
+    if (header->magic != INPUT_LOG_MAGIC || header->version != INPUT_LOG_VERSION) return false;
+    size_t shapesOffset = sizeof(InputLogHeader) + static_cast<size_t>(header->eventCount) * sizeof(InputEvent);
+    size_t verticesOffset = shapesOffset + static_cast<size_t>(header->shapeCount) * sizeof(SnapshotShape);
+    size_t materialsOffset = verticesOffset + static_cast<size_t>(header->vertexCount) * 3 * sizeof(float);
+    if (file.getSize() < materialsOffset + static_cast<size_t>(header->materialCount) * sizeof(SnapshotMaterial))
+    {
+        return false;
+    }
+
+    auto fileEvents = reinterpret_cast<const InputEvent*>(file.getData() + sizeof(InputLogHeader));
+    auto fileShapes = reinterpret_cast<const SnapshotShape*>(file.getData() + shapesOffset);
+    auto fileVertices = reinterpret_cast<const float*>(file.getData() + verticesOffset);
+    auto fileMaterials = reinterpret_cast<const SnapshotMaterial*>(file.getData() + materialsOffset);
+    std::vector<Material> loadedMaterials(header->materialCount);
+    for (uint32_t i = 0; i < header->materialCount; i++)
+    {
+        if (!Snapshot::readMaterial(fileMaterials[i], loadedMaterials[i])) return false;
+    }
+    if (!Snapshot::checkShapes(fileShapes, header->shapeCount, header->vertexCount, header->materialCount))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->eventCount; i++)
+    {
+        const InputEvent& event = fileEvents[i];
+        bool validShape = event.target >= 0 && static_cast<uint32_t>(event.target) < header->shapeCount;
+        if (event.type == AddShapeInput && !validShape) return false;
+    }
+
+    events.assign(fileEvents, fileEvents + header->eventCount);
+    shapes.assign(fileShapes, fileShapes + header->shapeCount);
+    vertices.assign(fileVertices, fileVertices + 3 * static_cast<size_t>(header->vertexCount));
+    materials = loadedMaterials;
+    materialIndices.resize(materials.size());
+    for (size_t i = 0; i < materials.size(); i++)
+    {
+        materialIndices[i] = MaterialTable::add(materials[i]);
+    }
+    scene = header->scene;
+    arenaSize = header->arenaSize;
+    terrainSpacing = header->terrainSpacing;
+    recording = false;
+    cursor = 0;
+    return true;
+}
+
+/**
+ * @brief Add the static geometry the world had when the recording started
+ * @param world The world, without static geometry
+ */
+void InputLog::setupScene(PhysicsWorld& world)
+{
+    if (scene & INPUT_LOG_ARENA) world.staticWorld.addArena(arenaSize);
+    if (scene & INPUT_LOG_TERRAIN) world.staticWorld.addTerrain(arenaSize, terrainSpacing);
+}
+
+/**
+ * @brief Replay the log from its first event
+ */
+void InputLog::rewind()
+{
+    cursor = 0;
+}
+
+/**
+ * @brief Simulate fixed steps, applying the recorded inputs before the steps they were recorded at
+ * @param world The world, restored from the snapshot of the recording
+ * @param steps The number of steps to simulate
+ * @return The number of inputs applied
+ */
+int InputLog::replay(PhysicsWorld& world, int steps)
+{
+    int applied = 0;
+    for (int i = 0; i < steps; i++)
+    {
+        // A clear resets the step counter, the events are in recording order so the next ones start again at 0
+        while (cursor < events.size() && events[cursor].step <= world.stepCount)
+        {
+            apply(world, events[cursor++]);
+            applied++;
+        }
+        world.step(FIXED_TIME_STEP);
+    }
+    return applied;
+}
+
+/**
+ * @return True when every recorded input was applied
+ */
+bool InputLog::isFinished()
+{
+    return cursor == events.size();
+}
+
+/**
+ * @brief Replay a recording without window nor rendering, and print how long the simulation took.
+ * Meant to be run under a profiler
+ * @param snapshotPath The snapshot taken when the recording started
+ * @param logPath The inputs recorded
+ * @param steps The number of steps to simulate
+ * @return False if a file can not be loaded
+ */
+bool InputLog::runHeadless(const std::string& snapshotPath, const std::string& logPath, int steps)
+{
+    InputLog log;
+    if (!log.load(logPath))
+    {
+        std::cout << "Can not load the input log " << logPath << std::endl;
+        return false;
+    }
+    PhysicsWorld world(log.arenaSize);
+    log.setupScene(world);
+    if (!Snapshot::load(world, snapshotPath))
+    {
+        std::cout << "Can not load the snapshot " << snapshotPath << std::endl;
+        return false;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    int applied = log.replay(world, steps);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+
+    std::cout << steps << " steps, " << applied << " inputs, " << world.bodies.size() << " bodies in "
+        << elapsed.count() << " ms (" << elapsed.count() / std::max(steps, 1) << " ms per step)" << std::endl;
+    std::cout << "Broad collisions: " << world.broadCollisionCount << ", narrow collisions: "
+        << world.narrowCollisionCount << std::endl;
+    return true;
+}
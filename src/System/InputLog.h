@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "PhysicsWorld.h"
+#include "Snapshot.h"
+
+// "FEIL" read as a little endian integer
+#define INPUT_LOG_MAGIC 0x4C494546u
+// Increased whenever a record of the log changes
+#define INPUT_LOG_VERSION 3u
+
+// Bits of InputLogHeader::scene, the static geometry present when the recording started
+#define INPUT_LOG_ARENA (1u << 0)
+#define INPUT_LOG_TERRAIN (1u << 1)
+
+enum InputType
+{
+    // target: shape type, flags: SNAPSHOT_CONTINUOUS_COLLISION, values: dimensions, position, initial force
+    AddBodyInput = 0,
+    // target: body id, values: force, application point
+    AddForceInput = 1,
+    // flags: SNAPSHOT_ settings bits
+    SettingsInput = 2,
+    ClearInput = 3,
+    // values[0]: spacing of the samples
+    TerrainInput = 4,
+    // target: index of the shape in InputLog::shapes, flags: SNAPSHOT_CONTINUOUS_COLLISION, values: position,
+    // initial force
+    AddShapeInput = 5
+};
+
+/**
+ * @brief One external input, applied before the step it was recorded at. Every field is 4 bytes wide
+ *
+ */
+struct InputEvent
+{
+    int32_t step;
+    uint32_t type;
+    int32_t target;
+    uint32_t flags;
+    float values[9];
+};
+
+/**
+ * @brief First bytes of a log file, followed by eventCount InputEvent records, shapeCount SnapshotShape records,
+ * vertexCount hull vertices of three floats, then materialCount SnapshotMaterial records
+ *
+ */
+struct InputLogHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t eventCount;
+    uint32_t scene;
+    float arenaSize;
+    float terrainSpacing;
+    uint32_t shapeCount;
+    uint32_t vertexCount;
+    uint32_t materialCount;
+};
+
+static_assert(sizeof(InputEvent) == 52, "The input event must not be padded");
+static_assert(sizeof(InputLogHeader) == 36, "The input log header must not be padded");
+
+/**
+ * @brief Every input given to a world, with the step it was applied at. Together with a snapshot of the world
+ * taken when the recording started, it replays the simulation without the GUI.
+ * The steps must be fixed for the replay to match, recordings are made in deterministic mode.
+ * Bodies of any shape, such as compounds or hulls, are described by shape records as in the snapshots. Their
+ * materials are copied in the log, so that the replay finds them even if the MaterialTable is not the same
+ *
+ */
+class InputLog
+{
+private:
+    // Next event to apply during a replay
+    size_t cursor = 0;
+
+    int addMaterial(int tableIndex);
+
+public:
+    std::vector<InputEvent> events;
+    // Shapes of the AddShapeInput events, their materials are indices in materials
+    std::vector<SnapshotShape> shapes;
+    // Vertices of the hulls of shapes, three coordinates each
+    std::vector<float> vertices;
+    std::vector<Material> materials;
+    // Index in the MaterialTable of each material of the log
+    std::vector<int> materialIndices;
+    bool recording = false;
+    uint32_t scene = 0;
+    float arenaSize = 0;
+    float terrainSpacing = 0;
+
+    static InputEvent addBodyEvent(ShapeType shapeType, Vector dimensions, Vector position, bool continuousCollision,
+                                   Vector force);
+    static InputEvent addForceEvent(int bodyId, Vector force, Vector pointApplication);
+    static InputEvent settingsEvent(uint32_t settings);
+    static InputEvent clearEvent();
+    static InputEvent terrainEvent(float spacing);
+    void apply(PhysicsWorld& world, const InputEvent& event);
+
+    void start(uint32_t scene, float arenaSize, float terrainSpacing);
+    void stop();
+    void submit(PhysicsWorld& world, InputEvent event);
+    bool submitShape(PhysicsWorld& world, Shape* shape, Vector position, bool continuousCollision, Vector force);
+    bool save(const std::string& path);
+    bool load(const std::string& path);
+
+    void setupScene(PhysicsWorld& world);
+    void rewind();
+    int replay(PhysicsWorld& world, int steps);
+    bool isFinished();
+    static bool runHeadless(const std::string& snapshotPath, const std::string& logPath, int steps);
+};
@@ -0,0 +1,105 @@
+#include "InstanceBuffer.h"
+
+#include <chrono>
+
+/**
+ * @brief Rebuild the instances from the bodies to draw
+ * @param bodies The bodies, with their interpolated pose
+ */
+void InstanceBuffer::fill(const std::vector<RenderBody>& bodies)
+{
+    for (auto& batch : instances)
+    {
+        batch.clear();
+    }
+    massCenters.clear();
+    massCenters.reserve(bodies.size());
+
+    const float massCenterColor[4] = {1, 1, 0, 1};
+    const Vector massCenterScale = Vector(MASS_CENTER_RADIUS, MASS_CENTER_RADIUS, MASS_CENTER_RADIUS);
+    for (const RenderBody& body : bodies)
+    {
+        float color[4] = {body.color[0] / 255.0f, body.color[1] / 255.0f, body.color[2] / 255.0f,
+                          BODY_ALPHA / 255.0f};
+        Quaternion orientation = body.orientation;
+        instances[body.shapeType].push_back(makeInstance(body.position, orientation, body.dimensions, color));
+
+        Vector realCenter = orientation.applyRotation(body.massCenter, orientation);
+        Vector position = body.position;
+        massCenters.push_back(makeInstance(position + realCenter, orientation, massCenterScale, massCenterColor));
+    }
+}
+
+/**
+ * @return The number of instances of every batch
+ */
+int InstanceBuffer::getInstanceCount()
+{
+    size_t count = massCenters.size();
+    for (auto& batch : instances)
+    {
+        count += batch.size();
+    }
+    return static_cast<int>(count);
+}
+
+/**
+ * @brief Build the attributes of an instance of a unit mesh
+ * @param position The translation
+ * @param orientation The rotation, normalized
+ * @param scale The scale along each axis of the mesh, applied before the rotation
+ * @param color The color, components between 0 and 1
+ * @return The instance
+ */
+InstanceData InstanceBuffer::makeInstance(Vector position, Quaternion orientation, Vector scale, const float color[4])
+{
+    // The lines of this matrix are the rotated axes, which are the columns of the model matrix
+    Matrix rotation = orientation.quatToMat();
+    const Vector* axes[3] = {&rotation.l1, &rotation.l2, &rotation.l3};
+    const float scales[3] = {scale.x, scale.y, scale.z};
+
+    InstanceData instance;
+    for (int column = 0; column < 3; column++)
+    {
+        instance.transform[column * 4] = axes[column]->x * scales[column];
+        instance.transform[column * 4 + 1] = axes[column]->y * scales[column];
+        instance.transform[column * 4 + 2] = axes[column]->z * scales[column];
+        instance.transform[column * 4 + 3] = 0;
+    }
+    instance.transform[12] = position.x;
+    instance.transform[13] = position.y;
+    instance.transform[14] = position.z;
+    instance.transform[15] = 1;
+    for (int c = 0; c < 4; c++) instance.color[c] = color[c];
+    return instance;
+}
+
+/**
+ * @brief Measure the fill of the instances without any window, for a pile of boxes and cones
+ * @param bodyCount The number of bodies
+ * @param frames The number of fills
+ * @return The average duration of a fill, in milliseconds
+ */
+double InstanceBuffer::benchmark(int bodyCount, int frames)
+{
+    std::vector<RenderBody> bodies(bodyCount);
+    for (int i = 0; i < bodyCount; i++)
+    {
+        RenderBody& body = bodies[i];
+        body.id = i;
+        body.shapeType = i % 3 == 0 ? ConeShape : BoxShape;
+        body.dimensions = body.shapeType == ConeShape ? Vector(20, 30, 20) : Vector(30, 20, 25);
+        body.position = Vector(i % 50 * 10, i / 50 % 50 * 10, i / 2500 * 10);
+        body.orientation = Quaternion(i * 0.1f, Vector(0, 1, 0));
+        body.massCenter = body.shapeType == ConeShape ? Vector(0, -7.5, 0) : Vector(0, 0, 0);
+    }
+
+    InstanceBuffer buffer;
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        buffer.fill(bodies);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() / std::max(frames, 1);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+
+#include "RenderFrame.h"
+
+// Radius of the sphere drawn at the center of mass of each body
+#define MASS_CENTER_RADIUS 5.0f
+// Opacity of the bodies, out of 255
+#define BODY_ALPHA 150
+
+/**
+ * @brief Per instance attributes of an instanced draw: a column major model matrix then a color, laid out as the
+ * vertex shader reads them
+ *
+ */
+struct InstanceData
+{
+    float transform[16];
+    float color[4];
+};
+
+/**
+ * @brief CPU side of the instanced rendering: the bodies of a frame grouped by shape type, one instance each, plus
+ * one sphere instance per center of mass. Independent of OpenGL so that the fill can run and be measured headless
+ *
+ */
+class InstanceBuffer
+{
+public:
+    // Indexed by ShapeType, the storage is kept from one fill to the next
+    std::vector<InstanceData> instances[ShapeTypeCount];
+    std::vector<InstanceData> massCenters;
+
+    void fill(const std::vector<RenderBody>& bodies);
+    int getInstanceCount();
+    static InstanceData makeInstance(Vector position, Quaternion orientation, Vector scale, const float color[4]);
+    static double benchmark(int bodyCount, int frames);
+};
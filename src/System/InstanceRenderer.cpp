@@ -0,0 +1,110 @@
+#include "InstanceRenderer.h"
+
+#include <cstddef>
+
+// First attribute location after the default ones of openFrameworks, the transform takes four of them
+#define INSTANCE_TRANSFORM_LOCATION 4
+#define INSTANCE_COLOR_LOCATION 8
+#define INITIAL_CAPACITY 256
+
+static const char* vertexShader = R"(
+#version 330
+uniform mat4 modelViewProjectionMatrix;
+in vec4 position;
+in vec3 normal;
+layout(location = 4) in mat4 instanceTransform;
+layout(location = 8) in vec4 instanceColor;
+out vec4 vertexColor;
+
+void main()
+{
+    // Same light for every face of a given orientation, brighter from above. Normals go through the inverse
+    // transpose of the transform: for a rotation times a scale, each column divided by its squared length
+    mat3 model = mat3(instanceTransform);
+    mat3 normalMatrix = mat3(model[0] / dot(model[0], model[0]), model[1] / dot(model[1], model[1]),
+                             model[2] / dot(model[2], model[2]));
+    vec3 worldNormal = normalize(normalMatrix * normal);
+    float light = 0.75 + 0.25 * worldNormal.y;
+    vertexColor = vec4(instanceColor.rgb * light, instanceColor.a);
+    gl_Position = modelViewProjectionMatrix * instanceTransform * position;
+}
+)";
+
+static const char* fragmentShader = R"(
+#version 330
+in vec4 vertexColor;
+out vec4 outputColor;
+
+void main()
+{
+    outputColor = vertexColor;
+}
+)";
+
+/**
+ * @brief Compile the shader and create the meshes and buffers, once the OpenGL context exists
+ */
+void InstanceRenderer::setup()
+{
+    shader.setupShaderFromSource(GL_VERTEX_SHADER, vertexShader);
+    shader.setupShaderFromSource(GL_FRAGMENT_SHADER, fragmentShader);
+    shader.bindDefaults();
+    shader.linkProgram();
+
+    setupBatch(boxes, ofBoxPrimitive(1, 1, 1).getMesh());
+    setupBatch(cones, ofConePrimitive(1, 1, 20, 20).getMesh());
+    setupBatch(massCenters, ofSpherePrimitive(1, 12).getMesh());
+}
+
+/**
+ * @brief Copy a unit mesh and bind the instance buffer to its per instance attributes
+ * @param batch The batch to set up
+ * @param mesh The unit mesh
+ */
+void InstanceRenderer::setupBatch(Batch& batch, const ofMesh& mesh)
+{
+    batch.mesh = mesh;
+    batch.capacity = INITIAL_CAPACITY;
+    batch.buffer.allocate(batch.capacity * sizeof(InstanceData), GL_DYNAMIC_DRAW);
+
+    ofVbo& vbo = batch.mesh.getVbo();
+    for (int column = 0; column < 4; column++)
+    {
+        vbo.setAttributeBuffer(INSTANCE_TRANSFORM_LOCATION + column, batch.buffer, 4, sizeof(InstanceData),
+                               column * 4 * sizeof(float));
+        vbo.setAttributeDivisor(INSTANCE_TRANSFORM_LOCATION + column, 1);
+    }
+    vbo.setAttributeBuffer(INSTANCE_COLOR_LOCATION, batch.buffer, 4, sizeof(InstanceData),
+                           offsetof(InstanceData, color));
+    vbo.setAttributeDivisor(INSTANCE_COLOR_LOCATION, 1);
+}
+
+/**
+ * @brief Upload the instances of a batch and draw them in one call. The GPU buffer doubles when it is too small
+ * @param batch The batch
+ * @param instances The instances to draw
+ */
+void InstanceRenderer::drawBatch(Batch& batch, const std::vector<InstanceData>& instances)
+{
+    if (instances.empty()) return;
+    if (instances.size() > batch.capacity)
+    {
+        while (batch.capacity < instances.size()) batch.capacity *= 2;
+        batch.buffer.allocate(batch.capacity * sizeof(InstanceData), GL_DYNAMIC_DRAW);
+    }
+    batch.buffer.updateData(0, instances.size() * sizeof(InstanceData), instances.data());
+    batch.mesh.drawInstanced(OF_MESH_FILL, static_cast<int>(instances.size()));
+}
+
+/**
+ * @brief Draw every batch, within the camera
+ * @param instances The filled instances
+ */
+void InstanceRenderer::draw(InstanceBuffer& instances)
+{
+    shader.begin();
+    drawBatch(massCenters, instances.massCenters);
+    drawBatch(boxes, instances.instances[BoxShape]);
+    drawBatch(cones, instances.instances[ConeShape]);
+    shader.end();
+}
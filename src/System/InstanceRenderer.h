@@ -0,0 +1,34 @@
+#pragma once
+#include "ofMain.h"
+
+#include "InstanceBuffer.h"
+
+/**
+ * @brief Draws an InstanceBuffer with one instanced draw call per batch: boxes, cones and centers of mass.
+ * Each batch has a unit mesh and a GPU buffer of instances, read by the vertex shader through per instance
+ * attributes. Needs an OpenGL 3.3 context
+ *
+ */
+class InstanceRenderer
+{
+private:
+    struct Batch
+    {
+        ofVboMesh mesh;
+        ofBufferObject buffer;
+        // Number of instances the GPU buffer can hold
+        size_t capacity = 0;
+    };
+
+    ofShader shader;
+    Batch boxes;
+    Batch cones;
+    Batch massCenters;
+
+    void setupBatch(Batch& batch, const ofMesh& mesh);
+    void drawBatch(Batch& batch, const std::vector<InstanceData>& instances);
+
+public:
+    void setup();
+    void draw(InstanceBuffer& instances);
+};
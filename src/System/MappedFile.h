@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief A read-only file mapped in memory. The content is paged in by the system on access, nothing is copied
+ *
+ */
+class MappedFile
+{
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int descriptor = -1;
+#endif
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+    const char* getData();
+    size_t getSize();
+};
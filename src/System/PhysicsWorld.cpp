@@ -0,0 +1,364 @@
+#include "PhysicsWorld.h"
+
+#include <algorithm>
+
+#include "CollisionManager.h"
+#include "ContinuousCollision.h"
+#include "TrajectoryWriter.h"
+
+PhysicsWorld::PhysicsWorld(float arenaSize) : octree(Vector(0, 0, 0), arenaSize, arenaSize, arenaSize, 0)
+{
+    this->arenaSize = arenaSize;
+}
+
+PhysicsWorld::~PhysicsWorld()
+{
+    clear();
+}
+
+/**
+ * @brief Add a body to the world, which takes its ownership. The body gets the next id
+ * @param body The body to add
+ */
+void PhysicsWorld::addBody(Shape* body)
+{
+    body->id = nextId++;
+    bodies.push_back(body);
+    octree.insert(body);
+    aabbTree.insert(body);
+}
+
+/**
+ * @brief Add a body that already has an id, such as one read from a snapshot. Bodies must be restored by
+ * increasing ids
+ * @param body The body to add
+ */
+void PhysicsWorld::restoreBody(Shape* body)
+{
+    nextId = std::max(nextId, body->id + 1);
+    bodies.push_back(body);
+    octree.insert(body);
+    aabbTree.insert(body);
+}
+
+/**
+ * @brief Add many bodies at once, which the world takes the ownership of. The storage grows once and the broad
+ * phases are rebuilt in a single pass instead of one insertion per body
+ * @param newBodies The bodies to add, they get consecutive ids in this order
+ */
+void PhysicsWorld::addBodies(const std::vector<Shape*>& newBodies)
+{
+    bodies.reserve(bodies.size() + newBodies.size());
+    for (Shape* body : newBodies)
+    {
+        body->id = nextId++;
+        bodies.push_back(body);
+    }
+
+    std::vector<RigidBody*> objects(bodies.begin(), bodies.end());
+    aabbTree.build(objects);
+    octree.clear();
+    for (auto object : bodies)
+    {
+        octree.insert(object);
+    }
+}
+
+/**
+ * @brief Give a generator to the world, which takes its ownership
+ * @param generator The generator to keep until the world is cleared
+ */
+void PhysicsWorld::addGenerator(ForceGenerator* generator)
+{
+    generators.push_back(generator);
+}
+
+/**
+ * @brief Apply a generator to a body at every step, until the world is cleared
+ * @param body The body of the world
+ * @param generator The generator, owned by the world or living longer than it
+ */
+void PhysicsWorld::addForce(RigidBody* body, ForceGenerator* generator)
+{
+    sceneForces.push_back({body, generator});
+}
+
+/**
+ * @brief Remove and delete every body, scene force and joint. The static geometry is kept
+ */
+void PhysicsWorld::clear()
+{
+    octree.clear();
+    aabbTree.clear();
+    forceRegistry.clear();
+    sceneForces.clear();
+    jointSolver.clear();
+    for (ForceGenerator* generator : generators)
+    {
+        delete generator;
+    }
+    generators.clear();
+    for (Shape* body : bodies)
+    {
+        delete body;
+    }
+    bodies.clear();
+    nextId = 0;
+    accumulator = 0;
+    stepCount = 0;
+    broadCollisionCount = narrowCollisionCount = 0;
+}
+
+/**
+ * @param id The id of the body
+ * @return The body with this id, or nullptr
+ */
+Shape* PhysicsWorld::findBody(int id)
+{
+    auto found = std::lower_bound(bodies.begin(), bodies.end(), id,
+                                  [](Shape* body, int value) { return body->id < value; });
+    return found != bodies.end() && (*found)->id == id ? *found : nullptr;
+}
+
+/**
+ * @brief Simulate one step: collisions, boundaries, forces, joints then integration
+ * @param delta_t The duration of the step
+ */
+void PhysicsWorld::step(float delta_t)
+{
+    collisionHandler(delta_t);
+    checkBoundaries();
+    updateForces(delta_t);
+    jointSolver.solve(delta_t);
+    float maxDisplacement = prepareContinuous(delta_t);
+    for (auto object : bodies)
+    {
+        if (object->continuousCollision) integrateContinuous(object, delta_t, maxDisplacement);
+        else object->eulerIntegration(delta_t);
+    }
+    stepCount++;
+    if (trajectoryWriter != nullptr) trajectoryWriter->record(*this);
+}
+
+/**
+ * @brief Simulate the time elapsed during a frame. In deterministic mode, the time is accumulated and simulated by
+ * steps of FIXED_TIME_STEP, otherwise a single step of the frame duration is done
+ * @param frameTime The simulated duration of the frame
+ * @return The number of steps done
+ */
+int PhysicsWorld::advance(float frameTime)
+{
+    if (!deterministic)
+    {
+        step(frameTime);
+        return 1;
+    }
+
+    accumulator += frameTime;
+    int steps = 0;
+    while (accumulator >= FIXED_TIME_STEP && steps < MAX_STEPS_PER_FRAME)
+    {
+        step(FIXED_TIME_STEP);
+        accumulator -= FIXED_TIME_STEP;
+        steps++;
+    }
+    if (steps == MAX_STEPS_PER_FRAME) accumulator = 0;
+    return steps;
+}
+
+/**
+ * @brief Register and apply the enabled forces to every body
+ */
+void PhysicsWorld::updateForces(float delta_t)
+{
+    for (auto& object : bodies)
+    {
+        if (gravity) forceRegistry.add(object, &gravityGenerator);
+        if (friction) forceRegistry.add(object, &frictionGenerator);
+    }
+    for (auto& registration : sceneForces)
+    {
+        forceRegistry.add(registration.object, registration.fg);
+    }
+    forceRegistry.updateForces(delta_t);
+}
+
+/**
+ * @brief Handle the collision detection and resolve
+ */
+void PhysicsWorld::collisionHandler(float delta_t)
+{
+    for (auto object : bodies)
+    {
+        object->contactCount = 0;
+    }
+    if (!collisions) return;
+
+    std::vector<std::pair<RigidBody*, RigidBody*>> colls;
+    if (useAABBTree)
+    {
+        // The tree is kept between frames, only the objects that left their fat box are reinserted
+        for (auto object : bodies)
+        {
+            aabbTree.update(object, object->linearVelocity * delta_t);
+        }
+        colls = aabbTree.getCollisions();
+    }
+    else
+    {
+        octree.clear();
+
+        for (auto object : bodies)
+        {
+            octree.insert(object);
+        }
+        colls = octree.getCollisions();
+    }
+    auto narrowColls = CollisionManager::getNarrowCollision(colls, delta_t);
+
+    // The static geometry has its own hierarchy, nothing to update
+    std::vector<Contact> staticContacts;
+    for (auto object : bodies)
+    {
+        staticWorld.getContacts(*object, staticContacts);
+    }
+    for (auto& contact : staticContacts)
+    {
+        CollisionManager::resolveStaticContact(contact);
+        contact.first->contactCount++;
+    }
+    for (auto& pair : narrowColls)
+    {
+        pair.first->contactCount++;
+        pair.second->contactCount++;
+    }
+
+    broadCollisionCount += colls.size();
+    narrowCollisionCount += narrowColls.size();
+}
+
+/**
+ * @brief Checks if the objects are out of bounds
+ */
+void PhysicsWorld::checkBoundaries()
+{
+    for (auto box : bodies)
+    {
+        // Check X borders
+        if (glm::abs(box->position.x) > arenaSize)
+        {
+            box->position.x = glm::sign(box->position.x) > 0 ? arenaSize : -arenaSize;
+            box->linearVelocity.x *= -1;
+        }
+
+        // Check Y borders
+        if (abs(box->position.y) > arenaSize)
+        {
+            box->position.y = glm::sign(box->position.y) > 0 ? arenaSize : -arenaSize;
+            box->linearVelocity.y *= -1;
+        }
+
+        // Check Z borders
+        if (abs(box->position.z) > arenaSize)
+        {
+            box->position.z = glm::sign(box->position.z) > 0 ? arenaSize : -arenaSize;
+            box->linearVelocity.z *= -1;
+        }
+
+        // A velocity cap check to make sure that the object doesn't go too fast and cross the boundaries (glitching visuals)
+        // Objects with continuous collisions are swept against the boundaries instead
+        if (!box->continuousCollision && box->linearVelocity.magnitude() > MAX_VELOCITY)
+        {
+            box->linearVelocity = box->linearVelocity.normalized() * MAX_VELOCITY;
+        }
+    }
+}
+
+/**
+ * @brief Bring the AABB tree up to date for the sweeps of the continuous collisions, when the collision pass did
+ * not already do it
+ * @param delta_t The duration of the step
+ * @return The largest displacement of a body during the step, 0 if no body has continuous collisions
+ */
+float PhysicsWorld::prepareContinuous(float delta_t)
+{
+    bool continuous = false;
+    float maxDisplacement = 0;
+    for (auto object : bodies)
+    {
+        continuous = continuous || object->continuousCollision;
+        maxDisplacement = std::max(maxDisplacement, (object->linearVelocity + object->accumForce * delta_t).magnitude());
+    }
+    if (!continuous) return 0;
+
+    if (!useAABBTree || !collisions)
+    {
+        for (auto object : bodies)
+        {
+            aabbTree.update(object, object->linearVelocity * delta_t);
+        }
+    }
+    return maxDisplacement * delta_t;
+}
+
+/**
+ * @brief Integrate an object, stopping it at its first impact of the step with a static plane or another object.
+ * The planes bounce the object back, the contacts with objects are resolved by the next collision pass.
+ * The other objects are found with the AABB tree around the swept bounds
+ * @param object The object to integrate
+ * @param delta_t The duration of the step
+ * @param maxDisplacement The largest displacement of a body during the step
+ */
+void PhysicsWorld::integrateContinuous(Shape* object, float delta_t, float maxDisplacement)
+{
+    Vector start = object->position;
+    // Motion of the step, with the velocity the integrator is about to use
+    Vector displacement = (object->linearVelocity + object->accumForce * delta_t) * delta_t;
+
+    float toi = 1;
+    Vector hitWall;
+    for (auto plane : staticWorld.planes)
+    {
+        float wallToi;
+        if (ContinuousCollision::sweptShapePlane(*object, displacement, plane->normal, plane->offset, wallToi)
+            && wallToi < toi)
+        {
+            toi = wallToi;
+            hitWall = plane->normal;
+        }
+    }
+
+    AABB sweptBounds = object->getBounds().extended(displacement);
+    // The others move by up to maxDisplacement during the step, and the ones already integrated may have left their
+    // leaf by as much
+    std::vector<RigidBody*>& candidates = continuousCandidates;
+    candidates.clear();
+    aabbTree.queryOverlap(sweptBounds.fattened(2 * maxDisplacement), candidates);
+    // Same order as the bodies, so that equal times of impact keep the same winner
+    std::sort(candidates.begin(), candidates.end(),
+              [](RigidBody* first, RigidBody* second) { return first->id < second->id; });
+    for (auto candidate : candidates)
+    {
+        Shape* other = static_cast<Shape*>(candidate);
+        if (other == object) continue;
+        Vector otherDisplacement = other->linearVelocity * delta_t;
+        if (!sweptBounds.overlaps(other->getBounds().extended(otherDisplacement))) continue;
+
+        float bodyToi;
+        if (ContinuousCollision::timeOfImpact(*object, displacement, *other, otherDisplacement, bodyToi)
+            && bodyToi < toi)
+        {
+            toi = bodyToi;
+            hitWall = Vector(0, 0, 0);
+        }
+    }
+
+    object->eulerIntegration(delta_t);
+    if (toi < 1)
+    {
+        object->position = start + displacement * toi;
+        // Same bounce as checkBoundaries, the velocity along the wall normal is flipped
+        object->linearVelocity -= hitWall * (2 * (object->linearVelocity * hitWall));
+        object->updateBounds();
+    }
+}
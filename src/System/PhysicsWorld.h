@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+
+#include "AABBTree.h"
+#include "ForceRegistry.h"
+#include "FrictionGenerator.h"
+#include "GravityGenerator.h"
+#include "JointSolver.h"
+#include "Octree.h"
+#include "Shape.h"
+#include "StaticWorld.h"
+
+// Time step of the deterministic mode, independent of the frame rate
+#define FIXED_TIME_STEP (1.0f / 60.0f)
+// A slow frame runs at most this many fixed steps, the remaining time is dropped
+#define MAX_STEPS_PER_FRAME 8
+// Only applied to the objects without continuous collisions
+#define MAX_VELOCITY 1000.0f
+
+class TrajectoryWriter;
+
+/**
+ * @brief The simulated scene: the bodies, the forces applied to them, the broad phases and the static geometry.
+ * It does not depend on the frame timing, the caller gives the duration of each step.
+ * Bodies get a stable id when added, and every ordering used during a step (bodies, pairs, contacts) follows
+ * these ids, so that identical inputs give identical states
+ *
+ */
+class PhysicsWorld
+{
+    // Saves and restores the ids and the time not yet simulated
+    friend class Snapshot;
+
+private:
+    int nextId = 0;
+    // Frame time not yet simulated by fixed steps
+    float accumulator = 0;
+    GravityGenerator gravityGenerator = GravityGenerator(Vector(0, -9.81, 0));
+    FrictionGenerator frictionGenerator = FrictionGenerator(0.1);
+    // Bodies around the sweep of a continuous body, kept between steps to avoid reallocations
+    std::vector<RigidBody*> continuousCandidates;
+
+    void updateForces(float delta_t);
+    void collisionHandler(float delta_t);
+    void checkBoundaries();
+    float prepareContinuous(float delta_t);
+    void integrateContinuous(Shape* object, float delta_t, float maxDisplacement);
+
+public:
+    // Half size of the arena
+    float arenaSize;
+    // Sorted by id
+    std::vector<Shape*> bodies;
+    ForceRegistry forceRegistry;
+    Octree octree;
+    // Unbounded broad phase, selectable instead of the octree
+    AABBTree aabbTree;
+    // Immovable geometry, built once and never reinserted
+    StaticWorld staticWorld;
+
+    // Settings, driven by the GUI
+    bool gravity = false;
+    bool friction = false;
+    bool collisions = true;
+    bool useAABBTree = false;
+    // Fixed time step only, frame times are accumulated and simulated by whole steps
+    bool deterministic = false;
+
+    int broadCollisionCount = 0;
+    int narrowCollisionCount = 0;
+    // Number of steps simulated since the world was created or cleared
+    int stepCount = 0;
+    // Generators created by the scene, owned by the world
+    std::vector<ForceGenerator*> generators;
+    // Registered again at each step, unlike the gravity and friction registrations driven by the settings
+    std::vector<ForceRegistry::ForceRegistration> sceneForces;
+    // Joints between the bodies, solved after the forces and before the integration
+    JointSolver jointSolver;
+    // Receives the state of the bodies after each step when set, not owned
+    TrajectoryWriter* trajectoryWriter = nullptr;
+
+    explicit PhysicsWorld(float arenaSize);
+    ~PhysicsWorld();
+
+    void addBody(Shape* body);
+    void restoreBody(Shape* body);
+    void addBodies(const std::vector<Shape*>& newBodies);
+    void addGenerator(ForceGenerator* generator);
+    void addForce(RigidBody* body, ForceGenerator* generator);
+    void clear();
+    Shape* findBody(int id);
+    void step(float delta_t);
+    int advance(float frameTime);
+};
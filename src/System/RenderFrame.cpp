@@ -0,0 +1,147 @@
+#include "RenderFrame.h"
+
+#include "Box.h"
+#include "Cone.h"
+
+/**
+ * @brief Copy the state of the world needed to draw it
+ * @param world The world, which must not be stepped during the capture
+ * @param withBroadPhase Whether to copy the boxes of the broad phase in use
+ */
+void RenderFrame::capture(PhysicsWorld& world, bool withBroadPhase)
+{
+    bodies.resize(world.bodies.size());
+    for (size_t i = 0; i < world.bodies.size(); i++)
+    {
+        Shape* body = world.bodies[i];
+        RenderBody& render = bodies[i];
+        render.id = body->id;
+        render.shapeType = body->shapeType;
+        for (int c = 0; c < 3; c++) render.color[c] = body->color[c];
+        if (body->shapeType == BoxShape)
+        {
+            Box* box = static_cast<Box*>(body);
+            render.dimensions = Vector(box->getWidth(), box->getHeight(), box->getDepth());
+        }
+        else if (body->shapeType == ConeShape)
+        {
+            Cone* cone = static_cast<Cone*>(body);
+            render.dimensions = Vector(cone->getRadius(), cone->getHeight(), cone->getRadius());
+        }
+        render.position = body->position;
+        render.orientation = body->orientation;
+        render.massCenter = body->massCenter;
+        render.linearVelocity = body->linearVelocity;
+        render.bounds = body->getBounds();
+    }
+
+    broadPhaseBoxes.clear();
+    broadPhaseNodes.clear();
+    if (withBroadPhase)
+    {
+        if (world.useAABBTree) world.aabbTree.getBoxes(broadPhaseBoxes, broadPhaseNodes);
+        else world.octree.getBoxes(broadPhaseBoxes);
+    }
+    stepCount = world.stepCount;
+    broadCollisionCount = world.broadCollisionCount;
+    narrowCollisionCount = world.narrowCollisionCount;
+}
+
+/**
+ * @brief Blend the pose of a body between two frames
+ * @param previous The body in the older frame
+ * @param current The body in the newer frame, which gives every other property
+ * @param alpha 0 for the older pose, 1 for the newer one
+ * @return The blended body
+ */
+RenderBody RenderFrame::interpolate(const RenderBody& previous, const RenderBody& current, float alpha)
+{
+    RenderBody blended = current;
+    Vector from = previous.position;
+    Vector to = current.position;
+    blended.position = from * (1 - alpha) + to * alpha;
+
+    // Normalized linear blend, along the shortest arc
+    Quaternion start = previous.orientation;
+    Quaternion end = current.orientation;
+    if (start.scalarProduct(end) < 0) end = end * -1;
+    blended.orientation = (start * (1 - alpha) + end * alpha).normalize();
+    return blended;
+}
+
+/**
+ * @brief Blend the bodies of two frames, matched by id. The bodies missing from the older frame are taken as is
+ * @param previous The older frame
+ * @param current The newer frame, which gives the bodies to draw
+ * @param alpha 0 for the older poses, 1 for the newer ones
+ * @param bodies Receives the blended bodies, sorted by id
+ */
+void RenderFrame::interpolate(const RenderFrame& previous, const RenderFrame& current, float alpha,
+                              std::vector<RenderBody>& bodies)
+{
+    bodies.clear();
+    bodies.reserve(current.bodies.size());
+    size_t previousIndex = 0;
+    for (auto& body : current.bodies)
+    {
+        // Both frames are sorted by id
+        while (previousIndex < previous.bodies.size() && previous.bodies[previousIndex].id < body.id) previousIndex++;
+        if (previousIndex < previous.bodies.size() && previous.bodies[previousIndex].id == body.id)
+        {
+            bodies.push_back(interpolate(previous.bodies[previousIndex], body, alpha));
+        }
+        else
+        {
+            bodies.push_back(body);
+        }
+    }
+}
+
+/**
+ * @return The frame the simulation fills, only used by the simulation side
+ */
+RenderFrame& RenderBuffer::getWriteFrame()
+{
+    return frames[writeIndex];
+}
+
+/**
+ * @brief Make the write frame the latest one, replacing a published frame the renderer did not take yet
+ */
+void RenderBuffer::publish()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::swap(writeIndex, readyIndex);
+    fresh = true;
+}
+
+/**
+ * @brief Take the latest published frame, if there is a new one. The current frame becomes the previous one
+ * @return True if the current frame changed
+ */
+bool RenderBuffer::acquire()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!fresh) return false;
+    // The read frame is only used by the renderer, its content is kept and its storage reused
+    std::swap(previous, frames[readIndex]);
+    std::swap(readIndex, readyIndex);
+    fresh = false;
+    return true;
+}
+
+/**
+ * @return The latest acquired frame, only used by the renderer
+ */
+const RenderFrame& RenderBuffer::getCurrent()
+{
+    return frames[readIndex];
+}
+
+/**
+ * @return The frame acquired before the current one, only used by the renderer
+ */
+const RenderFrame& RenderBuffer::getPrevious()
+{
+    return previous;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <mutex>
+#include <vector>
+
+#include "AABB.h"
+#include "PhysicsWorld.h"
+#include "Quaternion.h"
+
+/**
+ * @brief What the renderer needs to know about a body, copied out of the world after a step
+ *
+ */
+struct RenderBody
+{
+    int id = -1;
+    ShapeType shapeType = SphereShape;
+    int color[3] = {255, 255, 255};
+    // Box width, height and depth, or cone radius, height and radius
+    Vector dimensions;
+    Vector position;
+    Quaternion orientation = Quaternion(1, 0, 0, 0);
+    // In the body frame
+    Vector massCenter;
+    Vector linearVelocity;
+    AABB bounds;
+};
+
+/**
+ * @brief An immutable picture of the world after a step, drawn while the next steps are simulated
+ *
+ */
+struct RenderFrame
+{
+    // Sorted by id
+    std::vector<RenderBody> bodies;
+    // Captured only when requested: the leaves and octree cells, then the internal nodes of the AABB tree
+    std::vector<AABB> broadPhaseBoxes;
+    std::vector<AABB> broadPhaseNodes;
+    int stepCount = 0;
+    int broadCollisionCount = 0;
+    int narrowCollisionCount = 0;
+    // Steady clock time of the publication, in seconds
+    double time = 0;
+
+    void capture(PhysicsWorld& world, bool withBroadPhase);
+    static RenderBody interpolate(const RenderBody& previous, const RenderBody& current, float alpha);
+    static void interpolate(const RenderFrame& previous, const RenderFrame& current, float alpha,
+                            std::vector<RenderBody>& bodies);
+};
+
+/**
+ * @brief Triple buffer of render frames. The simulation fills the write frame and publishes it, the renderer
+ * acquires the latest published frame. Neither side waits for the other, only the indices are swapped under the lock.
+ * The renderer also keeps the frame it had before, to interpolate between the two
+ *
+ */
+class RenderBuffer
+{
+private:
+    RenderFrame frames[3];
+    int writeIndex = 0;
+    int readyIndex = 1;
+    int readIndex = 2;
+    // Whether the ready frame was published since the last acquire
+    bool fresh = false;
+    std::mutex mutex;
+    RenderFrame previous;
+
+public:
+    RenderFrame& getWriteFrame();
+    void publish();
+    bool acquire();
+    const RenderFrame& getCurrent();
+    const RenderFrame& getPrevious();
+};
@@ -0,0 +1,405 @@
+#include "SceneLoader.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+
+#include "BallSocketJoint.h"
+#include "Box.h"
+#include "Compound.h"
+#include "Cone.h"
+#include "ConvexHull.h"
+#include "ElectrostaticGenerator.h"
+#include "FixedJoint.h"
+#include "FrictionGenerator.h"
+#include "GravityGenerator.h"
+#include "HingeJoint.h"
+#include "Material.h"
+#include "MutualGravityGenerator.h"
+#include "SliderJoint.h"
+#include "SpringGenerator.h"
+
+/**
+ * @brief Body properties shared by the bodies referencing the material
+ */
+struct SceneMaterial
+{
+    float mass = 1;
+    int color[3] = {255, 255, 255};
+    bool continuousCollision = false;
+    float charge = 0;
+    // Surface properties, added to the MaterialTable once the whole scene is valid
+    Material surface;
+    // Index of the surface in the MaterialTable, the default material for the bodies without any
+    int index = 0;
+    // The mass and inertia come from the density and the shape instead of the mass
+    bool hasDensity = false;
+};
+
+/**
+ * @brief A body or a child of a compound, which gets the index and mass of its material once the materials are
+ * in the MaterialTable
+ */
+struct SceneShape
+{
+    Shape* shape;
+    const SceneMaterial* material;
+};
+
+/**
+ * @brief A force or a spring of the file, applied once the bodies exist
+ */
+struct SceneForce
+{
+    ForceGenerator* generator;
+    int body;
+};
+
+/**
+ * @brief Read the name of a combine mode
+ */
+static CombineMode readCombineMode(const ofJson& description, const char* key)
+{
+    std::string name = description.value(key, std::string("average"));
+    if (name == "average") return CombineAverage;
+    if (name == "minimum") return CombineMinimum;
+    if (name == "multiply") return CombineMultiply;
+    if (name == "maximum") return CombineMaximum;
+    throw std::invalid_argument(key);
+}
+
+static Vector readVector(const ofJson& value, Vector fallback)
+{
+    if (!value.is_array() || value.size() != 3) return fallback;
+    return Vector(value[0].get<float>(), value[1].get<float>(), value[2].get<float>());
+}
+
+/**
+ * @brief Read the number of copies of a body along each axis of its grid
+ * @param grid The grid, without a count for a single body
+ * @return The counts, which are positive integers
+ */
+static Vector readGridCount(const ofJson& grid)
+{
+    Vector count = readVector(grid.value("count", ofJson()), Vector(1, 1, 1));
+    for (float axisCount : {count.x, count.y, count.z})
+    {
+        // Negative, fractional, infinite or NaN counts would be undefined once converted to an integer
+        if (!std::isfinite(axisCount) || axisCount < 1 || axisCount != std::floor(axisCount))
+        {
+            throw std::invalid_argument("count");
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Change the mass of a body, scaling its inertia tensor with it
+ */
+static void setBodyMass(Shape* body, float mass)
+{
+    float scale = mass * body->inversedMass;
+    body->tenseurJ = Matrix(body->tenseurJ.l1 * scale, body->tenseurJ.l2 * scale, body->tenseurJ.l3 * scale);
+    body->inversedTenseurJ = body->tenseurJ.inverse();
+    body->setMass(mass);
+}
+
+/**
+ * @brief Find the material named by a body
+ * @param fallback The material of the bodies without any
+ */
+static const SceneMaterial& findMaterial(const ofJson& description, const SceneMaterial& fallback,
+                                         const std::map<std::string, SceneMaterial>& materials)
+{
+    std::string name = description.value("material", std::string());
+    if (name.empty()) return fallback;
+    auto found = materials.find(name);
+    if (found == materials.end()) throw std::invalid_argument("material");
+    return found->second;
+}
+
+/**
+ * @brief Give a body the index of its material, and the mass of the material or the one of its shape
+ */
+static void applyMaterial(Shape* body, const SceneMaterial& material)
+{
+    body->material = material.index;
+    if (material.hasDensity || body->shapeType == CompoundShape) body->updateMassProperties();
+    else if (material.mass != 1) setBodyMass(body, material.mass);
+}
+
+/**
+ * @brief Create the body described by an entry of the bodies section, or by a child of a compound. Its material
+ * is applied later, by applyMaterial
+ * @param shapes The created bodies and children with their material, the children of a compound before it
+ * @return The body, or nullptr if the shape is unknown
+ */
+static Shape* createBody(const ofJson& description, const SceneMaterial& material,
+                         const std::map<std::string, SceneMaterial>& materials, std::vector<SceneShape>& shapes)
+{
+    std::string shape = description.at("shape").get<std::string>();
+    Shape* body;
+    if (shape == "compound")
+    {
+        // Children are placed by their offset and orientation in the compound
+        std::unique_ptr<Compound> compound(new Compound());
+        for (auto& childDescription : description.at("children"))
+        {
+            const SceneMaterial& childMaterial = findMaterial(childDescription, material, materials);
+            Shape* child = createBody(childDescription, childMaterial, materials, shapes);
+            if (child == nullptr) return nullptr;
+            compound->addChild(child, readVector(childDescription.value("offset", ofJson()), Vector(0, 0, 0)),
+                               child->orientation);
+        }
+        if (compound->children.empty()) return nullptr;
+        body = compound.release();
+    }
+    else if (shape == "box")
+    {
+        Vector size = readVector(description.value("size", ofJson()), Vector(1, 1, 1));
+        body = new Box(size.x, size.y, size.z);
+    }
+    else if (shape == "cone")
+    {
+        body = new Cone(description.value("radius", 1.0f), description.value("height", 1.0f));
+    }
+    else if (shape == "hull")
+    {
+        std::vector<Vector> points;
+        for (auto& point : description.at("points"))
+        {
+            if (!point.is_array() || point.size() != 3) return nullptr;
+            points.push_back(readVector(point, Vector(0, 0, 0)));
+        }
+        std::unique_ptr<ConvexHull> hull(new ConvexHull(points, description.value("maxVertices", HULL_MAX_VERTICES)));
+        if (!hull->isValid()) return nullptr;
+        body = hull.release();
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    for (int c = 0; c < 3; c++) body->color[c] = material.color[c];
+    body->continuousCollision = description.value("continuousCollision", material.continuousCollision);
+    body->charge = description.value("charge", material.charge);
+    body->linearVelocity = readVector(description.value("velocity", ofJson()), body->linearVelocity);
+    body->angularVelocity = readVector(description.value("angularVelocity", ofJson()), body->angularVelocity);
+    if (description.contains("orientation"))
+    {
+        auto& orientation = description["orientation"];
+        body->orientation = Quaternion(orientation.at(0).get<float>(), orientation.at(1).get<float>(),
+                                       orientation.at(2).get<float>(), orientation.at(3).get<float>());
+    }
+    shapes.push_back({body, &material});
+    return body;
+}
+
+/**
+ * @brief Load a scene file, see SceneLoader for the format
+ * @param world The world to fill
+ * @param path The path of the JSON file
+ * @return False if the file can not be read or is not a valid scene, the world is then left untouched
+ */
+bool SceneLoader::loadFile(PhysicsWorld& world, const std::string& path)
+{
+    ofJson scene = ofLoadJson(path);
+    if (scene.is_null()) return false;
+    return load(world, scene);
+}
+
+/**
+ * @brief Replace the bodies and scene forces of a world with the ones of a scene, see SceneLoader for the format.
+ * The static geometry is kept
+ * @param world The world to fill
+ * @param scene The parsed scene
+ * @return False if the scene is not valid, the world is then left untouched
+ */
+bool SceneLoader::load(PhysicsWorld& world, const ofJson& scene)
+{
+    if (!scene.is_object()) return false;
+
+    std::vector<Shape*> bodies;
+    std::vector<ForceGenerator*> generators;
+    std::vector<SceneForce> forces;
+    std::vector<Joint*> joints;
+    std::map<std::string, SceneMaterial> materials;
+    SceneMaterial defaultMaterial;
+    std::vector<SceneShape> shapes;
+    try
+    {
+        const ofJson& materialDescriptions = scene.value("materials", ofJson::object());
+        for (auto& entry : materialDescriptions.items())
+        {
+            SceneMaterial& material = materials[entry.key()];
+            material.mass = entry.value().value("mass", 1.0f);
+            if (material.mass <= 0) throw std::invalid_argument("mass");
+            Vector color = readVector(entry.value().value("color", ofJson()), Vector(255, 255, 255));
+            material.color[0] = static_cast<int>(color.x);
+            material.color[1] = static_cast<int>(color.y);
+            material.color[2] = static_cast<int>(color.z);
+            material.continuousCollision = entry.value().value("continuousCollision", false);
+            material.charge = entry.value().value("charge", 0.0f);
+
+            Material& surface = material.surface;
+            surface.restitution = entry.value().value("restitution", DEFAULT_RESTITUTION);
+            surface.staticFriction = entry.value().value("staticFriction", DEFAULT_STATIC_FRICTION);
+            surface.dynamicFriction = entry.value().value("dynamicFriction", DEFAULT_DYNAMIC_FRICTION);
+            surface.density = entry.value().value("density", DEFAULT_DENSITY);
+            material.hasDensity = entry.value().contains("density");
+            surface.restitutionCombine = readCombineMode(entry.value(), "restitutionCombine");
+            surface.frictionCombine = readCombineMode(entry.value(), "frictionCombine");
+            if (surface.restitution < 0 || surface.staticFriction < 0 || surface.dynamicFriction < 0
+                || surface.density <= 0)
+            {
+                throw std::invalid_argument("material");
+            }
+        }
+
+        // Count first, so that the bodies are allocated in one go
+        const ofJson& descriptions = scene.value("bodies", ofJson::array());
+        // The total is computed in double and bounded, the bodies are referenced by int indices
+        double total = 0;
+        for (auto& description : descriptions)
+        {
+            Vector count = readGridCount(description.value("grid", ofJson::object()));
+            total += static_cast<double>(count.x) * count.y * count.z;
+        }
+        if (total > std::numeric_limits<int>::max()) throw std::invalid_argument("count");
+        bodies.reserve(static_cast<size_t>(total));
+
+        for (auto& description : descriptions)
+        {
+            const SceneMaterial& material = findMaterial(description, defaultMaterial, materials);
+
+            Vector position = readVector(description.value("position", ofJson()), Vector(0, 0, 0));
+            const ofJson& grid = description.value("grid", ofJson::object());
+            Vector count = readGridCount(grid);
+            Vector spacing = readVector(grid.value("spacing", ofJson()), Vector(0, 0, 0));
+            for (int x = 0; x < static_cast<int>(count.x); x++)
+            {
+                for (int y = 0; y < static_cast<int>(count.y); y++)
+                {
+                    for (int z = 0; z < static_cast<int>(count.z); z++)
+                    {
+                        Shape* body = createBody(description, material, materials, shapes);
+                        if (body == nullptr) throw std::invalid_argument("shape");
+                        body->position = position + Vector(x * spacing.x, y * spacing.y, z * spacing.z);
+                        body->updateBounds();
+                        bodies.push_back(body);
+                    }
+                }
+            }
+        }
+
+        int bodyCount = static_cast<int>(bodies.size());
+        auto checkBody = [bodyCount](int body)
+        {
+            if (body < 0 || body >= bodyCount) throw std::out_of_range("body");
+            return body;
+        };
+
+        for (auto& description : scene.value("forces", ofJson::array()))
+        {
+            std::string type = description.at("type").get<std::string>();
+            ForceGenerator* generator;
+            if (type == "gravity")
+            {
+                generator = new GravityGenerator(readVector(description.value("vector", ofJson()), Vector(0, -9.81, 0)));
+            }
+            else if (type == "friction")
+            {
+                generator = new FrictionGenerator(description.value("k", 0.1f));
+            }
+            else if (type == "mutualGravity")
+            {
+                generator = new MutualGravityGenerator(description.value("G", 1.0f),
+                                                       description.value("openingAngle", DEFAULT_OPENING_ANGLE),
+                                                       description.value("softening", 1.0f));
+            }
+            else if (type == "electrostatic")
+            {
+                generator = new ElectrostaticGenerator(description.value("k", 1.0f),
+                                                       description.value("openingAngle", DEFAULT_OPENING_ANGLE),
+                                                       description.value("softening", 1.0f));
+            }
+            else
+            {
+                throw std::invalid_argument("force");
+            }
+            generators.push_back(generator);
+
+            if (description.contains("bodies"))
+            {
+                for (auto& body : description["bodies"]) forces.push_back({generator, checkBody(body.get<int>())});
+            }
+            else
+            {
+                for (int body = 0; body < bodyCount; body++) forces.push_back({generator, body});
+            }
+        }
+
+        // A spring is made of one generator for each end
+        auto addSprings = [&](const char* section, bool rod)
+        {
+            for (auto& description : scene.value(section, ofJson::array()))
+            {
+                int first = checkBody(description.at("bodies").at(0).get<int>());
+                int second = checkBody(description.at("bodies").at(1).get<int>());
+                float k = rod ? SCENE_ROD_STIFFNESS : description.value("k", 1.0f);
+                float damping = rod ? SCENE_ROD_DAMPING : description.value("damping", 0.0f);
+                float length = description.value("length", bodies[first]->position.distance(bodies[second]->position));
+                generators.push_back(new SpringGenerator(k, length, bodies[second], damping));
+                forces.push_back({generators.back(), first});
+                generators.push_back(new SpringGenerator(k, length, bodies[first], damping));
+                forces.push_back({generators.back(), second});
+            }
+        };
+        addSprings("springs", false);
+        addSprings("rods", true);
+
+        for (auto& description : scene.value("joints", ofJson::array()))
+        {
+            std::string type = description.at("type").get<std::string>();
+            const ofJson& jointBodies = description.at("bodies");
+            Shape* first = bodies[checkBody(jointBodies.at(0).get<int>())];
+            Shape* second = jointBodies.size() > 1 ? bodies[checkBody(jointBodies.at(1).get<int>())] : nullptr;
+            Vector anchor = readVector(description.value("anchor", ofJson()),
+                                       second != nullptr ? second->position : first->position);
+            Vector axis = readVector(description.value("axis", ofJson()), Vector(0, 1, 0));
+            if (type == "ballSocket") joints.push_back(new BallSocketJoint(first, second, anchor));
+            else if (type == "hinge") joints.push_back(new HingeJoint(first, second, anchor, axis));
+            else if (type == "slider") joints.push_back(new SliderJoint(first, second, anchor, axis));
+            else if (type == "fixed") joints.push_back(new FixedJoint(first, second, anchor));
+            else throw std::invalid_argument("joint");
+        }
+    }
+    catch (const std::exception&)
+    {
+        for (Shape* body : bodies) delete body;
+        for (ForceGenerator* generator : generators) delete generator;
+        for (Joint* joint : joints) delete joint;
+        return false;
+    }
+
+    // A scene that fails leaves no material behind, the bodies get their materials only now
+    for (auto& entry : materials) entry.second.index = MaterialTable::add(entry.second.surface);
+    for (auto& shape : shapes) applyMaterial(shape.shape, *shape.material);
+
+    world.clear();
+    if (scene.contains("settings"))
+    {
+        const ofJson& settings = scene["settings"];
+        world.gravity = settings.value("gravity", world.gravity);
+        world.friction = settings.value("friction", world.friction);
+        world.collisions = settings.value("collisions", world.collisions);
+        world.useAABBTree = settings.value("aabbTree", world.useAABBTree);
+        world.deterministic = settings.value("deterministic", world.deterministic);
+    }
+    world.addBodies(bodies);
+    for (ForceGenerator* generator : generators) world.addGenerator(generator);
+    for (auto& force : forces) world.addForce(bodies[force.body], force.generator);
+    for (Joint* joint : joints) world.jointSolver.add(joint);
+    return true;
+}
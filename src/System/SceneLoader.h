@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+
+#include "ofJson.h"
+#include "PhysicsWorld.h"
+
+// A rod is loaded as a stiff and damped spring
+#define SCENE_ROD_STIFFNESS 2000.0f
+#define SCENE_ROD_DAMPING 50.0f
+
+/**
+ * @brief Loads a scene described in JSON into a world, replacing its bodies:
+ *
+ * {
+ *   "settings": {"gravity": true, "friction": false, "collisions": true, "aabbTree": true, "deterministic": true},
+ *   "materials": {"heavy": {"mass": 10, "color": [200, 50, 50], "continuousCollision": false, "charge": 0,
+ *                           "restitution": 0.5, "staticFriction": 0.6, "dynamicFriction": 0.4, "density": 2,
+ *                           "restitutionCombine": "minimum", "frictionCombine": "average"}},
+ *   "bodies": [
+ *     {"shape": "box", "size": [40, 30, 50], "position": [0, 0, 0], "material": "heavy"},
+ *     {"shape": "cone", "radius": 40, "height": 50, "velocity": [0, 10, 0], "angularVelocity": [1, 0, 0],
+ *      "orientation": [1, 0, 0, 0], "grid": {"count": [10, 1, 10], "spacing": [60, 0, 60]}},
+ *     {"shape": "compound", "position": [0, 50, 0], "children": [
+ *       {"shape": "box", "size": [40, 10, 10], "offset": [0, 0, 0]},
+ *       {"shape": "cone", "radius": 5, "height": 20, "offset": [20, 15, 0], "material": "heavy"}]},
+ *     {"shape": "hull", "points": [[0, 0, 0], [20, 0, 0], [0, 20, 0], [0, 0, 20]], "maxVertices": 64}
+ *   ],
+ *   "forces": [{"type": "gravity", "vector": [0, -9.81, 0], "bodies": [0, 1]}, {"type": "friction", "k": 0.1},
+ *              {"type": "mutualGravity", "G": 1, "openingAngle": 0.5, "softening": 1},
+ *              {"type": "electrostatic", "k": 1, "openingAngle": 0.5, "softening": 1}],
+ *   "springs": [{"bodies": [0, 1], "k": 5, "length": 100, "damping": 0.5}],
+ *   "rods": [{"bodies": [1, 2], "length": 80}],
+ *   "joints": [{"type": "hinge", "bodies": [0, 1], "anchor": [0, 20, 0], "axis": [0, 0, 1]},
+ *              {"type": "ballSocket", "bodies": [2], "anchor": [0, 100, 0]}]
+ * }
+ *
+ * Every section and field is optional except the shape of a body. Combine modes are "average", "minimum",
+ * "multiply" or "maximum". A material with a density gives its bodies the mass and inertia of their shape instead
+ * of its mass, the children of a compound always do, each with its own material. A hull is centered on its center
+ * of mass, which is placed at the position of the body. A grid repeats a body, shifted by the spacing.
+ * Bodies are referenced by their index in the file, grids expanded, and get consecutive ids in the same order.
+ * Forces without a list of bodies apply to all of them. The mutual gravity and electrostatic forces act between
+ * the bodies they apply to, the other forces on each body alone. Joints are "ballSocket", "hinge", "slider" or
+ * "fixed", a joint with a single body attaches it to the world, and the anchor defaults to the position of the last
+ * body
+ *
+ */
+class SceneLoader
+{
+public:
+    static bool loadFile(PhysicsWorld& world, const std::string& path);
+    static bool load(PhysicsWorld& world, const ofJson& scene);
+};
@@ -0,0 +1,84 @@
+#include "SimulationThread.h"
+
+#include <algorithm>
+#include <chrono>
+
+SimulationThread::SimulationThread(PhysicsWorld& world) : world(world)
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+/**
+ * @brief Start stepping the world, does nothing if it is already running
+ */
+void SimulationThread::start()
+{
+    if (running) return;
+    running = true;
+    thread = std::thread(&SimulationThread::run, this);
+}
+
+/**
+ * @brief Stop stepping the world, once the current step is done
+ */
+void SimulationThread::stop()
+{
+    if (!running) return;
+    running = false;
+    thread.join();
+}
+
+bool SimulationThread::isRunning()
+{
+    return running;
+}
+
+/**
+ * @return The time of the steady clock in seconds, the time base of the render frames
+ */
+double SimulationThread::now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Simulation loop: every FIXED_TIME_STEP / speed seconds, the world advances by the real time elapsed since
+ * the last tick times the speed. A deterministic world accumulates it and runs whole FIXED_TIME_STEP steps, any
+ * other runs a single step of that time. When the steps take too long, up to MAX_STEPS_PER_FRAME steps of time
+ * are caught up and the rest is dropped
+ */
+void SimulationThread::run()
+{
+    using Clock = std::chrono::steady_clock;
+    auto next = Clock::now();
+    auto last = next;
+    while (running)
+    {
+        std::this_thread::sleep_until(next);
+        auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(FIXED_TIME_STEP / std::max(speed.load(), 0.01f)));
+        next += period;
+        if (Clock::now() - next > period * MAX_STEPS_PER_FRAME) next = Clock::now();
+
+        // Simulated time since the last tick, bounded like the late steps
+        auto current = Clock::now();
+        float elapsed = std::min(std::chrono::duration<float>(current - last).count() * speed.load(),
+                                 FIXED_TIME_STEP * MAX_STEPS_PER_FRAME);
+        last = current;
+        if (paused || elapsed <= 0) continue;
+
+        RenderFrame& frame = renderBuffer.getWriteFrame();
+        {
+            std::lock_guard<std::mutex> lock(worldMutex);
+            // Whole steps of FIXED_TIME_STEP in deterministic mode, a step of the elapsed time otherwise
+            if (world.advance(elapsed) == 0) continue;
+            frame.capture(world, captureBroadPhase);
+        }
+        frame.time = now();
+        renderBuffer.publish();
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "PhysicsWorld.h"
+#include "RenderFrame.h"
+
+/**
+ * @brief Steps a world on its own thread at a fixed rate, and publishes a render frame after stepping. The steps
+ * follow the deterministic setting of the world, as PhysicsWorld::advance.
+ * The world is locked during each step: other threads lock worldMutex before touching the world, and draw
+ * the published frames instead of reading the bodies
+ *
+ */
+class SimulationThread
+{
+private:
+    PhysicsWorld& world;
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    void run();
+
+public:
+    std::mutex worldMutex;
+    RenderBuffer renderBuffer;
+    // Simulated time per real time
+    std::atomic<float> speed{1};
+    std::atomic<bool> paused{false};
+    // Whether the frames hold the boxes of the broad phase
+    std::atomic<bool> captureBroadPhase{false};
+
+    explicit SimulationThread(PhysicsWorld& world);
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+    ~SimulationThread();
+
+    void start();
+    void stop();
+    bool isRunning();
+    static double now();
+};
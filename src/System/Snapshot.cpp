@@ -0,0 +1,659 @@
+#include "Snapshot.h"
+
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+#include "BallSocketJoint.h"
+#include "Box.h"
+#include "Compound.h"
+#include "Cone.h"
+#include "ConvexHull.h"
+#include "ElectrostaticGenerator.h"
+#include "FixedJoint.h"
+#include "FrictionGenerator.h"
+#include "GravityGenerator.h"
+#include "HingeJoint.h"
+#include "MappedFile.h"
+#include "MutualGravityGenerator.h"
+#include "SliderJoint.h"
+#include "SpringGenerator.h"
+
+static void writeVector(Vector v, float* out)
+{
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+static Vector readVector(const float* in)
+{
+    return Vector(in[0], in[1], in[2]);
+}
+
+static void writeQuaternion(Quaternion q, float* out)
+{
+    out[0] = q.w;
+    out[1] = q.x;
+    out[2] = q.y;
+    out[3] = q.z;
+}
+
+static Quaternion readQuaternion(const float* in)
+{
+    return Quaternion(in[0], in[1], in[2], in[3]);
+}
+
+static void writeMatrix(Matrix m, float* out)
+{
+    writeVector(m.l1, out);
+    writeVector(m.l2, out + 3);
+    writeVector(m.l3, out + 6);
+}
+
+static Matrix readMatrix(const float* in)
+{
+    return Matrix(readVector(in), readVector(in + 3), readVector(in + 6));
+}
+
+/**
+ * @brief Fill the record of a generator with its type and parameters
+ * @return False if the generator has no snapshot format
+ */
+static bool writeGenerator(PhysicsWorld& world, ForceGenerator* generator, SnapshotGenerator& record)
+{
+    record = {};
+    record.type = generator->forceType;
+    record.other = -1;
+    switch (generator->forceType)
+    {
+    case GravityForce:
+        writeVector(static_cast<GravityGenerator*>(generator)->gravity, record.parameters);
+        return true;
+    case FrictionForce:
+        record.parameters[0] = static_cast<FrictionGenerator*>(generator)->k1;
+        return true;
+    case SpringForce:
+        {
+            auto spring = static_cast<SpringGenerator*>(generator);
+            // The other end is saved by its id, it must be a body of the world
+            if (world.findBody(spring->other->id) != spring->other) return false;
+            record.other = spring->other->id;
+            record.parameters[0] = spring->k;
+            record.parameters[1] = spring->length;
+            record.parameters[2] = spring->damping;
+            return true;
+        }
+    case MutualGravityForce:
+    case ElectrostaticForce:
+        {
+            auto longRange = static_cast<LongRangeGenerator*>(generator);
+            record.parameters[0] = generator->forceType == MutualGravityForce
+                                       ? static_cast<MutualGravityGenerator*>(generator)->G
+                                       : static_cast<ElectrostaticGenerator*>(generator)->k;
+            record.parameters[1] = longRange->openingAngle;
+            record.parameters[2] = longRange->softening;
+            return true;
+        }
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Create the generator of a record, once the bodies of the world are restored
+ */
+static ForceGenerator* readGenerator(PhysicsWorld& world, const SnapshotGenerator& record)
+{
+    const float* parameters = record.parameters;
+    switch (record.type)
+    {
+    case GravityForce:
+        return new GravityGenerator(readVector(parameters));
+    case FrictionForce:
+        return new FrictionGenerator(parameters[0]);
+    case SpringForce:
+        return new SpringGenerator(parameters[0], parameters[1], world.findBody(record.other), parameters[2]);
+    case MutualGravityForce:
+        return new MutualGravityGenerator(parameters[0], parameters[1], parameters[2]);
+    default:
+        return new ElectrostaticGenerator(parameters[0], parameters[1], parameters[2]);
+    }
+}
+
+/**
+ * @brief List the local vectors of a joint, in the order of SnapshotJoint::vectors
+ * @return The number of vectors
+ */
+static int getJointVectors(Joint* joint, Vector* (&vectors)[SNAPSHOT_JOINT_VECTORS])
+{
+    int count = 0;
+    if (joint->jointType == JointSlider)
+    {
+        auto slider = static_cast<SliderJoint*>(joint);
+        vectors[count++] = &slider->localAnchorFirst;
+        vectors[count++] = &slider->localAnchorSecond;
+        vectors[count++] = &slider->localAxis;
+        for (Vector& normal : slider->localNormals) vectors[count++] = &normal;
+        for (Vector& axis : slider->relativeAxes) vectors[count++] = &axis;
+        return count;
+    }
+
+    auto ballSocket = static_cast<BallSocketJoint*>(joint);
+    vectors[count++] = &ballSocket->localAnchorFirst;
+    vectors[count++] = &ballSocket->localAnchorSecond;
+    if (joint->jointType == JointHinge)
+    {
+        auto hinge = static_cast<HingeJoint*>(joint);
+        vectors[count++] = &hinge->localAxisFirst;
+        vectors[count++] = &hinge->localAxisSecond;
+        for (Vector& normal : hinge->localNormals) vectors[count++] = &normal;
+    }
+    else if (joint->jointType == JointFixed)
+    {
+        for (Vector& axis : static_cast<FixedJoint*>(joint)->relativeAxes) vectors[count++] = &axis;
+    }
+    return count;
+}
+
+/**
+ * @brief Fill the record of a joint with its bodies, local vectors and impulses
+ * @return False if a body of the joint is not in the world
+ */
+static bool writeJoint(PhysicsWorld& world, Joint* joint, SnapshotJoint& record)
+{
+    record = {};
+    if (world.findBody(joint->first->id) != joint->first) return false;
+    if (joint->second != nullptr && world.findBody(joint->second->id) != joint->second) return false;
+    record.type = joint->jointType;
+    record.first = joint->first->id;
+    record.second = joint->second != nullptr ? joint->second->id : -1;
+
+    Vector* vectors[SNAPSHOT_JOINT_VECTORS];
+    int count = getJointVectors(joint, vectors);
+    for (int i = 0; i < count; i++) writeVector(*vectors[i], record.vectors[i]);
+    for (size_t i = 0; i < joint->rows.size(); i++) record.impulses[i] = joint->rows[i].impulse;
+    return true;
+}
+
+/**
+ * @brief Create the joint of a record, once the bodies of the world are restored
+ */
+static Joint* readJoint(PhysicsWorld& world, const SnapshotJoint& record)
+{
+    Shape* first = world.findBody(record.first);
+    Shape* second = record.second >= 0 ? world.findBody(record.second) : nullptr;
+    Joint* joint;
+    switch (record.type)
+    {
+    case JointHinge:
+        joint = new HingeJoint(first, second, Vector(0, 0, 0), Vector(0, 1, 0));
+        break;
+    case JointSlider:
+        joint = new SliderJoint(first, second, Vector(0, 0, 0), Vector(0, 1, 0));
+        break;
+    case JointFixed:
+        joint = new FixedJoint(first, second, Vector(0, 0, 0));
+        break;
+    default:
+        joint = new BallSocketJoint(first, second, Vector(0, 0, 0));
+        break;
+    }
+
+    // The constructors computed the vectors from the current poses, the saved ones are the original
+    Vector* vectors[SNAPSHOT_JOINT_VECTORS];
+    int count = getJointVectors(joint, vectors);
+    for (int i = 0; i < count; i++) *vectors[i] = readVector(record.vectors[i]);
+    for (size_t i = 0; i < joint->rows.size(); i++) joint->rows[i].impulse = record.impulses[i];
+    return joint;
+}
+
+/**
+ * @param world The world
+ * @return The settings of the world, as SNAPSHOT_ bits
+ */
+uint32_t Snapshot::getSettings(PhysicsWorld& world)
+{
+    return (world.gravity ? SNAPSHOT_GRAVITY : 0) | (world.friction ? SNAPSHOT_FRICTION : 0)
+        | (world.collisions ? SNAPSHOT_COLLISIONS : 0) | (world.useAABBTree ? SNAPSHOT_AABB_TREE : 0)
+        | (world.deterministic ? SNAPSHOT_DETERMINISTIC : 0);
+}
+
+/**
+ * @brief Change every setting of the world
+ * @param world The world
+ * @param settings The new settings, as SNAPSHOT_ bits
+ */
+void Snapshot::setSettings(PhysicsWorld& world, uint32_t settings)
+{
+    world.gravity = settings & SNAPSHOT_GRAVITY;
+    world.friction = settings & SNAPSHOT_FRICTION;
+    world.collisions = settings & SNAPSHOT_COLLISIONS;
+    world.useAABBTree = settings & SNAPSHOT_AABB_TREE;
+    world.deterministic = settings & SNAPSHOT_DETERMINISTIC;
+}
+
+/**
+ * @param material A material of the table
+ * @return Its record
+ */
+SnapshotMaterial Snapshot::writeMaterial(const Material& material)
+{
+    SnapshotMaterial record;
+    record.restitution = material.restitution;
+    record.staticFriction = material.staticFriction;
+    record.dynamicFriction = material.dynamicFriction;
+    record.density = material.density;
+    record.restitutionCombine = material.restitutionCombine;
+    record.frictionCombine = material.frictionCombine;
+    return record;
+}
+
+/**
+ * @param record A material read from a file
+ * @param material Receives the material
+ * @return False if a combine mode is unknown
+ */
+bool Snapshot::readMaterial(const SnapshotMaterial& record, Material& material)
+{
+    if (record.restitutionCombine > CombineMaximum || record.frictionCombine > CombineMaximum) return false;
+    material.restitution = record.restitution;
+    material.staticFriction = record.staticFriction;
+    material.dynamicFriction = record.dynamicFriction;
+    material.density = record.density;
+    material.restitutionCombine = static_cast<CombineMode>(record.restitutionCombine);
+    material.frictionCombine = static_cast<CombineMode>(record.frictionCombine);
+    return true;
+}
+
+/**
+ * @brief Describe a shape in a record, appending the records of the children of a compound and the vertices of a
+ * hull
+ * @param shape The shape, a box, a cone, a hull or a compound of them
+ * @param shapes The records, the one at index is filled with the shape at the origin of its compound
+ * @param vertices The coordinates of the vertices of the hulls, three per vertex
+ * @param index The record of the shape
+ * @return False if the shape or one of its children has no snapshot format
+ */
+bool Snapshot::writeShape(Shape* shape, std::vector<SnapshotShape>& shapes, std::vector<float>& vertices,
+                          size_t index)
+{
+    SnapshotShape record = {};
+    record.type = shape->shapeType;
+    record.material = shape->material;
+    for (int c = 0; c < 3; c++) record.color[c] = shape->color[c];
+    writeQuaternion(Quaternion(1, 0, 0, 0), record.orientation);
+    if (shape->shapeType == BoxShape)
+    {
+        Box* box = static_cast<Box*>(shape);
+        writeVector(Vector(box->getWidth(), box->getHeight(), box->getDepth()), record.dimensions);
+    }
+    else if (shape->shapeType == ConeShape)
+    {
+        Cone* cone = static_cast<Cone*>(shape);
+        writeVector(Vector(cone->getRadius(), cone->getHeight(), 0), record.dimensions);
+    }
+    else if (shape->shapeType == ConvexHullShape)
+    {
+        ConvexHull* hull = static_cast<ConvexHull*>(shape);
+        writeVector(hull->cloudOrigin, record.dimensions);
+        record.first = static_cast<uint32_t>(vertices.size() / 3);
+        record.count = static_cast<uint32_t>(hull->vertices.size());
+        vertices.resize(vertices.size() + 3 * hull->vertices.size());
+        for (uint32_t i = 0; i < record.count; i++)
+        {
+            writeVector(hull->vertices[i], &vertices[3 * (record.first + i)]);
+        }
+    }
+    else if (shape->shapeType == CompoundShape)
+    {
+        Compound* compound = static_cast<Compound*>(shape);
+        record.first = static_cast<uint32_t>(shapes.size());
+        record.count = static_cast<uint32_t>(compound->children.size());
+        shapes.resize(shapes.size() + compound->children.size());
+        for (uint32_t i = 0; i < record.count; i++)
+        {
+            auto& child = compound->children[i];
+            if (!writeShape(child.shape, shapes, vertices, record.first + i)) return false;
+            writeVector(child.offset, shapes[record.first + i].offset);
+            writeQuaternion(child.orientation, shapes[record.first + i].orientation);
+        }
+    }
+    else
+    {
+        return false;
+    }
+    shapes[index] = record;
+    return true;
+}
+
+/**
+ * @brief Check shape records read from a file before building any of them
+ * @param shapes The records
+ * @param count The number of records
+ * @param vertexCount The number of hull vertices the records can refer to
+ * @param materialCount The number of materials the records can refer to
+ * @return False if a type or a material is unknown, if the vertices of a hull are out of range, or if the children
+ * of a compound are out of the records, before it, shared with another compound or nested deeper than
+ * SNAPSHOT_MAX_NESTING
+ */
+bool Snapshot::checkShapes(const SnapshotShape* shapes, uint32_t count, uint32_t vertexCount, uint32_t materialCount)
+{
+    // The parents come first, so the depth of a record is known when it is reached
+    std::vector<int> depths(count, 0);
+    std::vector<char> claimed(count, 0);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const SnapshotShape& shape = shapes[i];
+        if (shape.material < 0 || static_cast<uint32_t>(shape.material) >= materialCount) return false;
+        if (shape.type == BoxShape || shape.type == ConeShape) continue;
+        if (shape.type == ConvexHullShape)
+        {
+            if (shape.first > vertexCount || shape.count > vertexCount - shape.first) return false;
+            continue;
+        }
+        if (shape.type != CompoundShape || depths[i] >= SNAPSHOT_MAX_NESTING) return false;
+        if (shape.first <= i || shape.first > count || shape.count > count - shape.first) return false;
+        for (uint32_t child = shape.first; child < shape.first + shape.count; child++)
+        {
+            if (claimed[child]) return false;
+            claimed[child] = 1;
+            depths[child] = depths[i] + 1;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Build the shape of a record, with its children. The records must have passed checkShapes
+ * @param shapes The records
+ * @param vertices The coordinates of the vertices of the hulls, three per vertex
+ * @param index The record of the shape
+ * @param materialIndices The index in the MaterialTable of each material of the records
+ * @return The new shape, at the origin with the default mass of its type
+ */
+Shape* Snapshot::readShape(const SnapshotShape* shapes, const float* vertices, uint32_t index,
+                           const std::vector<int>& materialIndices)
+{
+    const SnapshotShape& record = shapes[index];
+    Shape* shape;
+    if (record.type == BoxShape)
+    {
+        shape = new Box(record.dimensions[0], record.dimensions[1], record.dimensions[2]);
+    }
+    else if (record.type == ConeShape)
+    {
+        shape = new Cone(record.dimensions[0], record.dimensions[1]);
+    }
+    else if (record.type == ConvexHullShape)
+    {
+        // The faces are computed again, the vertices keep their coordinates
+        std::vector<Vector> points(record.count);
+        for (uint32_t i = 0; i < record.count; i++) points[i] = readVector(&vertices[3 * (record.first + i)]);
+        shape = new ConvexHull(points, readVector(record.dimensions));
+    }
+    else
+    {
+        Compound* compound = new Compound();
+        for (uint32_t child = record.first; child < record.first + record.count; child++)
+        {
+            Shape* shape = readShape(shapes, vertices, child, materialIndices);
+            compound->addChild(shape, readVector(shapes[child].offset), readQuaternion(shapes[child].orientation));
+        }
+        shape = compound;
+    }
+    shape->material = materialIndices[record.material];
+    for (int c = 0; c < 3; c++) shape->color[c] = record.color[c];
+    return shape;
+}
+
+/**
+ * @brief Write the world to a file, replacing it
+ * @param world The world to save
+ * @param path The path of the file
+ * @return False if a body or a generator has no snapshot format, a scene force applies a generator the world does
+ * not own, a joint or a force applies to a body out of the world, or the file can not be written
+ */
+bool Snapshot::save(PhysicsWorld& world, const std::string& path)
+{
+    SnapshotHeader header = {};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.bodyCount = static_cast<uint32_t>(world.bodies.size());
+    header.settings = getSettings(world);
+    header.nextId = world.nextId;
+    header.stepCount = world.stepCount;
+    header.accumulator = world.accumulator;
+    header.materialCount = static_cast<uint32_t>(MaterialTable::size());
+    header.generatorCount = static_cast<uint32_t>(world.generators.size());
+    header.forceCount = static_cast<uint32_t>(world.sceneForces.size());
+    header.jointCount = static_cast<uint32_t>(world.jointSolver.joints.size());
+
+    std::vector<SnapshotMaterial> materials(header.materialCount);
+    for (uint32_t i = 0; i < header.materialCount; i++)
+    {
+        materials[i] = writeMaterial(MaterialTable::get(i));
+    }
+
+    // The shapes of the bodies come first, in the same order, followed by the children of the compounds
+    std::vector<SnapshotBody> records(world.bodies.size());
+    std::vector<SnapshotShape> shapes(world.bodies.size());
+    std::vector<float> vertices;
+    for (size_t i = 0; i < world.bodies.size(); i++)
+    {
+        if (!writeShape(world.bodies[i], shapes, vertices, i)) return false;
+    }
+    header.shapeCount = static_cast<uint32_t>(shapes.size());
+    header.vertexCount = static_cast<uint32_t>(vertices.size() / 3);
+    for (size_t i = 0; i < world.bodies.size(); i++)
+    {
+        Shape* body = world.bodies[i];
+        SnapshotBody& record = records[i];
+        record = {};
+        record.id = body->id;
+        record.shapeType = body->shapeType;
+        record.flags = body->continuousCollision ? SNAPSHOT_CONTINUOUS_COLLISION : 0;
+        record.material = body->material;
+        for (int c = 0; c < 3; c++) record.color[c] = body->color[c];
+        record.inversedMass = body->inversedMass;
+        record.gravity = body->gravity;
+        record.charge = body->charge;
+        writeVector(body->position, record.position);
+        writeQuaternion(body->orientation, record.orientation);
+        writeVector(body->linearVelocity, record.linearVelocity);
+        writeVector(body->angularVelocity, record.angularVelocity);
+        writeVector(body->linearAcceleration, record.linearAcceleration);
+        writeVector(body->angularAcceleration, record.angularAcceleration);
+        writeVector(body->accumForce, record.accumForce);
+        writeVector(body->torque, record.torque);
+        writeVector(body->massCenter, record.massCenter);
+        writeMatrix(body->tenseurJ, record.inertia);
+        writeMatrix(body->inversedTenseurJ, record.inversedInertia);
+    }
+
+    std::vector<SnapshotGenerator> generators(header.generatorCount);
+    std::unordered_map<ForceGenerator*, uint32_t> generatorIndices;
+    for (uint32_t i = 0; i < header.generatorCount; i++)
+    {
+        if (!writeGenerator(world, world.generators[i], generators[i])) return false;
+        generatorIndices[world.generators[i]] = i;
+    }
+
+    std::vector<SnapshotForce> forces(header.forceCount);
+    for (uint32_t i = 0; i < header.forceCount; i++)
+    {
+        auto& registration = world.sceneForces[i];
+        auto found = generatorIndices.find(registration.fg);
+        if (found == generatorIndices.end() || world.findBody(registration.object->id) != registration.object)
+        {
+            return false;
+        }
+        forces[i].generator = found->second;
+        forces[i].body = registration.object->id;
+    }
+
+    std::vector<SnapshotJoint> joints(header.jointCount);
+    for (uint32_t i = 0; i < header.jointCount; i++)
+    {
+        if (!writeJoint(world, world.jointSolver.joints[i], joints[i])) return false;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(materials.data()), materials.size() * sizeof(SnapshotMaterial));
+    file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(SnapshotBody));
+    file.write(reinterpret_cast<const char*>(shapes.data()), shapes.size() * sizeof(SnapshotShape));
+    file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(float));
+    file.write(reinterpret_cast<const char*>(generators.data()), generators.size() * sizeof(SnapshotGenerator));
+    file.write(reinterpret_cast<const char*>(forces.data()), forces.size() * sizeof(SnapshotForce));
+    file.write(reinterpret_cast<const char*>(joints.data()), joints.size() * sizeof(SnapshotJoint));
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Replace the bodies, scene forces, joints and settings of the world with the ones of a snapshot file
+ * @param world The world to restore, left untouched if the file is invalid
+ * @param path The path of the file
+ * @return False if the file can not be read or is not a valid snapshot
+ */
+bool Snapshot::load(PhysicsWorld& world, const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path)) return false;
+    return load(world, file.getData(), file.getSize());
+}
+
+/**
+ * @brief Replace the bodies, scene forces, joints and settings of the world with the ones of a snapshot in memory.
+ * The records are read where they are, the data must stay valid during the call
+ * @param world The world to restore, left untouched if the data is invalid
+ * @param data The snapshot, aligned on 4 bytes
+ * @param size The size of the snapshot in bytes
+ * @return False if the data is not a valid snapshot
+ */
+bool Snapshot::load(PhysicsWorld& world, const char* data, size_t size)
+{
+    if (size < sizeof(SnapshotHeader)) return false;
+    auto header = reinterpret_cast<const SnapshotHeader*>(data);
+    if (header->magic != SNAPSHOT_MAGIC || header->version != SNAPSHOT_VERSION) return false;
+    size_t bodiesOffset = sizeof(SnapshotHeader)
+        + static_cast<size_t>(header->materialCount) * sizeof(SnapshotMaterial);
+    size_t shapesOffset = bodiesOffset + static_cast<size_t>(header->bodyCount) * sizeof(SnapshotBody);
+    size_t verticesOffset = shapesOffset + static_cast<size_t>(header->shapeCount) * sizeof(SnapshotShape);
+    size_t generatorsOffset = verticesOffset + static_cast<size_t>(header->vertexCount) * 3 * sizeof(float);
+    size_t forcesOffset = generatorsOffset + static_cast<size_t>(header->generatorCount) * sizeof(SnapshotGenerator);
+    size_t jointsOffset = forcesOffset + static_cast<size_t>(header->forceCount) * sizeof(SnapshotForce);
+    if (size < jointsOffset + static_cast<size_t>(header->jointCount) * sizeof(SnapshotJoint)) return false;
+
+    auto materials = reinterpret_cast<const SnapshotMaterial*>(data + sizeof(SnapshotHeader));
+    auto records = reinterpret_cast<const SnapshotBody*>(data + bodiesOffset);
+    auto shapes = reinterpret_cast<const SnapshotShape*>(data + shapesOffset);
+    auto vertices = reinterpret_cast<const float*>(data + verticesOffset);
+    auto generators = reinterpret_cast<const SnapshotGenerator*>(data + generatorsOffset);
+    auto forces = reinterpret_cast<const SnapshotForce*>(data + forcesOffset);
+    auto joints = reinterpret_cast<const SnapshotJoint*>(data + jointsOffset);
+    std::vector<Material> fileMaterials(header->materialCount);
+    for (uint32_t i = 0; i < header->materialCount; i++)
+    {
+        if (!readMaterial(materials[i], fileMaterials[i])) return false;
+    }
+    // The shapes of the bodies are roots, no compound can claim them
+    if (header->shapeCount < header->bodyCount
+        || !checkShapes(shapes, header->shapeCount, header->vertexCount, header->materialCount))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->bodyCount; i++)
+    {
+        if (records[i].shapeType != shapes[i].type) return false;
+        if (shapes[i].type == CompoundShape && shapes[i].first < header->bodyCount) return false;
+        if (i > 0 && records[i].id <= records[i - 1].id) return false;
+        if (records[i].material < 0 || records[i].material >= static_cast<int32_t>(header->materialCount))
+        {
+            return false;
+        }
+    }
+
+    // The records are sorted by id, checked above
+    auto hasBody = [records, header](int32_t id)
+    {
+        const SnapshotBody* end = records + header->bodyCount;
+        const SnapshotBody* found = std::lower_bound(records, end, id, [](const SnapshotBody& record, int32_t value)
+        {
+            return record.id < value;
+        });
+        return found != end && found->id == id;
+    };
+    for (uint32_t i = 0; i < header->generatorCount; i++)
+    {
+        if (generators[i].type < GravityForce || generators[i].type > ElectrostaticForce) return false;
+        if (generators[i].type == SpringForce && !hasBody(generators[i].other)) return false;
+    }
+    for (uint32_t i = 0; i < header->forceCount; i++)
+    {
+        if (forces[i].generator >= header->generatorCount || !hasBody(forces[i].body)) return false;
+    }
+    for (uint32_t i = 0; i < header->jointCount; i++)
+    {
+        if (joints[i].type > JointFixed || !hasBody(joints[i].first)) return false;
+        if (joints[i].second != -1 && !hasBody(joints[i].second)) return false;
+    }
+
+    // The indices of the file are not the ones of the current table, which may have other materials
+    std::vector<int> materialIndices(header->materialCount);
+    for (uint32_t i = 0; i < header->materialCount; i++)
+    {
+        materialIndices[i] = MaterialTable::add(fileMaterials[i]);
+    }
+
+    world.clear();
+    setSettings(world, header->settings);
+
+    for (uint32_t i = 0; i < header->bodyCount; i++)
+    {
+        const SnapshotBody& record = records[i];
+        Shape* body = readShape(shapes, vertices, i, materialIndices);
+        body->id = record.id;
+        body->continuousCollision = record.flags & SNAPSHOT_CONTINUOUS_COLLISION;
+        body->material = materialIndices[record.material];
+        for (int c = 0; c < 3; c++) body->color[c] = record.color[c];
+        body->inversedMass = record.inversedMass;
+        body->gravity = record.gravity;
+        body->charge = record.charge;
+        body->position = readVector(record.position);
+        body->orientation = readQuaternion(record.orientation);
+        body->linearVelocity = readVector(record.linearVelocity);
+        body->angularVelocity = readVector(record.angularVelocity);
+        body->linearAcceleration = readVector(record.linearAcceleration);
+        body->angularAcceleration = readVector(record.angularAcceleration);
+        body->accumForce = readVector(record.accumForce);
+        body->torque = readVector(record.torque);
+        body->massCenter = readVector(record.massCenter);
+        body->tenseurJ = readMatrix(record.inertia);
+        body->inversedTenseurJ = readMatrix(record.inversedInertia);
+        body->updateBounds();
+        world.restoreBody(body);
+    }
+
+    std::vector<ForceGenerator*> restoredGenerators(header->generatorCount);
+    for (uint32_t i = 0; i < header->generatorCount; i++)
+    {
+        restoredGenerators[i] = readGenerator(world, generators[i]);
+        world.addGenerator(restoredGenerators[i]);
+    }
+    for (uint32_t i = 0; i < header->forceCount; i++)
+    {
+        world.addForce(world.findBody(forces[i].body), restoredGenerators[forces[i].generator]);
+    }
+    for (uint32_t i = 0; i < header->jointCount; i++)
+    {
+        world.jointSolver.add(readJoint(world, joints[i]));
+    }
+
+    world.nextId = header->nextId;
+    world.stepCount = header->stepCount;
+    world.accumulator = header->accumulator;
+    return true;
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Material.h"
+#include "PhysicsWorld.h"
+
+// "FESN" read as a little endian integer
+#define SNAPSHOT_MAGIC 0x4E534546u
+// Increased whenever a snapshot record changes
+#define SNAPSHOT_VERSION 7u
+
+// Bits of SnapshotHeader::settings
+#define SNAPSHOT_GRAVITY (1u << 0)
+#define SNAPSHOT_FRICTION (1u << 1)
+#define SNAPSHOT_COLLISIONS (1u << 2)
+#define SNAPSHOT_AABB_TREE (1u << 3)
+#define SNAPSHOT_DETERMINISTIC (1u << 4)
+
+// Local vectors and row impulses of the largest joint, the slider
+#define SNAPSHOT_JOINT_VECTORS 8
+#define SNAPSHOT_JOINT_ROWS 6
+
+// Compounds nested deeper are rejected, so that reading them can not exhaust the stack
+#define SNAPSHOT_MAX_NESTING 8
+
+// Bits of SnapshotBody::flags
+#define SNAPSHOT_CONTINUOUS_COLLISION (1u << 0)
+
+/**
+ * @brief First bytes of a snapshot file, followed by materialCount SnapshotMaterial records, bodyCount
+ * SnapshotBody records, shapeCount SnapshotShape records, vertexCount hull vertices of three floats, generatorCount
+ * SnapshotGenerator records, forceCount SnapshotForce records, then jointCount SnapshotJoint records.
+ * Every field is 4 bytes wide, so the layout has no padding and records can be read in place
+ *
+ */
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t bodyCount;
+    uint32_t settings;
+    int32_t nextId;
+    int32_t stepCount;
+    float accumulator;
+    uint32_t materialCount;
+    uint32_t shapeCount;
+    uint32_t vertexCount;
+    uint32_t generatorCount;
+    uint32_t forceCount;
+    uint32_t jointCount;
+};
+
+/**
+ * @brief A material of the MaterialTable, the bodies refer to it by its position in the file
+ *
+ */
+struct SnapshotMaterial
+{
+    float restitution;
+    float staticFriction;
+    float dynamicFriction;
+    float density;
+    uint32_t restitutionCombine;
+    uint32_t frictionCombine;
+};
+
+/**
+ * @brief The full state of a body, its shape is the SnapshotShape of the same index
+ *
+ */
+struct SnapshotBody
+{
+    int32_t id;
+    uint32_t shapeType;
+    uint32_t flags;
+    int32_t material;
+    int32_t color[3];
+    float inversedMass;
+    float gravity;
+    float charge;
+    float position[3];
+    float orientation[4];
+    float linearVelocity[3];
+    float angularVelocity[3];
+    float linearAcceleration[3];
+    float angularAcceleration[3];
+    float accumForce[3];
+    float torque[3];
+    float massCenter[3];
+    float inertia[9];
+    float inversedInertia[9];
+};
+
+/**
+ * @brief The geometry of a body or of a child of a compound. The dimensions are the box width, height and depth,
+ * the cone radius and height, or the cloud origin of a hull. A hull has count vertices from first, its faces are
+ * computed again on load. A compound has count children, the records from first, which come after it and belong to
+ * no other compound. The material, color and pose are the ones of a child in its compound, the shape of a body has
+ * the material and color of the body and no offset
+ *
+ */
+struct SnapshotShape
+{
+    uint32_t type;
+    int32_t material;
+    int32_t color[3];
+    float dimensions[3];
+    float offset[3];
+    float orientation[4];
+    uint32_t first;
+    uint32_t count;
+};
+
+/**
+ * @brief A generator owned by the world. The parameters are the gravity vector, the friction coefficient, the
+ * stiffness, rest length and damping of a spring, or the constant, opening angle and softening of a long range
+ * force
+ *
+ */
+struct SnapshotGenerator
+{
+    uint32_t type;
+    // Id of the body a spring pulls towards, -1 for the other types
+    int32_t other;
+    float parameters[3];
+};
+
+/**
+ * @brief A scene force: the generator, by its position in the file, applied to a body
+ *
+ */
+struct SnapshotForce
+{
+    uint32_t generator;
+    int32_t body;
+};
+
+/**
+ * @brief A joint, with what its constructor computed from the poses of its bodies. The local vectors are the
+ * anchors of both bodies, followed by the axes and normals of a hinge, the axis, normals and relative axes of a
+ * slider, or the relative axes of a fixed joint, in the order of their members
+ *
+ */
+struct SnapshotJoint
+{
+    uint32_t type;
+    int32_t first;
+    // -1 for a joint attaching the first body to the world
+    int32_t second;
+    float vectors[SNAPSHOT_JOINT_VECTORS][3];
+    // Accumulated impulse of each row, for the warm starting of the next step
+    float impulses[SNAPSHOT_JOINT_ROWS];
+};
+
+static_assert(sizeof(SnapshotHeader) == 52, "The snapshot header must not be padded");
+static_assert(sizeof(SnapshotMaterial) == 4 * 6, "The snapshot material must not be padded");
+static_assert(sizeof(SnapshotBody) == 4 * 56, "The snapshot body must not be padded");
+static_assert(sizeof(SnapshotShape) == 4 * 17, "The snapshot shape must not be padded");
+static_assert(sizeof(SnapshotGenerator) == 4 * 5, "The snapshot generator must not be padded");
+static_assert(sizeof(SnapshotForce) == 4 * 2, "The snapshot force must not be padded");
+static_assert(sizeof(SnapshotJoint) == 4 * 33, "The snapshot joint must not be padded");
+
+/**
+ * @brief Binary save and restore of the dynamic state of a PhysicsWorld: settings, step counter, every body, the
+ * scene forces and the joints. The gravity and friction registrations are rebuilt at each step from the settings,
+ * so the settings are enough to restore them, while the generators of the scene and the bodies they apply to are
+ * saved. Joints keep the local vectors and impulses they had, instead of being built again from the current poses.
+ * Bodies are boxes, cones, convex hulls, or compounds of them. The static geometry belongs to the scene and is not
+ * saved. Worlds with another shape or a generator of a CustomForce type can not be saved.
+ * The whole MaterialTable is saved with the bodies. Loading adds the materials to the table again, identical ones
+ * being shared, and maps the material of each body to its new index. Loading maps the file and reads the records in place
+ *
+ */
+class Snapshot
+{
+public:
+    static bool save(PhysicsWorld& world, const std::string& path);
+    static bool load(PhysicsWorld& world, const std::string& path);
+    static bool load(PhysicsWorld& world, const char* data, size_t size);
+    static uint32_t getSettings(PhysicsWorld& world);
+    static void setSettings(PhysicsWorld& world, uint32_t settings);
+    static SnapshotMaterial writeMaterial(const Material& material);
+    static bool readMaterial(const SnapshotMaterial& record, Material& material);
+    static bool writeShape(Shape* shape, std::vector<SnapshotShape>& shapes, std::vector<float>& vertices,
+                           size_t index);
+    static bool checkShapes(const SnapshotShape* shapes, uint32_t count, uint32_t vertexCount,
+                            uint32_t materialCount);
+    static Shape* readShape(const SnapshotShape* shapes, const float* vertices, uint32_t index,
+                            const std::vector<int>& materialIndices);
+};
@@ -0,0 +1,261 @@
+#include "SpatialQuery.h"
+
+#include <chrono>
+
+#include "Box.h"
+#include "Compound.h"
+#include "GJK.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+SpatialQuery::SpatialQuery(PhysicsWorld& world) : world(world)
+{
+}
+
+/**
+ * @brief Bring the AABB tree up to date with the bodies if the world was stepped or changed since the last
+ * refresh. Only the bodies that left their fat box are reinserted. Called by every query, and before the threads
+ * of a batch start
+ */
+void SpatialQuery::refresh()
+{
+    if (refreshedStep == world.stepCount && refreshedCount == world.bodies.size()) return;
+    for (auto body : world.bodies)
+    {
+        world.aabbTree.update(body, Vector(0, 0, 0));
+    }
+    refreshedStep = world.stepCount;
+    refreshedCount = world.bodies.size();
+}
+
+/**
+ * @brief Find the first body along a ray
+ * @param origin The origin of the ray
+ * @param direction The direction of the ray, normalized by the query
+ * @param maxDistance The length of the ray
+ * @param hit Receives the body hit, the distance, the point and the normal
+ * @return True if a body is hit
+ */
+bool SpatialQuery::raycast(Vector origin, Vector direction, float maxDistance, QueryHit& hit)
+{
+    return sphereCast(origin, 0, direction, maxDistance, hit);
+}
+
+/**
+ * @brief Find the first body touched by a sphere moving along a ray
+ * @param origin The start of the center of the sphere
+ * @param radius The radius of the sphere
+ * @param direction The direction of the motion, normalized by the query
+ * @param maxDistance The length of the motion
+ * @param hit Receives the body hit, the distance travelled, the point touched and the normal
+ * @return True if a body is touched
+ */
+bool SpatialQuery::sphereCast(Vector origin, float radius, Vector direction, float maxDistance, QueryHit& hit)
+{
+    refresh();
+    return cast({origin, direction, maxDistance, radius}, hit, stack);
+}
+
+/**
+ * @brief Find the bodies whose bounds overlap a box
+ * @param box The box
+ * @param results The bodies are appended to this vector
+ */
+void SpatialQuery::overlap(AABB box, std::vector<Shape*>& results)
+{
+    refresh();
+    std::vector<RigidBody*> found;
+    world.aabbTree.queryOverlap(box, found, stack);
+    for (auto body : found)
+    {
+        results.push_back(static_cast<Shape*>(body));
+    }
+}
+
+/**
+ * @brief Cast many rays or spheres at once, split across threads
+ * @param rays The rays, a positive radius casts a sphere
+ * @param hits Receives the hit of each ray, with no body when it hits nothing
+ * @return The number of rays that hit a body
+ */
+int SpatialQuery::castBatch(const std::vector<QueryRay>& rays, std::vector<QueryHit>& hits)
+{
+    refresh();
+    const int count = static_cast<int>(rays.size());
+    hits.assign(count, QueryHit());
+    int hitCount = 0;
+    const int threads = getThreadCount();
+#pragma omp parallel num_threads(threads) if (count >= PARALLEL_MIN_QUERIES) reduction(+ : hitCount)
+    {
+        std::vector<int> traversal;
+#pragma omp for schedule(dynamic, 16)
+        for (int i = 0; i < count; i++)
+        {
+            if (cast(rays[i], hits[i], traversal)) hitCount++;
+        }
+    }
+    return hitCount;
+}
+
+/**
+ * @brief Find the bodies overlapping many boxes at once, split across threads
+ * @param boxes The boxes
+ * @param results Receives the bodies whose bounds overlap each box
+ */
+void SpatialQuery::overlapBatch(const std::vector<AABB>& boxes, std::vector<std::vector<Shape*>>& results)
+{
+    refresh();
+    const int count = static_cast<int>(boxes.size());
+    results.resize(count);
+    const int threads = getThreadCount();
+#pragma omp parallel num_threads(threads) if (count >= PARALLEL_MIN_QUERIES)
+    {
+        std::vector<int> traversal;
+        std::vector<RigidBody*> found;
+#pragma omp for schedule(dynamic, 16)
+        for (int i = 0; i < count; i++)
+        {
+            found.clear();
+            world.aabbTree.queryOverlap(boxes[i], found, traversal);
+            results[i].clear();
+            for (auto body : found)
+            {
+                results[i].push_back(static_cast<Shape*>(body));
+            }
+        }
+    }
+}
+
+/**
+ * @return The number of threads the batches run on
+ */
+int SpatialQuery::getThreadCount()
+{
+#ifdef _OPENMP
+    return threadCount > 0 ? threadCount : omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief Cast a ray through the tree. Only reads the world, so that casts with their own stack run in parallel
+ */
+bool SpatialQuery::cast(const QueryRay& ray, QueryHit& hit, std::vector<int>& traversal)
+{
+    Vector direction = Vector(ray.direction).normalized();
+    if (direction.squaredMagnitude() == 0) return false;
+
+    hit = QueryHit();
+    world.aabbTree.queryRay(ray.origin, direction, ray.maxDistance, ray.radius, traversal,
+                            [&](RigidBody* object, float closest)
+                            {
+                                float distance;
+                                Vector normal;
+                                Shape* body = static_cast<Shape*>(object);
+                                if (!castBody(*body, ray, closest, distance, normal) || distance >= closest)
+                                {
+                                    return closest;
+                                }
+                                hit.body = body;
+                                hit.distance = distance;
+                                hit.normal = normal;
+                                return distance;
+                            });
+    if (hit.body == nullptr) return false;
+    hit.point = Vector(ray.origin) + direction * hit.distance - hit.normal * ray.radius;
+    return true;
+}
+
+/**
+ * @brief Cast a ray against the shape of a body, and against each child of a compound
+ */
+bool SpatialQuery::castBody(Shape& body, const QueryRay& ray, float maxDistance, float& distance, Vector& normal)
+{
+    Vector direction = Vector(ray.direction).normalized();
+    if (body.shapeType != CompoundShape)
+    {
+        return GJK::raycast(body, ray.origin, direction, ray.radius, maxDistance, distance, normal);
+    }
+
+    bool found = false;
+    for (auto& child : static_cast<Compound&>(body).children)
+    {
+        float childDistance;
+        Vector childNormal;
+        if (castBody(*child.shape, ray, maxDistance, childDistance, childNormal))
+        {
+            found = true;
+            maxDistance = distance = childDistance;
+            normal = childNormal;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Measure the casts against a grid of boxes, through the tree or against every body
+ * @param bodyCount The number of boxes
+ * @param rayCount The number of rays, cast as one batch
+ * @param bruteForce Whether to test every body for each ray instead of using the tree, on a single thread
+ * @return The duration of the batch in milliseconds
+ */
+double SpatialQuery::benchmark(int bodyCount, int rayCount, bool bruteForce)
+{
+    int side = std::max(1, static_cast<int>(std::cbrt(bodyCount)));
+    float arenaSize = side * 20.0f;
+    PhysicsWorld world(arenaSize);
+    std::vector<Shape*> bodies;
+    for (int i = 0; i < bodyCount; i++)
+    {
+        Shape* box = new Box(8, 8, 8);
+        box->position = Vector(i % side * 20 - arenaSize / 2, i / side % side * 20 - arenaSize / 2,
+                               i / (side * side) * 20 - arenaSize / 2);
+        box->updateBounds();
+        bodies.push_back(box);
+    }
+    world.addBodies(bodies);
+
+    std::vector<QueryRay> rays(rayCount);
+    for (int i = 0; i < rayCount; i++)
+    {
+        float angle = i * 2.39996f;
+        rays[i].origin = Vector(0, 0, 0);
+        rays[i].direction = Vector(std::cos(angle), std::sin(i * 0.37f), std::sin(angle));
+        rays[i].maxDistance = arenaSize;
+    }
+
+    SpatialQuery query(world);
+    std::vector<QueryHit> hits;
+    query.refresh();
+    auto begin = std::chrono::steady_clock::now();
+    if (bruteForce)
+    {
+        hits.assign(rayCount, QueryHit());
+        for (int i = 0; i < rayCount; i++)
+        {
+            Vector direction = rays[i].direction.normalized();
+            float closest = rays[i].maxDistance;
+            for (auto body : world.bodies)
+            {
+                float distance;
+                Vector normal;
+                if (castBody(*body, rays[i], closest, distance, normal) && distance < closest)
+                {
+                    closest = distance;
+                    hits[i].body = body;
+                    hits[i].distance = distance;
+                    hits[i].normal = normal;
+                }
+            }
+            hits[i].point = rays[i].origin + direction * closest;
+        }
+    }
+    else
+    {
+        query.castBatch(rays, hits);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count();
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+
+#include "PhysicsWorld.h"
+
+// Below this many queries, a batch runs on the calling thread only
+#define PARALLEL_MIN_QUERIES 64
+
+/**
+ * @brief The first body hit by a ray or a cast sphere
+ *
+ */
+struct QueryHit
+{
+    Shape* body = nullptr;
+    // Along the ray, 0 if it starts inside the body
+    float distance = 0;
+    // Point of the body touched, and its outward unit normal there
+    Vector point;
+    Vector normal;
+};
+
+/**
+ * @brief A ray of a batch, or a sphere cast along it when the radius is positive
+ *
+ */
+struct QueryRay
+{
+    Vector origin;
+    Vector direction;
+    float maxDistance = 0;
+    float radius = 0;
+};
+
+/**
+ * @brief Raycasts, sphere casts and box overlaps against the bodies of a world, accelerated by its AABB tree.
+ * The tree holds every body whichever broad phase steps the world, and is refreshed before the first query
+ * following a step. Rays are culled by the tree, then tested against the real shape of the bodies they reach
+ * with the GJK ray cast, the children of a compound one by one. The static geometry is not tested.
+ * A single query is not thread safe, but the batches split their queries across threads with OpenMP
+ *
+ */
+class SpatialQuery
+{
+private:
+    PhysicsWorld& world;
+    // Step and body count of the world when the tree was last refreshed
+    int refreshedStep = -1;
+    size_t refreshedCount = 0;
+    // Traversal stack of the queries made on the calling thread
+    std::vector<int> stack;
+
+    bool cast(const QueryRay& ray, QueryHit& hit, std::vector<int>& traversal);
+    static bool castBody(Shape& body, const QueryRay& ray, float maxDistance, float& distance, Vector& normal);
+
+public:
+    // Threads of the batches, 0 for every core
+    int threadCount = 0;
+
+    explicit SpatialQuery(PhysicsWorld& world);
+
+    void refresh();
+    bool raycast(Vector origin, Vector direction, float maxDistance, QueryHit& hit);
+    bool sphereCast(Vector origin, float radius, Vector direction, float maxDistance, QueryHit& hit);
+    void overlap(AABB box, std::vector<Shape*>& results);
+    int castBatch(const std::vector<QueryRay>& rays, std::vector<QueryHit>& hits);
+    void overlapBatch(const std::vector<AABB>& boxes, std::vector<std::vector<Shape*>>& results);
+    int getThreadCount();
+    static double benchmark(int bodyCount, int rayCount, bool bruteForce);
+};
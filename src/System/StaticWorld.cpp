@@ -0,0 +1,138 @@
+#include "StaticWorld.h"
+
+#include "Heightfield.h"
+
+StaticWorld::~StaticWorld()
+{
+    clear();
+}
+
+/**
+ * @brief Add a collider to the world, which takes its ownership. build() must be called once every collider of
+ * the scene is added
+ * @param collider The collider to add
+ */
+void StaticWorld::add(StaticCollider* collider)
+{
+    colliders.push_back(collider);
+    if (collider->isBounded()) bounded.push_back(collider);
+    else unbounded.push_back(collider);
+}
+
+/**
+ * @brief Same as addPlane, so that a plane added as any other collider is also swept by continuous collisions
+ * @param plane The plane to add
+ */
+void StaticWorld::add(StaticPlane* plane)
+{
+    addPlane(plane);
+}
+
+/**
+ * @brief Add a plane to the world, which takes its ownership. Planes do not need a build
+ * @param plane The plane to add
+ */
+void StaticWorld::addPlane(StaticPlane* plane)
+{
+    colliders.push_back(plane);
+    unbounded.push_back(plane);
+    planes.push_back(plane);
+}
+
+/**
+ * @brief Build the BVH of the bounded colliders. Meant to be called once, after loading the scene
+ */
+void StaticWorld::build()
+{
+    std::vector<AABB> bounds;
+    bounds.reserve(bounded.size());
+    for (auto collider : bounded)
+    {
+        bounds.push_back(collider->getBounds());
+    }
+    bvh.build(bounds);
+}
+
+/**
+ * @brief Add the 6 walls of a cubic arena centered on the origin, facing inwards, and build the world
+ * @param halfSize Half size of the arena
+ */
+void StaticWorld::addArena(float halfSize)
+{
+    addPlane(new StaticPlane(Vector(1, 0, 0), -halfSize));
+    addPlane(new StaticPlane(Vector(-1, 0, 0), -halfSize));
+    addPlane(new StaticPlane(Vector(0, 1, 0), -halfSize));
+    addPlane(new StaticPlane(Vector(0, -1, 0), -halfSize));
+    addPlane(new StaticPlane(Vector(0, 0, 1), -halfSize));
+    addPlane(new StaticPlane(Vector(0, 0, -1), -halfSize));
+    build();
+}
+
+/**
+ * @brief Add a wavy heightfield covering the floor of the arena, and build the world
+ * @param halfSize Half size of the arena
+ * @param spacing Distance between two samples, also the height of the waves
+ */
+void StaticWorld::addTerrain(float halfSize, float spacing)
+{
+    int samples = static_cast<int>(2 * halfSize / spacing) + 1;
+    std::vector<float> heights(samples * samples);
+    for (int row = 0; row < samples; row++)
+    {
+        for (int column = 0; column < samples; column++)
+        {
+            heights[row * samples + column] = spacing * 0.5f * (1 + sin(column * 0.8f) * cos(row * 0.6f));
+        }
+    }
+    add(new Heightfield(Vector(-halfSize, -halfSize, -halfSize), samples, samples, spacing, heights));
+    build();
+}
+
+/**
+ * @brief Remove and delete every collider
+ */
+void StaticWorld::clear()
+{
+    for (auto collider : colliders)
+    {
+        delete collider;
+    }
+    colliders.clear();
+    planes.clear();
+    bounded.clear();
+    unbounded.clear();
+    bvh.clear();
+}
+
+/**
+ * @brief Find the contacts of a body with the static geometry, at most one per collider
+ * @param body The dynamic body
+ * @param contacts The contacts are appended to this vector
+ */
+void StaticWorld::getContacts(RigidBody& body, std::vector<Contact>& contacts)
+{
+    Contact contact;
+    for (auto collider : unbounded)
+    {
+        if (!collider->collide(body, contact)) continue;
+        contact.staticMaterial = collider->material;
+        contacts.push_back(contact);
+    }
+
+    candidates.clear();
+    bvh.query(body.getBounds(), candidates);
+    for (auto index : candidates)
+    {
+        if (!bounded[index]->collide(body, contact)) continue;
+        contact.staticMaterial = bounded[index]->material;
+        contacts.push_back(contact);
+    }
+}
+
+void StaticWorld::draw()
+{
+    for (auto collider : colliders)
+    {
+        collider->draw();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+
+#include "Contact.h"
+#include "StaticBVH.h"
+#include "StaticCollider.h"
+#include "StaticPlane.h"
+
+/**
+ * @brief Owner of the static geometry of the scene. Bounded colliders are gathered in a BVH built once when
+ * loading is done, unbounded ones such as the planes are kept apart and tested against every body
+ *
+ */
+class StaticWorld
+{
+private:
+    std::vector<StaticCollider*> bounded;
+    std::vector<StaticCollider*> unbounded;
+    StaticBVH bvh;
+    // Colliders found by the last BVH query
+    std::vector<int> candidates;
+
+public:
+    // Every collider, owned by the world
+    std::vector<StaticCollider*> colliders;
+    // The planes also sweep the continuous collisions
+    std::vector<StaticPlane*> planes;
+
+    ~StaticWorld();
+
+    void add(StaticCollider* collider);
+    void add(StaticPlane* plane);
+    void addPlane(StaticPlane* plane);
+    void build();
+    void addArena(float halfSize);
+    void addTerrain(float halfSize, float spacing);
+    void clear();
+    void getContacts(RigidBody& body, std::vector<Contact>& contacts);
+    void draw();
+};
@@ -0,0 +1,173 @@
+#include "TrajectoryFile.h"
+
+#include <cstring>
+
+#include "MappedFile.h"
+
+// Longest run or literal sequence of the run-length encoding
+#define TRAJECTORY_MAX_RUN 128
+
+/**
+ * @param column The column, in the order of the field bits
+ * @param body The index of the body in the chunk
+ * @param frame The index of the frame in the chunk
+ * @return The recorded value
+ */
+float TrajectoryChunk::getValue(int column, int body, int frame)
+{
+    return values[(column * ids.size() + body) * steps.size() + frame];
+}
+
+/**
+ * @param fields The recorded fields, as TRAJECTORY_ bits
+ * @return The number of columns recorded for each body
+ */
+int TrajectoryFile::getColumnCount(uint32_t fields)
+{
+    int count = 0;
+    if (fields & TRAJECTORY_POSITION) count += 3;
+    if (fields & TRAJECTORY_ORIENTATION) count += 4;
+    if (fields & TRAJECTORY_LINEAR_VELOCITY) count += 3;
+    if (fields & TRAJECTORY_ANGULAR_VELOCITY) count += 3;
+    if (fields & TRAJECTORY_CONTACTS) count += 1;
+    return count;
+}
+
+/**
+ * @brief Compress words: XOR with the previous word, bytes grouped by significance, then runs of a same byte
+ * are stored as a count and the byte, other bytes as a count and the literal sequence
+ * @param words The words to compress
+ * @param out Receives the compressed bytes, appended
+ */
+void TrajectoryFile::encode(const std::vector<uint32_t>& words, std::vector<char>& out)
+{
+    size_t count = words.size();
+    std::vector<uint8_t> planes(count * 4);
+    uint32_t previous = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t delta = words[i] ^ previous;
+        previous = words[i];
+        for (int byte = 0; byte < 4; byte++)
+        {
+            planes[byte * count + i] = static_cast<uint8_t>(delta >> (8 * byte));
+        }
+    }
+
+    size_t i = 0;
+    while (i < planes.size())
+    {
+        size_t run = 1;
+        while (i + run < planes.size() && run < TRAJECTORY_MAX_RUN && planes[i + run] == planes[i]) run++;
+        if (run >= 3)
+        {
+            // 128 to 255: the next byte repeated count - 125 times
+            out.push_back(static_cast<char>(run + 125));
+            out.push_back(static_cast<char>(planes[i]));
+            i += run;
+            continue;
+        }
+
+        // 0 to 127: count + 1 literal bytes, until the next run of 3
+        size_t literal = 0;
+        while (i + literal < planes.size() && literal < TRAJECTORY_MAX_RUN)
+        {
+            size_t j = i + literal;
+            if (j + 2 < planes.size() && planes[j] == planes[j + 1] && planes[j] == planes[j + 2]) break;
+            literal++;
+        }
+        out.push_back(static_cast<char>(literal - 1));
+        out.insert(out.end(), planes.begin() + i, planes.begin() + i + literal);
+        i += literal;
+    }
+}
+
+/**
+ * @brief Decompress the output of encode
+ * @param data The compressed bytes
+ * @param size The number of compressed bytes
+ * @param words The words to fill, already sized to the number of words expected
+ * @return False if the data is corrupted
+ */
+bool TrajectoryFile::decode(const char* data, size_t size, std::vector<uint32_t>& words)
+{
+    size_t count = words.size();
+    std::vector<uint8_t> planes(count * 4);
+    size_t written = 0;
+    size_t i = 0;
+    while (i < size)
+    {
+        uint8_t control = static_cast<uint8_t>(data[i++]);
+        if (control >= 128)
+        {
+            size_t run = control - 125;
+            if (i >= size || written + run > planes.size()) return false;
+            std::memset(planes.data() + written, static_cast<uint8_t>(data[i++]), run);
+            written += run;
+        }
+        else
+        {
+            size_t literal = control + 1;
+            if (i + literal > size || written + literal > planes.size()) return false;
+            std::memcpy(planes.data() + written, data + i, literal);
+            i += literal;
+            written += literal;
+        }
+    }
+    if (written != planes.size()) return false;
+
+    uint32_t previous = 0;
+    for (size_t w = 0; w < count; w++)
+    {
+        uint32_t delta = 0;
+        for (int byte = 0; byte < 4; byte++)
+        {
+            delta |= static_cast<uint32_t>(planes[byte * count + w]) << (8 * byte);
+        }
+        previous ^= delta;
+        words[w] = previous;
+    }
+    return true;
+}
+
+/**
+ * @brief Decode every chunk of a trajectory file
+ * @param path The path of the file
+ * @return False if the file can not be read or is corrupted, the chunks before the corruption are kept
+ */
+bool TrajectoryFile::read(const std::string& path)
+{
+    chunks.clear();
+    MappedFile file;
+    if (!file.open(path) || file.getSize() < sizeof(TrajectoryHeader)) return false;
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (header.magic != TRAJECTORY_MAGIC || header.version != TRAJECTORY_VERSION) return false;
+
+    int columnCount = getColumnCount(header.fields);
+    size_t offset = sizeof(TrajectoryHeader);
+    std::vector<uint32_t> words;
+    while (offset < file.getSize())
+    {
+        TrajectoryChunkHeader chunkHeader;
+        if (offset + sizeof(chunkHeader) > file.getSize()) return false;
+        std::memcpy(&chunkHeader, file.getData() + offset, sizeof(chunkHeader));
+        offset += sizeof(chunkHeader);
+        if (offset + chunkHeader.encodedSize > file.getSize()) return false;
+
+        size_t frames = chunkHeader.frameCount;
+        size_t bodies = chunkHeader.bodyCount;
+        words.assign(bodies + frames + columnCount * bodies * frames, 0);
+        if (!decode(file.getData() + offset, chunkHeader.encodedSize, words)) return false;
+        offset += chunkHeader.encodedSize;
+
+        TrajectoryChunk chunk;
+        chunk.ids.resize(bodies);
+        chunk.steps.resize(frames);
+        chunk.values.resize(columnCount * bodies * frames);
+        std::memcpy(chunk.ids.data(), words.data(), bodies * sizeof(uint32_t));
+        std::memcpy(chunk.steps.data(), words.data() + bodies, frames * sizeof(uint32_t));
+        std::memcpy(chunk.values.data(), words.data() + bodies + frames, chunk.values.size() * sizeof(uint32_t));
+        chunks.push_back(std::move(chunk));
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// "FETJ" read as a little endian integer
+#define TRAJECTORY_MAGIC 0x4A544546u
+// Increased whenever the layout of the file changes
+#define TRAJECTORY_VERSION 1u
+// Recorded frames per chunk, a chunk is also closed early when the bodies change
+#define TRAJECTORY_CHUNK_FRAMES 64
+
+// Bits of TrajectoryHeader::fields, the recorded columns in this order
+// 3 columns: x, y, z
+#define TRAJECTORY_POSITION (1u << 0)
+// 4 columns: w, x, y, z
+#define TRAJECTORY_ORIENTATION (1u << 1)
+// 3 columns: x, y, z
+#define TRAJECTORY_LINEAR_VELOCITY (1u << 2)
+// 3 columns: x, y, z
+#define TRAJECTORY_ANGULAR_VELOCITY (1u << 3)
+// 1 column
+#define TRAJECTORY_CONTACTS (1u << 4)
+#define TRAJECTORY_ALL_FIELDS 0x1Fu
+
+struct TrajectoryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fields;
+    // Steps between two recorded frames
+    uint32_t interval;
+};
+
+/**
+ * @brief Precedes the encoded words of a chunk: the ids of the bodies, the steps of the frames, then every column
+ *
+ */
+struct TrajectoryChunkHeader
+{
+    uint32_t frameCount;
+    uint32_t bodyCount;
+    uint32_t encodedSize;
+    uint32_t reserved;
+};
+
+/**
+ * @brief The same bodies over consecutive recorded frames. The values are stored column after column, each column
+ * body after body, each body frame after frame, so that a trajectory is contiguous
+ *
+ */
+struct TrajectoryChunk
+{
+    std::vector<int32_t> ids;
+    std::vector<int32_t> steps;
+    std::vector<float> values;
+
+    float getValue(int column, int body, int frame);
+};
+
+/**
+ * @brief The chunked columnar format of the trajectory exports, and a reader decoding a whole file.
+ * Each word is XORed with the previous one, which leaves mostly zero bytes for smooth trajectories, then the
+ * bytes are grouped by significance and run-length encoded
+ *
+ */
+class TrajectoryFile
+{
+public:
+    TrajectoryHeader header = {};
+    std::vector<TrajectoryChunk> chunks;
+
+    static int getColumnCount(uint32_t fields);
+    static void encode(const std::vector<uint32_t>& words, std::vector<char>& out);
+    static bool decode(const char* data, size_t size, std::vector<uint32_t>& words);
+    bool read(const std::string& path);
+};
@@ -0,0 +1,183 @@
+#include "TrajectoryWriter.h"
+
+#include <algorithm>
+#include <cstring>
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+    close();
+}
+
+/**
+ * @brief Create the file, replacing it, and start the background thread
+ * @param path The path of the file
+ * @param fields The fields to record, as TRAJECTORY_ bits
+ * @param interval The number of steps between two recorded frames
+ * @return False if the file can not be created
+ */
+bool TrajectoryWriter::open(const std::string& path, uint32_t fields, int interval)
+{
+    close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    TrajectoryHeader header = {TRAJECTORY_MAGIC, TRAJECTORY_VERSION, fields, static_cast<uint32_t>(interval)};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    this->fields = fields;
+    this->interval = std::max(interval, 1);
+    columnCount = TrajectoryFile::getColumnCount(fields);
+    stopping = false;
+    active = true;
+    worker = std::thread(&TrajectoryWriter::run, this);
+    return true;
+}
+
+bool TrajectoryWriter::isOpen()
+{
+    return active;
+}
+
+/**
+ * @brief Copy the state of the bodies into the current chunk if the step is one of the recorded ones.
+ * Only blocks to hand a full chunk to the background thread
+ * @param world The world, after its step
+ */
+void TrajectoryWriter::record(PhysicsWorld& world)
+{
+    if (!active || world.stepCount % interval != 0) return;
+
+    size_t bodyCount = world.bodies.size();
+    bool sameBodies = current.ids.size() == bodyCount;
+    for (size_t i = 0; sameBodies && i < bodyCount; i++)
+    {
+        sameBodies = current.ids[i] == world.bodies[i]->id;
+    }
+    if (!sameBodies)
+    {
+        if (!current.steps.empty()) pushChunk();
+        for (auto body : world.bodies)
+        {
+            current.ids.push_back(body->id);
+        }
+        current.values.assign(columnCount * bodyCount * TRAJECTORY_CHUNK_FRAMES, 0);
+    }
+
+    size_t frame = current.steps.size();
+    current.steps.push_back(world.stepCount);
+    for (size_t i = 0; i < bodyCount; i++)
+    {
+        Shape* body = world.bodies[i];
+        float row[14];
+        int count = 0;
+        if (fields & TRAJECTORY_POSITION)
+        {
+            row[count++] = body->position.x;
+            row[count++] = body->position.y;
+            row[count++] = body->position.z;
+        }
+        if (fields & TRAJECTORY_ORIENTATION)
+        {
+            row[count++] = body->orientation.w;
+            row[count++] = body->orientation.x;
+            row[count++] = body->orientation.y;
+            row[count++] = body->orientation.z;
+        }
+        if (fields & TRAJECTORY_LINEAR_VELOCITY)
+        {
+            row[count++] = body->linearVelocity.x;
+            row[count++] = body->linearVelocity.y;
+            row[count++] = body->linearVelocity.z;
+        }
+        if (fields & TRAJECTORY_ANGULAR_VELOCITY)
+        {
+            row[count++] = body->angularVelocity.x;
+            row[count++] = body->angularVelocity.y;
+            row[count++] = body->angularVelocity.z;
+        }
+        if (fields & TRAJECTORY_CONTACTS)
+        {
+            row[count++] = static_cast<float>(body->contactCount);
+        }
+        for (int column = 0; column < count; column++)
+        {
+            current.values[(column * bodyCount + i) * TRAJECTORY_CHUNK_FRAMES + frame] = row[column];
+        }
+    }
+
+    if (current.steps.size() == TRAJECTORY_CHUNK_FRAMES) pushChunk();
+}
+
+/**
+ * @brief Flush the current chunk, wait for the background thread to write every chunk and close the file
+ */
+void TrajectoryWriter::close()
+{
+    if (!active) return;
+    if (!current.steps.empty()) pushChunk();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    worker.join();
+    file.close();
+    active = false;
+}
+
+/**
+ * @brief Hand the current chunk to the background thread and start a new one
+ */
+void TrajectoryWriter::pushChunk()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(current));
+    }
+    wakeUp.notify_one();
+    current = TrajectoryChunk();
+}
+
+/**
+ * @brief Background thread: write the pending chunks until the writer is closed
+ */
+void TrajectoryWriter::run()
+{
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeUp.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) return;
+        TrajectoryChunk chunk = std::move(pending.front());
+        pending.pop_front();
+        lock.unlock();
+
+        writeChunk(chunk);
+    }
+}
+
+/**
+ * @brief Compress a chunk and append it to the file
+ * @param chunk A chunk filled by record
+ */
+void TrajectoryWriter::writeChunk(TrajectoryChunk& chunk)
+{
+    size_t frames = chunk.steps.size();
+    size_t bodies = chunk.ids.size();
+    std::vector<uint32_t> words(bodies + frames + columnCount * bodies * frames);
+    std::memcpy(words.data(), chunk.ids.data(), bodies * sizeof(uint32_t));
+    std::memcpy(words.data() + bodies, chunk.steps.data(), frames * sizeof(uint32_t));
+    // The chunk has room for TRAJECTORY_CHUNK_FRAMES frames per body, only the recorded ones are kept
+    uint32_t* values = words.data() + bodies + frames;
+    for (size_t trajectory = 0; trajectory < columnCount * bodies; trajectory++)
+    {
+        std::memcpy(values + trajectory * frames, chunk.values.data() + trajectory * TRAJECTORY_CHUNK_FRAMES,
+                    frames * sizeof(uint32_t));
+    }
+
+    std::vector<char> encoded;
+    TrajectoryFile::encode(words, encoded);
+    TrajectoryChunkHeader header = {static_cast<uint32_t>(frames), static_cast<uint32_t>(bodies),
+                                    static_cast<uint32_t>(encoded.size()), 0};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(encoded.data(), encoded.size());
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "PhysicsWorld.h"
+#include "TrajectoryFile.h"
+
+/**
+ * @brief Streams the state of every body to a trajectory file, every few steps. The simulation thread only copies
+ * the values into the current chunk, full chunks are compressed and appended to the file by a background thread
+ *
+ */
+class TrajectoryWriter
+{
+private:
+    // Only used by the background thread once open
+    std::ofstream file;
+    bool active = false;
+    uint32_t fields = 0;
+    int interval = 1;
+    int columnCount = 0;
+    // Filled by the simulation thread, with room for TRAJECTORY_CHUNK_FRAMES frames per body
+    TrajectoryChunk current;
+
+    // Chunks waiting for the background thread
+    std::deque<TrajectoryChunk> pending;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::thread worker;
+    bool stopping = false;
+
+    void pushChunk();
+    void run();
+    void writeChunk(TrajectoryChunk& chunk);
+
+public:
+    TrajectoryWriter() = default;
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+    ~TrajectoryWriter();
+
+    bool open(const std::string& path, uint32_t fields, int interval);
+    bool isOpen();
+    void record(PhysicsWorld& world);
+    void close();
+};
@@ -1,11 +1,63 @@
 #include "ofMain.h"
 #include "ofApp.h"
+#include "ParticleSystem.h"
+#include "SPHSolver.h"
+#include "BarnesHutTree.h"
+#include "Cloth.h"
+#include "SpatialQuery.h"
 
 //========================================================================
-int main()
+int main(int argc, char* argv[])
 {
+    // Headless replay of a recording, without window: --replay <snapshot> <log> <steps>
+    if (argc == 5 && std::string(argv[1]) == "--replay")
+    {
+        return InputLog::runHeadless(argv[2], argv[3], std::atoi(argv[4])) ? 0 : 1;
+    }
+    // Headless measure of the fill of the render instances: --benchmark-instances <bodies> <frames>
+    if (argc == 4 && std::string(argv[1]) == "--benchmark-instances")
+    {
+        std::cout << InstanceBuffer::benchmark(std::atoi(argv[2]), std::atoi(argv[3])) << " ms per fill" << std::endl;
+        return 0;
+    }
+    // Headless measure of the 2D particle system: --benchmark-particles <particles> <steps>
+    if (argc == 4 && std::string(argv[1]) == "--benchmark-particles")
+    {
+        std::cout << ParticleSystem::benchmark(std::atoi(argv[2]), std::atoi(argv[3])) << " ms per step" << std::endl;
+        return 0;
+    }
+    // Headless measure of the fluid: --benchmark-fluid <particles> <steps>
+    if (argc == 4 && std::string(argv[1]) == "--benchmark-fluid")
+    {
+        std::cout << SPHSolver::benchmark(std::atoi(argv[2]), std::atoi(argv[3])) << " ms per step" << std::endl;
+        return 0;
+    }
+    // Headless measure of the long range forces: --benchmark-nbody <bodies> <opening angle>
+    if (argc == 4 && std::string(argv[1]) == "--benchmark-nbody")
+    {
+        std::cout << BarnesHutTree::benchmark(std::atoi(argv[2]), std::atof(argv[3])) << " ms per evaluation"
+            << std::endl;
+        return 0;
+    }
+    // Headless measure of the cloth: --benchmark-cloth <particles per side> <steps>
+    if (argc == 4 && std::string(argv[1]) == "--benchmark-cloth")
+    {
+        std::cout << Cloth::benchmark(std::atoi(argv[2]), std::atoi(argv[3])) << " ms per step" << std::endl;
+        return 0;
+    }
+    // Headless measure of a batch of raycasts, through the tree then against every body: --benchmark-queries <bodies> <rays>
+    if (argc == 4 && std::string(argv[1]) == "--benchmark-queries")
+    {
+        std::cout << SpatialQuery::benchmark(std::atoi(argv[2]), std::atoi(argv[3]), false) << " ms with the tree, "
+            << SpatialQuery::benchmark(std::atoi(argv[2]), std::atoi(argv[3]), true) << " ms against every body"
+            << std::endl;
+        return 0;
+    }
+
     //Use ofGLFWWindowSettings for more options like multi-monitor fullscreen
     ofGLWindowSettings settings;
+    // Instanced rendering needs the programmable renderer
+    settings.setGLVersion(3, 3);
     settings.setSize(1024, 768);
     settings.windowMode = OF_WINDOW; //can also be OF_FULLSCREEN
 
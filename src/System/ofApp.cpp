@@ -1,6 +1,7 @@
 #include "ofApp.h"
 
-#include "CollisionManager.h"
+#include "SceneLoader.h"
+#include "Snapshot.h"
 
 
 float maxX = max(BOX_WIDTH, CONE_RADIUS);
@@ -85,6 +86,9 @@ void ofApp::setupObjectPanel()
     addButton.setup("Add");
     addButton.addListener(this, &ofApp::addObject);
     objectPanel.add(&addButton);
+    terrainButton.setup("Add terrain");
+    terrainButton.addListener(this, &ofApp::addTerrain);
+    objectPanel.add(&terrainButton);
 }
 
 /**
@@ -115,6 +119,21 @@ void ofApp::setupControlPanel()
     controlPanel.add(collisionToggle.setup("Enable collisions", true));
     clearAll.addListener(this, &ofApp::clearAllObjects);
     controlPanel.add(octreeToggle.setup("Enable Octree", true)); //contr
+    controlPanel.add(aabbTreeToggle.setup("Use AABB tree", false));
+    controlPanel.add(ccdToggle.setup("Continuous collisions", false));
+    controlPanel.add(deterministicToggle.setup("Deterministic mode", false));
+    saveSnapshotButton.setup("Save snapshot");
+    saveSnapshotButton.addListener(this, &ofApp::saveSnapshot);
+    controlPanel.add(&saveSnapshotButton);
+    loadSnapshotButton.setup("Load snapshot");
+    loadSnapshotButton.addListener(this, &ofApp::loadSnapshot);
+    controlPanel.add(&loadSnapshotButton);
+    sceneButton.setup("Load scene");
+    sceneButton.addListener(this, &ofApp::loadDefaultScene);
+    controlPanel.add(&sceneButton);
+    controlPanel.add(recordToggle.setup("Record inputs", false));
+    controlPanel.add(exportToggle.setup("Export trajectories", false));
+    controlPanel.add(particlesToggle.setup("Particle fountain", false));
 }
 
 /**
@@ -152,6 +171,7 @@ void ofApp::setup()
     // rather than always drawing things on top of each other
     ofEnableDepthTest();
     ofSetCircleResolution(64);
+    instanceRenderer.setup();
     bHelpText = true;
 
     // Setup the GUI
@@ -161,7 +181,31 @@ void ofApp::setup()
     setupForcePanel();
     setupObjectPanel();
     setupCollisionPanel();
-    
+
+    setupArena();
+    particles.reserve(FOUNTAIN_CAPACITY);
+    particles.gravity = Vector(0, -FOUNTAIN_GRAVITY);
+    fountain.spread = 0.2f;
+    fountain.radius = 2;
+    simulation.start();
+}
+
+/**
+ * \brief Setup the static geometry: the 6 walls of the arena, facing inwards
+ */
+void ofApp::setupArena()
+{
+    world.staticWorld.addArena(VP_SIZE);
+}
+
+/**
+ * \brief Terrain button handler. Adds a wavy heightfield covering the floor of the arena
+ */
+void ofApp::addTerrain()
+{
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    inputLog.submit(world, InputLog::terrainEvent(VP_STEP));
+    terrainAdded = true;
 }
 
 //--------------------------------------------------------------
@@ -187,21 +231,21 @@ void ofApp::setConeType()
  */
 void ofApp::addObject()
 {
-    Shape* s;
+    // We divide the force by the duration of the next step to increase the applied force as it is meant to be an impulse
+    Vector initialForce = Vector(xfInput, yfInput, zfInput) * (1 / FIXED_TIME_STEP);
+    Vector position(xpInputObject, ypInputObject, zpInputObject);
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
     switch (objectType)
     {
     case BOX:
-        s = new Box(BOX_WIDTH,BOX_HEIGTH,BOX_LENGTH,
-                                      Vector(xpInputObject, ypInputObject, zpInputObject));
-        tabShape.emplace_back(s);
-        octree.insert(s);
+        inputLog.submit(world, InputLog::addBodyEvent(BoxShape, Vector(BOX_WIDTH, BOX_HEIGTH, BOX_LENGTH), position,
+                                                      ccdToggle, initialForce));
         break;
     case CONE:
-        tabShape.emplace_back(new Cone(CONE_RADIUS,CONE_HEIGHT, Vector(xpInputObject, ypInputObject, zpInputObject)));
+        inputLog.submit(world, InputLog::addBodyEvent(ConeShape, Vector(CONE_RADIUS, CONE_HEIGHT, 0), position,
+                                                      ccdToggle, initialForce));
         break;
     }
-    // We divide the force by delta_t to increase the applied force as it is meant to be an impulse
-    tabShape.back()->addForce(Vector(xfInput, yfInput, zfInput)*(1/delta_t), Vector(0,0,0));
 }
 
 /**
@@ -209,12 +253,144 @@ void ofApp::addObject()
  */
 void ofApp::clearAllObjects()
 {
-    for (Shape* obj : tabShape)
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    inputLog.submit(world, InputLog::clearEvent());
+    pickedId = -1;
+}
+
+/**
+ * \brief Save the bodies and settings of the world in the data folder
+ */
+void ofApp::saveSnapshot()
+{
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    if (!Snapshot::save(world, ofToDataPath(SNAPSHOT_FILE)))
+    {
+        std::cout << "The snapshot could not be saved" << std::endl;
+    }
+}
+
+/**
+ * \brief Restore the world saved by saveSnapshot, the toggles follow the restored settings
+ */
+void ofApp::loadSnapshot()
+{
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    if (inputLog.recording)
+    {
+        // The replay starts from the recorded snapshot and can not load another one
+        std::cout << "Stop the recording before loading a snapshot" << std::endl;
+    }
+    else if (Snapshot::load(world, ofToDataPath(SNAPSHOT_FILE)))
     {
-        delete obj;
+        syncToggles();
+        pickedId = -1;
+    }
+    else
+    {
+        std::cout << "No valid snapshot to load" << std::endl;
+    }
+}
+
+/**
+ * \brief Load a scene file, replacing the bodies. The toggles follow the settings of the scene
+ * \param path The path of the JSON scene
+ */
+void ofApp::loadScene(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    if (inputLog.recording)
+    {
+        // The input log has no event for a scene, the replay would go on with the recorded bodies
+        std::cout << "Stop the recording before loading a scene" << std::endl;
+    }
+    else if (SceneLoader::loadFile(world, path))
+    {
+        syncToggles();
+        pickedId = -1;
+    }
+    else
+    {
+        std::cout << "The scene " << path << " could not be loaded" << std::endl;
+    }
+}
+
+/**
+ * \brief Scene button handler
+ */
+void ofApp::loadDefaultScene()
+{
+    loadScene(ofToDataPath(SCENE_FILE));
+}
+
+/**
+ * \brief Set the toggles to the settings of the world, after it was replaced
+ */
+void ofApp::syncToggles()
+{
+    gravityToggle = world.gravity;
+    frictionToggle = world.friction;
+    collisionToggle = world.collisions;
+    aabbTreeToggle = world.useAABBTree;
+    deterministicToggle = world.deterministic;
+}
+
+/**
+ * \brief Start or stop the recording when the record toggle changes. A recording is a snapshot of the world when
+ * it starts and the inputs given until it stops, replayed by running the application with
+ * --replay <snapshot> <log> <steps>
+ */
+void ofApp::updateRecording()
+{
+    if (recordToggle == inputLog.recording) return;
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    if (recordToggle)
+    {
+        // The replay runs fixed steps
+        deterministicToggle = true;
+        world.deterministic = true;
+        if (!Snapshot::save(world, ofToDataPath(RECORDING_SNAPSHOT_FILE)))
+        {
+            std::cout << "The recording could not be started" << std::endl;
+            recordToggle = false;
+            return;
+        }
+        inputLog.start(INPUT_LOG_ARENA | (terrainAdded ? INPUT_LOG_TERRAIN : 0), VP_SIZE, VP_STEP);
+    }
+    else
+    {
+        inputLog.stop();
+        if (!inputLog.save(ofToDataPath(RECORDING_LOG_FILE)))
+        {
+            std::cout << "The recorded inputs could not be saved" << std::endl;
+        }
+    }
+}
+
+/**
+ * \brief Open or close the trajectory file when the export toggle changes
+ */
+void ofApp::updateExport()
+{
+    if (exportToggle == trajectoryWriter.isOpen()) return;
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    if (exportToggle)
+    {
+        if (trajectoryWriter.open(ofToDataPath(TRAJECTORY_FILE), TRAJECTORY_ALL_FIELDS, TRAJECTORY_INTERVAL))
+        {
+            world.trajectoryWriter = &trajectoryWriter;
+        }
+        else
+        {
+            std::cout << "The trajectory file could not be created" << std::endl;
+            exportToggle = false;
+        }
+    }
+    else
+    {
+        world.trajectoryWriter = nullptr;
+        trajectoryWriter.close();
     }
-    tabShape.clear();
-    nColls = bColls = 0;
 }
 
 /**
@@ -239,10 +415,14 @@ void ofApp::togglePause()
  */
 void ofApp::launchObject()
 {
-    if (tabShape.empty()) std::cout << "No object to add force to !" << std::endl;
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    if (world.bodies.empty()) std::cout << "No object to add force to !" << std::endl;
     else
     {
-        addForceObject(*(tabShape.back()), Vector(xvInput, yvInput, zvInput), Vector(xpInput, ypInput, zpInput));
+        // The picked object if it still exists, the last added one otherwise
+        Shape* target = world.findBody(pickedId);
+        if (target == nullptr) target = world.bodies.back();
+        addForceObject(*target, Vector(xvInput, yvInput, zvInput), Vector(xpInput, ypInput, zpInput));
         simPause = false;
         showForceAdd = false;
     }
@@ -281,61 +461,6 @@ void updateLines(std::vector<ofxLabel*>& lines, const std::string& text)
 }
 //--------------------------------------------------------------
 
-/**
- * \brief Checks if the objects are out of bounds
- */
-void ofApp::checkBoundaries()
-{
-    for (auto box : tabShape)
-    {
-        // Check X borders
-        if (glm::abs(box->position.x) > VP_SIZE)
-        {
-            box->position.x = glm::sign(box->position.x) > 0 ? VP_SIZE : -VP_SIZE;
-            box->linearVelocity.x *= -1;
-        }
-
-        // Check Y borders
-        if (abs(box->position.y) > VP_SIZE)
-        {
-            box->position.y = glm::sign(box->position.y) > 0 ? VP_SIZE : -VP_SIZE;
-            box->linearVelocity.y *= -1;
-        }
-
-        // Check Z borders
-        if (abs(box->position.z) > VP_SIZE)
-        {
-            box->position.z = glm::sign(box->position.z) > 0 ? VP_SIZE : -VP_SIZE;
-            box->linearVelocity.z *= -1;
-        }
-
-        // A velocity cap check to make sure that the object doesn't go too fast and cross the boundaries (glitching visuals)
-        if (box->linearVelocity.magnitude() > MAX_VELOCITY)
-        {
-            box->linearVelocity = box->linearVelocity.normalized() * MAX_VELOCITY;
-        }
-    }
-}
-
-GravityGenerator genGravity(Vector(0, -9.81, 0));
-FrictionGenerator genFriction(0.1);
-
-/**
- * \brief Update the forces applied to the objects
- */
-void ofApp::updateForces()
-{
-    {
-        // Appliquer les forces
-        for (auto& object : tabShape)
-        {
-            if(gravityToggle) forceRegistry.add(object, &genGravity);
-            if(frictionToggle) forceRegistry.add(object, &genFriction);
-        }
-    }
-    forceRegistry.updateForces(delta_t);
-}
-
 Vector force;
 
 /**
@@ -346,46 +471,60 @@ Vector force;
  */
 void ofApp::addForceObject(Shape& obj, Vector forceIntensity, Vector pointApplication)
 {
-    obj.addForce(forceIntensity, pointApplication);
+    inputLog.submit(world, InputLog::addForceEvent(obj.id, forceIntensity, pointApplication));
 }
 
-/**
- * \brief Handle the collision detection and resolve
- */
-void ofApp::collisionHandler()
+//--------------------------------------------------------------
+void ofApp::update()
 {
-    if(collisionToggle){
-        octree.clear();
+    updateRecording();
+    updateExport();
+    updateParticles();
+
+    // Settings changes are inputs, recorded like the others
+    uint32_t settings = (gravityToggle ? SNAPSHOT_GRAVITY : 0) | (frictionToggle ? SNAPSHOT_FRICTION : 0)
+        | (collisionToggle ? SNAPSHOT_COLLISIONS : 0) | (aabbTreeToggle ? SNAPSHOT_AABB_TREE : 0)
+        | (deterministicToggle ? SNAPSHOT_DETERMINISTIC : 0);
+    // The settings are only written from this thread, they can be read without the lock
+    if (settings != Snapshot::getSettings(world))
+    {
+        std::lock_guard<std::mutex> lock(simulation.worldMutex);
+        inputLog.submit(world, InputLog::settingsEvent(settings));
+    }
 
-        for (auto object : tabShape)
-        {
-            octree.insert(object);
-        }
-        auto colls = octree.getCollisions();
-        auto narrowColls = CollisionManager::getNarrowCollision(colls);
-        bColls += colls.size();
-        nColls += narrowColls.size();
-        broadCollisions.setup("Broad Collisions", std::to_string(bColls));
-        narrowCollisions.setup("Narrow Collision", std::to_string(nColls));
+    simPause = showForceAdd;
+    simulation.paused = simPause;
+    simulation.speed = simSpeed;
+    simulation.captureBroadPhase = octreeToggle;
+
+    // The simulation runs on its own thread, only take its latest frame
+    if (simulation.renderBuffer.acquire())
+    {
+        const RenderFrame& frame = simulation.renderBuffer.getCurrent();
+        broadCollisions.setup("Broad Collisions", std::to_string(frame.broadCollisionCount));
+        narrowCollisions.setup("Narrow Collision", std::to_string(frame.narrowCollisionCount));
     }
 }
 
-//--------------------------------------------------------------
-void ofApp::update()
+/**
+ * \brief Step the particle fountain with the frame time while the particles toggle is on, in screen space. The
+ * particles collide with each other and bounce on the edges of the window
+ */
+void ofApp::updateParticles()
 {
-    collisionHandler();
-    checkBoundaries();
-
-    simPause = showForceAdd;
-    if (simPause) return;
-    // Set the delta time using the last frame time
-    updateForces();
-    for (auto object : tabShape)
+    if (!particlesToggle)
     {
-        object->eulerIntegration(delta_t);
+        particles.clear();
+        return;
     }
-    
-    delta_t = static_cast<float>(ofGetLastFrameTime()) * simSpeed;
+    // Long frames, such as a moved window, would throw the particles through each other
+    float delta_t = std::min(static_cast<float>(ofGetLastFrameTime()), 1.0f / 30.0f);
+    particles.width = ofGetWidth();
+    particles.height = ofGetHeight();
+    fountain.position = Vector(ofGetWidth() / 2.0f, fountain.radius);
+    fountain.emit(particles, delta_t);
+    particles.step(delta_t);
+    particles.updateColors(particles.width, particles.height);
 }
 
 /**
@@ -415,18 +554,58 @@ void ofApp::draw()
     cam.begin();
     ofEnableDepthTest();
 
-    for (auto& object : tabShape)
+    // Draw one step behind the simulation, blending the last two frames
+    const RenderFrame& previous = simulation.renderBuffer.getPrevious();
+    const RenderFrame& current = simulation.renderBuffer.getCurrent();
+    float alpha = 1;
+    if (current.time > previous.time)
     {
-        object->draw();
-        if (showDebug && object->linearVelocity.magnitude() > 2)
+        double renderTime = SimulationThread::now() - (current.time - previous.time);
+        alpha = ofClamp(static_cast<float>((renderTime - previous.time) / (current.time - previous.time)), 0, 1);
+    }
+    RenderFrame::interpolate(previous, current, alpha, drawnBodies);
+
+    // One instanced draw call per shape type
+    instanceBuffer.fill(drawnBodies);
+    instanceRenderer.draw(instanceBuffer);
+    if (showDebug)
+    {
+        for (auto& body : drawnBodies)
         {
-            ofSetColor(ofColor::greenYellow);
-            ofDrawArrow(object->position.v3(), (object->position + object->linearVelocity).v3(), 10);
-            ofSetColor(ofColor::white);
+            drawDebug(body);
         }
     }
+    for (auto& body : drawnBodies)
+    {
+        if (body.id != pickedId) continue;
+        ofNoFill();
+        ofSetColor(ofColor::yellow);
+        Vector boundsSize = body.bounds.halfExtents() * 2;
+        ofDrawBox(body.bounds.center().v3(), boundsSize.x, boundsSize.y, boundsSize.z);
+        ofFill();
+        ofSetColor(ofColor::white);
+    }
 
-    if(octreeToggle) octree.draw(false,"");
+    // Only modified from this thread, under the lock
+    world.staticWorld.draw();
+
+    if(octreeToggle)
+    {
+        ofNoFill();
+        ofSetColor(ofColor::red);
+        for (AABB box : current.broadPhaseBoxes)
+        {
+            Vector size = box.halfExtents() * 2;
+            ofDrawBox(box.center().v3(), size.x, size.y, size.z);
+        }
+        ofSetColor(ofColor::blue);
+        for (AABB box : current.broadPhaseNodes)
+        {
+            Vector size = box.halfExtents() * 2;
+            ofDrawBox(box.center().v3(), size.x, size.y, size.z);
+        }
+        ofFill();
+    }
     else
     {
         ofNoFill();
@@ -438,6 +617,7 @@ void ofApp::draw()
     ofDisableDepthTest();
     cam.end();
     drawInteractionArea();
+    if (particlesToggle) particles.draw();
     ofSetColor(255);
 
     controlPanel.draw();
@@ -445,15 +625,42 @@ void ofApp::draw()
     if (showForceAdd) forcePanel.draw();
     if(collisionToggle) collisionPanel.draw();
     objectPanel.draw();
-    if (showDebug   && tabShape.size() > 0)
+    if (showDebug   && current.bodies.size() > 0)
     {
         debugPanel.draw();
-        auto object = tabShape.back();
-        updateLines(debugLines1, object->position.to_string());
-        updateLines(debugLines2, object->linearVelocity.to_string());
+        RenderBody object = current.bodies.back();
+        for (auto& body : current.bodies)
+        {
+            if (body.id == pickedId) object = body;
+        }
+        updateLines(debugLines1, object.position.to_string());
+        updateLines(debugLines2, object.linearVelocity.to_string());
     }
 }
 
+/**
+ * \brief Draw the bounding box and the velocity of a body of a render frame
+ * \param body The body
+ */
+void ofApp::drawDebug(const RenderBody& body)
+{
+    ofNoFill();
+    ofSetColor(ofColor::red, 20);
+    AABB bounds = body.bounds;
+    Vector boundsSize = bounds.halfExtents() * 2;
+    ofDrawBox(bounds.center().v3(), boundsSize.x, boundsSize.y, boundsSize.z);
+    ofFill();
+
+    Vector position = body.position;
+    Vector velocity = body.linearVelocity;
+    if (velocity.magnitude() > 2)
+    {
+        ofSetColor(ofColor::greenYellow);
+        ofDrawArrow(position.v3(), (position + velocity).v3(), 10);
+    }
+    ofSetColor(ofColor::white);
+}
+
 
 //--------------------------------------------------------------
 void ofApp::keyPressed(int key)
@@ -493,16 +700,49 @@ void ofApp::mouseMoved(int x, int y)
 //--------------------------------------------------------------
 void ofApp::mouseDragged(int x, int y, int button)
 {
+    pickPending = false;
 }
 
 //--------------------------------------------------------------
 void ofApp::mousePressed(int x, int y, int button)
 {
+    pickPending = button == OF_MOUSE_BUTTON_LEFT && !isOverPanel(x, y);
 }
 
 //--------------------------------------------------------------
+/**
+ * \brief Pick the object under the cursor with a ray from the camera, or unselect when there is none. Only a click
+ * picks, the cursor must not have moved since the press
+ */
 void ofApp::mouseReleased(int x, int y, int button)
 {
+    if (button != OF_MOUSE_BUTTON_LEFT || !pickPending) return;
+    pickPending = false;
+
+    // From the near plane to the far plane, through the cursor
+    glm::vec3 nearPoint = cam.screenToWorld(glm::vec3(x, y, -1));
+    glm::vec3 farPoint = cam.screenToWorld(glm::vec3(x, y, 1));
+    Vector origin(nearPoint.x, nearPoint.y, nearPoint.z);
+    Vector direction = Vector(farPoint.x, farPoint.y, farPoint.z) - origin;
+
+    std::lock_guard<std::mutex> lock(simulation.worldMutex);
+    QueryHit hit;
+    pickedId = spatialQuery.raycast(origin, direction, direction.magnitude(), hit) ? hit.body->id : -1;
+}
+
+/**
+ * \brief Check if a point of the window is on one of the panels drawn
+ */
+bool ofApp::isOverPanel(int x, int y)
+{
+    ofxPanel* panels[6] = {&controlPanel, &objectPanel, showHelp ? &helpPanel : nullptr,
+                           showForceAdd ? &forcePanel : nullptr, collisionToggle ? &collisionPanel : nullptr,
+                           showDebug ? &debugPanel : nullptr};
+    for (ofxPanel* panel : panels)
+    {
+        if (panel != nullptr && panel->getShape().inside(x, y)) return true;
+    }
+    return false;
 }
 
 //--------------------------------------------------------------
@@ -528,6 +768,11 @@ void ofApp::gotMessage(ofMessage msg)
 //--------------------------------------------------------------
 void ofApp::dragEvent(ofDragInfo dragInfo)
 {
+    // Dropped JSON files are loaded as scenes
+    for (auto& file : dragInfo.files)
+    {
+        if (ofToLower(ofFilePath::getFileExt(file)) == "json") loadScene(file);
+    }
 }
 
 /////////////////////////////// UNIT TESTS ///////////////////////////////
@@ -541,6 +786,28 @@ void ofApp::unitTests()
     vectorTests();
     matrixTests();
     quaternionTests();
+    aabbTreeTests();
+    boundsTests();
+    gjkTests();
+    narrowPhaseTests();
+    continuousCollisionTests();
+    staticGeometryTests();
+    determinismTests();
+    snapshotTests();
+    inputLogTests();
+    trajectoryTests();
+    sceneLoaderTests();
+    simulationThreadTests();
+    instanceBufferTests();
+    particleSystemTests();
+    sphSolverTests();
+    barnesHutTests();
+    clothTests();
+    jointTests();
+    materialTests();
+    massPropertiesTests();
+    convexHullTests();
+    spatialQueryTests();
 }
 
 void ofApp::vectorTests()
@@ -587,3 +854,201 @@ void ofApp::quaternionTests()
     quaternionTest.testQuaternionApplyRotation();
     quaternionTest.testQuaternionToMatrix();
 }
+
+void ofApp::aabbTreeTests()
+{
+    AABBTreeTest::testCollisions();
+    AABBTreeTest::testUpdate();
+    AABBTreeTest::testUnbounded();
+    AABBTreeTest::testRaycast();
+    AABBTreeTest::testOverlap();
+    AABBTreeTest::testBalance();
+}
+
+void ofApp::boundsTests()
+{
+    BoundsTest::testBoxBounds();
+    BoundsTest::testRotatedBoxBounds();
+    BoundsTest::testConeBounds();
+    BoundsTest::testRotatedConeBounds();
+}
+
+void ofApp::gjkTests()
+{
+    GJKTest::testSeparatedBoxes();
+    GJKTest::testOverlappingBoxes();
+    GJKTest::testRotatedBoxes();
+    GJKTest::testSpheres();
+    GJKTest::testBoxCone();
+}
+
+void ofApp::narrowPhaseTests()
+{
+    NarrowPhaseTest::testSphereSphere();
+    NarrowPhaseTest::testSphereBox();
+    NarrowPhaseTest::testSphereInsideBox();
+    NarrowPhaseTest::testBoxBoxFace();
+    NarrowPhaseTest::testBoxBoxAgainstGJK();
+    NarrowPhaseTest::testSortByShapeType();
+}
+
+void ofApp::continuousCollisionTests()
+{
+    ContinuousCollisionTest::testSpherePlane();
+    ContinuousCollisionTest::testBoxPlane();
+    ContinuousCollisionTest::testSphereSphere();
+    ContinuousCollisionTest::testFastBoxTunnelling();
+    ContinuousCollisionTest::testOverlappingStart();
+    ContinuousCollisionTest::testRestingContact();
+}
+
+void ofApp::staticGeometryTests()
+{
+    StaticGeometryTest::testPlane();
+    StaticGeometryTest::testHeightfield();
+    StaticGeometryTest::testBVHQuery();
+    StaticGeometryTest::testTriangleMesh();
+    StaticGeometryTest::testStaticWorld();
+}
+
+void ofApp::determinismTests()
+{
+    DeterminismTest::testRepeatableSteps();
+    DeterminismTest::testPairOrder();
+    DeterminismTest::testFixedStep();
+}
+
+void ofApp::snapshotTests()
+{
+    SnapshotTest::testRoundTrip();
+    SnapshotTest::testInvalidData();
+    SnapshotTest::testWrongVersion();
+    SnapshotTest::testSceneForces();
+    SnapshotTest::testJoints();
+    SnapshotTest::testCompound();
+    SnapshotTest::testHull();
+    SnapshotTest::testMaterials();
+}
+
+void ofApp::inputLogTests()
+{
+    InputLogTest::testReplayMatchesRecording();
+    InputLogTest::testReplayAfterClear();
+    InputLogTest::testSaveLoad();
+    InputLogTest::testShapes();
+}
+
+void ofApp::trajectoryTests()
+{
+    TrajectoryTest::testCodecRoundTrip();
+    TrajectoryTest::testSmoothDataCompresses();
+    TrajectoryTest::testWriterMatchesWorld();
+}
+
+void ofApp::sceneLoaderTests()
+{
+    SceneLoaderTest::testBodiesAndMaterials();
+    SceneLoaderTest::testSpringsAndForces();
+    SceneLoaderTest::testInvalidScene();
+    SceneLoaderTest::testBulkBuild();
+}
+
+void ofApp::simulationThreadTests()
+{
+    SimulationThreadTest::testTripleBuffer();
+    SimulationThreadTest::testInterpolation();
+    SimulationThreadTest::testThreadSteps();
+    SimulationThreadTest::testRealTimeSteps();
+}
+
+void ofApp::instanceBufferTests()
+{
+    InstanceBufferTest::testGrouping();
+    InstanceBufferTest::testTransform();
+    InstanceBufferTest::testCapture();
+    InstanceBufferTest::testNormalMatrix();
+}
+
+void ofApp::particleSystemTests()
+{
+    ParticleSystemTest::testIntegration();
+    ParticleSystemTest::testCollision();
+    ParticleSystemTest::testGridMatchesBruteForce();
+    ParticleSystemTest::testOversizedParticles();
+    ParticleSystemTest::testEscapedParticle();
+    ParticleSystemTest::testThreadCount();
+    ParticleSystemTest::testEmitterPool();
+    ParticleSystemTest::testCollidingPool();
+}
+
+void ofApp::sphSolverTests()
+{
+    SPHSolverTest::testNeighbours();
+    SPHSolverTest::testDensity();
+    SPHSolverTest::testPressure();
+}
+
+void ofApp::barnesHutTests()
+{
+    BarnesHutTest::testExactSum();
+    BarnesHutTest::testApproximation();
+    BarnesHutTest::testElectrostatic();
+    BarnesHutTest::testMutualGravity();
+    BarnesHutTest::testOwnCell();
+}
+
+void ofApp::clothTests()
+{
+    ClothTest::testGridConstraints();
+    ClothTest::testHangingCloth();
+    ClothTest::testSelfCollision();
+    ClothTest::testSoftBoxOnPlane();
+}
+
+void ofApp::jointTests()
+{
+    JointTest::testBallSocketPendulum();
+    JointTest::testHinge();
+    JointTest::testSlider();
+    JointTest::testFixedCantilever();
+    JointTest::testWarmStarting();
+    JointTest::testTorque();
+}
+
+void ofApp::materialTests()
+{
+    MaterialTest::testCombineModes();
+    MaterialTest::testTable();
+    MaterialTest::testStaticContact();
+    MaterialTest::testSlidingBox();
+    MaterialTest::testSceneMaterials();
+}
+
+void ofApp::massPropertiesTests()
+{
+    MassPropertiesTest::testPrimitives();
+    MassPropertiesTest::testPolyhedron();
+    MassPropertiesTest::testCompound();
+    MassPropertiesTest::testCompoundCollision();
+    MassPropertiesTest::testSceneDensity();
+    MassPropertiesTest::testOffCenterSpin();
+}
+
+void ofApp::convexHullTests()
+{
+    ConvexHullTest::testCube();
+    ConvexHullTest::testFlatCloud();
+    ConvexHullTest::testVertexLimit();
+    ConvexHullTest::testSupport();
+    ConvexHullTest::testCollision();
+    ConvexHullTest::testScene();
+}
+
+void ofApp::spatialQueryTests()
+{
+    SpatialQueryTest::testRaycastShapes();
+    SpatialQueryTest::testSphereCast();
+    SpatialQueryTest::testMatchesBruteForce();
+    SpatialQueryTest::testOverlap();
+    SpatialQueryTest::testBatch();
+}
@@ -1,23 +1,47 @@
 #pragma once
 
 #include "Box.h"
-#include "ForceRegistry.h"
 #include "ofMain.h"
 #include "ofxGui.h"
 #include "Shape.h"
+#include "InputLog.h"
+#include "PhysicsWorld.h"
+#include "InstanceRenderer.h"
+#include "ParticleEmitter.h"
+#include "SimulationThread.h"
+#include "SpatialQuery.h"
+#include "TrajectoryWriter.h"
 #include "Cone.h"
-#include "FrictionGenerator.h"
-#include "GravityGenerator.h"
 #include "MatrixTest.h"
-#include "Octree.h"
+#include "AABBTreeTest.h"
+#include "BarnesHutTest.h"
+#include "BoundsTest.h"
+#include "ClothTest.h"
+#include "ContinuousCollisionTest.h"
+#include "DeterminismTest.h"
+#include "GJKTest.h"
+#include "InputLogTest.h"
+#include "JointTest.h"
+#include "ConvexHullTest.h"
+#include "MassPropertiesTest.h"
+#include "MaterialTest.h"
+#include "InstanceBufferTest.h"
+#include "NarrowPhaseTest.h"
+#include "ParticleSystemTest.h"
 #include "QuaternionTest.h"
+#include "SceneLoaderTest.h"
+#include "SimulationThreadTest.h"
+#include "SnapshotTest.h"
+#include "SpatialQueryTest.h"
+#include "SPHSolverTest.h"
+#include "StaticGeometryTest.h"
+#include "TrajectoryTest.h"
 #include "VectorTest.h"
 
 
 # define VP_STEP 50
 # define VP_SIZE 250
 # define MAX_FORCE 200.0f
-# define MAX_VELOCITY 1000.0f
 // Width is the X axis
 # define BOX_WIDTH 40
 // Heigth is the Y axis
@@ -29,6 +53,24 @@
 # define CONE_RADIUS 40
 # define CONE_HEIGHT 50
 
+// Saved and restored by the snapshot buttons, in the data folder
+# define SNAPSHOT_FILE "snapshot.bin"
+// Loaded by the scene button, in the data folder. JSON files dropped on the window are loaded too
+# define SCENE_FILE "scene.json"
+// Written by the record toggle, in the data folder
+# define RECORDING_SNAPSHOT_FILE "recording.bin"
+# define RECORDING_LOG_FILE "recording.log"
+// Written by the export toggle, in the data folder
+# define TRAJECTORY_FILE "trajectories.bin"
+// Steps between two exported frames
+# define TRAJECTORY_INTERVAL 2
+
+// Fountain of the particles toggle, in pixels and seconds
+# define FOUNTAIN_CAPACITY 20000
+# define FOUNTAIN_RATE 4000
+# define FOUNTAIN_LIFETIME 3
+# define FOUNTAIN_GRAVITY 300
+
 class ofApp : public ofBaseApp
 {
 public:
@@ -38,21 +80,30 @@ public:
     void setupControlPanel();
     void setupHelpPanel();
     void setupCollisionPanel();
+    void setupArena();
     void setup() override;
     void setBoxType();
     void setConeType();
     void addObject();
+    void addTerrain();
     void clearAllObjects();
+    void saveSnapshot();
+    void loadSnapshot();
+    void loadScene(const std::string& path);
+    void loadDefaultScene();
+    void syncToggles();
+    void updateRecording();
+    void updateExport();
+    void updateParticles();
     void fullscreen();
     void togglePause();
     void launchObject();
     void addMultiLineText(ofxPanel& panel, std::vector<ofxLabel*>& lines, const std::string& text);
-    void checkBoundaries();
-    void updateForces();
     void addForceObject(Shape &obj, Vector forceIntensity, Vector pointApplication);
-    void collisionHandler();
     void update() override;
     void drawInteractionArea();
+    void drawDebug(const RenderBody& body);
+    bool isOverPanel(int x, int y);
     void draw() override;
 
     void keyPressed(int key) override;
@@ -67,17 +118,33 @@ public:
     void dragEvent(ofDragInfo dragInfo) override;
     void gotMessage(ofMessage msg) override;
 
-    float delta_t = 0.01f;
     float gravity;
     
     float simSpeed= 2.0f;
     bool simPause = false;
     
-    int bColls, nColls = 0;
-
-
-    ForceRegistry forceRegistry;
-    std::list<Shape*> tabShape;
+    // The simulated scene, stepped by update()
+    PhysicsWorld world{VP_SIZE};
+    // Every input goes through the log, which records them while the record toggle is on
+    InputLog inputLog;
+    bool terrainAdded = false;
+    // Streams the trajectories while the export toggle is on
+    TrajectoryWriter trajectoryWriter;
+    // Steps the world, declared after what it uses so that it stops before they are destroyed
+    SimulationThread simulation{world};
+    // Picking and other queries on the bodies, under the lock of the simulation
+    SpatialQuery spatialQuery{world};
+    // Id of the body selected with the mouse, -1 for none
+    int pickedId = -1;
+    // Set by a left press and cleared by a drag, which orbits the camera instead of picking
+    bool pickPending = false;
+    // Bodies of the last two frames blended, then grouped into instances by shape type
+    std::vector<RenderBody> drawnBodies;
+    InstanceBuffer instanceBuffer;
+    InstanceRenderer instanceRenderer;
+    // Screen space fountain of the particles toggle, on the thread of the application
+    ParticleSystem particles;
+    ParticleEmitter fountain{Vector(0, 0), FOUNTAIN_RATE, FOUNTAIN_LIFETIME, 250, 450};
 
     //Cone object = Cone(40, 80);
     //Box object = Box(20, 20, 20);
@@ -91,11 +158,12 @@ public:
     // todo toggle ?
 
     // Control panel elements
-    ofxToggle showHelp, showDebug, showAxis, showForceAdd, gravityToggle, frictionToggle, collisionToggle, octreeToggle; 
+    ofxToggle showHelp, showDebug, showAxis, showForceAdd, gravityToggle, frictionToggle, collisionToggle, octreeToggle, aabbTreeToggle, ccdToggle, deterministicToggle, recordToggle, exportToggle, particlesToggle;
 
     ofxButton fullscreenButton;
     ofxButton gamePaused;
     ofxButton clearAll;
+    ofxButton saveSnapshotButton, loadSnapshotButton, sceneButton;
 
     // Help panel elements
     std::string manualText =
@@ -103,6 +171,7 @@ public:
         "While adding an object, \n the initial force is applied on [0,0,0]\n"
         "Enabling the debug panel, will show informations on the last added obect to the viewport. \n"
         "The same goes for the force panel \n"
+        "Clicking on an object selects it instead, for the debug panel and the launch button \n"
         "Keyboard shortcut are enabled to control the application \n"
         "Pressing 'spacebar' will enable orthographic camera \n"
         "Pressing 'f' will enable fullscreen \n"
@@ -129,7 +198,7 @@ public:
     ofxLabel cdmObjectLabel;
     ofxFloatSlider xpInputObject, ypInputObject, zpInputObject;
     ofxLabel objectTypeLabel;
-    ofxButton boxButton,coneButton, addButton;
+    ofxButton boxButton,coneButton, addButton, terrainButton;
     ofxLabel initialForceLabel;
     ofxFloatSlider xfInput, yfInput, zfInput;
    
@@ -144,11 +213,31 @@ public:
 
     ObjectType objectType = BOX;
 
-    Octree octree = Octree(Vector(0,0,0), VP_SIZE,VP_SIZE,VP_SIZE,0);
-
     // Tests methods
     void unitTests();
     void vectorTests();
     void matrixTests();
     void quaternionTests();
+    void aabbTreeTests();
+    void boundsTests();
+    void gjkTests();
+    void narrowPhaseTests();
+    void continuousCollisionTests();
+    void staticGeometryTests();
+    void determinismTests();
+    void snapshotTests();
+    void inputLogTests();
+    void trajectoryTests();
+    void sceneLoaderTests();
+    void simulationThreadTests();
+    void instanceBufferTests();
+    void particleSystemTests();
+    void sphSolverTests();
+    void barnesHutTests();
+    void clothTests();
+    void jointTests();
+    void materialTests();
+    void massPropertiesTests();
+    void convexHullTests();
+    void spatialQueryTests();
 };
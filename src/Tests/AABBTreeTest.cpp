@@ -0,0 +1,131 @@
+#include "AABBTreeTest.h"
+
+#include "AABBTree.h"
+
+/**
+ * @brief Create a body with a bounding sphere of radius 1 at a given position
+ */
+static RigidBody makeBody(Vector position)
+{
+    RigidBody body;
+    body.colliderRadius = 1;
+    body.setPosition(position);
+    return body;
+}
+
+void AABBTreeTest::testCollisions()
+{
+    RigidBody b1 = makeBody(Vector(0, 0, 0));
+    RigidBody b2 = makeBody(Vector(1.5, 0, 0));
+    RigidBody b3 = makeBody(Vector(10, 0, 0));
+    AABBTree tree;
+    tree.insert(&b1);
+    tree.insert(&b2);
+    tree.insert(&b3);
+
+    // Only b1 and b2 overlap, and the pair must be reported once
+    auto collisions = tree.getCollisions();
+    if (collisions.size() != 1 || collisions[0].first == &b3 || collisions[0].second == &b3)
+    {
+        std::cout << "Error in AABBTreeTest::testCollisions()" << std::endl;
+    }
+}
+
+void AABBTreeTest::testUpdate()
+{
+    RigidBody b1 = makeBody(Vector(0, 0, 0));
+    RigidBody b2 = makeBody(Vector(1.5, 0, 0));
+    RigidBody b3 = makeBody(Vector(10, 0, 0));
+    AABBTree tree;
+    tree.insert(&b1);
+    tree.insert(&b2);
+    tree.insert(&b3);
+
+    // A small move stays inside the fat box, a large one forces a reinsertion
+    b3.setPosition(Vector(9, 0, 0));
+    bool smallMove = tree.update(&b3, Vector(-1, 0, 0));
+    b3.setPosition(Vector(0.5, 0, 0));
+    bool largeMove = tree.update(&b3, Vector(-8.5, 0, 0));
+
+    if (smallMove || !largeMove || tree.getCollisions().size() != 3)
+    {
+        std::cout << "Error in AABBTreeTest::testUpdate()" << std::endl;
+    }
+}
+
+void AABBTreeTest::testUnbounded()
+{
+    // Far outside of the viewport, where the octree would drop the objects
+    RigidBody b1 = makeBody(Vector(10000, 0, -10000));
+    RigidBody b2 = makeBody(Vector(10001, 0, -10000));
+    AABBTree tree;
+    tree.insert(&b1);
+    tree.insert(&b2);
+
+    if (tree.getCollisions().size() != 1)
+    {
+        std::cout << "Error in AABBTreeTest::testUnbounded()" << std::endl;
+    }
+}
+
+void AABBTreeTest::testRaycast()
+{
+    RigidBody b1 = makeBody(Vector(0, 0, 0));
+    RigidBody b2 = makeBody(Vector(5, 0, 0));
+    RigidBody b3 = makeBody(Vector(0, 5, 0));
+    AABBTree tree;
+    tree.insert(&b1);
+    tree.insert(&b2);
+    tree.insert(&b3);
+
+    // The ray enters the box of b1 at x = -1
+    float distance = 0;
+    auto hit = tree.raycast(Vector(-10, 0, 0), Vector(1, 0, 0), 100, distance);
+    float missDistance = 0;
+    auto miss = tree.raycast(Vector(-10, 0, 0), Vector(-1, 0, 0), 100, missDistance);
+
+    if (hit != &b1 || glm::abs(distance - 9) > 0.0001f || miss != nullptr)
+    {
+        std::cout << "Error in AABBTreeTest::testRaycast()" << std::endl;
+    }
+}
+
+void AABBTreeTest::testOverlap()
+{
+    RigidBody b1 = makeBody(Vector(0, 0, 0));
+    RigidBody b2 = makeBody(Vector(5, 0, 0));
+    RigidBody b3 = makeBody(Vector(0, 5, 0));
+    AABBTree tree;
+    tree.insert(&b1);
+    tree.insert(&b2);
+    tree.insert(&b3);
+
+    std::vector<RigidBody*> results;
+    tree.queryOverlap(AABB(Vector(-2, -2, -2), Vector(6, 2, 2)), results);
+    tree.remove(&b2);
+    std::vector<RigidBody*> afterRemove;
+    tree.queryOverlap(AABB(Vector(-2, -2, -2), Vector(6, 2, 2)), afterRemove);
+
+    if (results.size() != 2 || afterRemove.size() != 1 || b2.proxyId != AABB_TREE_NULL_NODE)
+    {
+        std::cout << "Error in AABBTreeTest::testOverlap()" << std::endl;
+    }
+}
+
+void AABBTreeTest::testBalance()
+{
+    // Sorted insertions would build a linked list without rotations
+    std::vector<RigidBody> bodies(128);
+    AABBTree tree;
+    for (int i = 0; i < 128; i++)
+    {
+        bodies[i].colliderRadius = 1;
+        bodies[i].setPosition(Vector(i * 3.0f, 0, 0));
+        tree.insert(&bodies[i]);
+    }
+
+    if (tree.getHeight() > 14 || tree.getLeafCount() != 128 || !tree.getCollisions().empty())
+    {
+        std::cout << "Error in AABBTreeTest::testBalance()" << std::endl;
+    }
+}
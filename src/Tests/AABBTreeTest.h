@@ -0,0 +1,12 @@
+#pragma once
+
+class AABBTreeTest
+{
+public:
+    static void testCollisions();
+    static void testUpdate();
+    static void testUnbounded();
+    static void testRaycast();
+    static void testOverlap();
+    static void testBalance();
+};
@@ -0,0 +1,184 @@
+#include "BarnesHutTest.h"
+
+#include "BarnesHutTree.h"
+#include "Box.h"
+#include "ElectrostaticGenerator.h"
+#include "MutualGravityGenerator.h"
+#include "PhysicsWorld.h"
+
+/**
+ * @brief Field of the sources at a point, by the direct sum
+ */
+static Vector directField(std::vector<Vector>& points, std::vector<float>& strengths, Vector point, float softening)
+{
+    Vector result = Vector(0, 0, 0);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        Vector offset = points[i] - point;
+        float squaredDistance = offset.squaredMagnitude();
+        if (squaredDistance == 0) continue;
+        float softened = squaredDistance + softening * softening;
+        result += offset * (strengths[i] / (softened * std::sqrt(softened)));
+    }
+    return result;
+}
+
+/**
+ * @brief A cloud of sources, denser in the middle
+ */
+static void buildCloud(std::vector<Vector>& points, std::vector<float>& strengths, bool signedStrengths)
+{
+    for (int i = 0; i < 2000; i++)
+    {
+        float spread = i % 4 == 0 ? 1000 : 200;
+        points.push_back(Vector(ofRandom(-spread, spread), ofRandom(-spread, spread), ofRandom(-spread, spread)));
+        strengths.push_back(signedStrengths && i % 3 == 0 ? -ofRandom(1, 5) : ofRandom(1, 5));
+    }
+    // Coincident sources share a leaf
+    points.push_back(points[0]);
+    strengths.push_back(strengths[0]);
+}
+
+void BarnesHutTest::testExactSum()
+{
+    std::vector<Vector> points;
+    std::vector<float> strengths;
+    buildCloud(points, strengths, true);
+    BarnesHutTree tree;
+    tree.build(points, strengths);
+
+    // Without approximation, every leaf is opened
+    for (size_t i = 0; i < points.size(); i += 97)
+    {
+        Vector expected = directField(points, strengths, points[i], 1);
+        Vector found = tree.field(points[i], 0, 1);
+        if ((found - expected).magnitude() > 1e-4 * expected.magnitude() + 1e-7)
+        {
+            std::cout << "Error in BarnesHutTest::testExactSum()" << std::endl;
+            return;
+        }
+    }
+}
+
+void BarnesHutTest::testApproximation()
+{
+    std::vector<Vector> points;
+    std::vector<float> strengths;
+    buildCloud(points, strengths, false);
+    BarnesHutTree tree;
+    tree.build(points, strengths);
+
+    float totalError = 0;
+    float totalField = 0;
+    for (size_t i = 0; i < points.size(); i += 13)
+    {
+        Vector expected = directField(points, strengths, points[i], 1);
+        totalError += (tree.field(points[i], DEFAULT_OPENING_ANGLE, 1) - expected).magnitude();
+        totalField += expected.magnitude();
+    }
+    if (totalError > 0.02f * totalField || tree.getNodeCount() >= static_cast<int>(points.size()))
+    {
+        std::cout << "Error in BarnesHutTest::testApproximation()" << std::endl;
+    }
+}
+
+void BarnesHutTest::testElectrostatic()
+{
+    Box first(1, 1, 1);
+    Box second(1, 1, 1);
+    Box neutral(1, 1, 1);
+    first.position = Vector(0, 0, 0);
+    second.position = Vector(10, 0, 0);
+    neutral.position = Vector(0, 10, 0);
+    first.charge = 2;
+    second.charge = 3;
+
+    ElectrostaticGenerator generator(1, DEFAULT_OPENING_ANGLE, 0);
+    ForceRegistry registry;
+    for (RigidBody* body : {static_cast<RigidBody*>(&first), static_cast<RigidBody*>(&second),
+                            static_cast<RigidBody*>(&neutral)})
+    {
+        registry.add(body, &generator);
+    }
+    registry.updateForces(0);
+
+    // Like charges repel with k q1 q2 / r^2, the neutral body feels nothing
+    if ((first.accumForce - Vector(-0.06f, 0, 0)).magnitude() > 1e-5
+        || (second.accumForce - Vector(0.06f, 0, 0)).magnitude() > 1e-5 || neutral.accumForce.magnitude() != 0)
+    {
+        std::cout << "Error in BarnesHutTest::testElectrostatic()" << std::endl;
+        return;
+    }
+
+    // Opposite charges attract
+    first.clearAccum();
+    second.charge = -3;
+    registry.add(&first, &generator);
+    registry.add(&second, &generator);
+    registry.updateForces(0);
+    if (first.accumForce.x <= 0)
+    {
+        std::cout << "Error in BarnesHutTest::testElectrostatic()" << std::endl;
+    }
+}
+
+void BarnesHutTest::testMutualGravity()
+{
+    // A ring of bodies registered in the world collapses towards its center, with no net force on the ring
+    PhysicsWorld world(1000);
+    world.collisions = false;
+    MutualGravityGenerator* generator = new MutualGravityGenerator(1000, DEFAULT_OPENING_ANGLE, 1);
+    world.addGenerator(generator);
+    for (int i = 0; i < 16; i++)
+    {
+        float angle = i * TWO_PI / 16;
+        Box* body = new Box(1, 1, 1);
+        body->position = Vector(std::cos(angle) * 100, std::sin(angle) * 100, 0);
+        body->angularVelocity = Vector(0, 0, 0);
+        world.addBody(body);
+        world.addForce(body, generator);
+    }
+    // An immovable body has an infinite mass, it must be left out instead of pulling with it
+    Box* anchor = new Box(1, 1, 1);
+    anchor->position = Vector(0, 0, 500);
+    anchor->angularVelocity = Vector(0, 0, 0);
+    anchor->inversedMass = 0;
+    world.addBody(anchor);
+    world.addForce(anchor, generator);
+    world.step(0.1f);
+
+    Vector momentum = Vector(0, 0, 0);
+    bool inwards = true;
+    for (auto body : world.bodies)
+    {
+        if (body == anchor) continue;
+        momentum += body->linearVelocity;
+        inwards = inwards && body->linearVelocity * body->position < 0;
+    }
+    if (!inwards || momentum.magnitude() > 1e-3 || anchor->linearVelocity.magnitude() != 0)
+    {
+        std::cout << "Error in BarnesHutTest::testMutualGravity()" << std::endl;
+    }
+}
+
+void BarnesHutTest::testOwnCell()
+{
+    // With a wide opening angle the whole tree is seen as one source from the lone point, which must not include
+    // itself: the cells around a point are always opened
+    std::vector<Vector> points = {Vector(0, 0, 0)};
+    std::vector<float> strengths = {1};
+    for (int i = 0; i < 5; i++)
+    {
+        points.push_back(Vector(10, i * 0.1f, 0));
+        strengths.push_back(1);
+    }
+    BarnesHutTree tree;
+    tree.build(points, strengths);
+
+    Vector expected = directField(points, strengths, points[0], 0);
+    Vector found = tree.field(points[0], 1.5f, 0);
+    if ((found - expected).magnitude() > 0.01f * expected.magnitude())
+    {
+        std::cout << "Error in BarnesHutTest::testOwnCell()" << std::endl;
+    }
+}
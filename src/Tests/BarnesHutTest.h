@@ -0,0 +1,11 @@
+#pragma once
+
+class BarnesHutTest
+{
+public:
+    static void testExactSum();
+    static void testApproximation();
+    static void testElectrostatic();
+    static void testMutualGravity();
+    static void testOwnCell();
+};
@@ -0,0 +1,61 @@
+#include "BoundsTest.h"
+
+#include "Box.h"
+#include "Cone.h"
+
+/**
+ * @brief Compare two boxes with a tolerance, to absorb the rounding of the rotations
+ */
+static bool nearlyEqual(AABB box, AABB expected)
+{
+    float epsilon = 0.001f;
+    return box.minCorner.distance(expected.minCorner) < epsilon && box.maxCorner.distance(expected.maxCorner) < epsilon;
+}
+
+void BoundsTest::testBoxBounds()
+{
+    Box box(2, 4, 6);
+    box.setPosition(Vector(10, 0, 0));
+
+    if (!nearlyEqual(box.getBounds(), AABB(Vector(9, -2, -3), Vector(11, 2, 3))))
+    {
+        std::cout << "Error in BoundsTest::testBoxBounds()" << std::endl;
+    }
+}
+
+void BoundsTest::testRotatedBoxBounds()
+{
+    // A quarter turn around Z swaps the width and the height
+    Box box(2, 4, 6);
+    box.orientation = Quaternion(PI / 2, Vector(0, 0, 1));
+    box.updateBounds();
+
+    if (!nearlyEqual(box.getBounds(), AABB(Vector(-2, -1, -3), Vector(2, 1, 3))))
+    {
+        std::cout << "Error in BoundsTest::testRotatedBoxBounds()" << std::endl;
+    }
+}
+
+void BoundsTest::testConeBounds()
+{
+    Cone cone(1, 4);
+    cone.setPosition(Vector(0, 5, 0));
+
+    if (!nearlyEqual(cone.getBounds(), AABB(Vector(-1, 3, -1), Vector(1, 7, 1))))
+    {
+        std::cout << "Error in BoundsTest::testConeBounds()" << std::endl;
+    }
+}
+
+void BoundsTest::testRotatedConeBounds()
+{
+    // Lying along the X axis, the cone is much tighter than its bounding sphere
+    Cone cone(1, 4);
+    cone.orientation = Quaternion(PI / 2, Vector(0, 0, 1));
+    cone.updateBounds();
+
+    if (!nearlyEqual(cone.getBounds(), AABB(Vector(-2, -1, -1), Vector(2, 1, 1))))
+    {
+        std::cout << "Error in BoundsTest::testRotatedConeBounds()" << std::endl;
+    }
+}
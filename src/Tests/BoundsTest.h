@@ -0,0 +1,10 @@
+#pragma once
+
+class BoundsTest
+{
+public:
+    static void testBoxBounds();
+    static void testRotatedBoxBounds();
+    static void testConeBounds();
+    static void testRotatedConeBounds();
+};
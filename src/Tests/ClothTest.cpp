@@ -0,0 +1,122 @@
+#include "ClothTest.h"
+
+#include <cmath>
+
+#include "Cloth.h"
+
+void ClothTest::testGridConstraints()
+{
+    const int columns = 7, rows = 5;
+    Cloth cloth;
+    cloth.buildGrid(columns, rows, 1, Vector(0, 0, 0), 1);
+
+    int structural = (columns - 1) * rows + columns * (rows - 1);
+    int shear = 2 * (columns - 1) * (rows - 1);
+    int bend = (columns - 2) * rows + columns * (rows - 2);
+    if (cloth.size() != columns * rows || static_cast<int>(cloth.constraints.size()) != structural + shear + bend
+        || static_cast<int>(cloth.triangles.size()) != 6 * (columns - 1) * (rows - 1))
+    {
+        std::cout << "Error in ClothTest::testGridConstraints()" << std::endl;
+        return;
+    }
+
+    // Every cell of the soft box is six tetrahedra: the 12 edges, 6 face diagonals and the main diagonal
+    cloth.buildSoftBox(2, 2, 2, 1, Vector(0, 0, 0), 1, 0);
+    if (cloth.size() != 8 || cloth.constraints.size() != 19)
+    {
+        std::cout << "Error in ClothTest::testGridConstraints()" << std::endl;
+    }
+}
+
+void ClothTest::testHangingCloth()
+{
+    // A cloth pinned by its top corners sags but the structural springs keep their length
+    const int columns = 10;
+    Cloth cloth;
+    cloth.buildGrid(columns, columns, 0.1f, Vector(0, 0, 0), 1);
+    cloth.pin(0);
+    cloth.pin(columns - 1);
+    for (int i = 0; i < 120; i++)
+    {
+        cloth.step(1.0f / 60.0f);
+    }
+
+    if (cloth.getPosition(0).y != 0 || cloth.getPosition(columns * columns - 1).y > -0.5f)
+    {
+        std::cout << "Error in ClothTest::testHangingCloth()" << std::endl;
+        return;
+    }
+    for (auto& constraint : cloth.constraints)
+    {
+        if (constraint.compliance != STRUCTURAL_COMPLIANCE) continue;
+        float length = (cloth.getPosition(constraint.first) - cloth.getPosition(constraint.second)).magnitude();
+        if (std::abs(length - constraint.restLength) > constraint.restLength * 0.02f)
+        {
+            std::cout << "Error in ClothTest::testHangingCloth()" << std::endl;
+            return;
+        }
+    }
+}
+
+void ClothTest::testSelfCollision()
+{
+    // Two free particles thrown at each other stop at the thickness
+    Cloth cloth;
+    cloth.gravity = Vector(0, 0, 0);
+    cloth.damping = 0;
+    cloth.thickness = 0.2f;
+    cloth.addParticle(Vector(0, 0, 0), 1);
+    cloth.addParticle(Vector(1, 0, 0), 1);
+    cloth.vx[0] = 1;
+    cloth.vx[1] = -1;
+    for (int i = 0; i < 60; i++)
+    {
+        cloth.step(1.0f / 60.0f);
+    }
+    float distance = (cloth.getPosition(0) - cloth.getPosition(1)).magnitude();
+    if (distance < cloth.thickness * 0.99f || cloth.selfCollisionCount == 0)
+    {
+        std::cout << "Error in ClothTest::testSelfCollision()" << std::endl;
+        return;
+    }
+
+    // Without self collisions, they cross
+    cloth.selfCollision = false;
+    cloth.clear();
+    cloth.addParticle(Vector(0, 0, 0), 1);
+    cloth.addParticle(Vector(1, 0, 0), 1);
+    cloth.vx[0] = 1;
+    cloth.vx[1] = -1;
+    for (int i = 0; i < 60; i++)
+    {
+        cloth.step(1.0f / 60.0f);
+    }
+    if (cloth.getPosition(0).x < cloth.getPosition(1).x)
+    {
+        std::cout << "Error in ClothTest::testSelfCollision()" << std::endl;
+    }
+}
+
+void ClothTest::testSoftBoxOnPlane()
+{
+    // A soft box falls on the ground and rests on it without collapsing
+    StaticPlane ground(Vector(0, 1, 0), 0);
+    Cloth box;
+    box.buildSoftBox(4, 4, 4, 0.25f, Vector(0, 1, 0), 1, 1e-4f);
+    box.planes.push_back(&ground);
+    for (int i = 0; i < 180; i++)
+    {
+        box.step(1.0f / 60.0f);
+    }
+
+    float lowest = 1e9f, highest = -1e9f;
+    for (int i = 0; i < box.size(); i++)
+    {
+        lowest = std::min(lowest, box.y[i]);
+        highest = std::max(highest, box.y[i]);
+    }
+    if (lowest < box.thickness / 2 - 1e-3f || highest - lowest < 0.6f || highest - lowest > 0.8f)
+    {
+        std::cout << "Error in ClothTest::testSoftBoxOnPlane()" << std::endl;
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+class ClothTest
+{
+public:
+    static void testGridConstraints();
+    static void testHangingCloth();
+    static void testSelfCollision();
+    static void testSoftBoxOnPlane();
+};
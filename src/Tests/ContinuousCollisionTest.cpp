@@ -0,0 +1,112 @@
+#include "ContinuousCollisionTest.h"
+
+#include "Box.h"
+#include "ContinuousCollision.h"
+#include "PhysicsWorld.h"
+
+void ContinuousCollisionTest::testSpherePlane()
+{
+    // Floor at y = 0, the sphere falls from 5 by 10
+    float toi = -1;
+    bool hit = ContinuousCollision::sweptSpherePlane(Vector(0, 5, 0), 1, Vector(0, -10, 0), Vector(0, 1, 0), 0, toi);
+    float missToi = -1;
+    bool miss = ContinuousCollision::sweptSpherePlane(Vector(0, 5, 0), 1, Vector(0, -2, 0), Vector(0, 1, 0), 0, missToi);
+
+    if (!hit || glm::abs(toi - 0.4f) > 0.001f || miss)
+    {
+        std::cout << "Error in ContinuousCollisionTest::testSpherePlane()" << std::endl;
+    }
+}
+
+void ContinuousCollisionTest::testBoxPlane()
+{
+    // Turned by 45 degrees, the lowest corner of the box is sqrt(2) under its center
+    Box box(2, 2, 2);
+    box.orientation = Quaternion(PI / 4, Vector(0, 0, 1));
+    box.setPosition(Vector(0, 5, 0));
+
+    float toi = -1;
+    bool hit = ContinuousCollision::sweptShapePlane(box, Vector(0, -10, 0), Vector(0, 1, 0), 0, toi);
+    if (!hit || glm::abs(toi - (5 - glm::sqrt(2.0f)) / 10) > 0.001f)
+    {
+        std::cout << "Error in ContinuousCollisionTest::testBoxPlane()" << std::endl;
+    }
+}
+
+void ContinuousCollisionTest::testSphereSphere()
+{
+    // Head-on, both spheres move by 5 and start 10 apart
+    float toi = -1;
+    bool hit = ContinuousCollision::sweptSphereSphere(Vector(0, 0, 0), 1, Vector(5, 0, 0), Vector(10, 0, 0), 1,
+                                                      Vector(-5, 0, 0), toi);
+    float missToi = -1;
+    bool miss = ContinuousCollision::sweptSphereSphere(Vector(0, 0, 0), 1, Vector(5, 0, 0), Vector(10, 3, 0), 1,
+                                                       Vector(-5, 0, 0), missToi);
+
+    if (!hit || glm::abs(toi - 0.8f) > 0.001f || miss)
+    {
+        std::cout << "Error in ContinuousCollisionTest::testSphereSphere()" << std::endl;
+    }
+}
+
+void ContinuousCollisionTest::testFastBoxTunnelling()
+{
+    // The bullet would end up on the other side of the thin wall after a discrete step
+    Box bullet(1, 1, 1);
+    Box wall(0.2, 10, 10);
+    wall.setPosition(Vector(10, 0, 0));
+
+    float toi = -1;
+    bool hit = ContinuousCollision::timeOfImpact(bullet, Vector(20, 0, 0), wall, Vector(0, 0, 0), toi);
+    // Contact once the bullet has moved by 10 - 0.1 - 0.5
+    if (!hit || toi > 9.4f / 20 || toi < (9.4f - 2 * CCD_TOLERANCE) / 20)
+    {
+        std::cout << "Error in ContinuousCollisionTest::testFastBoxTunnelling()" << std::endl;
+    }
+}
+
+void ContinuousCollisionTest::testOverlappingStart()
+{
+    // Overlaps are left to the discrete narrow phase
+    Box first(2, 2, 2);
+    Box second(2, 2, 2);
+    second.setPosition(Vector(1, 0, 0));
+
+    float toi = -1;
+    if (ContinuousCollision::timeOfImpact(first, Vector(5, 0, 0), second, Vector(0, 0, 0), toi))
+    {
+        std::cout << "Error in ContinuousCollisionTest::testOverlappingStart()" << std::endl;
+    }
+}
+
+void ContinuousCollisionTest::testRestingContact()
+{
+    // A box resting on another one: pushing into it is an impact at once, leaving it is not
+    Box top(1, 1, 1);
+    top.setPosition(Vector(0, 1 + CCD_TOLERANCE / 2, 0));
+    Box floor(1, 1, 1);
+    floor.setPosition(Vector(0, 0, 0));
+    float toi = -1;
+    bool closing = ContinuousCollision::timeOfImpact(top, Vector(0, -1, 0), floor, Vector(0, 0, 0), toi);
+    float leavingToi = -1;
+    bool leaving = ContinuousCollision::timeOfImpact(top, Vector(0, 1, 0), floor, Vector(0, 0, 0), leavingToi);
+
+    // In a world, the continuous box must not stay stuck on the resting one once it is launched upwards
+    PhysicsWorld world(250);
+    Box* resting = new Box(10, 10, 10);
+    resting->setPosition(Vector(0, 10 + CCD_TOLERANCE / 2, 0));
+    resting->continuousCollision = true;
+    Box* base = new Box(10, 10, 10);
+    base->setPosition(Vector(0, 0, 0));
+    world.addBody(resting);
+    world.addBody(base);
+    world.collisions = false;
+    resting->linearVelocity = Vector(0, 20, 0);
+    world.step(0.1f);
+    world.step(0.1f);
+
+    if (!closing || toi != 0 || leaving || resting->position.y < 13.9f)
+    {
+        std::cout << "Error in ContinuousCollisionTest::testRestingContact()" << std::endl;
+    }
+}
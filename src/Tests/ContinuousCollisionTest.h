@@ -0,0 +1,12 @@
+#pragma once
+
+class ContinuousCollisionTest
+{
+public:
+    static void testSpherePlane();
+    static void testBoxPlane();
+    static void testSphereSphere();
+    static void testFastBoxTunnelling();
+    static void testOverlappingStart();
+    static void testRestingContact();
+};
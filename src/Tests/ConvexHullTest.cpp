@@ -0,0 +1,201 @@
+#include "ConvexHullTest.h"
+
+#include <cmath>
+#include <random>
+
+#include "CollisionManager.h"
+#include "ConvexHull.h"
+#include "QuickHull.h"
+#include "SceneLoader.h"
+
+static std::vector<Vector> cubeCloud(float size, int innerPoints)
+{
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> inside(-size / 2, size / 2);
+    std::vector<Vector> points;
+    for (int i = 0; i < innerPoints; i++)
+    {
+        points.push_back(Vector(inside(generator), inside(generator), inside(generator)));
+    }
+    // Corners, and points in the middle of the faces that must not become vertices
+    for (int i = 0; i < 8; i++)
+    {
+        points.push_back(Vector(i & 1 ? size / 2 : -size / 2, i & 2 ? size / 2 : -size / 2, i & 4 ? size / 2 : -size / 2));
+    }
+    points.push_back(Vector(size / 2, 0, 0));
+    points.push_back(Vector(0, -size / 2, size / 4));
+    return points;
+}
+
+static std::vector<Vector> sphereCloud(float radius, int count)
+{
+    std::mt19937 generator(11);
+    std::normal_distribution<float> normal(0, 1);
+    std::vector<Vector> points;
+    for (int i = 0; i < count; i++)
+    {
+        points.push_back(Vector(normal(generator), normal(generator), normal(generator)).normalized() * radius);
+    }
+    return points;
+}
+
+void ConvexHullTest::testCube()
+{
+    std::vector<Vector> points = cubeCloud(2, 200);
+    ConvexHull hull(points);
+    bool valid = hull.isValid() && hull.vertices.size() == 8 && hull.triangles.size() == 36
+        && hull.faceNormals.size() == 12 && hull.neighbours.size() == 36;
+
+    // Every point of the cloud is in the hull, and every face has the others behind it
+    for (auto& point : points)
+    {
+        valid = valid && hull.contains(point);
+    }
+    for (size_t face = 0; face < hull.faceNormals.size(); face++)
+    {
+        for (auto& vertex : hull.vertices)
+        {
+            valid = valid && hull.faceNormals[face] * vertex <= hull.faceOffsets[face] + 1e-4f;
+        }
+    }
+
+    // Same mass properties and bounds as the box
+    MassProperties box = MassProperties::box(2, 2, 2, 1);
+    MassProperties properties = hull.computeMassProperties(1);
+    valid = valid && std::abs(properties.mass - box.mass) < 1e-3f && std::abs(hull.tenseurJ.l1.x - 2.0f / 3) < 1e-3f
+        && std::abs(hull.getBounds().maxCorner.y - 1) < 1e-4f && std::abs(hull.getBounds().minCorner.z + 1) < 1e-4f;
+    if (!valid)
+    {
+        std::cout << "Error in ConvexHullTest::testCube()" << std::endl;
+    }
+}
+
+void ConvexHullTest::testFlatCloud()
+{
+    std::vector<Vector> points = {Vector(0, 0, 0), Vector(1, 0, 0), Vector(0, 1, 0), Vector(1, 1, 0), Vector(2, 3, 0)};
+    QuickHull builder;
+    ConvexHull hull(points);
+    if (builder.build(points) || hull.isValid() || !builder.build({Vector(0, 0, 0), Vector(1, 0, 0), Vector(0, 1, 0),
+                                                                    Vector(0, 0, 1), Vector(0.1f, 0.1f, 0.1f)})
+        || builder.vertices.size() != 4)
+    {
+        std::cout << "Error in ConvexHullTest::testFlatCloud()" << std::endl;
+    }
+}
+
+void ConvexHullTest::testVertexLimit()
+{
+    std::vector<Vector> points = sphereCloud(10, 2000);
+    ConvexHull full(points, 0);
+    ConvexHull reduced(points, 40);
+
+    // The reduced hull grows evenly from the extreme points, so it stays close to the sphere
+    float volume = reduced.computeMassProperties(1).mass;
+    float sphereVolume = 4 * PI * 1000 / 3;
+    bool valid = full.vertices.size() > 0.95f * points.size() && reduced.vertices.size() == 40
+        && volume > 0.75f * sphereVolume && volume < sphereVolume;
+
+    // A closed polyhedron of triangles has 2V - 4 faces
+    valid = valid && full.triangles.size() == 3 * (2 * full.vertices.size() - 4)
+        && reduced.triangles.size() == 3 * (2 * reduced.vertices.size() - 4);
+
+    // In a solid cloud some added points end up inside the hull, the limit still counts the final vertices
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> inside(-5, 5);
+    std::vector<Vector> solid;
+    for (int i = 0; i < 2000; i++)
+    {
+        solid.push_back(Vector(inside(generator), inside(generator), inside(generator)));
+    }
+    for (int limit : {30, 60})
+    {
+        QuickHull builder;
+        valid = valid && builder.build(solid, limit) && builder.vertices.size() == static_cast<size_t>(limit);
+    }
+    if (!valid)
+    {
+        std::cout << "Error in ConvexHullTest::testVertexLimit()" << std::endl;
+    }
+}
+
+void ConvexHullTest::testSupport()
+{
+    ConvexHull hull(sphereCloud(5, 500), 0);
+    hull.position = Vector(3, -2, 1);
+    hull.orientation = Quaternion(0.7f, Vector(1, 2, 3).normalized());
+    hull.updateBounds();
+
+    // Hill climbing from any vertex reaches the vertex found by testing all of them
+    std::mt19937 generator(3);
+    std::normal_distribution<float> normal(0, 1);
+    bool valid = hull.vertices.size() >= HULL_CLIMB_MIN_VERTICES;
+    Matrix toWorld = hull.orientation.quatToMat().transpose();
+    for (int i = 0; i < 200; i++)
+    {
+        Vector direction(normal(generator), normal(generator), normal(generator));
+        Vector best = hull.position + toWorld * hull.vertices[0];
+        for (auto& vertex : hull.vertices)
+        {
+            Vector point = hull.position + toWorld * vertex;
+            if (point * direction > best * direction) best = point;
+        }
+        Vector found = hull.support(direction);
+        valid = valid && std::abs(found * direction - best * direction) < 1e-4f
+            && found.x >= hull.getBounds().minCorner.x - 1e-4f && found.x <= hull.getBounds().maxCorner.x + 1e-4f;
+    }
+    if (!valid)
+    {
+        std::cout << "Error in ConvexHullTest::testSupport()" << std::endl;
+    }
+}
+
+void ConvexHullTest::testCollision()
+{
+    // A hull of a box must collide like the box itself
+    std::vector<Vector> corners = cubeCloud(2, 0);
+    ConvexHull hull(corners);
+    hull.position = Vector(0, 1.8f, 0);
+    hull.updateBounds();
+    Box box(2, 2, 2);
+    box.position = Vector(0, 0, 0);
+    box.updateBounds();
+    ConvexHull far(corners);
+    far.position = Vector(0, 5, 0);
+    far.updateBounds();
+
+    Contact contact;
+    bool hit = CollisionManager::getKernel(BoxShape, ConvexHullShape)(box, hull, contact);
+    Contact farContact;
+    bool farHit = CollisionManager::getKernel(ConvexHullShape, ConvexHullShape)(hull, far, farContact);
+    if (!hit || farHit || std::abs(contact.penetration - 0.2f) > 1e-2f || contact.normal.y < 0.99f)
+    {
+        std::cout << "Error in ConvexHullTest::testCollision()" << std::endl;
+    }
+}
+
+void ConvexHullTest::testScene()
+{
+    PhysicsWorld world(250);
+    ofJson scene = ofJson::parse(R"({
+        "materials": {"dense": {"density": 3}},
+        "bodies": [
+            {"shape": "hull", "position": [0, 10, 0], "material": "dense",
+             "points": [[0, 0, 0], [6, 0, 0], [0, 6, 0], [0, 0, 6]]}
+        ]
+    })");
+    bool loaded = SceneLoader::load(world, scene);
+    ofJson flat = ofJson::parse(R"({"bodies": [{"shape": "hull", "points": [[0, 0, 0], [1, 0, 0], [0, 1, 0], [1, 1, 0]]}]})");
+
+    // The tetrahedron has a volume of 36 and its center of mass at a quarter of the corner
+    bool valid = loaded && world.bodies.size() == 1 && world.bodies[0]->shapeType == ConvexHullShape
+        && std::abs(world.bodies[0]->getMass() - 108) < 1e-2f && !SceneLoader::load(world, flat);
+    if (valid)
+    {
+        ConvexHull* hull = static_cast<ConvexHull*>(world.bodies[0]);
+        valid = std::abs(hull->cloudOrigin.x + 1.5f) < 1e-4f && std::abs(hull->getBounds().minCorner.y - 8.5f) < 1e-4f;
+    }
+    if (!valid)
+    {
+        std::cout << "Error in ConvexHullTest::testScene()" << std::endl;
+    }
+}
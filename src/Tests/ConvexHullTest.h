@@ -0,0 +1,12 @@
+#pragma once
+
+class ConvexHullTest
+{
+public:
+    static void testCube();
+    static void testFlatCloud();
+    static void testVertexLimit();
+    static void testSupport();
+    static void testCollision();
+    static void testScene();
+};
@@ -0,0 +1,94 @@
+#include "DeterminismTest.h"
+
+#include <cstring>
+
+#include "Box.h"
+#include "CollisionManager.h"
+#include "Cone.h"
+#include "PhysicsWorld.h"
+
+/**
+ * @brief Fill a world with a pile of colliding bodies, always in the same order
+ */
+static void buildScene(PhysicsWorld& world)
+{
+    world.deterministic = true;
+    world.gravity = true;
+    world.staticWorld.addPlane(new StaticPlane(Vector(0, 1, 0), -world.arenaSize));
+    world.staticWorld.build();
+    for (int i = 0; i < 12; i++)
+    {
+        Shape* body;
+        if (i % 3 == 0) body = new Cone(20, 30, Vector(i * 7 - 40, i * 25 - 100, i % 2 * 10));
+        else body = new Box(30, 20, 25, Vector(i * 9 - 50, i * 30 - 120, i % 4 * 5));
+        body->linearVelocity = Vector(i % 5 * 10 - 20, -30, i % 3 * 7);
+        world.addBody(body);
+    }
+}
+
+void DeterminismTest::testRepeatableSteps()
+{
+    PhysicsWorld first(250);
+    PhysicsWorld second(250);
+    buildScene(first);
+    buildScene(second);
+
+    for (int i = 0; i < 300; i++)
+    {
+        first.step(FIXED_TIME_STEP);
+        second.step(FIXED_TIME_STEP);
+    }
+
+    // Bit for bit, not within a tolerance
+    bool identical = first.bodies.size() == second.bodies.size();
+    for (size_t i = 0; identical && i < first.bodies.size(); i++)
+    {
+        Shape* a = first.bodies[i];
+        Shape* b = second.bodies[i];
+        identical = a->id == b->id && std::memcmp(&a->position, &b->position, sizeof(Vector)) == 0
+            && std::memcmp(&a->linearVelocity, &b->linearVelocity, sizeof(Vector)) == 0
+            && std::memcmp(&a->angularVelocity, &b->angularVelocity, sizeof(Vector)) == 0
+            && std::memcmp(&a->orientation, &b->orientation, sizeof(Quaternion)) == 0;
+    }
+
+    if (!identical || first.narrowCollisionCount == 0 || first.narrowCollisionCount != second.narrowCollisionCount)
+    {
+        std::cout << "Error in DeterminismTest::testRepeatableSteps()" << std::endl;
+    }
+}
+
+void DeterminismTest::testPairOrder()
+{
+    // The sorted pairs must not depend on the order given by the broad phase
+    PhysicsWorld world(250);
+    for (int i = 0; i < 4; i++)
+    {
+        world.addBody(new Box(1, 1, 1));
+    }
+    std::vector<std::pair<RigidBody*, RigidBody*>> forward = {
+        {world.bodies[0], world.bodies[1]}, {world.bodies[2], world.bodies[3]}, {world.bodies[1], world.bodies[3]}};
+    std::vector<std::pair<RigidBody*, RigidBody*>> backward = {
+        {world.bodies[3], world.bodies[1]}, {world.bodies[3], world.bodies[2]}, {world.bodies[1], world.bodies[0]}};
+
+    CollisionManager::sortByShapeType(forward);
+    CollisionManager::sortByShapeType(backward);
+
+    if (forward != backward || forward[0].first->id != 0 || forward[2].first->id != 2)
+    {
+        std::cout << "Error in DeterminismTest::testPairOrder()" << std::endl;
+    }
+}
+
+void DeterminismTest::testFixedStep()
+{
+    // 2.5 fixed steps worth of frame time: 2 steps now, the half step is kept for the next frame
+    PhysicsWorld world(250);
+    world.deterministic = true;
+    int firstSteps = world.advance(FIXED_TIME_STEP * 2.5f);
+    int secondSteps = world.advance(FIXED_TIME_STEP * 0.6f);
+
+    if (firstSteps != 2 || secondSteps != 1 || world.stepCount != 3 || world.findBody(0) != nullptr)
+    {
+        std::cout << "Error in DeterminismTest::testFixedStep()" << std::endl;
+    }
+}
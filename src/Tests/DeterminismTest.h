@@ -0,0 +1,9 @@
+#pragma once
+
+class DeterminismTest
+{
+public:
+    static void testRepeatableSteps();
+    static void testPairOrder();
+    static void testFixedStep();
+};
@@ -0,0 +1,93 @@
+#include "GJKTest.h"
+
+#include "Box.h"
+#include "Cone.h"
+#include "GJK.h"
+
+void GJKTest::testSeparatedBoxes()
+{
+    Box first(2, 2, 2);
+    Box second(2, 2, 2);
+    second.setPosition(Vector(3, 0, 0));
+
+    Vector normal;
+    float depth = 0;
+    Vector point;
+    if (GJK::intersect(first, second) || GJK::penetration(first, second, normal, depth, point))
+    {
+        std::cout << "Error in GJKTest::testSeparatedBoxes()" << std::endl;
+    }
+}
+
+void GJKTest::testOverlappingBoxes()
+{
+    Box first(2, 2, 2);
+    Box second(2, 2, 2);
+    second.setPosition(Vector(1.5, 0, 0));
+
+    // The second box is pushed along +X by 0.5
+    Vector normal;
+    float depth = 0;
+    Vector point;
+    bool overlap = GJK::penetration(first, second, normal, depth, point);
+    if (!overlap || glm::abs(depth - 0.5f) > 0.01f || normal.distance(Vector(1, 0, 0)) > 0.01f)
+    {
+        std::cout << "Error in GJKTest::testOverlappingBoxes()" << std::endl;
+    }
+}
+
+void GJKTest::testRotatedBoxes()
+{
+    // Turned by 45 degrees, the first box reaches sqrt(2) along X
+    Box first(2, 2, 2);
+    first.orientation = Quaternion(PI / 4, Vector(0, 0, 1));
+    Box second(2, 2, 2);
+    second.setPosition(Vector(2.2, 0, 0));
+
+    Vector normal;
+    float depth = 0;
+    Vector point;
+    bool overlap = GJK::penetration(first, second, normal, depth, point);
+    if (!overlap || glm::abs(depth - (glm::sqrt(2.0f) - 1.2f)) > 0.01f)
+    {
+        std::cout << "Error in GJKTest::testRotatedBoxes()" << std::endl;
+    }
+}
+
+void GJKTest::testSpheres()
+{
+    RigidBody first;
+    first.colliderRadius = 1;
+    RigidBody second;
+    second.colliderRadius = 1;
+    second.setPosition(Vector(0, 1.5, 0));
+
+    Vector normal;
+    float depth = 0;
+    Vector point;
+    bool overlap = GJK::penetration(first, second, normal, depth, point);
+    if (!overlap || glm::abs(depth - 0.5f) > 0.01f || normal.distance(Vector(0, 1, 0)) > 0.05f)
+    {
+        std::cout << "Error in GJKTest::testSpheres()" << std::endl;
+    }
+}
+
+void GJKTest::testBoxCone()
+{
+    // The apex of the cone points down, towards the top face of the box
+    Box box(2, 2, 2);
+    Cone cone(1, 2);
+    cone.setPosition(Vector(0, 2.5, 0));
+    bool separated = !GJK::intersect(box, cone);
+
+    cone.setPosition(Vector(0, 1.8, 0));
+    Vector normal;
+    float depth = 0;
+    Vector point;
+    bool overlap = GJK::penetration(box, cone, normal, depth, point);
+
+    if (!separated || !overlap || glm::abs(depth - 0.2f) > 0.01f || normal.distance(Vector(0, 1, 0)) > 0.01f)
+    {
+        std::cout << "Error in GJKTest::testBoxCone()" << std::endl;
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+class GJKTest
+{
+public:
+    static void testSeparatedBoxes();
+    static void testOverlappingBoxes();
+    static void testRotatedBoxes();
+    static void testSpheres();
+    static void testBoxCone();
+};
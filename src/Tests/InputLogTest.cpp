@@ -0,0 +1,198 @@
+#include "InputLogTest.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "Box.h"
+#include "Compound.h"
+#include "Cone.h"
+#include "ConvexHull.h"
+#include "InputLog.h"
+#include "Snapshot.h"
+
+static bool sameBodies(PhysicsWorld& first, PhysicsWorld& second)
+{
+    if (first.bodies.size() != second.bodies.size() || first.stepCount != second.stepCount) return false;
+    for (size_t i = 0; i < first.bodies.size(); i++)
+    {
+        Shape* a = first.bodies[i];
+        Shape* b = second.bodies[i];
+        if (a->id != b->id || std::memcmp(&a->position, &b->position, sizeof(Vector)) != 0
+            || std::memcmp(&a->linearVelocity, &b->linearVelocity, sizeof(Vector)) != 0
+            || std::memcmp(&a->orientation, &b->orientation, sizeof(Quaternion)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Drive a world like the GUI does: irregular frames, with inputs between them
+ */
+static void playSession(PhysicsWorld& world, InputLog& log, bool withClear)
+{
+    for (int frame = 0; frame < 90; frame++)
+    {
+        if (frame % 15 == 0)
+        {
+            ShapeType type = frame % 30 == 0 ? BoxShape : ConeShape;
+            log.submit(world, InputLog::addBodyEvent(type, Vector(30, 20, 25), Vector(frame - 40, 50, frame % 7),
+                                                     frame == 45, Vector(100, 0, -50)));
+        }
+        if (frame % 20 == 10) log.submit(world, InputLog::addForceEvent(0, Vector(0, 500, 0), Vector(5, 0, 0)));
+        if (frame == 40) log.submit(world, InputLog::settingsEvent(Snapshot::getSettings(world) | SNAPSHOT_FRICTION));
+        if (withClear && frame == 60) log.submit(world, InputLog::clearEvent());
+        world.advance(FIXED_TIME_STEP * (0.5f + frame % 4 * 0.4f));
+    }
+}
+
+/**
+ * @brief Restore the snapshot and replay as many steps as the recorded world did
+ */
+static bool replayMatches(PhysicsWorld& recorded, const std::string& snapshotPath, InputLog& log, int steps)
+{
+    PhysicsWorld replayed(250);
+    log.setupScene(replayed);
+    if (!Snapshot::load(replayed, snapshotPath)) return false;
+    log.rewind();
+    log.replay(replayed, steps);
+    return log.isFinished() && sameBodies(recorded, replayed);
+}
+
+void InputLogTest::testReplayMatchesRecording()
+{
+    const std::string path = "input_log_test.bin";
+    PhysicsWorld world(250);
+    world.staticWorld.addArena(250);
+    world.deterministic = true;
+    world.gravity = true;
+    world.addBody(new Box(20, 20, 20, Vector(0, -100, 0)));
+    for (int i = 0; i < 10; i++) world.step(FIXED_TIME_STEP);
+
+    InputLog log;
+    Snapshot::save(world, path);
+    int startStep = world.stepCount;
+    log.start(INPUT_LOG_ARENA, 250, 0);
+    playSession(world, log, false);
+    log.stop();
+
+    bool matches = replayMatches(world, path, log, world.stepCount - startStep);
+    std::remove(path.c_str());
+
+    if (!matches || log.events.size() != 11 || !world.friction)
+    {
+        std::cout << "Error in InputLogTest::testReplayMatchesRecording()" << std::endl;
+    }
+}
+
+void InputLogTest::testReplayAfterClear()
+{
+    // A clear resets the step counter during the recording
+    const std::string path = "input_log_clear_test.bin";
+    PhysicsWorld world(250);
+    world.staticWorld.addArena(250);
+    world.deterministic = true;
+    world.gravity = true;
+
+    InputLog log;
+    Snapshot::save(world, path);
+    log.start(INPUT_LOG_ARENA, 250, 0);
+    playSession(world, log, true);
+    log.stop();
+
+    int stepsBeforeClear = 0;
+    for (auto& event : log.events)
+    {
+        if (event.type == ClearInput) stepsBeforeClear = event.step;
+    }
+
+    bool matches = replayMatches(world, path, log, stepsBeforeClear + world.stepCount);
+    std::remove(path.c_str());
+
+    if (!matches || world.bodies.size() != 1)
+    {
+        std::cout << "Error in InputLogTest::testReplayAfterClear()" << std::endl;
+    }
+}
+
+void InputLogTest::testSaveLoad()
+{
+    const std::string path = "input_log_test.log";
+    InputLog log;
+    PhysicsWorld world(250);
+    log.start(INPUT_LOG_ARENA | INPUT_LOG_TERRAIN, 250, 50);
+    log.submit(world, InputLog::addBodyEvent(ConeShape, Vector(10, 20, 0), Vector(1, 2, 3), true, Vector(4, 5, 6)));
+    world.step(FIXED_TIME_STEP);
+    log.submit(world, InputLog::addForceEvent(0, Vector(7, 8, 9), Vector(0, 0, 0)));
+    log.stop();
+
+    InputLog loaded;
+    bool valid = log.save(path) && loaded.load(path);
+    std::remove(path.c_str());
+
+    valid = valid && loaded.events.size() == 2 && loaded.scene == (INPUT_LOG_ARENA | INPUT_LOG_TERRAIN)
+        && loaded.arenaSize == 250 && loaded.terrainSpacing == 50
+        && std::memcmp(loaded.events.data(), log.events.data(), 2 * sizeof(InputEvent)) == 0
+        && loaded.events[1].step == 1 && !loaded.load("missing_input_log.log");
+
+    if (!valid)
+    {
+        std::cout << "Error in InputLogTest::testSaveLoad()" << std::endl;
+    }
+}
+
+void InputLogTest::testShapes()
+{
+    // A compound and a hull added during the recording are replayed with their children and vertices, and the log
+    // carries their materials
+    const std::string snapshotPath = "input_log_shapes_test.bin";
+    const std::string logPath = "input_log_shapes_test.log";
+    PhysicsWorld world(250);
+    world.staticWorld.addArena(250);
+    world.deterministic = true;
+    world.gravity = true;
+
+    Material dense;
+    dense.density = 7.5f;
+    dense.restitution = 0.125f;
+    Compound dumbbell;
+    dumbbell.addChild(new Box(40, 5, 5), Vector(0, 0, 0));
+    Cone* weight = new Cone(8, 10);
+    weight->material = MaterialTable::add(dense);
+    dumbbell.addChild(weight, Vector(20, 0, 0), Quaternion(0.7071f, Vector(0, 0, 1)));
+    ConvexHull pyramid({Vector(-10, 0, -10), Vector(10, 0, -10), Vector(10, 0, 10), Vector(-10, 0, 10),
+                        Vector(0, 15, 0)});
+
+    InputLog log;
+    Snapshot::save(world, snapshotPath);
+    log.start(INPUT_LOG_ARENA, 250, 0);
+    bool valid = log.submitShape(world, &dumbbell, Vector(0, 50, 0), false, Vector(0, 0, 100));
+    for (int i = 0; i < 40; i++) world.step(FIXED_TIME_STEP);
+    valid = valid && log.submitShape(world, &pyramid, Vector(60, 30, 0), true, Vector(-100, 0, 0));
+    log.submit(world, InputLog::addForceEvent(0, Vector(300, 0, 0), Vector(10, 0, 0)));
+    for (int i = 0; i < 40; i++) world.step(FIXED_TIME_STEP);
+    log.stop();
+
+    InputLog loaded;
+    valid = valid && log.save(logPath) && loaded.load(logPath) && loaded.shapes.size() == 4
+        && loaded.vertices.size() == 3 * 5
+        && loaded.materials.size() == 2 && loaded.materials[1] == dense;
+    std::remove(logPath.c_str());
+
+    PhysicsWorld replayed(250);
+    loaded.setupScene(replayed);
+    valid = valid && Snapshot::load(replayed, snapshotPath);
+    std::remove(snapshotPath.c_str());
+    loaded.replay(replayed, world.stepCount);
+    valid = valid && loaded.isFinished() && sameBodies(world, replayed)
+        && replayed.bodies[0]->getMass() == world.bodies[0]->getMass()
+        && MaterialTable::get(static_cast<Compound*>(replayed.bodies[0])->children[1].shape->material) == dense
+        && replayed.bodies[1]->shapeType == ConvexHullShape
+        && static_cast<ConvexHull*>(replayed.bodies[1])->vertices.size() == 5;
+
+    if (!valid)
+    {
+        std::cout << "Error in InputLogTest::testShapes()" << std::endl;
+    }
+}
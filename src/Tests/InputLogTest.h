@@ -0,0 +1,10 @@
+#pragma once
+
+class InputLogTest
+{
+public:
+    static void testReplayMatchesRecording();
+    static void testReplayAfterClear();
+    static void testSaveLoad();
+    static void testShapes();
+};
@@ -0,0 +1,133 @@
+#include "InstanceBufferTest.h"
+
+#include "Box.h"
+#include "Cone.h"
+#include "InstanceBuffer.h"
+
+void InstanceBufferTest::testGrouping()
+{
+    std::vector<RenderBody> bodies(5);
+    for (int i = 0; i < 5; i++)
+    {
+        bodies[i].id = i;
+        bodies[i].shapeType = i < 2 ? ConeShape : BoxShape;
+    }
+
+    InstanceBuffer buffer;
+    buffer.fill(bodies);
+    if (buffer.instances[ConeShape].size() != 2 || buffer.instances[BoxShape].size() != 3
+        || buffer.instances[SphereShape].size() != 0 || buffer.massCenters.size() != 5 || buffer.getInstanceCount() != 10)
+    {
+        std::cout << "Error in InstanceBufferTest::testGrouping()" << std::endl;
+        return;
+    }
+
+    // A second fill replaces the instances
+    bodies.resize(1);
+    buffer.fill(bodies);
+    if (buffer.instances[ConeShape].size() != 1 || buffer.instances[BoxShape].size() != 0 || buffer.getInstanceCount() != 2)
+    {
+        std::cout << "Error in InstanceBufferTest::testGrouping()" << std::endl;
+    }
+}
+
+void InstanceBufferTest::testTransform()
+{
+    RenderBody body;
+    body.shapeType = BoxShape;
+    body.color[0] = 255;
+    body.color[1] = 0;
+    body.color[2] = 51;
+    body.dimensions = Vector(30, 20, 10);
+    body.position = Vector(5, -3, 7);
+    body.orientation = Quaternion(PI / 3, Vector(1, 2, 2).normalized());
+    body.massCenter = Vector(0, 4, 0);
+
+    InstanceBuffer buffer;
+    buffer.fill({body});
+    const InstanceData& instance = buffer.instances[BoxShape][0];
+
+    // The corner of the unit box must land where the rotation of the scaled corner puts it
+    Vector corner = Vector(0.5f * 30, 0.5f * 20, 0.5f * 10);
+    Vector expected = body.orientation.applyRotation(corner, body.orientation) + body.position;
+    const float* m = instance.transform;
+    Vector transformed = Vector(m[0] * 0.5f + m[4] * 0.5f + m[8] * 0.5f + m[12],
+                                m[1] * 0.5f + m[5] * 0.5f + m[9] * 0.5f + m[13],
+                                m[2] * 0.5f + m[6] * 0.5f + m[10] * 0.5f + m[14]);
+    if ((transformed - expected).magnitude() > 1e-3 || m[15] != 1 || std::abs(instance.color[2] - 0.2f) > 1e-5
+        || std::abs(instance.color[3] - BODY_ALPHA / 255.0f) > 1e-5)
+    {
+        std::cout << "Error in InstanceBufferTest::testTransform()" << std::endl;
+        return;
+    }
+
+    const float* center = buffer.massCenters[0].transform;
+    Vector centerExpected = body.orientation.applyRotation(body.massCenter, body.orientation) + body.position;
+    if ((Vector(center[12], center[13], center[14]) - centerExpected).magnitude() > 1e-3)
+    {
+        std::cout << "Error in InstanceBufferTest::testTransform()" << std::endl;
+    }
+}
+
+void InstanceBufferTest::testCapture()
+{
+    // Bodies only hold their physics state, the meshes are shared by the renderer
+    if (sizeof(Box) > 512 || sizeof(Cone) > 512)
+    {
+        std::cout << "Error in InstanceBufferTest::testCapture()" << std::endl;
+        return;
+    }
+
+    PhysicsWorld world(250);
+    world.addBody(new Box(30, 20, 10, Vector(10, 0, 0)));
+    world.addBody(new Cone(5, 12, Vector(-10, 0, 0)));
+    Box copy = *static_cast<Box*>(world.bodies[0]);
+
+    RenderFrame frame;
+    frame.capture(world, false);
+    if (frame.bodies.size() != 2 || frame.bodies[0].shapeType != BoxShape || frame.bodies[1].shapeType != ConeShape
+        || (frame.bodies[0].dimensions - Vector(30, 20, 10)).magnitude() > 1e-5
+        || (frame.bodies[1].dimensions - Vector(5, 12, 5)).magnitude() > 1e-5
+        || copy.getWidth() != 30 || (copy.position - frame.bodies[0].position).magnitude() > 1e-5)
+    {
+        std::cout << "Error in InstanceBufferTest::testCapture()" << std::endl;
+    }
+}
+
+void InstanceBufferTest::testNormalMatrix()
+{
+    // The vertex shader turns the normals with the columns of the transform over their squared lengths. On a
+    // stretched and turned box, the normal of a face must stay perpendicular to the face
+    RenderBody body;
+    body.shapeType = BoxShape;
+    body.dimensions = Vector(30, 2, 10);
+    body.position = Vector(0, 0, 0);
+    body.orientation = Quaternion(PI / 5, Vector(1, 1, 0).normalized());
+    body.massCenter = Vector(0, 0, 0);
+    InstanceBuffer buffer;
+    buffer.fill({body});
+    const float* m = buffer.instances[BoxShape][0].transform;
+
+    Vector columns[3];
+    for (int c = 0; c < 3; c++) columns[c] = Vector(m[4 * c], m[4 * c + 1], m[4 * c + 2]);
+    // A slanted face of the unit box, with its normal and two of its edges
+    Vector normal = Vector(1, 1, 0);
+    Vector edges[2] = {Vector(1, -1, 0), Vector(0, 0, 1)};
+    Vector worldNormal = Vector(0, 0, 0);
+    for (int c = 0; c < 3; c++)
+    {
+        worldNormal += columns[c] * ((c == 0 ? normal.x : c == 1 ? normal.y : normal.z) / (columns[c] * columns[c]));
+    }
+    worldNormal = worldNormal.normalized();
+
+    bool perpendicular = true;
+    for (Vector edge : edges)
+    {
+        Vector worldEdge = columns[0] * edge.x + columns[1] * edge.y + columns[2] * edge.z;
+        perpendicular = perpendicular && std::abs(worldNormal * worldEdge.normalized()) < 1e-4f;
+    }
+    if (!perpendicular)
+    {
+        std::cout << "Error in InstanceBufferTest::testNormalMatrix()" << std::endl;
+    }
+}
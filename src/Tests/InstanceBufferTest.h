@@ -0,0 +1,10 @@
+#pragma once
+
+class InstanceBufferTest
+{
+public:
+    static void testGrouping();
+    static void testTransform();
+    static void testCapture();
+    static void testNormalMatrix();
+};
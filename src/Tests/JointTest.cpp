@@ -0,0 +1,190 @@
+#include "JointTest.h"
+
+#include <cmath>
+
+#include "BallSocketJoint.h"
+#include "Box.h"
+#include "FixedJoint.h"
+#include "HingeJoint.h"
+#include "PhysicsWorld.h"
+#include "SliderJoint.h"
+
+/**
+ * @brief A world without collisions nor walls, where the joints are the only constraints
+ */
+static void setupWorld(PhysicsWorld& world)
+{
+    world.collisions = false;
+    world.gravity = true;
+}
+
+static Box* addBox(PhysicsWorld& world, Vector position)
+{
+    Box* box = new Box(1, 1, 1);
+    box->setPosition(position);
+    world.addBody(box);
+    return box;
+}
+
+/**
+ * @brief Hang a chain of boxes from the world by ball sockets, each link one unit long
+ * @return The largest error of the joints during the simulation
+ */
+static float simulateChain(int links, float delta_t, int steps, int iterations, bool warmStarting)
+{
+    PhysicsWorld world(1000);
+    setupWorld(world);
+    world.jointSolver.iterations = iterations;
+    world.jointSolver.warmStarting = warmStarting;
+    Box* previous = nullptr;
+    for (int i = 0; i < links; i++)
+    {
+        Box* box = addBox(world, Vector(i + 1.0f, 0, 0));
+        if (previous == nullptr) world.jointSolver.add(new BallSocketJoint(box, nullptr, Vector(0, 0, 0)));
+        else world.jointSolver.add(new BallSocketJoint(previous, box, Vector(i + 0.5f, 0, 0)));
+        previous = box;
+    }
+
+    float maxError = 0;
+    for (int i = 0; i < steps; i++)
+    {
+        world.step(delta_t);
+        maxError = std::max(maxError, world.jointSolver.getMaxError());
+    }
+    return maxError;
+}
+
+void JointTest::testBallSocketPendulum()
+{
+    // The box swings down but stays at the end of its arm
+    PhysicsWorld world(1000);
+    setupWorld(world);
+    Box* box = addBox(world, Vector(2, 0, 0));
+    world.jointSolver.add(new BallSocketJoint(box, nullptr, Vector(0, 0, 0)));
+
+    float lowest = 0;
+    for (int i = 0; i < 120; i++)
+    {
+        world.step(1.0f / 60.0f);
+        lowest = std::min(lowest, box->position.y);
+        if (std::abs(box->position.magnitude() - 2) > 0.05f)
+        {
+            std::cout << "Error in JointTest::testBallSocketPendulum()" << std::endl;
+            return;
+        }
+    }
+    if (lowest > -1.5f)
+    {
+        std::cout << "Error in JointTest::testBallSocketPendulum()" << std::endl;
+    }
+}
+
+void JointTest::testHinge()
+{
+    // Only the spin around the hinge axis survives, and the bodies keep their anchors together
+    PhysicsWorld world(1000);
+    setupWorld(world);
+    world.gravity = false;
+    Box* first = addBox(world, Vector(0, 0, 0));
+    Box* second = addBox(world, Vector(1, 0, 0));
+    auto hinge = new HingeJoint(first, second, Vector(0.5f, 0, 0), Vector(0, 0, 1));
+    world.jointSolver.add(hinge);
+    second->angularVelocity = Vector(2, 1, 3);
+
+    for (int i = 0; i < 120; i++)
+    {
+        world.step(1.0f / 60.0f);
+    }
+    // The axis turns with the first body
+    Vector axis = first->orientation.quatToMat().transpose() * hinge->localAxisFirst;
+    Vector relative = second->angularVelocity - first->angularVelocity;
+    Vector offAxis = relative - axis * (relative * axis);
+    if (hinge->getError() > 0.02f || offAxis.magnitude() > 0.05f || relative.magnitude() < 0.5f)
+    {
+        std::cout << "Error in JointTest::testHinge()" << std::endl;
+    }
+}
+
+void JointTest::testSlider()
+{
+    // A box attached to the world slides along x only, without turning
+    PhysicsWorld world(1000);
+    setupWorld(world);
+    Box* box = addBox(world, Vector(0, 0, 0));
+    auto slider = new SliderJoint(box, nullptr, Vector(0, 0, 0), Vector(1, 0, 0));
+    world.jointSolver.add(slider);
+    box->linearVelocity = Vector(1, 2, -1);
+    box->angularVelocity = Vector(0, 2, 1);
+
+    for (int i = 0; i < 60; i++)
+    {
+        world.step(1.0f / 60.0f);
+    }
+    if (slider->getError() > 0.02f || std::abs(box->position.y) > 0.02f || std::abs(box->position.z) > 0.02f
+        || std::abs(slider->getTranslation() + 1) > 0.05f || box->angularVelocity.magnitude() > 0.01f)
+    {
+        std::cout << "Error in JointTest::testSlider()" << std::endl;
+    }
+}
+
+void JointTest::testFixedCantilever()
+{
+    // A beam of welded boxes sticking out of a wall under gravity bends only slightly
+    PhysicsWorld world(1000);
+    setupWorld(world);
+    world.jointSolver.iterations = 20;
+    Box* previous = nullptr;
+    for (int i = 0; i < 4; i++)
+    {
+        Box* box = addBox(world, Vector(i + 0.5f, 0, 0));
+        world.jointSolver.add(new FixedJoint(previous != nullptr ? previous : box,
+                                             previous != nullptr ? box : nullptr, Vector(i, 0, 0)));
+        previous = box;
+    }
+
+    for (int i = 0; i < 120; i++)
+    {
+        world.step(1.0f / 60.0f);
+    }
+    if (previous->position.y < -0.5f || world.jointSolver.getMaxError() > 0.1f)
+    {
+        std::cout << "Error in JointTest::testFixedCantilever()" << std::endl;
+    }
+}
+
+void JointTest::testWarmStarting()
+{
+    // With few iterations and large steps, a hanging chain holds together better from the last impulses
+    float cold = simulateChain(8, 1.0f / 30.0f, 60, 4, false);
+    float warm = simulateChain(8, 1.0f / 30.0f, 60, 4, true);
+    if (warm >= cold || warm > 0.25f)
+    {
+        std::cout << "Error in JointTest::testWarmStarting()" << std::endl;
+    }
+}
+
+void JointTest::testTorque()
+{
+    // A torque across the axis of a hinge must not turn the body: the solver removes what the integrator will add,
+    // with the same inverse inertia, even after the integrator updated it many times
+    PhysicsWorld world(1000);
+    setupWorld(world);
+    world.gravity = false;
+    Box* box = new Box(1, 2, 3);
+    box->setPosition(Vector(0, 0, 0));
+    box->orientation = Quaternion(0.7f, Vector(1, 1, 0).normalized());
+    box->angularVelocity = Vector(0.5f, 2, -1);
+    for (int i = 0; i < 30; i++) box->eulerIntegration(1.0f / 60.0f);
+    box->angularVelocity = Vector(0, 0, 0);
+    world.addBody(box);
+    world.jointSolver.add(new HingeJoint(box, nullptr, Vector(0, 0, 0), Vector(0, 1, 0)));
+
+    box->torque = Vector(4, 0, -3);
+    world.step(1.0f / 60.0f);
+
+    Vector across = box->angularVelocity - Vector(0, 1, 0) * box->angularVelocity.y;
+    if (across.magnitude() > 1e-3f)
+    {
+        std::cout << "Error in JointTest::testTorque()" << std::endl;
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+class JointTest
+{
+public:
+    static void testBallSocketPendulum();
+    static void testHinge();
+    static void testSlider();
+    static void testFixedCantilever();
+    static void testWarmStarting();
+    static void testTorque();
+};
@@ -0,0 +1,206 @@
+#include "MassPropertiesTest.h"
+
+#include <cmath>
+
+#include "Box.h"
+#include "CollisionManager.h"
+#include "Compound.h"
+#include "Cone.h"
+#include "MassProperties.h"
+#include "SceneLoader.h"
+
+static bool near(float value, float expected, float tolerance)
+{
+    return std::abs(value - expected) <= tolerance * std::max(1.0f, std::abs(expected));
+}
+
+static bool nearMatrix(Matrix value, Matrix expected, float tolerance)
+{
+    Vector rows[3] = {value.l1, value.l2, value.l3};
+    Vector expectedRows[3] = {expected.l1, expected.l2, expected.l3};
+    for (int i = 0; i < 3; i++)
+    {
+        if (!near(rows[i].x, expectedRows[i].x, tolerance) || !near(rows[i].y, expectedRows[i].y, tolerance)
+            || !near(rows[i].z, expectedRows[i].z, tolerance))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The faces of a box as triangles, counterclockwise seen from outside. Vertex i has its x, y and z at the
+ * maximum for the bits 1, 2 and 4
+ */
+static MassProperties boxPolyhedron(Vector size, Vector center, float density)
+{
+    std::vector<Vector> vertices;
+    for (int i = 0; i < 8; i++)
+    {
+        vertices.push_back(center + Vector((i & 1 ? 0.5f : -0.5f) * size.x, (i & 2 ? 0.5f : -0.5f) * size.y,
+                                           (i & 4 ? 0.5f : -0.5f) * size.z));
+    }
+    std::vector<int> triangles = {0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5, 0, 1, 5, 0, 5, 4,
+                                  2, 6, 7, 2, 7, 3, 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6};
+    return MassProperties::polyhedron(vertices, triangles, density);
+}
+
+void MassPropertiesTest::testPrimitives()
+{
+    MassProperties box = MassProperties::box(1, 2, 3, 2);
+    MassProperties sphere = MassProperties::sphere(1, 1);
+    MassProperties cone = MassProperties::cone(1, 4, 3);
+    bool valid = near(box.mass, 12, 1e-5f) && near(box.inertia.l1.x, 13, 1e-5f) && near(box.inertia.l2.y, 10, 1e-5f)
+        && near(box.inertia.l3.z, 5, 1e-5f) && near(sphere.mass, 4 * PI / 3, 1e-5f)
+        && near(sphere.inertia.l2.y, 0.4f * sphere.mass, 1e-5f) && near(cone.mass, 4 * PI, 1e-5f)
+        && near(cone.centerOfMass.y, 1, 1e-5f) && near(cone.inertia.l2.y, 0.3f * cone.mass, 1e-5f);
+
+    // The shapes give the same properties for their own density, and keep them in sync with their mass
+    Box body(1, 2, 3);
+    body.setMassProperties(body.computeMassProperties(2));
+    valid = valid && body.getMass() == box.mass && nearMatrix(body.tenseurJ, box.inertia, 1e-5f)
+        && nearMatrix(Box(1, 2, 3).tenseurJ, box.withMass(1).inertia, 1e-5f);
+    if (!valid)
+    {
+        std::cout << "Error in MassPropertiesTest::testPrimitives()" << std::endl;
+    }
+}
+
+void MassPropertiesTest::testPolyhedron()
+{
+    // A box given by its faces, away from the origin
+    MassProperties expected = MassProperties::box(1, 2, 3, 2);
+    MassProperties box = boxPolyhedron(Vector(1, 2, 3), Vector(1, -2, 3), 2);
+    bool valid = near(box.mass, expected.mass, 1e-4f) && near(box.centerOfMass.x, 1, 1e-4f)
+        && near(box.centerOfMass.y, -2, 1e-4f) && near(box.centerOfMass.z, 3, 1e-4f)
+        && nearMatrix(box.inertia, expected.inertia, 1e-3f);
+
+    // A cone approximated by a pyramid of many sides
+    const int sides = 128;
+    std::vector<Vector> vertices = {Vector(0, -2, 0), Vector(0, 2, 0)};
+    std::vector<int> triangles;
+    for (int i = 0; i < sides; i++)
+    {
+        float angle = 2 * PI * i / sides;
+        vertices.push_back(Vector(std::cos(angle), 2, std::sin(angle)));
+        int current = 2 + i;
+        int next = 2 + (i + 1) % sides;
+        triangles.insert(triangles.end(), {0, current, next, 1, next, current});
+    }
+    MassProperties pyramid = MassProperties::polyhedron(vertices, triangles, 3);
+    MassProperties cone = MassProperties::cone(1, 4, 3);
+    valid = valid && near(pyramid.mass, cone.mass, 0.01f) && near(pyramid.centerOfMass.y, cone.centerOfMass.y, 0.01f)
+        && nearMatrix(pyramid.inertia, cone.inertia, 0.01f);
+    if (!valid)
+    {
+        std::cout << "Error in MassPropertiesTest::testPolyhedron()" << std::endl;
+    }
+}
+
+void MassPropertiesTest::testCompound()
+{
+    // Two unit cubes side by side are a 2 x 1 x 1 box
+    MassProperties expected = MassProperties::box(2, 1, 1, 1);
+    Compound pair;
+    pair.addChild(new Box(1, 1, 1), Vector(-0.5f, 0, 0));
+    pair.addChild(new Box(1, 1, 1), Vector(0.5f, 0, 0));
+    MassProperties combined = pair.computeMassProperties(1);
+
+    // So is a 1 x 2 x 1 box turned a quarter around Z, the rotation moves the inertia with it
+    Compound turned;
+    turned.addChild(new Box(1, 2, 1), Vector(0, 0, 0), Quaternion(PI / 2, Vector(0, 0, 1)));
+    MassProperties rotated = turned.computeMassProperties(1);
+
+    // An off-center child moves the center of mass
+    Compound hammer;
+    hammer.addChild(new Box(1, 1, 1), Vector(0, 0, 0));
+    hammer.addChild(new Box(1, 1, 1), Vector(3, 0, 0));
+    hammer.updateMassProperties();
+
+    if (!near(combined.mass, 2, 1e-5f) || !nearMatrix(combined.inertia, expected.inertia, 1e-5f)
+        || !nearMatrix(rotated.inertia, expected.withMass(rotated.mass).inertia, 1e-4f)
+        || !near(hammer.massCenter.x, 1.5f, 1e-5f) || !near(hammer.getMass(), 2, 1e-5f)
+        || !near(hammer.tenseurJ.l2.y, 2 * (1.0f / 6) + 2 * 1.5f * 1.5f, 1e-5f))
+    {
+        std::cout << "Error in MassPropertiesTest::testCompound()" << std::endl;
+    }
+}
+
+void MassPropertiesTest::testCompoundCollision()
+{
+    // A dumbbell of two cubes with a gap between them: a small box in the gap is inside the hull but touches
+    // neither child
+    Compound dumbbell;
+    dumbbell.addChild(new Box(1, 1, 1), Vector(-2, 0, 0));
+    dumbbell.addChild(new Box(1, 1, 1), Vector(2, 0, 0));
+    dumbbell.setPosition(Vector(0, 0, 0));
+
+    Box inGap(0.5f, 0.5f, 0.5f);
+    inGap.setPosition(Vector(0, 0, 0));
+    Box onChild(1, 1, 1);
+    onChild.setPosition(Vector(2.8f, 0, 0));
+
+    NarrowPhaseKernel kernel = CollisionManager::getKernel(BoxShape, CompoundShape);
+    Contact gapContact;
+    Contact childContact;
+    bool gapHit = kernel(inGap, dumbbell, gapContact);
+    bool childHit = kernel(onChild, dumbbell, childContact);
+
+    // The normal points from the first body to the compound
+    if (gapHit || !childHit || childContact.second != &dumbbell || !near(childContact.penetration, 0.2f, 1e-3f)
+        || childContact.normal.x > -0.99f)
+    {
+        std::cout << "Error in MassPropertiesTest::testCompoundCollision()" << std::endl;
+    }
+}
+
+void MassPropertiesTest::testSceneDensity()
+{
+    PhysicsWorld world(250);
+    ofJson scene = ofJson::parse(R"({
+        "materials": {"steel": {"density": 8}, "light": {"mass": 3}},
+        "bodies": [
+            {"shape": "box", "size": [1, 2, 3], "material": "steel"},
+            {"shape": "box", "size": [1, 2, 3], "material": "light"},
+            {"shape": "compound", "children": [
+                {"shape": "box", "size": [1, 1, 1], "offset": [-1, 0, 0], "material": "steel"},
+                {"shape": "box", "size": [1, 1, 1], "offset": [1, 0, 0]}]}
+        ]
+    })");
+    bool loaded = SceneLoader::load(world, scene);
+    // The compound has a steel cube and a default one of density 1, its center of mass is towards the steel
+    bool valid = loaded && near(world.bodies[0]->getMass(), 48, 1e-5f) && near(world.bodies[1]->getMass(), 3, 1e-5f)
+        && world.bodies[2]->shapeType == CompoundShape && near(world.bodies[2]->getMass(), 9, 1e-5f)
+        && near(world.bodies[2]->massCenter.x, -7.0f / 9, 1e-5f);
+    if (!valid)
+    {
+        std::cout << "Error in MassPropertiesTest::testSceneDensity()" << std::endl;
+    }
+}
+
+void MassPropertiesTest::testOffCenterSpin()
+{
+    // The hammer turns about its center of mass, half way between the cubes, not about its first cube
+    Compound hammer;
+    hammer.addChild(new Box(1, 1, 1), Vector(0, 0, 0));
+    hammer.addChild(new Box(1, 1, 1), Vector(3, 0, 0));
+    hammer.updateMassProperties();
+    hammer.setPosition(Vector(0, 0, 0));
+    hammer.setLinearVelocity(Vector(0, 0, 0));
+    hammer.setAngularVelocity(Vector(0, 0, 2));
+
+    Vector start = hammer.getWorldMassCenter();
+    float drift = 0;
+    for (int i = 0; i < 120; i++)
+    {
+        hammer.eulerIntegration(1.0f / 60);
+        drift = std::max(drift, (hammer.getWorldMassCenter() - start).magnitude());
+    }
+
+    // After two seconds at 2 rad/s the head went around more than half a turn, and the first cube with it
+    if (!near(start.x, 1.5f, 1e-5f) || drift > 1e-3f || hammer.position.x < 2)
+    {
+        std::cout << "Error in MassPropertiesTest::testOffCenterSpin()" << std::endl;
+    }
+}
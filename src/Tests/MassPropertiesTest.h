@@ -0,0 +1,12 @@
+#pragma once
+
+class MassPropertiesTest
+{
+public:
+    static void testPrimitives();
+    static void testPolyhedron();
+    static void testCompound();
+    static void testCompoundCollision();
+    static void testSceneDensity();
+    static void testOffCenterSpin();
+};
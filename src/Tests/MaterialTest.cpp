@@ -0,0 +1,159 @@
+#include "MaterialTest.h"
+
+#include <cmath>
+
+#include "Box.h"
+#include "CollisionManager.h"
+#include "Material.h"
+#include "PhysicsWorld.h"
+#include "SceneLoader.h"
+
+void MaterialTest::testCombineModes()
+{
+    // The mode of highest value wins
+    bool valid = MaterialTable::combine(0.2f, 0.6f, CombineAverage, CombineAverage) == 0.4f
+        && MaterialTable::combine(0.2f, 0.6f, CombineAverage, CombineMinimum) == 0.2f
+        && std::abs(MaterialTable::combine(0.2f, 0.6f, CombineMultiply, CombineMinimum) - 0.12f) < 1e-6f
+        && MaterialTable::combine(0.2f, 0.6f, CombineMultiply, CombineMaximum) == 0.6f;
+
+    Material ice;
+    ice.staticFriction = ice.dynamicFriction = 0.05f;
+    ice.frictionCombine = CombineMinimum;
+    MaterialPair pair = MaterialTable::getPair(0, MaterialTable::add(ice));
+    valid = valid && pair.staticFriction == 0.05f && pair.restitution == DEFAULT_RESTITUTION;
+
+    if (!valid)
+    {
+        std::cout << "Error in MaterialTest::testCombineModes()" << std::endl;
+    }
+}
+
+void MaterialTest::testTable()
+{
+    // Identical materials share an index, unknown indices fall back to the default material
+    Material rubber;
+    rubber.restitution = 0.95f;
+    rubber.staticFriction = 1.2f;
+    int first = MaterialTable::add(rubber);
+    int size = MaterialTable::size();
+    int second = MaterialTable::add(rubber);
+    if (first == 0 || second != first || MaterialTable::size() != size || MaterialTable::get(first).restitution != 0.95f
+        || MaterialTable::add(Material()) != 0 || MaterialTable::get(-1).restitution != DEFAULT_RESTITUTION)
+    {
+        std::cout << "Error in MaterialTest::testTable()" << std::endl;
+    }
+}
+
+/**
+ * @brief Resolve a body hitting a floor below it, moving down at 1 and sideways at the given speed
+ * @return The velocity after the contact
+ */
+static Vector hitFloor(int material, float slidingSpeed)
+{
+    Box box(1, 1, 1);
+    box.material = material;
+    box.linearVelocity = Vector(slidingSpeed, -1, 0);
+    Contact contact;
+    contact.first = &box;
+    contact.normal = Vector(0, -1, 0);
+    contact.penetration = 0.1f;
+    CollisionManager::resolveStaticContact(contact);
+    return box.linearVelocity;
+}
+
+void MaterialTest::testStaticContact()
+{
+    Material sticky;
+    sticky.restitution = 0;
+    sticky.staticFriction = 5;
+    sticky.dynamicFriction = 2;
+    sticky.restitutionCombine = CombineMinimum;
+    sticky.frictionCombine = CombineMaximum;
+    int stickyIndex = MaterialTable::add(sticky);
+
+    // Slides at once, with a dynamic friction of 5 * 0.3 larger than the sliding speed
+    Material slippery;
+    slippery.restitution = 0;
+    slippery.staticFriction = 0;
+    slippery.dynamicFriction = 5;
+    slippery.restitutionCombine = CombineMinimum;
+    slippery.frictionCombine = CombineMultiply;
+    int slipperyIndex = MaterialTable::add(slippery);
+
+    // Default bounce and dynamic friction: the normal impulse is 1.9, the sliding slows by 1.9 * 0.3
+    Vector bounce = hitFloor(0, 3);
+    // Below the static limit the contact sticks, and without restitution it does not bounce
+    Vector stuck = hitFloor(stickyIndex, 3);
+    // The friction stops the sliding but does not send the body back
+    Vector stopped = hitFloor(slipperyIndex, 1);
+    if (std::abs(bounce.y - DEFAULT_RESTITUTION) > 1e-5f || std::abs(bounce.x - (3 - 1.9f * 0.3f)) > 1e-5f
+        || stuck.x != 0 || stuck.y != 0 || std::abs(stopped.x) > 1e-6f)
+    {
+        std::cout << "Error in MaterialTest::testStaticContact()" << std::endl;
+    }
+}
+
+/**
+ * @brief Launch a box along a floor
+ * @return The distance the box slid in two seconds
+ */
+static float slide(const Material& material)
+{
+    PhysicsWorld world(1000);
+    world.gravity = true;
+    StaticPlane* floor = new StaticPlane(Vector(0, 1, 0), 0);
+    floor->material = MaterialTable::add(material);
+    world.staticWorld.addPlane(floor);
+    world.staticWorld.build();
+
+    Box* box = new Box(1, 1, 1);
+    box->material = floor->material;
+    box->angularVelocity = Vector(0, 0, 0);
+    box->setPosition(Vector(0, 0.5f, 0));
+    box->linearVelocity = Vector(5, 0, 0);
+    world.addBody(box);
+    for (int i = 0; i < 120; i++)
+    {
+        world.step(1.0f / 60.0f);
+    }
+    return box->position.x;
+}
+
+void MaterialTest::testSlidingBox()
+{
+    // A box on a rough floor stops quickly, on a frictionless one it keeps going
+    Material rough;
+    rough.restitution = 0;
+    rough.dynamicFriction = 0.8f;
+    Material frictionless;
+    frictionless.restitution = 0;
+    frictionless.staticFriction = frictionless.dynamicFriction = 0;
+    float roughDistance = slide(rough);
+    float freeDistance = slide(frictionless);
+    if (roughDistance > 3 || std::abs(freeDistance - 10) > 0.5f)
+    {
+        std::cout << "Error in MaterialTest::testSlidingBox()" << std::endl;
+    }
+}
+
+void MaterialTest::testSceneMaterials()
+{
+    PhysicsWorld world(250);
+    ofJson scene = ofJson::parse(R"({
+        "materials": {"rubber": {"restitution": 0.95, "staticFriction": 1.1, "dynamicFriction": 0.9,
+                                 "frictionCombine": "maximum"}},
+        "bodies": [{"shape": "box", "material": "rubber"}, {"shape": "box"}]
+    })");
+    bool loaded = SceneLoader::load(world, scene);
+    bool valid = loaded && world.bodies[1]->material == 0 && world.bodies[0]->material != 0
+        && MaterialTable::get(world.bodies[0]->material).restitution == 0.95f
+        && MaterialTable::getPair(world.bodies[0]->material, world.bodies[1]->material).dynamicFriction == 0.9f;
+
+    // Unknown combine modes and negative coefficients are rejected
+    valid = valid && !SceneLoader::load(world, ofJson::parse(R"({"materials": {"bad": {"frictionCombine": "sum"}}})"))
+        && !SceneLoader::load(world, ofJson::parse(R"({"materials": {"bad": {"restitution": -1}}})"));
+    if (!valid)
+    {
+        std::cout << "Error in MaterialTest::testSceneMaterials()" << std::endl;
+    }
+}
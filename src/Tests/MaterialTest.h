@@ -0,0 +1,11 @@
+#pragma once
+
+class MaterialTest
+{
+public:
+    static void testCombineModes();
+    static void testTable();
+    static void testStaticContact();
+    static void testSlidingBox();
+    static void testSceneMaterials();
+};
@@ -0,0 +1,122 @@
+#include "NarrowPhaseTest.h"
+
+#include "Box.h"
+#include "CollisionManager.h"
+#include "Cone.h"
+#include "GJK.h"
+
+void NarrowPhaseTest::testSphereSphere()
+{
+    RigidBody first;
+    first.colliderRadius = 1;
+    RigidBody second;
+    second.colliderRadius = 1;
+    second.setPosition(Vector(1.5, 0, 0));
+
+    Contact contact;
+    bool overlap = CollisionManager::sphereSphere(first, second, contact);
+    second.setPosition(Vector(2.5, 0, 0));
+    Contact separated;
+
+    if (!overlap || glm::abs(contact.penetration - 0.5f) > 0.001f || contact.normal.distance(Vector(1, 0, 0)) > 0.001f
+        || CollisionManager::sphereSphere(first, second, separated))
+    {
+        std::cout << "Error in NarrowPhaseTest::testSphereSphere()" << std::endl;
+    }
+}
+
+void NarrowPhaseTest::testSphereBox()
+{
+    RigidBody sphere;
+    sphere.colliderRadius = 1;
+    sphere.setPosition(Vector(0, 1.5, 0));
+    Box box(2, 2, 2);
+
+    // The sphere lies 0.5 below its radius above the top face
+    Contact contact;
+    bool overlap = CollisionManager::sphereBox(sphere, box, contact);
+    if (!overlap || glm::abs(contact.penetration - 0.5f) > 0.001f || contact.normal.distance(Vector(0, -1, 0)) > 0.001f
+        || contact.point.distance(Vector(0, 1, 0)) > 0.001f)
+    {
+        std::cout << "Error in NarrowPhaseTest::testSphereBox()" << std::endl;
+    }
+}
+
+void NarrowPhaseTest::testSphereInsideBox()
+{
+    RigidBody sphere;
+    sphere.colliderRadius = 0.5;
+    sphere.setPosition(Vector(0.8, 0, 0));
+    Box box(2, 2, 2);
+
+    // Nearest face is +X, 0.2 away from the center
+    Contact contact;
+    bool overlap = CollisionManager::sphereBox(sphere, box, contact);
+    if (!overlap || glm::abs(contact.penetration - 0.7f) > 0.001f || contact.normal.distance(Vector(-1, 0, 0)) > 0.001f)
+    {
+        std::cout << "Error in NarrowPhaseTest::testSphereInsideBox()" << std::endl;
+    }
+}
+
+void NarrowPhaseTest::testBoxBoxFace()
+{
+    Box first(2, 2, 2);
+    Box second(2, 2, 2);
+    second.setPosition(Vector(0, 1.8, 0));
+
+    Contact contact;
+    bool overlap = CollisionManager::boxBox(first, second, contact);
+    second.setPosition(Vector(0, 2.1, 0));
+    Contact separated;
+
+    if (!overlap || glm::abs(contact.penetration - 0.2f) > 0.001f || contact.normal.distance(Vector(0, 1, 0)) > 0.001f
+        || CollisionManager::boxBox(first, second, separated))
+    {
+        std::cout << "Error in NarrowPhaseTest::testBoxBoxFace()" << std::endl;
+    }
+}
+
+void NarrowPhaseTest::testBoxBoxAgainstGJK()
+{
+    // The specialised kernel must agree with the generic path
+    Box first(2, 2, 2);
+    first.orientation = Quaternion(PI / 4, Vector(0, 0, 1));
+    Box second(2, 3, 1);
+    second.orientation = Quaternion(PI / 6, Vector(1, 0, 0));
+    second.setPosition(Vector(2, 0.3, 0.2));
+
+    Contact satContact;
+    Contact gjkContact;
+    bool satOverlap = CollisionManager::boxBox(first, second, satContact);
+    bool gjkOverlap = CollisionManager::convexConvex(first, second, gjkContact);
+
+    if (satOverlap != gjkOverlap || glm::abs(satContact.penetration - gjkContact.penetration) > 0.01f
+        || satContact.normal.distance(gjkContact.normal) > 0.05f)
+    {
+        std::cout << "Error in NarrowPhaseTest::testBoxBoxAgainstGJK()" << std::endl;
+    }
+}
+
+void NarrowPhaseTest::testSortByShapeType()
+{
+    RigidBody sphere;
+    Box box;
+    Cone cone;
+    std::vector<std::pair<RigidBody*, RigidBody*>> collisions;
+    collisions.emplace_back(&cone, &box);
+    collisions.emplace_back(&box, &sphere);
+    collisions.emplace_back(&box, &box);
+    collisions.emplace_back(&sphere, &box);
+
+    CollisionManager::sortByShapeType(collisions);
+
+    bool ordered = collisions[0].first == &sphere && collisions[0].second == &box
+        && collisions[1].first == &sphere && collisions[1].second == &box
+        && collisions[2].first == &box && collisions[2].second == &box
+        && collisions[3].first == &box && collisions[3].second == &cone;
+    if (!ordered || CollisionManager::getKernel(SphereShape, BoxShape) != CollisionManager::sphereBox
+        || CollisionManager::getKernel(BoxShape, ConeShape) != CollisionManager::convexConvex)
+    {
+        std::cout << "Error in NarrowPhaseTest::testSortByShapeType()" << std::endl;
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+class NarrowPhaseTest
+{
+public:
+    static void testSphereSphere();
+    static void testSphereBox();
+    static void testSphereInsideBox();
+    static void testBoxBoxFace();
+    static void testBoxBoxAgainstGJK();
+    static void testSortByShapeType();
+};
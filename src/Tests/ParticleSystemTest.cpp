@@ -0,0 +1,238 @@
+#include "ParticleSystemTest.h"
+
+#include "Particle.h"
+#include "ParticleEmitter.h"
+#include "ParticleSystem.h"
+
+void ParticleSystemTest::testIntegration()
+{
+    // Same motion as a Particle under the same gravity, integrated by RigidBody::eulerIntegration
+    Particle particle(Vector(3, 4, 0), 2, 1);
+    particle.position = Vector(10, 20, 0);
+    particle.angularVelocity = Vector(0, 0, 0);
+
+    ParticleSystem system;
+    system.collisions = false;
+    system.gravity = Vector(0, -9.81f);
+    system.add(Vector(10, 20), Vector(3, 4), 2, 1);
+    system.add(Vector(0, 0), Vector(0, 0), 0, 1);
+
+    for (int i = 0; i < 30; i++)
+    {
+        particle.addForce(Vector(0, -9.81f, 0));
+        particle.eulerIntegration(0.02f);
+        system.step(0.02f);
+    }
+    if (std::abs(system.x[0] - particle.position.x) > 1e-3 || std::abs(system.y[0] - particle.position.y) > 1e-3
+        || system.x[1] != 0 || system.y[1] != 0)
+    {
+        std::cout << "Error in ParticleSystemTest::testIntegration()" << std::endl;
+    }
+}
+
+void ParticleSystemTest::testCollision()
+{
+    // Head on collision of equal masses: the velocities are exchanged, scaled by the restitution
+    ParticleSystem system;
+    system.add(Vector(0, 0), Vector(10, 0), 1, 1);
+    system.add(Vector(1.5f, 0), Vector(-10, 0), 1, 1);
+    system.collide();
+
+    float leftVelocity = system.x[0] < system.x[1] ? system.vx[0] : system.vx[1];
+    float rightVelocity = system.x[0] < system.x[1] ? system.vx[1] : system.vx[0];
+    float distance = std::abs(system.x[1] - system.x[0]);
+    if (system.collisionCount != 1 || std::abs(leftVelocity + 10 * PARTICLE_RESTITUTION) > 1e-4
+        || std::abs(rightVelocity - 10 * PARTICLE_RESTITUTION) > 1e-4 || std::abs(distance - 2) > 1e-4)
+    {
+        std::cout << "Error in ParticleSystemTest::testCollision()" << std::endl;
+    }
+}
+
+/**
+ * @brief Count the overlapping pairs of particles by testing every pair
+ */
+static int countOverlaps(ParticleSystem& system)
+{
+    int overlaps = 0;
+    for (int i = 0; i < system.size(); i++)
+    {
+        for (int j = i + 1; j < system.size(); j++)
+        {
+            float dx = system.x[j] - system.x[i];
+            float dy = system.y[j] - system.y[i];
+            float minDistance = system.radius[i] + system.radius[j];
+            if (dx * dx + dy * dy <= minDistance * minDistance) overlaps++;
+        }
+    }
+    return overlaps;
+}
+
+void ParticleSystemTest::testGridMatchesBruteForce()
+{
+    ParticleSystem system;
+    for (int i = 0; i < 2000; i++)
+    {
+        float radius = i % 7 == 0 ? 3 : 1;
+        system.add(Vector(ofRandom(0, 200), ofRandom(0, 100)), Vector(0, 0), 0, radius);
+    }
+    system.add(Vector(5000, 5000), Vector(0, 0), 0, 1);
+
+    // Overlapping pairs of the initial positions, before any of them is pushed apart
+    int expected = countOverlaps(system);
+
+    // Immovable particles are not pushed apart, so each overlapping pair is found exactly once
+    system.collide();
+    if (system.collisionCount != expected || system.size() != 2001)
+    {
+        std::cout << "Error in ParticleSystemTest::testGridMatchesBruteForce()" << std::endl;
+    }
+}
+
+void ParticleSystemTest::testOversizedParticles()
+{
+    // Two boulders among grains: the cells stay as small as the grains, the boulders are tested on their own
+    ParticleSystem system;
+    for (int i = 0; i < 2000; i++)
+    {
+        system.add(Vector(ofRandom(0, 200), ofRandom(0, 100)), Vector(0, 0), 0, 1);
+    }
+    system.add(Vector(60, 50), Vector(0, 0), 0, 40);
+    system.add(Vector(250, 50), Vector(0, 0), 0, 20);
+    int expected = countOverlaps(system);
+
+    system.collide();
+    int oversized = system.size() - system.cellStart[system.columns * system.rows];
+    if (system.collisionCount != expected || oversized != 2 || system.cellSize > 2)
+    {
+        std::cout << "Error in ParticleSystemTest::testOversizedParticles()" << std::endl;
+    }
+}
+
+void ParticleSystemTest::testEscapedParticle()
+{
+    // Without walls a particle can go further than an int counts cells, the grid still fits the particle limit
+    ParticleSystem system;
+    for (int i = 0; i < 500; i++)
+    {
+        system.add(Vector(ofRandom(0, 100), ofRandom(0, 100)), Vector(0, 0), 0, 1);
+    }
+    system.add(Vector(1e30f, 50), Vector(0, 0), 0, 1);
+    system.add(Vector(1e30f, 51), Vector(0, 0), 0, 1);
+    system.add(Vector(-1e30f, 3e38f), Vector(0, 0), 0, 20);
+    int expected = countOverlaps(system);
+
+    system.collide();
+    long long cells = static_cast<long long>(system.columns) * system.rows;
+    if (system.collisionCount != expected || system.columns < 1 || system.rows < 1
+        || cells > MAX_CELLS_PER_PARTICLE * system.size())
+    {
+        std::cout << "Error in ParticleSystemTest::testEscapedParticle()" << std::endl;
+    }
+}
+
+void ParticleSystemTest::testThreadCount()
+{
+    // Enough particles for the kernels to run in parallel, the result must not depend on the thread count
+    ParticleSystem single;
+    ParticleSystem parallel;
+    single.threadCount = 1;
+    parallel.threadCount = 4;
+    for (ParticleSystem* system : {&single, &parallel})
+    {
+        system->gravity = Vector(0, -9.81f);
+        system->friction = 0.5f;
+        system->width = system->height = 400;
+        for (int i = 0; i < 2 * PARALLEL_MIN_PARTICLES; i++)
+        {
+            system->add(Vector(i % 100 * 4 + 2, i / 100 * 2 + 2), Vector(i % 13 - 6, i % 7 - 3), 1, 1);
+        }
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        single.step(0.02f);
+        parallel.step(0.02f);
+    }
+    single.updateColors(ofGetWidth(), ofGetHeight());
+    parallel.updateColors(ofGetWidth(), ofGetHeight());
+
+    if (single.x != parallel.x || single.vy != parallel.vy || single.green != parallel.green
+        || single.collisionCount != parallel.collisionCount)
+    {
+        std::cout << "Error in ParticleSystemTest::testThreadCount()" << std::endl;
+        return;
+    }
+
+    // Same colors as a Particle at the same place
+    Particle particle;
+    particle.position = Vector(single.x[0], single.y[0], 0);
+    particle.updateColor();
+    if (std::abs(particle.color[0] - single.red[0]) > 1 || std::abs(particle.color[1] - single.green[0]) > 1
+        || std::abs(particle.color[2] - single.blue[0]) > 1)
+    {
+        std::cout << "Error in ParticleSystemTest::testThreadCount()" << std::endl;
+    }
+}
+
+void ParticleSystemTest::testEmitterPool()
+{
+    ParticleSystem system;
+    system.collisions = false;
+    system.reserve(100);
+    const float* storage = system.x.data();
+
+    // 60 particles per second living half a second: about 30 alive at any time
+    ParticleEmitter emitter(Vector(0, 0), 60, 0.5f, 5, 10);
+    emitter.spread = PI;
+    int emitted = 0;
+    for (int i = 0; i < 120; i++)
+    {
+        emitted += emitter.emit(system, 1.0f / 60.0f);
+        system.step(1.0f / 60.0f);
+    }
+    bool aged = true;
+    for (int i = 0; i < system.size(); i++)
+    {
+        aged = aged && system.time[i] < system.lifetime[i];
+    }
+    if (emitted < 119 || emitted > 120 || system.size() < 29 || system.size() > 31 || !aged || system.x.data() != storage)
+    {
+        std::cout << "Error in ParticleSystemTest::testEmitterPool()" << std::endl;
+        return;
+    }
+
+    // A full pool drops the extra particles
+    emitter.rate = 6000;
+    emitter.lifetime = 0;
+    int alive = system.size();
+    emitted = emitter.emit(system, 1);
+    if (system.size() != 100 || emitted != 100 - alive || system.add(Vector(0, 0), Vector(0, 0), 1, 1) != -1 || system.x.data() != storage)
+    {
+        std::cout << "Error in ParticleSystemTest::testEmitterPool()" << std::endl;
+    }
+}
+
+void ParticleSystemTest::testCollidingPool()
+{
+    // Colliding particles reorder every array by cell at each step, with the scratch reserved nothing grows
+    ParticleSystem system;
+    system.reserve(500);
+    system.width = system.height = 100;
+    system.gravity = Vector(0, -9.81f);
+    for (int i = 0; i < 500; i++)
+    {
+        system.add(Vector(ofRandom(5, 95), ofRandom(5, 95)), Vector(ofRandom(-20, 20), ofRandom(-20, 20)), 1, 1.5f);
+    }
+    size_t allocated = system.getAllocatedBytes();
+    const int* grid = system.cellStart.data();
+
+    int collisions = 0;
+    for (int i = 0; i < 120; i++)
+    {
+        system.step(1.0f / 60.0f);
+        collisions += system.collisionCount;
+    }
+    if (collisions == 0 || system.getAllocatedBytes() != allocated || system.cellStart.data() != grid)
+    {
+        std::cout << "Error in ParticleSystemTest::testCollidingPool()" << std::endl;
+    }
+}
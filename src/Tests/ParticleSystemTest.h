@@ -0,0 +1,14 @@
+#pragma once
+
+class ParticleSystemTest
+{
+public:
+    static void testIntegration();
+    static void testCollision();
+    static void testGridMatchesBruteForce();
+    static void testOversizedParticles();
+    static void testEscapedParticle();
+    static void testThreadCount();
+    static void testEmitterPool();
+    static void testCollidingPool();
+};
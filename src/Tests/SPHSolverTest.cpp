@@ -0,0 +1,96 @@
+#include "SPHSolverTest.h"
+
+#include <algorithm>
+
+#include "SPHSolver.h"
+
+void SPHSolverTest::testNeighbours()
+{
+    ParticleSystem system;
+    for (int i = 0; i < 3000; i++)
+    {
+        system.add(Vector(ofRandom(0, 300), ofRandom(0, 200)), Vector(0, 0), 1, 1);
+    }
+    SPHSolver solver;
+    solver.buildNeighbours(system);
+
+    // Same neighbours as a brute force search, on the reordered particles
+    for (int i = 0; i < system.size(); i += 37)
+    {
+        std::vector<int> expected;
+        for (int j = 0; j < system.size(); j++)
+        {
+            float dx = system.x[j] - system.x[i];
+            float dy = system.y[j] - system.y[i];
+            if (j != i && dx * dx + dy * dy < solver.smoothingRadius * solver.smoothingRadius) expected.push_back(j);
+        }
+        std::vector<int> found(solver.neighbours.begin() + solver.neighbourStart[i],
+                               solver.neighbours.begin() + solver.neighbourStart[i + 1]);
+        std::sort(found.begin(), found.end());
+        if (found != expected)
+        {
+            std::cout << "Error in SPHSolverTest::testNeighbours()" << std::endl;
+            return;
+        }
+    }
+}
+
+void SPHSolverTest::testDensity()
+{
+    // A lone particle only weighs itself
+    ParticleSystem system;
+    system.add(Vector(0, 0), Vector(0, 0), 1, 1);
+    system.add(Vector(1000, 0), Vector(0, 0), 1, 1);
+    SPHSolver solver;
+    solver.apply(system, 0);
+    float h = solver.smoothingRadius;
+    float alone = solver.particleMass * 4 / (PI * std::pow(h, 2.0f));
+    if (std::abs(solver.density[0] - alone) > alone * 1e-4 || std::abs(solver.density[1] - alone) > alone * 1e-4)
+    {
+        std::cout << "Error in SPHSolverTest::testDensity()" << std::endl;
+        return;
+    }
+
+    // Inside a dense lattice, the density grows with the number of neighbours
+    ParticleSystem lattice;
+    for (int i = 0; i < 400; i++)
+    {
+        lattice.add(Vector(i % 20 * h / 4, i / 20 * h / 4), Vector(0, 0), 1, 1);
+    }
+    solver.apply(lattice, 0);
+    float corner = 0;
+    float center = 0;
+    for (int i = 0; i < lattice.size(); i++)
+    {
+        if (lattice.x[i] == 0 && lattice.y[i] == 0) corner = solver.density[i];
+        if (lattice.x[i] == 10 * h / 4 && lattice.y[i] == 10 * h / 4) center = solver.density[i];
+    }
+    if (corner <= alone || center <= 2 * corner)
+    {
+        std::cout << "Error in SPHSolverTest::testDensity()" << std::endl;
+    }
+}
+
+void SPHSolverTest::testPressure()
+{
+    // Two particles compressed above the rest density are pushed apart, with opposite velocity changes
+    SPHSolver solver;
+    solver.restDensity = 0;
+    solver.viscosity = 0;
+    ParticleSystem system;
+    system.collisions = false;
+    system.fluid = &solver;
+    system.add(Vector(0, 0), Vector(0, 0), 1, 1);
+    system.add(Vector(4, 3), Vector(0, 0), 1, 1);
+    system.add(Vector(100, 100), Vector(0, 0), 0, 1);
+    system.step(0.01f);
+
+    int left = system.x[0] < system.x[1] ? 0 : 1;
+    int right = 1 - left;
+    if (system.x[left] > system.x[right] || system.vx[left] >= 0 || system.vy[left] >= 0
+        || std::abs(system.vx[left] + system.vx[right]) > 1e-4 || std::abs(system.vy[left] + system.vy[right]) > 1e-4
+        || std::abs(system.vx[left] * 3 - system.vy[left] * 4) > 1e-3)
+    {
+        std::cout << "Error in SPHSolverTest::testPressure()" << std::endl;
+    }
+}
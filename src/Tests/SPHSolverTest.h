@@ -0,0 +1,9 @@
+#pragma once
+
+class SPHSolverTest
+{
+public:
+    static void testNeighbours();
+    static void testDensity();
+    static void testPressure();
+};
@@ -0,0 +1,146 @@
+#include "SceneLoaderTest.h"
+
+#include "Box.h"
+#include "Material.h"
+#include "SceneLoader.h"
+
+void SceneLoaderTest::testBodiesAndMaterials()
+{
+    PhysicsWorld world(250);
+    world.addBody(new Box(1, 1, 1));
+    ofJson scene = ofJson::parse(R"({
+        "settings": {"gravity": true, "aabbTree": true},
+        "materials": {"heavy": {"mass": 4, "color": [10, 20, 30], "continuousCollision": true}},
+        "bodies": [
+            {"shape": "box", "size": [2, 4, 6], "position": [1, 2, 3], "material": "heavy"},
+            {"shape": "cone", "radius": 3, "height": 5, "velocity": [0, 7, 0],
+             "grid": {"count": [2, 1, 3], "spacing": [10, 0, 20]}}
+        ]
+    })");
+
+    bool valid = SceneLoader::load(world, scene) && world.bodies.size() == 7 && world.gravity && world.useAABBTree;
+    if (valid)
+    {
+        Shape* heavy = world.bodies[0];
+        Shape* lastCone = world.bodies[6];
+        // A box of mass 4 has 4 times the inertia of the unit mass one
+        Box reference(2, 4, 6);
+        valid = heavy->id == 0 && heavy->getMass() == 4 && heavy->color[1] == 20 && heavy->continuousCollision
+            && heavy->position.y == 2 && std::abs(heavy->tenseurJ.l1.x - 4 * reference.tenseurJ.l1.x) < 0.001f
+            && lastCone->shapeType == ConeShape && lastCone->id == 6 && lastCone->linearVelocity.y == 7
+            && lastCone->position.x == 10 && lastCone->position.z == 40
+            && world.aabbTree.getLeafCount() == 7;
+    }
+
+    if (!valid)
+    {
+        std::cout << "Error in SceneLoaderTest::testBodiesAndMaterials()" << std::endl;
+    }
+}
+
+void SceneLoaderTest::testSpringsAndForces()
+{
+    PhysicsWorld world(250);
+    ofJson scene = ofJson::parse(R"({
+        "bodies": [
+            {"shape": "box", "size": [2, 2, 2], "position": [-50, 0, 0]},
+            {"shape": "box", "size": [2, 2, 2], "position": [50, 0, 0]},
+            {"shape": "box", "size": [2, 2, 2], "position": [0, 100, 0]}
+        ],
+        "forces": [{"type": "gravity", "vector": [0, -10, 0], "bodies": [2]}],
+        "springs": [{"bodies": [0, 1], "k": 2, "length": 60}],
+        "joints": [{"type": "ballSocket", "bodies": [2], "anchor": [10, 100, 0]}]
+    })");
+
+    bool loaded = SceneLoader::load(world, scene);
+    for (int i = 0; loaded && i < 10; i++) world.step(FIXED_TIME_STEP);
+
+    // The spring is stretched, the ends get closer, only the third body falls, held by its joint
+    bool valid = loaded && world.sceneForces.size() == 3 && world.bodies[0]->position.x > -50
+        && world.bodies[1]->position.x < 50 && world.bodies[2]->position.y < 100
+        && world.bodies[0]->position.y == 0 && world.jointSolver.joints.size() == 1
+        && world.jointSolver.getMaxError() < 0.5f;
+
+    if (!valid)
+    {
+        std::cout << "Error in SceneLoaderTest::testSpringsAndForces()" << std::endl;
+    }
+}
+
+void SceneLoaderTest::testInvalidScene()
+{
+    // A bad scene must leave the world and the material table untouched
+    PhysicsWorld world(250);
+    world.addBody(new Box(1, 1, 1));
+    int materialCount = MaterialTable::size();
+    const char* scenes[] = {
+        R"({"materials": {"unused": {"restitution": 0.123}}, "bodies": [{"shape": "torus", "material": "unused"}]})",
+        R"({"bodies": [{"shape": "torus"}]})",
+        R"({"bodies": [{"shape": "box", "material": "missing"}]})",
+        R"({"bodies": [{"shape": "box"}], "springs": [{"bodies": [0, 3]}]})",
+        R"({"bodies": [{"shape": "box"}], "joints": [{"type": "rope", "bodies": [0]}]})",
+        R"({"bodies": [{"size": [1, 1, 1]}]})",
+        R"({"bodies": [{"shape": "box", "grid": {"count": [2, -1, 2]}}]})",
+        R"({"bodies": [{"shape": "box", "grid": {"count": [1.5, 1, 1]}}]})",
+        R"({"bodies": [{"shape": "box", "grid": {"count": [0, 1, 1]}}]})",
+        R"({"bodies": [{"shape": "box", "grid": {"count": [1e20, 1e20, 1]}}]})",
+        R"([1, 2, 3])"};
+
+    bool rejected = !SceneLoader::loadFile(world, "missing_scene.json");
+    for (const char* scene : scenes)
+    {
+        rejected = rejected && !SceneLoader::load(world, ofJson::parse(scene));
+    }
+
+    if (!rejected || world.bodies.size() != 1 || MaterialTable::size() != materialCount)
+    {
+        std::cout << "Error in SceneLoaderTest::testInvalidScene()" << std::endl;
+    }
+}
+
+void SceneLoaderTest::testBulkBuild()
+{
+    // The tree built in one pass must find the same pairs as the incremental one
+    PhysicsWorld bulk(250);
+    ofJson scene = ofJson::parse(R"({
+        "bodies": [{"shape": "box", "size": [10, 10, 10], "position": [-100, -100, -100],
+                    "grid": {"count": [8, 8, 8], "spacing": [9, 9, 9]}}]
+    })");
+    SceneLoader::load(bulk, scene);
+
+    AABBTree incremental;
+    for (auto body : bulk.bodies)
+    {
+        incremental.insert(body);
+    }
+    auto expected = incremental.getCollisions();
+    incremental.clear();
+    for (auto body : bulk.bodies)
+    {
+        bulk.aabbTree.remove(body);
+    }
+    std::vector<RigidBody*> objects(bulk.bodies.begin(), bulk.bodies.end());
+    bulk.aabbTree.build(objects);
+    auto found = bulk.aabbTree.getCollisions();
+
+    auto normalize = [](std::vector<std::pair<RigidBody*, RigidBody*>>& pairs)
+    {
+        for (auto& pair : pairs)
+        {
+            if (pair.first->id > pair.second->id) std::swap(pair.first, pair.second);
+        }
+        std::sort(pairs.begin(), pairs.end(), [](const std::pair<RigidBody*, RigidBody*>& a,
+                                                 const std::pair<RigidBody*, RigidBody*>& b)
+        {
+            return a.first->id != b.first->id ? a.first->id < b.first->id : a.second->id < b.second->id;
+        });
+    };
+    normalize(expected);
+    normalize(found);
+
+    // A balanced tree over 512 leaves
+    if (expected.empty() || found != expected || bulk.aabbTree.getHeight() > 10)
+    {
+        std::cout << "Error in SceneLoaderTest::testBulkBuild()" << std::endl;
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+class SceneLoaderTest
+{
+public:
+    static void testBodiesAndMaterials();
+    static void testSpringsAndForces();
+    static void testInvalidScene();
+    static void testBulkBuild();
+};
@@ -0,0 +1,127 @@
+#include "SimulationThreadTest.h"
+
+#include <chrono>
+#include <thread>
+
+#include "Box.h"
+#include "SimulationThread.h"
+
+void SimulationThreadTest::testTripleBuffer()
+{
+    RenderBuffer buffer;
+    if (buffer.acquire())
+    {
+        std::cout << "Error in SimulationThreadTest::testTripleBuffer()" << std::endl;
+        return;
+    }
+
+    // Two frames published before the renderer looks, only the latest one is taken
+    for (int step = 1; step <= 2; step++)
+    {
+        buffer.getWriteFrame().stepCount = step;
+        buffer.publish();
+    }
+    if (!buffer.acquire() || buffer.getCurrent().stepCount != 2 || buffer.acquire())
+    {
+        std::cout << "Error in SimulationThreadTest::testTripleBuffer()" << std::endl;
+        return;
+    }
+
+    buffer.getWriteFrame().stepCount = 3;
+    buffer.publish();
+    if (!buffer.acquire() || buffer.getCurrent().stepCount != 3 || buffer.getPrevious().stepCount != 2)
+    {
+        std::cout << "Error in SimulationThreadTest::testTripleBuffer()" << std::endl;
+    }
+}
+
+void SimulationThreadTest::testInterpolation()
+{
+    RenderBody previous;
+    previous.position = Vector(0, 0, 0);
+    previous.orientation = Quaternion(1, 0, 0, 0);
+    RenderBody current;
+    current.position = Vector(10, 20, 0);
+    // Same rotation as the identity, on the other side of the sphere
+    current.orientation = Quaternion(-1, 0, 0, 0);
+
+    RenderBody blended = RenderFrame::interpolate(previous, current, 0.5f);
+    Vector expected = Vector(5, 10, 0);
+    if ((blended.position - expected).magnitude() > 1e-4 || std::abs(std::abs(blended.orientation.w) - 1) > 1e-4)
+    {
+        std::cout << "Error in SimulationThreadTest::testInterpolation()" << std::endl;
+        return;
+    }
+
+    // A quarter turn around y, half of it gives an eighth of a turn
+    current.orientation = Quaternion(std::cos(PI / 4), 0, std::sin(PI / 4), 0);
+    blended = RenderFrame::interpolate(previous, current, 0.5f);
+    if (std::abs(blended.orientation.w - std::cos(PI / 8)) > 1e-4
+        || std::abs(blended.orientation.y - std::sin(PI / 8)) > 1e-4)
+    {
+        std::cout << "Error in SimulationThreadTest::testInterpolation()" << std::endl;
+    }
+}
+
+void SimulationThreadTest::testThreadSteps()
+{
+    PhysicsWorld world(250);
+    world.addBody(new Box(10, 10, 10, Vector(0, 0, 0)));
+    world.bodies.back()->linearVelocity = Vector(30, 0, 0);
+
+    SimulationThread simulation(world);
+    simulation.speed = 4;
+    simulation.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    {
+        // Inputs are applied between two steps
+        std::lock_guard<std::mutex> lock(simulation.worldMutex);
+        world.addBody(new Box(10, 10, 10, Vector(100, 0, 0)));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    simulation.stop();
+
+    simulation.renderBuffer.acquire();
+    const RenderFrame& frame = simulation.renderBuffer.getCurrent();
+    if (simulation.isRunning() || world.stepCount == 0 || frame.stepCount != world.stepCount
+        || frame.bodies.size() != 2 || frame.bodies[0].position.x <= 0)
+    {
+        std::cout << "Error in SimulationThreadTest::testThreadSteps()" << std::endl;
+    }
+}
+
+/**
+ * @brief Run a world with a body moving at 1 on its thread, blocked for a while in the middle
+ * @return The simulated time, from the distance of the body, over the time of the steps at FIXED_TIME_STEP
+ */
+static float simulatedOverFixed(bool deterministic)
+{
+    PhysicsWorld world(250);
+    world.deterministic = deterministic;
+    world.addBody(new Box(10, 10, 10, Vector(0, 0, 0)));
+    world.bodies.back()->linearVelocity = Vector(1, 0, 0);
+    world.bodies.back()->angularVelocity = Vector(0, 0, 0);
+
+    SimulationThread simulation(world);
+    simulation.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        // Longer than MAX_STEPS_PER_FRAME steps, the thread drops the late steps
+        std::lock_guard<std::mutex> lock(simulation.worldMutex);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    simulation.stop();
+    return world.bodies.back()->position.x / (world.stepCount * FIXED_TIME_STEP);
+}
+
+void SimulationThreadTest::testRealTimeSteps()
+{
+    // Deterministic worlds catch up the blocked time with fixed steps, the others with a single longer step
+    float fixed = simulatedOverFixed(true);
+    float realTime = simulatedOverFixed(false);
+    if (std::abs(fixed - 1) > 1e-3f || realTime < 1.1f)
+    {
+        std::cout << "Error in SimulationThreadTest::testRealTimeSteps()" << std::endl;
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+class SimulationThreadTest
+{
+public:
+    static void testTripleBuffer();
+    static void testInterpolation();
+    static void testThreadSteps();
+    static void testRealTimeSteps();
+};
@@ -0,0 +1,419 @@
+#include "SnapshotTest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "Box.h"
+#include "Compound.h"
+#include "Cone.h"
+#include "ConvexHull.h"
+#include "Material.h"
+#include "SceneLoader.h"
+#include "Snapshot.h"
+
+/**
+ * @brief Fill a world with falling bodies of both shapes
+ */
+static void buildScene(PhysicsWorld& world)
+{
+    world.deterministic = true;
+    world.gravity = true;
+    world.staticWorld.addPlane(new StaticPlane(Vector(0, 1, 0), -world.arenaSize));
+    world.staticWorld.build();
+    for (int i = 0; i < 8; i++)
+    {
+        Shape* body;
+        if (i % 2 == 0) body = new Cone(20, 30, Vector(i * 11 - 40, i * 25 - 80, 0));
+        else body = new Box(30, 20, 25, Vector(i * 9 - 30, i * 30 - 100, 10));
+        body->linearVelocity = Vector(i % 3 * 10 - 10, -20, 5);
+        body->continuousCollision = i == 3;
+        body->charge = i - 4.0f;
+        world.addBody(body);
+    }
+}
+
+static bool sameState(PhysicsWorld& first, PhysicsWorld& second)
+{
+    if (first.bodies.size() != second.bodies.size()) return false;
+    for (size_t i = 0; i < first.bodies.size(); i++)
+    {
+        Shape* a = first.bodies[i];
+        Shape* b = second.bodies[i];
+        if (a->id != b->id || a->shapeType != b->shapeType || a->continuousCollision != b->continuousCollision
+            || a->charge != b->charge
+            || std::memcmp(&a->position, &b->position, sizeof(Vector)) != 0
+            || std::memcmp(&a->linearVelocity, &b->linearVelocity, sizeof(Vector)) != 0
+            || std::memcmp(&a->angularVelocity, &b->angularVelocity, sizeof(Vector)) != 0
+            || std::memcmp(&a->orientation, &b->orientation, sizeof(Quaternion)) != 0)
+        {
+            return false;
+        }
+    }
+    return first.stepCount == second.stepCount;
+}
+
+void SnapshotTest::testRoundTrip()
+{
+    // A restored world must continue exactly like the one that was saved
+    const std::string path = "snapshot_test.bin";
+    PhysicsWorld original(250);
+    buildScene(original);
+    for (int i = 0; i < 60; i++) original.step(FIXED_TIME_STEP);
+
+    PhysicsWorld restored(250);
+    restored.staticWorld.addPlane(new StaticPlane(Vector(0, 1, 0), -restored.arenaSize));
+    restored.staticWorld.build();
+    bool loaded = Snapshot::save(original, path) && Snapshot::load(restored, path);
+    std::remove(path.c_str());
+
+    bool identical = loaded && sameState(original, restored) && restored.gravity && restored.deterministic;
+    for (int i = 0; identical && i < 120; i++)
+    {
+        original.step(FIXED_TIME_STEP);
+        restored.step(FIXED_TIME_STEP);
+        identical = sameState(original, restored);
+    }
+
+    // New bodies must not reuse a restored id
+    Box* added = new Box(1, 1, 1);
+    restored.addBody(added);
+
+    if (!identical || added->id != 8)
+    {
+        std::cout << "Error in SnapshotTest::testRoundTrip()" << std::endl;
+    }
+}
+
+void SnapshotTest::testInvalidData()
+{
+    // Garbage and truncated snapshots must leave the world untouched
+    PhysicsWorld world(250);
+    world.addBody(new Box(1, 1, 1));
+    std::vector<uint32_t> garbage(64, 0xDEADBEEF);
+
+    SnapshotHeader header = {};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.bodyCount = 1000;
+
+    bool rejected = !Snapshot::load(world, reinterpret_cast<const char*>(garbage.data()), garbage.size() * 4)
+        && !Snapshot::load(world, reinterpret_cast<const char*>(&header), sizeof(header))
+        && !Snapshot::load(world, "missing_snapshot.bin");
+
+    if (!rejected || world.bodies.size() != 1)
+    {
+        std::cout << "Error in SnapshotTest::testInvalidData()" << std::endl;
+    }
+}
+
+void SnapshotTest::testWrongVersion()
+{
+    PhysicsWorld world(250);
+    world.addBody(new Box(1, 1, 1));
+
+    SnapshotHeader header = {};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION + 1;
+
+    if (Snapshot::load(world, reinterpret_cast<const char*>(&header), sizeof(header)) || world.bodies.size() != 1)
+    {
+        std::cout << "Error in SnapshotTest::testWrongVersion()" << std::endl;
+    }
+}
+
+/**
+ * @brief A generator the snapshots do not know
+ */
+class PushGenerator : public ForceGenerator
+{
+public:
+    void updateForce(RigidBody* object, float duration) override
+    {
+        object->addForce(Vector(1, 0, 0));
+    }
+};
+
+void SnapshotTest::testSceneForces()
+{
+    // Every generator of a scene and the bodies it applies to are restored, the world goes on identically
+    const std::string path = "snapshot_forces_test.bin";
+    ofJson scene = ofJson::parse(R"({
+        "settings": {"deterministic": true, "collisions": false},
+        "materials": {"charged": {"charge": 2}},
+        "bodies": [
+            {"shape": "box", "size": [10, 10, 10], "position": [0, 0, 0]},
+            {"shape": "cone", "radius": 5, "height": 10, "position": [60, 0, 0], "material": "charged"},
+            {"shape": "box", "size": [10, 10, 10], "position": [0, 80, 0], "material": "charged"}
+        ],
+        "forces": [{"type": "gravity", "vector": [0, -2, 0], "bodies": [0, 1]}, {"type": "friction", "k": 0.2},
+                   {"type": "mutualGravity", "G": 50, "openingAngle": 0.3, "softening": 2},
+                   {"type": "electrostatic", "k": 30, "bodies": [1, 2]}],
+        "springs": [{"bodies": [0, 1], "k": 3, "length": 50, "damping": 0.5}],
+        "rods": [{"bodies": [0, 2]}]
+    })");
+    PhysicsWorld original(250);
+    bool valid = SceneLoader::load(original, scene);
+    for (int i = 0; i < 30; i++) original.step(FIXED_TIME_STEP);
+
+    PhysicsWorld restored(250);
+    valid = valid && Snapshot::save(original, path) && Snapshot::load(restored, path)
+        && restored.generators.size() == original.generators.size()
+        && restored.sceneForces.size() == original.sceneForces.size();
+    std::remove(path.c_str());
+    for (int i = 0; valid && i < 60; i++)
+    {
+        original.step(FIXED_TIME_STEP);
+        restored.step(FIXED_TIME_STEP);
+        valid = sameState(original, restored);
+    }
+
+    // A generator without format can not be saved, and the file is not written
+    PhysicsWorld custom(250);
+    Box* pushed = new Box(1, 1, 1);
+    custom.addBody(pushed);
+    custom.addGenerator(new PushGenerator());
+    custom.addForce(pushed, custom.generators.back());
+    bool saved = Snapshot::save(custom, path);
+    std::ifstream written(path);
+    bool created = written.good();
+    written.close();
+    std::remove(path.c_str());
+
+    if (!valid || saved || created)
+    {
+        std::cout << "Error in SnapshotTest::testSceneForces()" << std::endl;
+    }
+}
+
+void SnapshotTest::testJoints()
+{
+    // The joints keep the rest pose they were built with and their impulses, the world goes on identically
+    const std::string path = "snapshot_joints_test.bin";
+    ofJson scene = ofJson::parse(R"({
+        "settings": {"deterministic": true, "gravity": true, "collisions": false},
+        "bodies": [
+            {"shape": "box", "size": [10, 10, 10], "position": [0, 0, 0], "angularVelocity": [0, 0, 0]},
+            {"shape": "box", "size": [10, 10, 10], "position": [15, 0, 0], "angularVelocity": [0, 0, 0]},
+            {"shape": "cone", "radius": 5, "height": 10, "position": [30, 0, 0], "angularVelocity": [0, 0, 0]},
+            {"shape": "box", "size": [10, 10, 10], "position": [0, -40, 0], "angularVelocity": [0, 0, 0]}
+        ],
+        "joints": [{"type": "ballSocket", "bodies": [0], "anchor": [-5, 5, 0]},
+                   {"type": "hinge", "bodies": [0, 1], "anchor": [7, 0, 0], "axis": [0, 0, 1]},
+                   {"type": "fixed", "bodies": [1, 2]},
+                   {"type": "slider", "bodies": [0, 3], "axis": [0, 1, 0]}]
+    })");
+    PhysicsWorld original(250);
+    bool valid = SceneLoader::load(original, scene);
+    for (int i = 0; i < 30; i++) original.step(FIXED_TIME_STEP);
+
+    PhysicsWorld restored(250);
+    valid = valid && Snapshot::save(original, path) && Snapshot::load(restored, path)
+        && restored.jointSolver.joints.size() == 4;
+    std::remove(path.c_str());
+    for (size_t i = 0; valid && i < 4; i++)
+    {
+        Joint* saved = original.jointSolver.joints[i];
+        Joint* loaded = restored.jointSolver.joints[i];
+        valid = saved->jointType == loaded->jointType && loaded->first->id == saved->first->id
+            && (saved->second == nullptr) == (loaded->second == nullptr)
+            && loaded->rows.back().impulse == saved->rows.back().impulse && loaded->getError() == saved->getError();
+    }
+    for (int i = 0; valid && i < 60; i++)
+    {
+        original.step(FIXED_TIME_STEP);
+        restored.step(FIXED_TIME_STEP);
+        valid = sameState(original, restored);
+    }
+
+    if (!valid)
+    {
+        std::cout << "Error in SnapshotTest::testJoints()" << std::endl;
+    }
+}
+
+/**
+ * @brief Read a whole file into words, so that its records can be changed in place
+ */
+static std::vector<uint32_t> readWords(const std::string& path, size_t& size)
+{
+    std::vector<char> data;
+    {
+        std::ifstream file(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    std::vector<uint32_t> aligned((data.size() + 3) / 4);
+    std::memcpy(aligned.data(), data.data(), data.size());
+    size = data.size();
+    return aligned;
+}
+
+void SnapshotTest::testCompound()
+{
+    // A compound keeps its children, their poses and materials, down to the nested ones
+    const std::string path = "snapshot_compound_test.bin";
+    ofJson scene = ofJson::parse(R"({
+        "settings": {"deterministic": true, "gravity": true},
+        "materials": {"dense": {"density": 4, "color": [10, 20, 30]}},
+        "bodies": [
+            {"shape": "box", "size": [200, 10, 200], "position": [0, -60, 0], "material": "dense"},
+            {"shape": "compound", "position": [0, 0, 0], "angularVelocity": [0, 1, 0], "children": [
+                {"shape": "box", "size": [40, 10, 10]},
+                {"shape": "cone", "radius": 5, "height": 20, "offset": [20, 15, 0], "material": "dense"},
+                {"shape": "compound", "offset": [-20, 0, 0], "orientation": [0.7071, 0, 0, 0.7071], "children": [
+                    {"shape": "box", "size": [5, 5, 5], "offset": [0, 10, 0]}]}]}
+        ]
+    })");
+    PhysicsWorld original(250);
+    bool valid = SceneLoader::load(original, scene);
+    original.bodies[0]->setMass(0);
+    for (int i = 0; i < 30; i++) original.step(FIXED_TIME_STEP);
+
+    PhysicsWorld restored(250);
+    valid = valid && Snapshot::save(original, path) && Snapshot::load(restored, path)
+        && restored.bodies[1]->shapeType == CompoundShape;
+    if (valid)
+    {
+        Compound* saved = static_cast<Compound*>(original.bodies[1]);
+        Compound* loaded = static_cast<Compound*>(restored.bodies[1]);
+        valid = loaded->children.size() == 3 && loaded->children[2].shape->shapeType == CompoundShape
+            && static_cast<Compound*>(loaded->children[2].shape)->children.size() == 1
+            && loaded->children[1].shape->material == saved->children[1].shape->material
+            && loaded->children[1].shape->color[2] == 30
+            && std::memcmp(&loaded->children[2].orientation, &saved->children[2].orientation, sizeof(Quaternion)) == 0
+            && std::memcmp(&loaded->children[1].shape->position, &saved->children[1].shape->position,
+                           sizeof(Vector)) == 0;
+    }
+    for (int i = 0; valid && i < 60; i++)
+    {
+        original.step(FIXED_TIME_STEP);
+        restored.step(FIXED_TIME_STEP);
+        valid = sameState(original, restored);
+    }
+
+    // A child claimed by two compounds, or a compound among its own children, is rejected
+    size_t size;
+    std::vector<uint32_t> data = readWords(path, size);
+    std::remove(path.c_str());
+    auto header = reinterpret_cast<SnapshotHeader*>(data.data());
+    auto shapes = reinterpret_cast<SnapshotShape*>(reinterpret_cast<char*>(data.data()) + sizeof(SnapshotHeader)
+                                                   + header->materialCount * sizeof(SnapshotMaterial)
+                                                   + header->bodyCount * sizeof(SnapshotBody));
+    // The records are the box, the compound, its three children, then the child of the nested compound
+    PhysicsWorld corrupted(250);
+    valid = valid && header->shapeCount == 6 && shapes[1].count == 3 && shapes[4].type == CompoundShape;
+    shapes[1].count = 4;
+    valid = valid && !Snapshot::load(corrupted, reinterpret_cast<const char*>(data.data()), size);
+    shapes[1].count = 3;
+    shapes[4].first = 4;
+    valid = valid && !Snapshot::load(corrupted, reinterpret_cast<const char*>(data.data()), size)
+        && corrupted.bodies.empty();
+
+    if (!valid)
+    {
+        std::cout << "Error in SnapshotTest::testCompound()" << std::endl;
+    }
+}
+
+void SnapshotTest::testHull()
+{
+    // A hull keeps its vertices and cloud origin, alone or as a child, so that it moves exactly as before
+    const std::string path = "snapshot_hull_test.bin";
+    ofJson scene = ofJson::parse(R"({
+        "settings": {"deterministic": true, "gravity": true},
+        "bodies": [
+            {"shape": "box", "size": [200, 10, 200], "position": [0, -60, 0]},
+            {"shape": "hull", "position": [-30, 0, 0], "angularVelocity": [1, 0, 0],
+             "points": [[0, 0, 0], [20, 0, 0], [0, 20, 0], [0, 0, 20], [10, 10, 10]]},
+            {"shape": "compound", "position": [30, 0, 0], "children": [
+                {"shape": "box", "size": [20, 10, 10]},
+                {"shape": "hull", "offset": [0, 10, 0],
+                 "points": [[-5, 0, -5], [5, 0, -5], [5, 0, 5], [-5, 0, 5], [0, 12, 0]]}]}
+        ]
+    })");
+    PhysicsWorld original(250);
+    bool valid = SceneLoader::load(original, scene);
+    original.bodies[0]->setMass(0);
+    for (int i = 0; i < 20; i++) original.step(FIXED_TIME_STEP);
+
+    PhysicsWorld restored(250);
+    valid = valid && Snapshot::save(original, path) && Snapshot::load(restored, path)
+        && restored.bodies[1]->shapeType == ConvexHullShape && restored.bodies[2]->shapeType == CompoundShape;
+    if (valid)
+    {
+        ConvexHull* saved = static_cast<ConvexHull*>(original.bodies[1]);
+        ConvexHull* loaded = static_cast<ConvexHull*>(restored.bodies[1]);
+        Shape* child = static_cast<Compound*>(restored.bodies[2])->children[1].shape;
+        valid = loaded->isValid() && loaded->vertices.size() == saved->vertices.size()
+            && std::memcmp(loaded->vertices.data(), saved->vertices.data(), saved->vertices.size() * sizeof(Vector))
+                == 0
+            && std::memcmp(&loaded->cloudOrigin, &saved->cloudOrigin, sizeof(Vector)) == 0
+            && child->shapeType == ConvexHullShape && static_cast<ConvexHull*>(child)->vertices.size() == 5;
+    }
+    for (int i = 0; valid && i < 60; i++)
+    {
+        original.step(FIXED_TIME_STEP);
+        restored.step(FIXED_TIME_STEP);
+        valid = sameState(original, restored);
+    }
+
+    // Vertices past the end of the file are rejected
+    size_t size;
+    std::vector<uint32_t> data = readWords(path, size);
+    std::remove(path.c_str());
+    auto header = reinterpret_cast<SnapshotHeader*>(data.data());
+    auto shapes = reinterpret_cast<SnapshotShape*>(reinterpret_cast<char*>(data.data()) + sizeof(SnapshotHeader)
+                                                   + header->materialCount * sizeof(SnapshotMaterial)
+                                                   + header->bodyCount * sizeof(SnapshotBody));
+    PhysicsWorld corrupted(250);
+    valid = valid && header->vertexCount == 10 && shapes[1].type == ConvexHullShape && shapes[1].count == 5;
+    shapes[1].first = 6;
+    valid = valid && !Snapshot::load(corrupted, reinterpret_cast<const char*>(data.data()), size)
+        && corrupted.bodies.empty();
+
+    if (!valid)
+    {
+        std::cout << "Error in SnapshotTest::testHull()" << std::endl;
+    }
+}
+
+void SnapshotTest::testMaterials()
+{
+    // The bodies keep their material, which the table still has or gets again
+    const std::string path = "snapshot_materials_test.bin";
+    Material rubber;
+    rubber.restitution = 0.25f;
+    rubber.staticFriction = 1.5f;
+    rubber.density = 3;
+    rubber.frictionCombine = CombineMaximum;
+
+    PhysicsWorld original(250);
+    Box* plain = new Box(1, 1, 1);
+    Box* coated = new Box(1, 1, 1, Vector(5, 0, 0));
+    coated->material = MaterialTable::add(rubber);
+    original.addBody(plain);
+    original.addBody(coated);
+
+    PhysicsWorld restored(250);
+    bool loaded = Snapshot::save(original, path) && Snapshot::load(restored, path);
+
+    // A file pointing at a material it does not have is rejected
+    size_t size;
+    std::vector<uint32_t> aligned = readWords(path, size);
+    std::remove(path.c_str());
+    auto header = reinterpret_cast<SnapshotHeader*>(aligned.data());
+    auto records = reinterpret_cast<SnapshotBody*>(reinterpret_cast<char*>(aligned.data()) + sizeof(SnapshotHeader)
+                                                   + header->materialCount * sizeof(SnapshotMaterial));
+    records[1].material = header->materialCount;
+    PhysicsWorld corrupted(250);
+    bool rejected = !Snapshot::load(corrupted, reinterpret_cast<const char*>(aligned.data()), size);
+
+    bool valid = loaded && rejected && restored.bodies.size() == 2 && restored.bodies[0]->material == 0
+        && MaterialTable::get(restored.bodies[1]->material) == rubber;
+    if (!valid)
+    {
+        std::cout << "Error in SnapshotTest::testMaterials()" << std::endl;
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+class SnapshotTest
+{
+public:
+    static void testRoundTrip();
+    static void testInvalidData();
+    static void testWrongVersion();
+    static void testSceneForces();
+    static void testJoints();
+    static void testCompound();
+    static void testHull();
+    static void testMaterials();
+};
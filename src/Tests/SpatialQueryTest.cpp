@@ -0,0 +1,239 @@
+#include "SpatialQueryTest.h"
+
+#include <cmath>
+#include <random>
+
+#include "Box.h"
+#include "Compound.h"
+#include "Cone.h"
+#include "ConvexHull.h"
+#include "GJK.h"
+#include "SpatialQuery.h"
+
+static bool near(float value, float expected, float tolerance)
+{
+    return std::abs(value - expected) <= tolerance;
+}
+
+static bool nearVector(Vector value, Vector expected, float tolerance)
+{
+    return near(value.x, expected.x, tolerance) && near(value.y, expected.y, tolerance)
+        && near(value.z, expected.z, tolerance);
+}
+
+static Shape* makeBody(Shape* body, Vector position)
+{
+    body->setPosition(position);
+    return body;
+}
+
+/**
+ * @brief A world of boxes, cones, spheres and hulls at random places and orientations
+ */
+static void fillWorld(PhysicsWorld& world, int count)
+{
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> place(-200, 200);
+    std::uniform_real_distribution<float> angle(0, 2 * PI);
+    std::vector<Vector> tetrahedron = {Vector(0, 0, 0), Vector(20, 0, 0), Vector(0, 20, 0), Vector(0, 0, 20)};
+    std::vector<Shape*> bodies;
+    for (int i = 0; i < count; i++)
+    {
+        Shape* body;
+        switch (i % 4)
+        {
+        case 0: body = new Box(10, 15, 20); break;
+        case 1: body = new Cone(8, 20); break;
+        case 2: body = new ConvexHull(tetrahedron); break;
+        default:
+            body = new Shape();
+            body->colliderRadius = 7;
+            break;
+        }
+        body->orientation = Quaternion(angle(generator), Vector(place(generator), place(generator), 1).normalized());
+        body->setPosition(Vector(place(generator), place(generator), place(generator)));
+        bodies.push_back(body);
+    }
+    world.addBodies(bodies);
+}
+
+void SpatialQueryTest::testRaycastShapes()
+{
+    PhysicsWorld world(250);
+    world.addBody(makeBody(new Box(2, 2, 2), Vector(0, 0, 0)));
+    Shape* turned = new Box(2, 2, 2);
+    turned->orientation = Quaternion(PI / 4, Vector(0, 0, 1));
+    world.addBody(makeBody(turned, Vector(0, 20, 0)));
+    world.addBody(makeBody(new Cone(2, 4), Vector(20, 0, 0)));
+    Compound* dumbbell = new Compound();
+    dumbbell->addChild(new Box(2, 2, 2), Vector(-3, 0, 0));
+    dumbbell->addChild(new Box(2, 2, 2), Vector(3, 0, 0));
+    world.addBody(makeBody(dumbbell, Vector(0, -20, 0)));
+    SpatialQuery query(world);
+
+    QueryHit box;
+    QueryHit diamond;
+    QueryHit cone;
+    QueryHit child;
+    QueryHit gap;
+    QueryHit away;
+    QueryHit tooShort;
+    QueryHit inside;
+    bool valid = query.raycast(Vector(-10, 0, 0), Vector(2, 0, 0), 100, box)
+        && query.raycast(Vector(-10, 20, 0), Vector(1, 0, 0), 100, diamond)
+        && query.raycast(Vector(20, 10, 0), Vector(0, -1, 0), 100, cone)
+        && query.raycast(Vector(-3, -10, 0), Vector(0, -1, 0), 100, child)
+        && !query.raycast(Vector(0, -10, 0), Vector(0, -1, 0), 100, gap)
+        && !query.raycast(Vector(-10, 0, 0), Vector(-1, 0, 0), 100, away)
+        && !query.raycast(Vector(-10, 0, 0), Vector(1, 0, 0), 5, tooShort)
+        && query.raycast(Vector(0.5f, 0, 0), Vector(1, 0, 0), 100, inside);
+
+    // The cone base is at the top, the rotated box shows an edge to the ray
+    valid = valid && box.body == world.bodies[0] && near(box.distance, 9, 1e-2f)
+        && nearVector(box.normal, Vector(-1, 0, 0), 1e-2f) && nearVector(box.point, Vector(-1, 0, 0), 1e-2f)
+        && diamond.body == turned && near(diamond.distance, 10 - std::sqrt(2.0f), 1e-2f)
+        && cone.body == world.bodies[2] && near(cone.distance, 8, 1e-2f) && nearVector(cone.normal, Vector(0, 1, 0), 1e-2f)
+        && child.body == dumbbell && near(child.distance, 9, 1e-2f)
+        && inside.body == world.bodies[0] && inside.distance == 0;
+    if (!valid)
+    {
+        std::cout << "Error in SpatialQueryTest::testRaycastShapes()" << std::endl;
+    }
+}
+
+void SpatialQueryTest::testSphereCast()
+{
+    PhysicsWorld world(250);
+    world.addBody(makeBody(new Box(2, 2, 2), Vector(0, 0, 0)));
+    SpatialQuery query(world);
+
+    QueryHit face;
+    QueryHit edge;
+    QueryHit miss;
+    bool valid = query.sphereCast(Vector(-10, 0, 0), 1, Vector(1, 0, 0), 100, face)
+        && query.sphereCast(Vector(-10, 1.5f, 0), 1, Vector(1, 0, 0), 100, edge)
+        && !query.sphereCast(Vector(-10, 2.5f, 0), 1, Vector(1, 0, 0), 100, miss);
+
+    // Past the top face, the sphere touches the edge of the box
+    float edgeDistance = 9 - std::sqrt(0.75f);
+    valid = valid && near(face.distance, 8, 1e-2f) && nearVector(face.point, Vector(-1, 0, 0), 1e-2f)
+        && near(edge.distance, edgeDistance, 1e-2f) && nearVector(edge.normal, Vector(-std::sqrt(0.75f), 0.5f, 0), 1e-2f)
+        && nearVector(edge.point, Vector(-1, 1, 0), 1e-2f);
+    if (!valid)
+    {
+        std::cout << "Error in SpatialQueryTest::testSphereCast()" << std::endl;
+    }
+}
+
+void SpatialQueryTest::testMatchesBruteForce()
+{
+    // The octree steps the world, the queries refresh the tree themselves
+    PhysicsWorld world(250);
+    fillWorld(world, 200);
+    for (auto body : world.bodies)
+    {
+        body->linearVelocity = Vector(30, -20, 10);
+    }
+    world.collisions = false;
+    world.step(0.5f);
+    SpatialQuery query(world);
+
+    std::mt19937 generator(9);
+    std::normal_distribution<float> normal(0, 1);
+    bool valid = true;
+    int hitCount = 0;
+    for (int i = 0; i < 300; i++)
+    {
+        Vector origin(normal(generator) * 100, normal(generator) * 100, normal(generator) * 100);
+        Vector direction = Vector(normal(generator), normal(generator), normal(generator)).normalized();
+        float radius = i % 2 == 0 ? 0 : 3;
+
+        Shape* expected = nullptr;
+        float closest = 500;
+        for (auto body : world.bodies)
+        {
+            float distance;
+            Vector hitNormal;
+            if (GJK::raycast(*body, origin, direction, radius, closest, distance, hitNormal) && distance < closest)
+            {
+                closest = distance;
+                expected = body;
+            }
+        }
+
+        QueryHit hit;
+        bool found = query.sphereCast(origin, radius, direction, 500, hit);
+        valid = valid && found == (expected != nullptr) && (!found || near(hit.distance, closest, 1e-2f));
+        hitCount += found;
+    }
+    if (!valid || hitCount < 20)
+    {
+        std::cout << "Error in SpatialQueryTest::testMatchesBruteForce()" << std::endl;
+    }
+}
+
+void SpatialQueryTest::testOverlap()
+{
+    PhysicsWorld world(250);
+    fillWorld(world, 100);
+    SpatialQuery query(world);
+
+    AABB box(Vector(-100, -50, -100), Vector(50, 100, 20));
+    std::vector<Shape*> results;
+    query.overlap(box, results);
+    size_t expected = 0;
+    for (auto body : world.bodies)
+    {
+        expected += body->getBounds().overlaps(box);
+    }
+    bool valid = results.size() == expected && expected > 0;
+    for (auto body : results)
+    {
+        valid = valid && body->getBounds().overlaps(box);
+    }
+    if (!valid)
+    {
+        std::cout << "Error in SpatialQueryTest::testOverlap()" << std::endl;
+    }
+}
+
+void SpatialQueryTest::testBatch()
+{
+    PhysicsWorld world(250);
+    fillWorld(world, 200);
+    SpatialQuery query(world);
+    query.threadCount = 4;
+
+    std::vector<QueryRay> rays;
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 500; i++)
+    {
+        float angle = i * 2.39996f;
+        rays.push_back({Vector(0, 0, 0), Vector(std::cos(angle), std::sin(i * 0.37f), std::sin(angle)), 300,
+                        i % 3 == 0 ? 2.0f : 0.0f});
+        boxes.push_back(AABB::fromSphere(Vector(std::cos(angle) * 150, 0, std::sin(angle) * 150), 30));
+    }
+    std::vector<QueryHit> hits;
+    int hitCount = query.castBatch(rays, hits);
+    std::vector<std::vector<Shape*>> overlaps;
+    query.overlapBatch(boxes, overlaps);
+
+    // Same results as one query at a time
+    bool valid = hits.size() == rays.size() && overlaps.size() == boxes.size() && hitCount > 0;
+    int sequentialCount = 0;
+    for (size_t i = 0; valid && i < rays.size(); i++)
+    {
+        QueryHit hit;
+        bool found = query.sphereCast(rays[i].origin, rays[i].radius, rays[i].direction, rays[i].maxDistance, hit);
+        sequentialCount += found;
+        valid = found == (hits[i].body != nullptr) && hit.body == hits[i].body && hit.distance == hits[i].distance;
+
+        std::vector<Shape*> results;
+        query.overlap(boxes[i], results);
+        valid = valid && results == overlaps[i];
+    }
+    if (!valid || sequentialCount != hitCount)
+    {
+        std::cout << "Error in SpatialQueryTest::testBatch()" << std::endl;
+    }
+}
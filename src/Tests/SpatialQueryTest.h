@@ -0,0 +1,11 @@
+#pragma once
+
+class SpatialQueryTest
+{
+public:
+    static void testRaycastShapes();
+    static void testSphereCast();
+    static void testMatchesBruteForce();
+    static void testOverlap();
+    static void testBatch();
+};
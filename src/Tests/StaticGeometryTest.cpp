@@ -0,0 +1,162 @@
+#include "StaticGeometryTest.h"
+
+#include <stdexcept>
+
+#include "Box.h"
+#include "Heightfield.h"
+#include "StaticBVH.h"
+#include "StaticWorld.h"
+#include "TriangleMesh.h"
+
+void StaticGeometryTest::testPlane()
+{
+    // Turned by 45 degrees, the lowest corner of the box is sqrt(2) under its center
+    StaticPlane floor(Vector(0, 1, 0), 0);
+    Box box(2, 2, 2);
+    box.orientation = Quaternion(PI / 4, Vector(0, 0, 1));
+    box.setPosition(Vector(0, 1, 0));
+
+    Contact contact;
+    bool collided = floor.collide(box, contact);
+    box.setPosition(Vector(0, 2, 0));
+    Contact separated;
+
+    if (!collided || glm::abs(contact.penetration - (glm::sqrt(2.0f) - 1)) > 0.001f
+        || contact.normal.distance(Vector(0, -1, 0)) > 0.001f || contact.second != nullptr
+        || floor.collide(box, separated))
+    {
+        std::cout << "Error in StaticGeometryTest::testPlane()" << std::endl;
+    }
+}
+
+void StaticGeometryTest::testHeightfield()
+{
+    // Flat terrain at y = 2, the box sinks by 0.5 into it
+    Heightfield terrain(Vector(-10, 0, -10), 5, 5, 5, std::vector<float>(25, 2));
+    Box box(2, 2, 2);
+    box.setPosition(Vector(1, 2.5, 1));
+
+    Contact contact;
+    bool collided = terrain.collide(box, contact);
+
+    // A grid without heights has no bounds, it is refused
+    bool rejected = false;
+    try
+    {
+        Heightfield empty(Vector(0, 0, 0), 0, 0, 1, std::vector<float>());
+    }
+    catch (const std::invalid_argument&)
+    {
+        rejected = true;
+    }
+
+    if (!collided || glm::abs(contact.penetration - 0.5f) > 0.01f || contact.normal.distance(Vector(0, -1, 0)) > 0.01f
+        || !rejected)
+    {
+        std::cout << "Error in StaticGeometryTest::testHeightfield()" << std::endl;
+    }
+}
+
+void StaticGeometryTest::testBVHQuery()
+{
+    // The hierarchy must find the same boxes as a brute force search
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 200; i++)
+    {
+        Vector center(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100));
+        boxes.push_back(AABB::fromSphere(center, ofRandom(1, 10)));
+    }
+    StaticBVH bvh;
+    bvh.build(boxes);
+
+    bool same = true;
+    for (int i = 0; i < 50; i++)
+    {
+        AABB query = AABB::fromSphere(Vector(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100)), 20);
+        std::vector<int> results;
+        bvh.query(query, results);
+
+        size_t expected = 0;
+        for (auto box : boxes)
+        {
+            if (box.overlaps(query)) expected++;
+        }
+        if (results.size() != expected) same = false;
+    }
+
+    if (!same)
+    {
+        std::cout << "Error in StaticGeometryTest::testBVHQuery()" << std::endl;
+    }
+}
+
+void StaticGeometryTest::testTriangleMesh()
+{
+    // A 20x20 floor made of a grid of quads at y = 0
+    std::vector<Vector> vertices;
+    std::vector<int> indices;
+    for (int row = 0; row <= 10; row++)
+    {
+        for (int column = 0; column <= 10; column++)
+        {
+            vertices.emplace_back(column * 2 - 10, 0, row * 2 - 10);
+        }
+    }
+    for (int row = 0; row < 10; row++)
+    {
+        for (int column = 0; column < 10; column++)
+        {
+            int first = row * 11 + column;
+            indices.insert(indices.end(), {first, first + 11, first + 1, first + 1, first + 11, first + 12});
+        }
+    }
+    TriangleMesh floor(vertices, indices);
+
+    Box box(2, 2, 2);
+    box.setPosition(Vector(0.5, 0.8, 0.5));
+    Contact contact;
+    bool collided = floor.collide(box, contact);
+
+    // Deep enough for EPA to prefer the back side, the box must still be pushed up
+    Box sunk(2, 2, 2);
+    sunk.setPosition(Vector(0.5, 0.2, 0.5));
+    Contact sunkContact;
+    bool sunkCollided = floor.collide(sunk, sunkContact);
+
+    std::vector<int> triangles;
+    floor.queryTriangles(box.getBounds(), triangles);
+
+    if (!collided || glm::abs(contact.penetration - 0.2f) > 0.01f || contact.normal.distance(Vector(0, -1, 0)) > 0.01f
+        || !sunkCollided || glm::abs(sunkContact.penetration - 0.8f) > 0.01f
+        || sunkContact.normal.distance(Vector(0, -1, 0)) > 0.01f
+        || triangles.empty() || triangles.size() > 16)
+    {
+        std::cout << "Error in StaticGeometryTest::testTriangleMesh()" << std::endl;
+    }
+}
+
+void StaticGeometryTest::testStaticWorld()
+{
+    StaticWorld world;
+    world.addPlane(new StaticPlane(Vector(0, 1, 0), -10));
+    std::vector<Vector> vertices = {Vector(-5, 0, -5), Vector(-5, 0, 5), Vector(5, 0, -5)};
+    world.add(new TriangleMesh(vertices, {0, 1, 2}));
+    world.build();
+
+    // Resting on the triangle, far above the plane
+    Box box(2, 2, 2);
+    box.setPosition(Vector(-1, 0.9, -1));
+    std::vector<Contact> contacts;
+    world.getContacts(box, contacts);
+
+    // A plane added as any other collider is tested too
+    world.add(new StaticPlane(Vector(0, -1, 0), -0.5f));
+    std::vector<Contact> underCeiling;
+    world.getContacts(box, underCeiling);
+
+    if (contacts.size() != 1 || contacts[0].first != &box || world.colliders.size() != 3 || world.planes.size() != 2
+        || underCeiling.size() != 2)
+    {
+        std::cout << "Error in StaticGeometryTest::testStaticWorld()" << std::endl;
+    }
+}
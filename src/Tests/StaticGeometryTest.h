@@ -0,0 +1,11 @@
+#pragma once
+
+class StaticGeometryTest
+{
+public:
+    static void testPlane();
+    static void testHeightfield();
+    static void testBVHQuery();
+    static void testTriangleMesh();
+    static void testStaticWorld();
+};
@@ -0,0 +1,117 @@
+#include "TrajectoryTest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "Box.h"
+#include "Cone.h"
+#include "TrajectoryWriter.h"
+
+void TrajectoryTest::testCodecRoundTrip()
+{
+    // Random words, long runs and a single word must all survive the encoding
+    std::vector<std::vector<uint32_t>> inputs(3);
+    for (int i = 0; i < 1000; i++)
+    {
+        inputs[0].push_back(static_cast<uint32_t>(rand()) * 2654435761u);
+        inputs[1].push_back(i < 500 ? 7 : 0xFFFFFFFF);
+    }
+    inputs[2].push_back(0x12345678);
+
+    bool identical = true;
+    for (auto& words : inputs)
+    {
+        std::vector<char> encoded;
+        TrajectoryFile::encode(words, encoded);
+        std::vector<uint32_t> decoded(words.size());
+        identical = identical && TrajectoryFile::decode(encoded.data(), encoded.size(), decoded) && decoded == words;
+    }
+
+    // Truncated data is rejected
+    std::vector<char> encoded;
+    TrajectoryFile::encode(inputs[0], encoded);
+    std::vector<uint32_t> decoded(inputs[0].size());
+    bool rejected = !TrajectoryFile::decode(encoded.data(), encoded.size() / 2, decoded);
+
+    if (!identical || !rejected)
+    {
+        std::cout << "Error in TrajectoryTest::testCodecRoundTrip()" << std::endl;
+    }
+}
+
+void TrajectoryTest::testSmoothDataCompresses()
+{
+    // A resting body and a slowly moving one, like most of a trajectory
+    std::vector<uint32_t> words;
+    for (int i = 0; i < 4096; i++)
+    {
+        float value = i < 2048 ? 12.5f : 100 + std::floor(i / 64.0f);
+        uint32_t word;
+        std::memcpy(&word, &value, sizeof(word));
+        words.push_back(word);
+    }
+    std::vector<char> encoded;
+    TrajectoryFile::encode(words, encoded);
+
+    if (encoded.size() * 8 > words.size() * sizeof(uint32_t))
+    {
+        std::cout << "Error in TrajectoryTest::testSmoothDataCompresses()" << std::endl;
+    }
+}
+
+void TrajectoryTest::testWriterMatchesWorld()
+{
+    const std::string path = "trajectory_test.bin";
+    PhysicsWorld world(250);
+    world.staticWorld.addArena(250);
+    world.gravity = true;
+    world.addBody(new Box(30, 20, 25, Vector(0, -200, 0)));
+    world.addBody(new Cone(20, 30, Vector(50, 0, 0)));
+
+    TrajectoryWriter writer;
+    bool valid = writer.open(path, TRAJECTORY_ALL_FIELDS, 2);
+    world.trajectoryWriter = &writer;
+    for (int i = 0; i < 200; i++)
+    {
+        world.step(FIXED_TIME_STEP);
+        // A new body closes the current chunk
+        if (i == 100) world.addBody(new Box(10, 10, 10, Vector(-50, 0, 0)));
+    }
+    writer.close();
+    world.trajectoryWriter = nullptr;
+
+    TrajectoryFile trajectories;
+    valid = valid && trajectories.read(path);
+    std::remove(path.c_str());
+
+    // 50 frames with 2 bodies then 50 with 3, one chunk each
+    size_t frames = 0;
+    for (auto& chunk : trajectories.chunks)
+    {
+        frames += chunk.steps.size();
+        valid = valid && (chunk.ids.size() == 2 || chunk.ids.size() == 3);
+    }
+    valid = valid && frames == 100 && trajectories.chunks.size() == 2 && trajectories.header.interval == 2;
+
+    if (valid)
+    {
+        TrajectoryChunk& last = trajectories.chunks.back();
+        int frame = static_cast<int>(last.steps.size()) - 1;
+        valid = last.steps[frame] == world.stepCount && last.ids[2] == 2;
+        for (int body = 0; valid && body < 3; body++)
+        {
+            Shape* shape = world.bodies[body];
+            valid = last.getValue(1, body, frame) == shape->position.y
+                && last.getValue(3, body, frame) == shape->orientation.w
+                && last.getValue(8, body, frame) == shape->linearVelocity.y
+                && last.getValue(12, body, frame) == shape->angularVelocity.z
+                && last.getValue(13, body, frame) == shape->contactCount;
+        }
+    }
+
+    if (!valid)
+    {
+        std::cout << "Error in TrajectoryTest::testWriterMatchesWorld()" << std::endl;
+    }
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+class TrajectoryTest
+{
+public:
+    static void testCodecRoundTrip();
+    static void testSmoothDataCompresses();
+    static void testWriterMatchesWorld();
+};